@@ -19,6 +19,7 @@
 
 #include <vector>
 
+#include "common/math/math_util.h"
 #include "common/math_util.h"
 #include "common/util.h"
 
@@ -122,6 +123,71 @@ void BCast::ReverseAllIntermediateShapes() {
   Reverse(grad_y_reduce_idx_);
 }
 
+Status BCast::GenerateBcastLoop(const std::vector<ConstGeTensorPtr> &input, size_t type_size) {
+  // Min input num is 2
+  if (input.size() < kMinDimNum) {
+    REPORT_INNER_ERROR("E19999", "Param input.size():%zu < %zu, check invalid", input.size(), kMinDimNum);
+    GELOGE(PARAM_INVALID, "[Check][Param] Input size is smaller than two.");
+    return PARAM_INVALID;
+  }
+  GE_CHECK_NOTNULL(input[0]);
+  GE_CHECK_NOTNULL(input[1]);
+  // Only broadcast shape
+  Status ret = GenerateBcastInfo(TransShapeToDimVec(input[0]->GetTensorDesc()),
+                                 TransShapeToDimVec(input[1]->GetTensorDesc()));
+  if (ret != SUCCESS) {
+    GELOGE(ret, "[Generate][BcastInfo] broadcasting failed.");
+    return ret;
+  }
+
+  bcast_dims_.clear();
+  int64_t x_num = 1;
+  int64_t y_num = 1;
+  output_num_ = 1;
+  for (size_t i = output_.size(); i > 0; --i) {
+    const int64_t out_dim = output_[i - 1];
+    const int64_t x_dim = x_reshape_[i - 1];
+    const int64_t y_dim = y_reshape_[i - 1];
+    if (out_dim == 0) {
+      output_num_ = 0;
+      break;
+    }
+    if (out_dim == 1) {
+      continue;
+    }
+    const bool x_bcast = (x_dim == 1);
+    const bool y_bcast = (y_dim == 1);
+    // an outer dim continues the inner one if both inputs broadcast along them the same way
+    if (!bcast_dims_.empty() && ((bcast_dims_.back().x_stride == 0) == x_bcast) &&
+        ((bcast_dims_.back().y_stride == 0) == y_bcast)) {
+      FMK_INT64_MULCHECK(bcast_dims_.back().size, out_dim);
+      bcast_dims_.back().size *= out_dim;
+    } else {
+      bcast_dims_.push_back({out_dim, x_bcast ? 0 : x_num, y_bcast ? 0 : y_num});
+    }
+    FMK_INT64_MULCHECK(output_num_, out_dim);
+    output_num_ *= out_dim;
+    x_num *= x_dim;
+    y_num *= y_dim;
+  }
+  if (output_num_ == 0) {
+    bcast_dims_.clear();
+    return SUCCESS;
+  }
+
+  size_t x_size = input[0]->GetData().size();
+  size_t y_size = input[1]->GetData().size();
+  if ((static_cast<uint64_t>(x_num) > x_size / type_size) || (static_cast<uint64_t>(y_num) > y_size / type_size)) {
+    REPORT_INNER_ERROR("E19999", "Data size of x:%zu or y:%zu is less than its shape, element num x:%ld, y:%ld",
+                       x_size, y_size, x_num, y_num);
+    GELOGE(PARAM_INVALID, "[Check][Param] Data size of x:%zu or y:%zu is less than its shape, element num x:%ld, y:%ld",
+           x_size, y_size, x_num, y_num);
+    return PARAM_INVALID;
+  }
+  GELOGD("Broadcast %zu dims in %zu loops, output element num %ld.", output_.size(), bcast_dims_.size(), output_num_);
+  return SUCCESS;
+}
+
 void BCast::BCastIndexes(kVecInt &x_indexes, kVecInt &y_indexes) {
   Reverse(x_reshape_);
   Reverse(y_reshape_);
@@ -107,92 +107,71 @@ class BCast {
   static kVecInt TransShapeToDimVec(const GeTensorDesc &shape);
 
   void BCastIndexes(kVecInt &x_indexes, kVecInt &y_indexes);
-  template <typename InT, typename OutT>
-  Status BCastCompute(const std::vector<ConstGeTensorPtr> &input, std::vector<OutT> &v_output,
-                      const std::function<OutT(InT const &, InT const &)> &func) {
-    Status ret;
-    if (func == nullptr) {
-      REPORT_INNER_ERROR("E19999", "Check param func nullptr");
-      GELOGE(domi::PARAM_INVALID, "Param func is null");
-      return domi::PARAM_INVALID;
-    }
-    // Min input num is 2
-    if (input.size() < kMinDimNum) {
-      REPORT_INNER_ERROR("E19999", "Param input.size():%zu < %zu, check invalid",
-                         input.size(), kMinDimNum);
-      GELOGE(domi::PARAM_INVALID, "Input size is smaller than two.");
-      return domi::PARAM_INVALID;
-    }
-    // Only broadcast shape
-    ret =
-      GenerateBcastInfo(TransShapeToDimVec(input[0]->GetTensorDesc()), TransShapeToDimVec(input[1]->GetTensorDesc()));
-    if (ret != domi::SUCCESS) {
-      GELOGE(ret, "Greater broadcasting failed.");
-      return ret;
-    }
 
-    kVecInt x_indexes;
-    kVecInt y_indexes;
-    BCastIndexes(x_indexes, y_indexes);
-
-    const void *x1_data = input[0]->GetData().data();
-    const void *x2_data = input[1]->GetData().data();
-
-    for (size_t i = 0; i < x_indexes.size(); i++) {
-      int64_t x_index = x_indexes[i];
-      int64_t y_index = y_indexes[i];
-      auto value = func((*(reinterpret_cast<const InT *>(x1_data) + x_index)),
-                        (*(reinterpret_cast<const InT *>(x2_data) + y_index)));
-      v_output.push_back(value);
+  ///
+  /// @ingroup domi_calibration
+  /// @brief broadcast input[0] and input[1] elementwise by func, output is appended to v_output
+  /// @param [in] func   OutT(InT const &, InT const &), a lambda or functor is inlined in the loops
+  ///
+  template <typename InT, typename OutT, typename Func>
+  Status BCastCompute(const std::vector<ConstGeTensorPtr> &input, std::vector<OutT> &v_output, const Func &func) {
+    Status ret = GenerateBcastLoop(input, sizeof(InT));
+    if (ret != SUCCESS) {
+      return ret;
     }
-
-    return domi::SUCCESS;
+    const InT *x_data = reinterpret_cast<const InT *>(input[0]->GetData().data());
+    const InT *y_data = reinterpret_cast<const InT *>(input[1]->GetData().data());
+    size_t out_begin = v_output.size();
+    v_output.resize(out_begin + static_cast<size_t>(output_num_));
+    OutT *out_data = v_output.data() + out_begin;
+    (void)ForEachBcastRun([&](int64_t x_offset, bool x_step, int64_t y_offset, bool y_step, int64_t out_offset,
+                              int64_t count) -> bool {
+      ComputeRun(x_data + x_offset, x_step, y_data + y_offset, y_step, out_data + out_offset, count, func);
+      return true;
+    });
+    return SUCCESS;
   }
 
-  template <typename InT, typename OutT>
+  ///
+  /// @ingroup domi_calibration
+  /// @brief same as BCastCompute, but every pair of elements is checked before computed
+  /// @param [in] check   bool(InT const &, InT const &), false if func overflows with the pair
+  /// @return     PARAM_INVALID   check fails with any pair, nothing is computed for its run
+  ///
+  template <typename InT, typename OutT, typename Func, typename Check>
   Status BCastComputeCheck(const std::vector<ConstGeTensorPtr> &input, std::vector<OutT> &v_output,
-                           const std::function<OutT(InT const &, InT const &, DataType &type, Status &)> &func) {
-    if (func == nullptr) {
-      REPORT_INNER_ERROR("E19999", "Check param func nullptr");
-      GELOGE(PARAM_INVALID, "Param func is null");
-      return PARAM_INVALID;
-    }
-    // Min input num is 2
-    if (input.size() < kMinDimNum) {
-      REPORT_INNER_ERROR("E19999", "Param input.size():%zu < %zu, check invalid",
-                         input.size(), kMinDimNum);
-      GELOGE(PARAM_INVALID, "Input size is smaller than two.");
-      return PARAM_INVALID;
-    }
-    // Only broadcast shape
-    Status ret =
-      GenerateBcastInfo(TransShapeToDimVec(input[0]->GetTensorDesc()), TransShapeToDimVec(input[1]->GetTensorDesc()));
+                           const Func &func, const Check &check) {
+    Status ret = GenerateBcastLoop(input, sizeof(InT));
     if (ret != SUCCESS) {
-      GELOGE(ret, "Greater broadcasting failed.");
       return ret;
     }
-
-    DataType data_type = input[0]->GetTensorDesc().GetDataType();
-    kVecInt x_indexes;
-    kVecInt y_indexes;
-    BCastIndexes(x_indexes, y_indexes);
-
-    const void *x1_data = input[0]->GetData().data();
-    const void *x2_data = input[1]->GetData().data();
-
-    for (size_t i = 0; i < x_indexes.size(); i++) {
-      int64_t x_index = x_indexes[i];
-      int64_t y_index = y_indexes[i];
-      auto value = func((*(reinterpret_cast<const InT *>(x1_data) + x_index)),
-                        (*(reinterpret_cast<const InT *>(x2_data) + y_index)), data_type, ret);
-      if (ret != SUCCESS) {
-        REPORT_INNER_ERROR("E19999", "BCastComputeCheck func execute failed, datatype is %d.", data_type);
-        GELOGE(ret, "BCastComputeCheck func execute failed, datatype is %d.", data_type);
-        return ret;
+    const InT *x_data = reinterpret_cast<const InT *>(input[0]->GetData().data());
+    const InT *y_data = reinterpret_cast<const InT *>(input[1]->GetData().data());
+    size_t out_begin = v_output.size();
+    v_output.resize(out_begin + static_cast<size_t>(output_num_));
+    OutT *out_data = v_output.data() + out_begin;
+    bool all_valid = ForEachBcastRun([&](int64_t x_offset, bool x_step, int64_t y_offset, bool y_step,
+                                         int64_t out_offset, int64_t count) -> bool {
+      // a whole run is checked before computed, so the check loop has no early exit as well
+      if (!CheckRun(x_data + x_offset, x_step, y_data + y_offset, y_step, count, check)) {
+        for (int64_t i = 0; i < count; ++i) {
+          if (!check(x_data[x_offset + (x_step ? i : 0)], y_data[y_offset + (y_step ? i : 0)])) {
+            REPORT_INNER_ERROR("E19999", "BCastComputeCheck func execute failed at output index %ld, datatype is %d.",
+                               out_offset + i, input[0]->GetTensorDesc().GetDataType());
+            GELOGE(PARAM_INVALID, "BCastComputeCheck func execute failed at output index %ld, datatype is %d.",
+                   out_offset + i, input[0]->GetTensorDesc().GetDataType());
+            break;
+          }
+        }
+        return false;
       }
-      v_output.push_back(value);
+      ComputeRun(x_data + x_offset, x_step, y_data + y_offset, y_step, out_data + out_offset, count, func);
+      return true;
+    });
+    if (!all_valid) {
+      v_output.resize(out_begin);
+      return PARAM_INVALID;
     }
-
     return SUCCESS;
   }
 
@@ -229,6 +208,121 @@ class BCast {
   ///
   void ReverseAllIntermediateShapes();
 
+  ///
+  /// @ingroup domi_calibration
+  /// @brief generate broadcast info of input[0] and input[1], and collapse it to the loop of bcast_dims_
+  /// @param [in] input   at least two tensors, of which the data must hold their shapes
+  /// @param [in] type_size   size of an element
+  ///
+  Status GenerateBcastLoop(const std::vector<ConstGeTensorPtr> &input, size_t type_size);
+
+  ///
+  /// @ingroup domi_calibration
+  /// @brief call func with every contiguous run of the output in order, the innermost dim of bcast_dims_ is a run
+  /// @param [in] func   bool(x_offset, x_step, y_offset, y_step, out_offset, count), a step is false if the
+  ///                    input stays at its offset for the run, true if it moves along with the output;
+  ///                    return false to stop
+  /// @return     false if stopped by func
+  ///
+  template <typename Func>
+  bool ForEachBcastRun(const Func &func) const {
+    if (output_num_ == 0) {
+      return true;
+    }
+    if (bcast_dims_.empty()) {
+      return func(0, false, 0, false, 0, 1);
+    }
+    const BcastDim &inner = bcast_dims_[0];
+    const bool x_step = inner.x_stride != 0;
+    const bool y_step = inner.y_stride != 0;
+    std::vector<int64_t> counters(bcast_dims_.size(), 0);
+    int64_t x_offset = 0;
+    int64_t y_offset = 0;
+    for (int64_t out_offset = 0; out_offset < output_num_; out_offset += inner.size) {
+      if (!func(x_offset, x_step, y_offset, y_step, out_offset, inner.size)) {
+        return false;
+      }
+      for (size_t i = 1; i < bcast_dims_.size(); ++i) {
+        const BcastDim &dim = bcast_dims_[i];
+        x_offset += dim.x_stride;
+        y_offset += dim.y_stride;
+        if (++counters[i] < dim.size) {
+          break;
+        }
+        x_offset -= dim.x_stride * dim.size;
+        y_offset -= dim.y_stride * dim.size;
+        counters[i] = 0;
+      }
+    }
+    return true;
+  }
+
+  ///
+  /// @ingroup domi_calibration
+  /// @brief compute a run, each combination of steps has its own loop so that the compiler vectorizes it
+  ///
+  template <typename InT, typename OutT, typename Func>
+  static void ComputeRun(const InT *x, bool x_step, const InT *y, bool y_step, OutT *out, int64_t count,
+                         const Func &func) {
+    if (x_step && y_step) {
+      for (int64_t i = 0; i < count; ++i) {
+        out[i] = func(x[i], y[i]);
+      }
+    } else if (x_step) {
+      const InT y_value = *y;
+      for (int64_t i = 0; i < count; ++i) {
+        out[i] = func(x[i], y_value);
+      }
+    } else if (y_step) {
+      const InT x_value = *x;
+      for (int64_t i = 0; i < count; ++i) {
+        out[i] = func(x_value, y[i]);
+      }
+    } else {
+      const OutT value = func(*x, *y);
+      for (int64_t i = 0; i < count; ++i) {
+        out[i] = value;
+      }
+    }
+  }
+
+  ///
+  /// @ingroup domi_calibration
+  /// @brief check a run, results are and-ed up instead of returned early
+  ///
+  template <typename InT, typename Check>
+  static bool CheckRun(const InT *x, bool x_step, const InT *y, bool y_step, int64_t count, const Check &check) {
+    bool valid = true;
+    if (x_step && y_step) {
+      for (int64_t i = 0; i < count; ++i) {
+        valid &= check(x[i], y[i]);
+      }
+    } else if (x_step) {
+      const InT y_value = *y;
+      for (int64_t i = 0; i < count; ++i) {
+        valid &= check(x[i], y_value);
+      }
+    } else if (y_step) {
+      const InT x_value = *x;
+      for (int64_t i = 0; i < count; ++i) {
+        valid &= check(x_value, y[i]);
+      }
+    } else {
+      valid = check(*x, *y);
+    }
+    return valid;
+  }
+
+  ///
+  /// @ingroup domi_calibration
+  /// @brief a dim of the broadcast loop, adjacent dims broadcasting the same way are collapsed into one
+  ///
+  struct BcastDim {
+    int64_t size;
+    int64_t x_stride;  // 0 if x is broadcast along the dim
+    int64_t y_stride;  // 0 if y is broadcast along the dim
+  };
+
   kVecInt x_reshape_;
   kVecInt x_bcast_;
   kVecInt y_reshape_;
@@ -237,6 +331,9 @@ class BCast {
   kVecInt output_;
   kVecInt grad_x_reduce_idx_;
   kVecInt grad_y_reduce_idx_;
+  // from the innermost dim to the outermost one
+  std::vector<BcastDim> bcast_dims_;
+  int64_t output_num_ = 0;
 };
 }  // namespace ge
 
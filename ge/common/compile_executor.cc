@@ -0,0 +1,153 @@
+/**
+* Copyright 2021, 2022 LuoJiaNET Research and Development Group, Wuhan University
+* Copyright 2021, 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "common/compile_executor.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <new>
+
+#include "common/util/error_manager/error_manager.h"
+#include "framework/common/debug/ge_log.h"
+
+namespace ge {
+namespace {
+// the number of threads optimizing the subgraphs used to be 16 by default
+const uint32_t kDefaultThreadNum = 16U;
+const uint32_t kMaxThreadNum = 256U;
+const size_t kMaxRecordedNameNum = 65536U;
+
+uint32_t GetThreadNum() {
+  uint32_t thread_num = kDefaultThreadNum;
+  const char *env = std::getenv("THREAD_MULTI_NUM");
+  if (env != nullptr) {
+    int32_t env_num = std::atoi(env);
+    if (env_num > 0) {
+      thread_num = std::min(static_cast<uint32_t>(env_num), kMaxThreadNum);
+    }
+  }
+  return thread_num;
+}
+}  // namespace
+
+CompileExecutor &CompileExecutor::GetInstance() {
+  static CompileExecutor instance;
+  return instance;
+}
+
+CompileExecutor::CompileExecutor() {
+  uint32_t thread_num = GetThreadNum();
+  // the caller thread of Run takes part as well
+  thread_pool_.reset(new (std::nothrow) WorkStealingThreadPool(thread_num > 1U ? thread_num - 1U : 1U));
+  if (thread_pool_ == nullptr) {
+    REPORT_CALL_ERROR("E19999", "New WorkStealingThreadPool failed");
+    GELOGE(MEMALLOC_FAILED, "[New][ThreadPool] of compile executor failed.");
+    return;
+  }
+  GEEVENT("Compile executor is created with %u threads.", thread_pool_->GetThreadNum());
+}
+
+Status CompileExecutor::Run(const std::string &purpose, std::vector<Task> &tasks, uint32_t max_parallel) {
+  if (thread_pool_ == nullptr) {
+    REPORT_INNER_ERROR("E19999", "Thread pool of compile executor is nullptr, check invalid");
+    GELOGE(MEMALLOC_FAILED, "[Check][Param] Thread pool of compile executor is nullptr, %s not run.",
+           purpose.c_str());
+    return MEMALLOC_FAILED;
+  }
+  std::vector<std::pair<uint64_t, size_t>> costs_to_indexes;
+  for (size_t i = 0U; i < tasks.size(); ++i) {
+    if (!tasks[i].func) {
+      REPORT_INNER_ERROR("E19999", "Task %s of %s is empty, check invalid", tasks[i].name.c_str(), purpose.c_str());
+      GELOGE(PARAM_INVALID, "[Check][Param] Task %s of %s is empty.", tasks[i].name.c_str(), purpose.c_str());
+      return PARAM_INVALID;
+    }
+    costs_to_indexes.emplace_back(EstimateCost(tasks[i].name, tasks[i].node_num), i);
+  }
+  // start the largest tasks first, so a slow one does not run alone at the end
+  std::stable_sort(costs_to_indexes.begin(), costs_to_indexes.end(),
+                   [](const std::pair<uint64_t, size_t> &lhs, const std::pair<uint64_t, size_t> &rhs) {
+                     return lhs.first > rhs.first;
+                   });
+
+  const auto start = std::chrono::steady_clock::now();
+  std::atomic<bool> failed(false);
+  std::atomic<size_t> done_num(0U);
+  const auto run_tasks = [&](size_t begin, size_t end) -> Status {
+    for (size_t i = begin; i < end; ++i) {
+      if (failed.load()) {
+        return SUCCESS;
+      }
+      auto &task = tasks[costs_to_indexes[i].second];
+      const auto task_start = std::chrono::steady_clock::now();
+      Status ret = task.func();
+      if (ret != SUCCESS) {
+        failed.store(true);
+        GELOGE(ret, "[Run][Task] %s of %s failed.", task.name.c_str(), purpose.c_str());
+        return ret;
+      }
+      auto cost = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(
+          std::chrono::steady_clock::now() - task_start).count());
+      RecordCost(task.name, task.node_num, cost);
+      GELOGD("[%s] Task %s of %zu nodes done in %lu us, %zu/%zu.", purpose.c_str(), task.name.c_str(),
+             task.node_num, cost, ++done_num, tasks.size());
+    }
+    return SUCCESS;
+  };
+  Status ret = thread_pool_->ParallelFor(tasks.size(), 1U, max_parallel, run_tasks);
+  if (ret != SUCCESS) {
+    return ret;
+  }
+  GELOGI("[%s] %zu tasks done in %lu us.", purpose.c_str(), tasks.size(),
+         static_cast<uint64_t>(
+             std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count()));
+  return SUCCESS;
+}
+
+uint64_t CompileExecutor::EstimateCost(const std::string &name, size_t node_num) const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto iter = names_to_time_us_.find(name);
+  if (iter != names_to_time_us_.end()) {
+    return iter->second;
+  }
+  if (recorded_node_num_ == 0U) {
+    return node_num;
+  }
+  return static_cast<uint64_t>(static_cast<double>(node_num) * recorded_time_us_ / recorded_node_num_);
+}
+
+void CompileExecutor::RecordCost(const std::string &name, size_t node_num, uint64_t time_us) {
+  if (name.empty()) {
+    return;
+  }
+  std::lock_guard<std::mutex> lock(mutex_);
+  if ((names_to_time_us_.size() >= kMaxRecordedNameNum) && (names_to_time_us_.count(name) == 0U)) {
+    names_to_time_us_.clear();
+  }
+  names_to_time_us_[name] = time_us;
+  recorded_time_us_ += time_us;
+  recorded_node_num_ += node_num;
+}
+
+void CompileExecutor::ClearCosts() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  names_to_time_us_.clear();
+  recorded_time_us_ = 0U;
+  recorded_node_num_ = 0U;
+}
+}  // namespace ge
@@ -0,0 +1,76 @@
+/**
+* Copyright 2021, 2022 LuoJiaNET Research and Development Group, Wuhan University
+* Copyright 2021, 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef GE_COMMON_COMPILE_EXECUTOR_H_
+#define GE_COMMON_COMPILE_EXECUTOR_H_
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "common/work_stealing_thread_pool.h"
+
+namespace ge {
+///
+/// Process wide executor of the compile tasks, e.g. subgraph optimization, shared by graphs and sessions so
+/// the threads are created only once. Tasks of a batch are started largest first by their estimated cost,
+/// which is the compile time recorded for the same name before or else derived from the node number.
+///
+class CompileExecutor {
+ public:
+  struct Task {
+    // name of the recorded compile time, empty for not recording
+    std::string name;
+    size_t node_num = 0U;
+    std::function<Status()> func;
+  };
+
+  static CompileExecutor &GetInstance();
+
+  CompileExecutor(const CompileExecutor &) = delete;
+  CompileExecutor &operator=(const CompileExecutor &) = delete;
+
+  ///
+  /// @brief run the tasks and wait for all of them. The caller thread takes part, so it is safe to call from
+  ///        inside a task. No task is started after one fails.
+  /// @param [in] max_parallel at most this number of tasks run at the same time, 0 for the thread number
+  /// @return the status of the first failed task
+  ///
+  Status Run(const std::string &purpose, std::vector<Task> &tasks, uint32_t max_parallel = 0U);
+
+  uint64_t EstimateCost(const std::string &name, size_t node_num) const;
+  void RecordCost(const std::string &name, size_t node_num, uint64_t time_us);
+  void ClearCosts();
+
+ private:
+  CompileExecutor();
+  ~CompileExecutor() = default;
+
+  std::unique_ptr<WorkStealingThreadPool> thread_pool_;
+  mutable std::mutex mutex_;
+  std::unordered_map<std::string, uint64_t> names_to_time_us_;
+  // time per node of all the recorded tasks, to compare the tasks with and without recorded time
+  uint64_t recorded_time_us_ = 0U;
+  uint64_t recorded_node_num_ = 0U;
+};
+}  // namespace ge
+
+#endif  // GE_COMMON_COMPILE_EXECUTOR_H_
@@ -38,12 +38,15 @@ GE_COMMON_LOCAL_SRC_FILES := \
     properties_manager.cc \
     types.cc\
     model_parser/base.cc \
+    model_parser/mapped_model_file.cc \
     kernel_store.cc \
     tbe_kernel_store.cc \
     cust_aicpu_kernel_store.cc \
     op/attr_value_util.cc \
     op/ge_op_utils.cc \
     thread_pool.cc \
+    work_stealing_thread_pool.cc \
+    compile_executor.cc \
     ge/tbe_plugin_manager.cc \
 
 GE_COMMON_LOCAL_C_INCLUDES := \
@@ -17,7 +17,13 @@
 
 #include "framework/common/helper/model_helper.h"
 
+#include <algorithm>
+#include <sstream>
+
+#include "common/model_parser/mapped_model_file.h"
 #include "common/model_parser/model_parser.h"
+#include "common/util/error_manager/error_manager.h"
+#include "common/work_stealing_thread_pool.h"
 #include "framework/omg/model_tool.h"
 #include "framework/omg/version.h"
 #include "graph/debug/ge_attr_define.h"
@@ -30,6 +36,12 @@ using domi::ModelTaskDef;
 namespace {
 const int64_t kOriginalOmPartitionNum = 1;
 const uint32_t kStatiOmFileModelNum = 1;
+const char *const kPartitionModelDef = "model_def";
+const char *const kPartitionWeights = "weights";
+const char *const kPartitionTask = "task";
+const char *const kPartitionTbeKernels = "tbe_kernels";
+const char *const kPartitionCustAicpuKernels = "cust_aicpu_kernels";
+const char *const kPartitionTotal = "total";
 }
 
 
@@ -652,27 +664,19 @@ Status ModelHelper::LoadRootModel(const ge::ModelData &model_data) {
 Status ModelHelper::GenerateGeModel(OmFileLoadHelper &om_load_helper) {
   model_ = ge::MakeShared<ge::GeModel>();
   GE_CHECK_NOTNULL(model_);
-  Status ret = LoadModelData(om_load_helper);
-  if (ret != SUCCESS) {
-    return ACL_ERROR_GE_EXEC_LOAD_MODEL_PARTITION_FAILED;
-  }
-  ret = LoadWeights(om_load_helper);
-  if (ret != SUCCESS) {
-    return ACL_ERROR_GE_EXEC_LOAD_WEIGHT_PARTITION_FAILED;
-  }
-  ret = LoadTask(om_load_helper);
-  if (ret != SUCCESS) {
-    return ACL_ERROR_GE_EXEC_LOAD_TASK_PARTITION_FAILED;
-  }
-  ret = LoadTBEKernelStore(om_load_helper);
-  if (ret != SUCCESS) {
-    return ACL_ERROR_GE_EXEC_LOAD_KERNEL_PARTITION_FAILED;
-  }
-  ret = LoadCustAICPUKernelStore(om_load_helper);
-  if (ret != SUCCESS) {
-    return ACL_ERROR_GE_EXEC_LOAD_KERNEL_PARTITION_FAILED;
-  }
-  return SUCCESS;
+  // every partition is decoded into its own member of model_, so they can be decoded at the same time
+  const std::vector<PartitionLoadTask> tasks = {
+      {kPartitionModelDef, ACL_ERROR_GE_EXEC_LOAD_MODEL_PARTITION_FAILED,
+       [this, &om_load_helper]() { return LoadModelData(om_load_helper); }},
+      {kPartitionWeights, ACL_ERROR_GE_EXEC_LOAD_WEIGHT_PARTITION_FAILED,
+       [this, &om_load_helper]() { return LoadWeights(om_load_helper); }},
+      {kPartitionTask, ACL_ERROR_GE_EXEC_LOAD_TASK_PARTITION_FAILED,
+       [this, &om_load_helper]() { return LoadTask(om_load_helper); }},
+      {kPartitionTbeKernels, ACL_ERROR_GE_EXEC_LOAD_KERNEL_PARTITION_FAILED,
+       [this, &om_load_helper]() { return LoadTBEKernelStore(om_load_helper); }},
+      {kPartitionCustAicpuKernels, ACL_ERROR_GE_EXEC_LOAD_KERNEL_PARTITION_FAILED,
+       [this, &om_load_helper]() { return LoadCustAICPUKernelStore(om_load_helper); }}};
+  return RunPartitionLoadTasks(tasks);
 }
 
 Status ModelHelper::GenerateGeRootModel(OmFileLoadHelper &om_load_helper) {
@@ -690,46 +694,101 @@ Status ModelHelper::GenerateGeRootModel(OmFileLoadHelper &om_load_helper) {
     return SUCCESS;
   }
 
-  bool is_first_model = true;
-  for (size_t mode_index = 0;  mode_index < file_header_->model_num; ++mode_index) {
-    GeModelPtr cur_model = ge::MakeShared<ge::GeModel>();
-    Status ret = LoadModelData(om_load_helper, cur_model, mode_index);
-    if (ret != SUCCESS) {
-      return ACL_ERROR_GE_EXEC_LOAD_MODEL_PARTITION_FAILED;
-    }
-
-    if (is_first_model) {
-      is_first_model = false;
-      root_model_->SetRootGraph(GraphUtils::GetComputeGraph(cur_model->GetGraph()));
-      root_model_->SetModelId(cur_model->GetModelId());
-      root_model_->SetModelName(cur_model->GetName());
-      model_ = cur_model;
-      continue;
+  // only the graph of the first model is needed, it is the root graph
+  std::vector<GeModelPtr> models(file_header_->model_num);
+  std::vector<PartitionLoadTask> tasks;
+  for (size_t mode_index = 0;  mode_index < models.size(); ++mode_index) {
+    models[mode_index] = ge::MakeShared<ge::GeModel>();
+    GE_CHECK_NOTNULL(models[mode_index]);
+    if (mode_index == 0) {
+      GeModelPtr &cur_model = models[mode_index];
+      tasks.push_back({kPartitionModelDef, ACL_ERROR_GE_EXEC_LOAD_MODEL_PARTITION_FAILED,
+                       [this, &om_load_helper, &cur_model]() { return LoadModelData(om_load_helper, cur_model, 0); }});
+    } else {
+      AddPartitionLoadTasks(om_load_helper, models[mode_index], mode_index, tasks);
     }
+  }
+  Status ret = RunPartitionLoadTasks(tasks);
+  if (ret != SUCCESS) {
+    return ret;
+  }
 
-    ret = LoadWeights(om_load_helper, cur_model, mode_index);
-    if (ret != SUCCESS) {
-      return ACL_ERROR_GE_EXEC_LOAD_WEIGHT_PARTITION_FAILED;
-    }
+  model_ = models[0];
+  root_model_->SetRootGraph(GraphUtils::GetComputeGraph(model_->GetGraph()));
+  root_model_->SetModelId(model_->GetModelId());
+  root_model_->SetModelName(model_->GetName());
+  for (size_t mode_index = 1; mode_index < models.size(); ++mode_index) {
+    root_model_->SetSubgraphInstanceNameToModel(models[mode_index]->GetName(), models[mode_index]);
+  }
+  return SUCCESS;
+}
 
-    ret = LoadTBEKernelStore(om_load_helper, cur_model, mode_index);
-    if (ret != SUCCESS) {
-      return ACL_ERROR_GE_EXEC_LOAD_KERNEL_PARTITION_FAILED;
-    }
+void ModelHelper::AddPartitionLoadTasks(OmFileLoadHelper &om_load_helper, GeModelPtr &cur_model,
+                                        const size_t mode_index, std::vector<PartitionLoadTask> &tasks) {
+  tasks.push_back({kPartitionModelDef, ACL_ERROR_GE_EXEC_LOAD_MODEL_PARTITION_FAILED,
+                   [this, &om_load_helper, &cur_model, mode_index]() {
+                     return LoadModelData(om_load_helper, cur_model, mode_index);
+                   }});
+  tasks.push_back({kPartitionWeights, ACL_ERROR_GE_EXEC_LOAD_WEIGHT_PARTITION_FAILED,
+                   [this, &om_load_helper, &cur_model, mode_index]() {
+                     return LoadWeights(om_load_helper, cur_model, mode_index);
+                   }});
+  tasks.push_back({kPartitionTbeKernels, ACL_ERROR_GE_EXEC_LOAD_KERNEL_PARTITION_FAILED,
+                   [this, &om_load_helper, &cur_model, mode_index]() {
+                     return LoadTBEKernelStore(om_load_helper, cur_model, mode_index);
+                   }});
+  tasks.push_back({kPartitionCustAicpuKernels, ACL_ERROR_GE_EXEC_LOAD_KERNEL_PARTITION_FAILED,
+                   [this, &om_load_helper, &cur_model, mode_index]() {
+                     return LoadCustAICPUKernelStore(om_load_helper, cur_model, mode_index);
+                   }});
+  tasks.push_back({kPartitionTask, ACL_ERROR_GE_EXEC_LOAD_TASK_PARTITION_FAILED,
+                   [this, &om_load_helper, &cur_model, mode_index]() {
+                     return LoadTask(om_load_helper, cur_model, mode_index);
+                   }});
+}
 
-    ret = LoadCustAICPUKernelStore(om_load_helper, cur_model, mode_index);
-    if (ret != SUCCESS) {
-      return ACL_ERROR_GE_EXEC_LOAD_KERNEL_PARTITION_FAILED;
+Status ModelHelper::RunPartitionLoadTasks(const std::vector<PartitionLoadTask> &tasks) {
+  partition_load_cost_.clear();
+  std::vector<uint64_t> costs(tasks.size(), 0U);
+  auto run_tasks = [&tasks, &costs](size_t begin, size_t end) -> Status {
+    for (size_t i = begin; i < end; ++i) {
+      const uint64_t start = GetCurrentTimestamp();
+      Status ret = tasks[i].load();
+      costs[i] = GetCurrentTimestamp() - start;
+      if (ret != SUCCESS) {
+        GELOGE(ret, "[Load][Partition]Failed, partition:%s", tasks[i].partition);
+        return tasks[i].error_code;
+      }
     }
+    return SUCCESS;
+  };
 
-    ret = LoadTask(om_load_helper, cur_model, mode_index);
-    if (ret != SUCCESS) {
-      return ACL_ERROR_GE_EXEC_LOAD_TASK_PARTITION_FAILED;
-    }
-    root_model_->SetSubgraphInstanceNameToModel(cur_model->GetName(), cur_model);
+  const uint64_t start = GetCurrentTimestamp();
+  const uint32_t thread_num = static_cast<uint32_t>(std::min<size_t>(load_thread_num_, tasks.size()));
+  Status ret = SUCCESS;
+  if (thread_num <= 1U) {
+    ret = run_tasks(0, tasks.size());
+  } else {
+    const auto error_context = ErrorManager::GetInstance().GetErrorManagerContext();
+    // the calling thread decodes partitions as well
+    WorkStealingThreadPool executor(thread_num - 1U);
+    ret = executor.ParallelFor(tasks.size(), 1, [&run_tasks, &error_context](size_t begin, size_t end) {
+      ErrorManager::GetInstance().SetErrorContext(error_context);
+      return run_tasks(begin, end);
+    });
+  }
+  partition_load_cost_[kPartitionTotal] = GetCurrentTimestamp() - start;
+  for (size_t i = 0; i < tasks.size(); ++i) {
+    partition_load_cost_[tasks[i].partition] += costs[i];
   }
 
-  return SUCCESS;
+  std::stringstream ss;
+  for (const auto &cost : partition_load_cost_) {
+    ss << cost.first << ":" << cost.second << "us ";
+  }
+  GELOGI("[LoadModel] %zu partitions decoded by %u threads, cost %s", tasks.size(), std::max(thread_num, 1U),
+         ss.str().c_str());
+  return ret;
 }
 
 Status ModelHelper::LoadModelData(OmFileLoadHelper &om_load_helper) {
@@ -999,23 +1058,18 @@ Status ModelHelper::GetModelNameFromMergedGraphName(const string &graph_name, st
 
 Status ModelTool::GetModelInfoFromOm(const char *model_file, ge::proto::ModelDef &model_def, uint32_t &modeldef_size) {
   GE_CHECK_NOTNULL(model_file);
-  ge::ModelData model;
   int32_t priority = 0;
 
-  Status ret = ModelParserBase::LoadFromFile(model_file, priority, model);
+  // only the model def partition is read, map the file rather than loading the weights too
+  MappedModelFile model_file_mapping;
+  Status ret = model_file_mapping.Map(model_file, priority);
   if (ret != SUCCESS) {
     GELOGE(ret, "[Load][ModelInfo]Failed from file %s, error_code %u", model_file, ret);
     REPORT_CALL_ERROR("E19999", "Load model info failed from file %s, error_code %u",
                       model_file, ret);
     return ret;
   }
-  std::function<void()> callback = [&]() {
-    if (model.model_data != nullptr) {
-      delete[] reinterpret_cast<char *>(model.model_data);
-      model.model_data = nullptr;
-    }
-  };
-  GE_MAKE_GUARD(release, callback);
+  const ge::ModelData &model = model_file_mapping.GetModelData();
 
   uint8_t *model_data = nullptr;
   uint32_t model_len = 0;
@@ -0,0 +1,289 @@
+/**
+* Copyright 2021, 2022 LuoJiaNET Research and Development Group, Wuhan University
+* Copyright 2021, 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef GE_COMMON_LOCK_FREE_BLOCKING_QUEUE_H_
+#define GE_COMMON_LOCK_FREE_BLOCKING_QUEUE_H_
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <thread>
+#include <utility>
+
+#include "common/blocking_queue.h"
+
+namespace ge {
+// Bounded multi-producer multi-consumer ring buffer with the same interface as BlockingQueue.
+// Push and Pop are lock free on the fast path, each slot carries a sequence number telling whether
+// it is ready to be written or read. A blocked caller spins for a while before parking on a
+// condition variable, which is only signaled when someone is actually parked.
+template <typename T>
+class LockFreeBlockingQueue {
+ public:
+  explicit LockFreeBlockingQueue(uint32_t max_size = kDefaultMaxSize)
+      : capacity_(RoundUpPowerOfTwo(max_size)), mask_(capacity_ - 1), cells_(new Cell[capacity_]), pad0_(),
+        enqueue_pos_(0), pad1_(), dequeue_pos_(0), pad2_(), is_stoped_(false), pop_waiters_(0), push_waiters_(0) {
+    for (uint64_t i = 0; i < capacity_; ++i) {
+      cells_[i].sequence.store(i, std::memory_order_relaxed);
+    }
+  }
+
+  ~LockFreeBlockingQueue() = default;
+
+  LockFreeBlockingQueue(const LockFreeBlockingQueue &) = delete;
+  LockFreeBlockingQueue &operator=(const LockFreeBlockingQueue &) = delete;
+
+  bool Pop(T &item) {
+    while (true) {
+      for (uint32_t i = 0; i < kSpinCount; ++i) {
+        if (is_stoped_.load(std::memory_order_acquire)) {
+          return false;
+        }
+        if (TryPop(item)) {
+          WakeUp(push_waiters_, full_cond_);
+          return true;
+        }
+        std::this_thread::yield();
+      }
+      std::unique_lock<std::mutex> lock(park_mutex_);
+      ++pop_waiters_;
+      std::atomic_thread_fence(std::memory_order_seq_cst);
+      empty_cond_.wait(lock, [this] { return is_stoped_.load() || !IsEmpty(); });
+      --pop_waiters_;
+    }
+  }
+
+  bool Push(const T &item, bool is_wait = true) {
+    T copied = item;
+    return Push(std::move(copied), is_wait);
+  }
+
+  bool Push(T &&item, bool is_wait = true) {
+    while (true) {
+      for (uint32_t i = 0; i < kSpinCount; ++i) {
+        if (is_stoped_.load(std::memory_order_acquire)) {
+          return false;
+        }
+        if (TryPush(item)) {
+          WakeUp(pop_waiters_, empty_cond_);
+          return true;
+        }
+        if (!is_wait) {
+          return false;
+        }
+        std::this_thread::yield();
+      }
+      std::unique_lock<std::mutex> lock(park_mutex_);
+      ++push_waiters_;
+      std::atomic_thread_fence(std::memory_order_seq_cst);
+      full_cond_.wait(lock, [this] { return is_stoped_.load() || !IsFull(); });
+      --push_waiters_;
+    }
+  }
+
+  void Stop() {
+    {
+      std::lock_guard<std::mutex> lock(park_mutex_);
+      is_stoped_.store(true);
+    }
+    empty_cond_.notify_all();
+    full_cond_.notify_all();
+  }
+
+  void Restart() {
+    std::lock_guard<std::mutex> lock(park_mutex_);
+    is_stoped_.store(false);
+  }
+
+  bool IsFull() { return Size() >= capacity_; }
+
+  void Clear() {
+    T item;
+    while (TryPop(item)) {
+    }
+    WakeUp(push_waiters_, full_cond_);
+  }
+
+  uint32_t Size() {
+    uint64_t enqueue_pos = enqueue_pos_.load(std::memory_order_acquire);
+    uint64_t dequeue_pos = dequeue_pos_.load(std::memory_order_acquire);
+    return enqueue_pos > dequeue_pos ? static_cast<uint32_t>(enqueue_pos - dequeue_pos) : 0U;
+  }
+
+  uint32_t Capacity() const { return static_cast<uint32_t>(capacity_); }
+
+ private:
+  static constexpr uint32_t kDefaultMaxSize = 2048;
+  static constexpr uint32_t kSpinCount = 64;
+  static constexpr size_t kCacheLineSize = 64;
+
+  struct Cell {
+    std::atomic<uint64_t> sequence;
+    T data;
+  };
+
+  static uint64_t RoundUpPowerOfTwo(uint32_t size) {
+    uint64_t capacity = 2;
+    while (capacity < size) {
+      capacity <<= 1U;
+    }
+    return capacity;
+  }
+
+  bool IsEmpty() { return Size() == 0; }
+
+  bool TryPush(T &item) {
+    uint64_t pos = enqueue_pos_.load(std::memory_order_relaxed);
+    while (true) {
+      Cell &cell = cells_[pos & mask_];
+      uint64_t sequence = cell.sequence.load(std::memory_order_acquire);
+      auto diff = static_cast<int64_t>(sequence) - static_cast<int64_t>(pos);
+      if (diff == 0) {
+        if (enqueue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+          cell.data = std::move(item);
+          cell.sequence.store(pos + 1, std::memory_order_release);
+          return true;
+        }
+      } else if (diff < 0) {
+        return false;
+      } else {
+        pos = enqueue_pos_.load(std::memory_order_relaxed);
+      }
+    }
+  }
+
+  bool TryPop(T &item) {
+    uint64_t pos = dequeue_pos_.load(std::memory_order_relaxed);
+    while (true) {
+      Cell &cell = cells_[pos & mask_];
+      uint64_t sequence = cell.sequence.load(std::memory_order_acquire);
+      auto diff = static_cast<int64_t>(sequence) - static_cast<int64_t>(pos + 1);
+      if (diff == 0) {
+        if (dequeue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+          item = std::move(cell.data);
+          cell.sequence.store(pos + mask_ + 1, std::memory_order_release);
+          return true;
+        }
+      } else if (diff < 0) {
+        return false;
+      } else {
+        pos = dequeue_pos_.load(std::memory_order_relaxed);
+      }
+    }
+  }
+
+  void WakeUp(const std::atomic<uint32_t> &waiters, std::condition_variable &cond) {
+    // pairs with the fence after a waiter registers: either it sees the new item or we see the waiter
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (waiters.load() > 0) {
+      { std::lock_guard<std::mutex> lock(park_mutex_); }
+      cond.notify_all();
+    }
+  }
+
+  const uint64_t capacity_;
+  const uint64_t mask_;
+  std::unique_ptr<Cell[]> cells_;
+  // keep producers and consumers off each other's cache line
+  char pad0_[kCacheLineSize];
+  std::atomic<uint64_t> enqueue_pos_;
+  char pad1_[kCacheLineSize];
+  std::atomic<uint64_t> dequeue_pos_;
+  char pad2_[kCacheLineSize];
+  std::atomic<bool> is_stoped_;
+  std::mutex park_mutex_;
+  std::condition_variable empty_cond_;
+  std::condition_variable full_cond_;
+  std::atomic<uint32_t> pop_waiters_;
+  std::atomic<uint32_t> push_waiters_;
+};
+
+// BlockingQueue or LockFreeBlockingQueue, chosen when the queue is created. The mutex based one is the default, the
+// ring buffer of the lock free one is allocated in full up front. It falls back to the mutex based one if that fails
+template <typename T>
+class SelectableBlockingQueue {
+ public:
+  explicit SelectableBlockingQueue(bool lock_free = false, uint32_t max_size = kDefaultMaxSize)
+      : queue_(max_size), lock_free_queue_(lock_free ? new (std::nothrow) LockFreeBlockingQueue<T>(max_size) : nullptr) {}
+
+  ~SelectableBlockingQueue() = default;
+
+  SelectableBlockingQueue(const SelectableBlockingQueue &) = delete;
+  SelectableBlockingQueue &operator=(const SelectableBlockingQueue &) = delete;
+
+  bool IsLockFree() const { return lock_free_queue_ != nullptr; }
+
+  bool Pop(T &item) { return IsLockFree() ? lock_free_queue_->Pop(item) : queue_.Pop(item); }
+
+  bool Push(const T &item, bool is_wait = true) {
+    return IsLockFree() ? lock_free_queue_->Push(item, is_wait) : queue_.Push(item, is_wait);
+  }
+
+  bool Push(T &&item, bool is_wait = true) {
+    return IsLockFree() ? lock_free_queue_->Push(std::move(item), is_wait) : queue_.Push(std::move(item), is_wait);
+  }
+
+  void Stop() {
+    if (IsLockFree()) {
+      lock_free_queue_->Stop();
+    } else {
+      queue_.Stop();
+    }
+  }
+
+  void Restart() {
+    if (IsLockFree()) {
+      lock_free_queue_->Restart();
+    } else {
+      queue_.Restart();
+    }
+  }
+
+  bool IsFull() { return IsLockFree() ? lock_free_queue_->IsFull() : queue_.IsFull(); }
+
+  void Clear() {
+    if (IsLockFree()) {
+      lock_free_queue_->Clear();
+    } else {
+      queue_.Clear();
+    }
+  }
+
+  uint32_t Size() { return IsLockFree() ? lock_free_queue_->Size() : queue_.Size(); }
+
+ private:
+  static constexpr uint32_t kDefaultMaxSize = 2048;
+
+  BlockingQueue<T> queue_;
+  std::unique_ptr<LockFreeBlockingQueue<T>> lock_free_queue_;
+};
+
+template <typename T>
+constexpr uint32_t LockFreeBlockingQueue<T>::kDefaultMaxSize;
+template <typename T>
+constexpr uint32_t LockFreeBlockingQueue<T>::kSpinCount;
+template <typename T>
+constexpr size_t LockFreeBlockingQueue<T>::kCacheLineSize;
+template <typename T>
+constexpr uint32_t SelectableBlockingQueue<T>::kDefaultMaxSize;
+}  // namespace ge
+
+#endif  // GE_COMMON_LOCK_FREE_BLOCKING_QUEUE_H_
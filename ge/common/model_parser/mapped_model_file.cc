@@ -0,0 +1,96 @@
+/**
+* Copyright 2021, 2022 LuoJiaNET Research and Development Group, Wuhan University
+* Copyright 2021, 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "common/model_parser/mapped_model_file.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstring>
+#include <limits>
+
+#include "framework/common/debug/ge_log.h"
+#include "framework/common/debug/log.h"
+#include "framework/common/helper/model_helper.h"
+#include "framework/common/util.h"
+
+namespace ge {
+MappedModelFile::~MappedModelFile() {
+  Unmap();
+}
+
+Status MappedModelFile::Map(const std::string &model_path, int32_t priority) {
+  Unmap();
+  std::string real_path = RealPath(model_path.c_str());
+  if (real_path.empty()) {
+    GELOGE(ACL_ERROR_GE_EXEC_MODEL_PATH_INVALID, "[Check][Param]Model file path %s is invalid", model_path.c_str());
+    REPORT_CALL_ERROR("E19999", "Model file path %s is invalid", model_path.c_str());
+    return ACL_ERROR_GE_EXEC_MODEL_PATH_INVALID;
+  }
+
+  int fd = open(real_path.c_str(), O_RDONLY);
+  if (fd < 0) {
+    GELOGE(ACL_ERROR_GE_EXEC_MODEL_PATH_INVALID, "[Open][File]Failed, file %s, error %s", model_path.c_str(),
+           strerror(errno));
+    REPORT_CALL_ERROR("E19999", "Open file %s failed, error %s", model_path.c_str(), strerror(errno));
+    return ACL_ERROR_GE_EXEC_MODEL_PATH_INVALID;
+  }
+  struct stat file_stat;
+  if ((fstat(fd, &file_stat) != 0) || (file_stat.st_size <= 0) ||
+      (static_cast<uint64_t>(file_stat.st_size) > std::numeric_limits<uint32_t>::max())) {
+    (void)close(fd);
+    GELOGE(ACL_ERROR_GE_EXEC_MODEL_PATH_INVALID, "[Check][Param]File size not valid, file %s", model_path.c_str());
+    REPORT_INNER_ERROR("E19999", "File size not valid, file %s", model_path.c_str());
+    return ACL_ERROR_GE_EXEC_MODEL_PATH_INVALID;
+  }
+
+  size_t length = static_cast<size_t>(file_stat.st_size);
+  void *addr = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+  // the mapping holds its own reference to the file
+  (void)close(fd);
+  if (addr == MAP_FAILED) {
+    GELOGE(ACL_ERROR_GE_MEMORY_ALLOCATION, "[Map][File]Failed, file %s, size %zu, error %s", model_path.c_str(),
+           length, strerror(errno));
+    REPORT_CALL_ERROR("E19999", "Map file %s failed, size %zu, error %s", model_path.c_str(), length,
+                      strerror(errno));
+    return ACL_ERROR_GE_MEMORY_ALLOCATION;
+  }
+  // partitions are deserialized front to back, let the kernel read ahead more and reclaim read pages earlier
+  (void)madvise(addr, length, MADV_SEQUENTIAL);
+
+  addr_ = addr;
+  length_ = length;
+  ModelHelper model_helper;
+  (void)model_helper.GetBaseNameFromFileName(model_path, model_data_.om_name);
+  model_data_.model_data = addr_;
+  model_data_.model_len = static_cast<uint32_t>(length_);
+  model_data_.priority = priority;
+  GELOGI("Map model file %s success, size %zu.", model_path.c_str(), length_);
+  return SUCCESS;
+}
+
+void MappedModelFile::Unmap() {
+  if (addr_ != nullptr) {
+    (void)munmap(addr_, length_);
+    addr_ = nullptr;
+    length_ = 0;
+  }
+  model_data_ = ModelData();
+}
+}  // namespace ge
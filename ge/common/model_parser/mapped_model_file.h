@@ -0,0 +1,64 @@
+/**
+* Copyright 2021, 2022 LuoJiaNET Research and Development Group, Wuhan University
+* Copyright 2021, 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef GE_COMMON_MODEL_PARSER_MAPPED_MODEL_FILE_H_
+#define GE_COMMON_MODEL_PARSER_MAPPED_MODEL_FILE_H_
+
+#include <cstddef>
+#include <string>
+
+#include "framework/common/ge_types.h"
+
+namespace ge {
+///
+/// Read-only mapping of an om file, an alternative to ModelParserBase::LoadFromFile.
+/// The file is not read up front: pages are faulted in when a partition is deserialized, so
+/// partitions which are never touched (e.g. the weights when only the model def is queried)
+/// never cost host memory, and the touched ones stay clean page cache instead of heap.
+/// The ModelData handed out points into the mapping and is valid until Unmap or destruction,
+/// it must never be released with delete[].
+///
+class MappedModelFile {
+ public:
+  MappedModelFile() = default;
+  ~MappedModelFile();
+
+  MappedModelFile(const MappedModelFile &) = delete;
+  MappedModelFile &operator=(const MappedModelFile &) = delete;
+
+  ///
+  /// @ingroup ge
+  /// @brief Map a model file
+  /// @param [in] model_path: model path
+  /// @param [in] priority: model priority
+  /// @return SUCCESS / ACL_ERROR_GE_EXEC_MODEL_PATH_INVALID / ACL_ERROR_GE_MEMORY_ALLOCATION
+  ///
+  Status Map(const std::string &model_path, int32_t priority);
+
+  void Unmap();
+
+  bool IsMapped() const { return addr_ != nullptr; }
+
+  const ModelData &GetModelData() const { return model_data_; }
+
+ private:
+  void *addr_ = nullptr;
+  size_t length_ = 0;
+  ModelData model_data_;
+};
+}  // namespace ge
+#endif  // GE_COMMON_MODEL_PARSER_MAPPED_MODEL_FILE_H_
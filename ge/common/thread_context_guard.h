@@ -0,0 +1,71 @@
+/**
+* Copyright 2021, 2022 LuoJiaNET Research and Development Group, Wuhan University
+* Copyright 2021, 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef GE_COMMON_THREAD_CONTEXT_GUARD_H_
+#define GE_COMMON_THREAD_CONTEXT_GUARD_H_
+
+#include <cstdint>
+
+#include "common/local_context.h"
+#include "common/util/error_manager/error_manager.h"
+#include "framework/common/debug/ge_log.h"
+#include "graph/ge_context.h"
+#include "graph/ge_local_context.h"
+#include "runtime/context.h"
+
+namespace ge {
+///
+/// Threads of the CompileExecutor are shared by graphs, sessions and models. A task setting up the thread local
+/// contexts of its caller declares the guard first, so the contexts are restored when the task returns and
+/// nothing of it, e.g. the rt context of an unloaded model, is seen by the next task on the thread.
+///
+class ThreadContextGuard {
+ public:
+  ThreadContextGuard()
+      : ge_context_(GetThreadLocalContext()),
+        session_id_(GetContext().SessionId()),
+        omg_context_(GetLocalOmgContext()),
+        error_context_(ErrorManager::GetInstance().GetErrorManagerContext()) {
+    if (rtCtxGetCurrent(&rt_context_) != RT_ERROR_NONE) {
+      rt_context_ = nullptr;
+    }
+  }
+
+  ~ThreadContextGuard() {
+    GetThreadLocalContext() = ge_context_;
+    GetContext().SetSessionId(session_id_);
+    SetLocalOmgContext(omg_context_);
+    ErrorManager::GetInstance().SetErrorContext(error_context_);
+    rtError_t rt_ret = rtCtxSetCurrent(rt_context_);
+    if ((rt_ret != RT_ERROR_NONE) && (rt_context_ != nullptr)) {
+      GELOGW("Restore rt context failed, ret:0x%X.", rt_ret);
+    }
+  }
+
+  ThreadContextGuard(const ThreadContextGuard &) = delete;
+  ThreadContextGuard &operator=(const ThreadContextGuard &) = delete;
+
+ private:
+  const GEThreadLocalContext ge_context_;
+  const uint64_t session_id_;
+  OmgContext &omg_context_;
+  const struct error_message::Context error_context_;
+  rtContext_t rt_context_ = nullptr;
+};
+}  // namespace ge
+
+#endif  // GE_COMMON_THREAD_CONTEXT_GUARD_H_
@@ -0,0 +1,185 @@
+/**
+* Copyright 2021, 2022 LuoJiaNET Research and Development Group, Wuhan University
+* Copyright 2021, 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "common/work_stealing_thread_pool.h"
+
+#include <algorithm>
+
+namespace ge {
+namespace {
+// identifies the pool and deque owned by the current thread, if it is a worker
+thread_local const WorkStealingThreadPool *tls_owner_pool = nullptr;
+thread_local size_t tls_worker_index = 0;
+}  // namespace
+
+WorkStealingThreadPool::WorkStealingThreadPool(uint32_t size)
+    : is_stoped_(false), pending_num_(0), sleeping_num_(0), next_queue_(0) {
+  uint32_t thread_num = size < 1 ? 1 : size;
+  for (uint32_t i = 0; i < thread_num; ++i) {
+    queues_.emplace_back(new WorkerQueue());
+  }
+  for (uint32_t i = 0; i < thread_num; ++i) {
+    workers_.emplace_back(&WorkStealingThreadPool::WorkerFunc, this, i);
+  }
+}
+
+WorkStealingThreadPool::~WorkStealingThreadPool() {
+  is_stoped_.store(true);
+  {
+    std::lock_guard<std::mutex> lock(park_mutex_);
+    park_cond_.notify_all();
+  }
+
+  for (std::thread &thd : workers_) {
+    if (thd.joinable()) {
+      try {
+        thd.join();
+      } catch (const std::system_error &) {
+        GELOGW("system_error");
+      } catch (...) {
+        GELOGW("exception");
+      }
+    }
+  }
+}
+
+void WorkStealingThreadPool::Push(SmallTask &&task) {
+  size_t index = (tls_owner_pool == this) ? tls_worker_index : (next_queue_++ % queues_.size());
+  {
+    std::lock_guard<std::mutex> lock(queues_[index]->mutex);
+    queues_[index]->tasks.emplace_back(std::move(task));
+  }
+  ++pending_num_;
+  // only touch the park mutex when some worker may be sleeping; the seq_cst pair
+  // pending_num_/sleeping_num_ guarantees a parking worker either sees the task or gets notified
+  if (sleeping_num_.load() > 0) {
+    { std::lock_guard<std::mutex> lock(park_mutex_); }
+    park_cond_.notify_one();
+  }
+}
+
+bool WorkStealingThreadPool::TryPop(size_t index, SmallTask &task) {
+  WorkerQueue &queue = *queues_[index];
+  std::lock_guard<std::mutex> lock(queue.mutex);
+  if (queue.tasks.empty()) {
+    return false;
+  }
+  task = std::move(queue.tasks.back());
+  queue.tasks.pop_back();
+  return true;
+}
+
+bool WorkStealingThreadPool::TrySteal(size_t index, SmallTask &task) {
+  for (size_t i = 1; i < queues_.size(); ++i) {
+    WorkerQueue &victim = *queues_[(index + i) % queues_.size()];
+    std::unique_lock<std::mutex> lock(victim.mutex, std::try_to_lock);
+    if (!lock.owns_lock() || victim.tasks.empty()) {
+      continue;
+    }
+    task = std::move(victim.tasks.front());
+    victim.tasks.pop_front();
+    return true;
+  }
+  return false;
+}
+
+bool WorkStealingThreadPool::RunPendingTask() {
+  size_t index = (tls_owner_pool == this) ? tls_worker_index : 0;
+  SmallTask task;
+  if (!TryPop(index, task) && !TrySteal(index, task)) {
+    return false;
+  }
+  --pending_num_;
+  task();
+  return true;
+}
+
+void WorkStealingThreadPool::WorkerFunc(size_t index) {
+  tls_owner_pool = this;
+  tls_worker_index = index;
+  while (true) {
+    SmallTask task;
+    if (TryPop(index, task) || TrySteal(index, task)) {
+      --pending_num_;
+      task();
+      continue;
+    }
+    // a failed try_lock in TrySteal can miss a task, so only park when nothing is pending at all
+    if (pending_num_.load() > 0) {
+      std::this_thread::yield();
+      continue;
+    }
+    if (is_stoped_.load()) {
+      break;
+    }
+    std::unique_lock<std::mutex> lock(park_mutex_);
+    ++sleeping_num_;
+    park_cond_.wait(lock, [this] { return is_stoped_.load() || pending_num_.load() > 0; });
+    --sleeping_num_;
+  }
+  tls_owner_pool = nullptr;
+}
+
+Status WorkStealingThreadPool::ParallelFor(size_t total, size_t grain, size_t max_parallel,
+                                           const std::function<Status(size_t, size_t)> &func) {
+  if (total == 0) {
+    return SUCCESS;
+  }
+  grain = std::max<size_t>(grain, 1);
+  size_t chunk_num = (total + grain - 1) / grain;
+  if (chunk_num == 1) {
+    return func(0, total);
+  }
+
+  std::atomic<size_t> next_begin(0);
+  std::atomic<uint32_t> first_error(SUCCESS);
+  auto run_chunks = [&]() {
+    while (true) {
+      size_t begin = next_begin.fetch_add(grain);
+      if (begin >= total) {
+        return;
+      }
+      Status ret = func(begin, std::min(total, begin + grain));
+      if (ret != SUCCESS) {
+        uint32_t expected = SUCCESS;
+        (void)first_error.compare_exchange_strong(expected, ret);
+      }
+    }
+  };
+
+  size_t helper_num = std::min(chunk_num - 1, workers_.size());
+  if (max_parallel > 0) {
+    helper_num = std::min(helper_num, max_parallel - 1);
+  }
+  std::atomic<size_t> active_helpers(helper_num);
+  for (size_t i = 0; i < helper_num; ++i) {
+    Push(SmallTask([&run_chunks, &active_helpers]() {
+      run_chunks();
+      --active_helpers;
+    }));
+  }
+  run_chunks();
+  // helpers which have not started yet must still run since they reference this frame, help with the queue
+  // instead of blocking so nested calls from inside a worker cannot deadlock the pool
+  while (active_helpers.load() > 0) {
+    if (!RunPendingTask()) {
+      std::this_thread::yield();
+    }
+  }
+  return first_error.load();
+}
+}  // namespace ge
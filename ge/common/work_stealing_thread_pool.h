@@ -0,0 +1,221 @@
+/**
+* Copyright 2021, 2022 LuoJiaNET Research and Development Group, Wuhan University
+* Copyright 2021, 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef GE_COMMON_WORK_STEALING_THREAD_POOL_H_
+#define GE_COMMON_WORK_STEALING_THREAD_POOL_H_
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "framework/common/debug/ge_log.h"
+#include "framework/common/ge_inner_error_codes.h"
+#include "external/ge/ge_api_error_codes.h"
+
+namespace ge {
+// Move-only callable wrapper. Callables up to kInlineSize bytes are constructed in place, so moving a task
+// through the deques does not allocate. commit() still allocates the shared state of its std::packaged_task.
+class SmallTask {
+ public:
+  static constexpr size_t kInlineSize = 48;
+
+  SmallTask() = default;
+
+  template <typename Func,
+            typename = typename std::enable_if<!std::is_same<typename std::decay<Func>::type, SmallTask>::value>::type>
+  SmallTask(Func &&func) {  // NOLINT: implicit conversion is intended
+    using FuncType = typename std::decay<Func>::type;
+    Emplace<FuncType>(std::forward<Func>(func), IsInline<FuncType>());
+  }
+
+  SmallTask(SmallTask &&other) noexcept { MoveFrom(other); }
+
+  SmallTask &operator=(SmallTask &&other) noexcept {
+    if (this != &other) {
+      Reset();
+      MoveFrom(other);
+    }
+    return *this;
+  }
+
+  SmallTask(const SmallTask &) = delete;
+  SmallTask &operator=(const SmallTask &) = delete;
+
+  ~SmallTask() { Reset(); }
+
+  explicit operator bool() const { return ops_ != nullptr; }
+
+  void operator()() { ops_->invoke(Target()); }
+
+ private:
+  struct Ops {
+    void (*invoke)(void *target);
+    // move-constructs the inline callable from src into dst and destroys src
+    void (*relocate)(void *dst, void *src);
+    void (*destroy)(void *target);
+  };
+
+  template <typename FuncType>
+  using IsInline = std::integral_constant<bool, (sizeof(FuncType) <= kInlineSize) &&
+                                                    (alignof(FuncType) <= alignof(std::max_align_t)) &&
+                                                    std::is_nothrow_move_constructible<FuncType>::value>;
+
+  template <typename FuncType>
+  struct InlineOps {
+    static void Invoke(void *target) { (*static_cast<FuncType *>(target))(); }
+    static void Relocate(void *dst, void *src) {
+      auto src_func = static_cast<FuncType *>(src);
+      new (dst) FuncType(std::move(*src_func));
+      src_func->~FuncType();
+    }
+    static void Destroy(void *target) { static_cast<FuncType *>(target)->~FuncType(); }
+    static const Ops kOps;
+  };
+
+  template <typename FuncType>
+  struct HeapOps {
+    static void Invoke(void *target) { (*static_cast<FuncType *>(target))(); }
+    static void Destroy(void *target) { delete static_cast<FuncType *>(target); }
+    static const Ops kOps;
+  };
+
+  template <typename FuncType, typename Func>
+  void Emplace(Func &&func, std::true_type) {
+    new (&storage_) FuncType(std::forward<Func>(func));
+    ops_ = &InlineOps<FuncType>::kOps;
+  }
+
+  template <typename FuncType, typename Func>
+  void Emplace(Func &&func, std::false_type) {
+    heap_target_ = new (std::nothrow) FuncType(std::forward<Func>(func));
+    if (heap_target_ != nullptr) {
+      ops_ = &HeapOps<FuncType>::kOps;
+    }
+  }
+
+  void *Target() { return ops_->relocate != nullptr ? static_cast<void *>(&storage_) : heap_target_; }
+
+  void MoveFrom(SmallTask &other) {
+    if (other.ops_ == nullptr) {
+      return;
+    }
+    if (other.ops_->relocate != nullptr) {
+      other.ops_->relocate(&storage_, &other.storage_);
+    } else {
+      heap_target_ = other.heap_target_;
+      other.heap_target_ = nullptr;
+    }
+    ops_ = other.ops_;
+    other.ops_ = nullptr;
+  }
+
+  void Reset() {
+    if (ops_ != nullptr) {
+      ops_->destroy(Target());
+      ops_ = nullptr;
+      heap_target_ = nullptr;
+    }
+  }
+
+  const Ops *ops_ = nullptr;
+  void *heap_target_ = nullptr;
+  typename std::aligned_storage<kInlineSize, alignof(std::max_align_t)>::type storage_;
+};
+
+template <typename FuncType>
+const SmallTask::Ops SmallTask::InlineOps<FuncType>::kOps = {&SmallTask::InlineOps<FuncType>::Invoke,
+                                                             &SmallTask::InlineOps<FuncType>::Relocate,
+                                                             &SmallTask::InlineOps<FuncType>::Destroy};
+
+template <typename FuncType>
+const SmallTask::Ops SmallTask::HeapOps<FuncType>::kOps = {&SmallTask::HeapOps<FuncType>::Invoke, nullptr,
+                                                           &SmallTask::HeapOps<FuncType>::Destroy};
+
+// Thread pool with one task deque per worker. Tasks committed from a worker go to its own deque and are
+// popped LIFO, tasks committed from outside are spread round-robin, and idle workers steal FIFO from
+// their siblings. The commit() contract is the same as ThreadPool.
+class WorkStealingThreadPool {
+ public:
+  explicit WorkStealingThreadPool(uint32_t size = 4);
+  ~WorkStealingThreadPool();
+
+  template <class Func, class... Args>
+  auto commit(Func &&func, Args &&... args) -> std::future<decltype(func(args...))> {
+    using retType = decltype(func(args...));
+    std::future<retType> fail_future;
+    if (is_stoped_.load()) {
+      GELOGE(ge::FAILED, "thread pool has been stopped.");
+      return fail_future;
+    }
+
+    std::packaged_task<retType()> task(std::bind(std::forward<Func>(func), std::forward<Args>(args)...));
+    std::future<retType> future = task.get_future();
+    SmallTask small_task(std::move(task));
+    if (!small_task) {
+      GELOGE(ge::FAILED, "Make task failed.");
+      return fail_future;
+    }
+    Push(std::move(small_task));
+    return future;
+  }
+
+  // Runs func(begin, end) over [0, total) split into chunks of at most grain elements. The caller thread
+  // takes part in the loop, so it is safe to call from inside a task of the same pool.
+  // Returns the first non-SUCCESS status returned by func.
+  Status ParallelFor(size_t total, size_t grain, const std::function<Status(size_t, size_t)> &func) {
+    return ParallelFor(total, grain, 0U, func);
+  }
+
+  // Same as above, with at most max_parallel threads including the caller running the chunks, 0 for no limit.
+  Status ParallelFor(size_t total, size_t grain, size_t max_parallel,
+                     const std::function<Status(size_t, size_t)> &func);
+
+  uint32_t GetThreadNum() const { return static_cast<uint32_t>(workers_.size()); }
+
+ private:
+  struct WorkerQueue {
+    std::mutex mutex;
+    std::deque<SmallTask> tasks;
+  };
+
+  void Push(SmallTask &&task);
+  bool TryPop(size_t index, SmallTask &task);
+  bool TrySteal(size_t index, SmallTask &task);
+  bool RunPendingTask();
+  void WorkerFunc(size_t index);
+
+  std::vector<std::unique_ptr<WorkerQueue>> queues_;
+  std::vector<std::thread> workers_;
+  std::mutex park_mutex_;
+  std::condition_variable park_cond_;
+  std::atomic<bool> is_stoped_;
+  std::atomic<size_t> pending_num_;
+  std::atomic<size_t> sleeping_num_;
+  std::atomic<size_t> next_queue_;
+};
+}  // namespace ge
+
+#endif  // GE_COMMON_WORK_STEALING_THREAD_POOL_H_
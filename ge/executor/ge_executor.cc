@@ -24,6 +24,7 @@
 #include "framework/common/helper/model_helper.h"
 #include "common/profiling/profiling_manager.h"
 #include "common/dump/dump_manager.h"
+#include "common/model_parser/mapped_model_file.h"
 #include "graph/execute/graph_execute.h"
 #include "graph/load/graph_loader.h"
 #include "graph/load/model_manager/model_manager.h"
@@ -924,6 +925,40 @@ Status GeExecutor::LoadModelFromData(uint32_t &model_id, const ModelData &model_
   return GraphLoader::LoadModelFromData(model_id, model_data, dev_ptr, mem_size, weight_ptr, weight_size);
 }
 
+/**
+* @ingroup ge
+* @brief Load model from offline model file without reading the whole file into host memory
+* @param [in] const std::string &path: Offline model file path
+              void *dev_ptr: Input/Output memory start address
+              size_t memsize: Input/Output memory length
+              void *weight_ptr: Weight memory start address
+              size_t weightsize: Weight memory length
+* @param [out] uint32_t &model_id: identification after model loading
+* @return SUCCESS handle successfully / others handle failed
+*/
+Status GeExecutor::LoadModelFromFile(uint32_t &model_id, const std::string &path, void *dev_ptr, size_t mem_size,
+                                     void *weight_ptr, size_t weight_size) {
+  if (!isInit_) {
+    REPORT_INNER_ERROR("E19999", "GeExecutor has not been initialized!");
+    GELOGE(ACL_ERROR_GE_EXEC_NOT_INIT, "[Check][Param] GeExecutor has not inited yet!");
+    return ACL_ERROR_GE_EXEC_NOT_INIT;
+  }
+  if (!CheckInputPathValid(path, "model_file")) {
+    GELOGE(ACL_ERROR_GE_EXEC_MODEL_PATH_INVALID, "[Check][Param] model path is invalid:%s", path.c_str());
+    return ACL_ERROR_GE_EXEC_MODEL_PATH_INVALID;
+  }
+
+  // the model is deserialized and its weights uploaded during loading, the mapping is not needed afterwards
+  MappedModelFile model_file;
+  Status ret = model_file.Map(path, 0);
+  if (ret != SUCCESS) {
+    GELOGE(ret, "[Map][ModelFile] failed, path:%s", path.c_str());
+    return ret;
+  }
+  return GraphLoader::LoadModelFromData(model_id, model_file.GetModelData(), dev_ptr, mem_size, weight_ptr,
+                                        weight_size);
+}
+
 /**
  * @ingroup ge
  * @brief Load task list from ModelData with queue.
@@ -1022,20 +1057,16 @@ Status GeExecutor::GetMemAndWeightSize(const std::string &path, size_t &mem_size
     return ACL_ERROR_GE_EXEC_NOT_INIT;
   }
 
-  ModelData model;
-  Status ret = ge::GraphLoader::LoadDataFromFile(path, 0, model);
-  if ((ret != SUCCESS) || (model.model_data == nullptr)) {
+  // only the model def partition is parsed, the weights are never read from the file
+  MappedModelFile model_file;
+  Status ret = model_file.Map(path, 0);
+  if (ret != SUCCESS) {
     REPORT_CALL_ERROR("E19999", "load data from file failed, ret = %d", ret);
     GELOGE(ret, "[Load][Data] from file failed. ret = %d", ret);
     return ret;
   }
 
-  ret = ge::ModelManager::GetModelMemAndWeightSize(model, mem_size, weight_size);
-
-  delete[] static_cast<char *>(model.model_data);
-  model.model_data = nullptr;
-
-  return ret;
+  return ge::ModelManager::GetModelMemAndWeightSize(model_file.GetModelData(), mem_size, weight_size);
 }
 
 /**
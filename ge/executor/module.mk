@@ -17,6 +17,7 @@ local_ge_executor_src_files :=  \
     ../graph/manager/host_mem_allocator.cc \
     ../graph/manager/graph_mem_allocator.cc \
     ../graph/manager/graph_caching_allocator.cc \
+    ../graph/manager/graph_slab_allocator.cc \
     ../graph/manager/trans_var_data_utils.cc \
     ../graph/manager/util/debug.cc \
     ../model/ge_model.cc \
@@ -66,6 +67,7 @@ local_ge_executor_src_files :=  \
     ../common/local_context.cc \
     ../hybrid/common/tensor_value.cc                                        \
     ../hybrid/common/npu_memory_allocator.cc                                \
+    ../hybrid/common/node_latency_stats.cc                                  \
     ../hybrid/executor/rt_callback_manager.cc                               \
     ../hybrid/executor/node_state.cc                                        \
     ../hybrid/executor/node_done_manager.cc                                 \
@@ -42,6 +42,7 @@ GRAPH_MANAGER_LOCAL_SRC_FILES := \
     engine_manager/dnnengine_manager.cc \
     opskernel_manager/ops_kernel_manager.cc \
     opskernel_manager/ops_kernel_builder_manager.cc \
+    graph/manager/graph_compile_cache.cc \
     graph/manager/graph_manager.cc \
     graph/manager/graph_manager_utils.cc \
     graph/manager/graph_context.cc \
@@ -66,6 +67,7 @@ GRAPH_MANAGER_LOCAL_SRC_FILES := \
     graph/manager/host_mem_allocator.cc \
     graph/manager/graph_mem_allocator.cc \
     graph/manager/graph_caching_allocator.cc \
+    graph/manager/graph_slab_allocator.cc \
 
 BUILER_SRC_FILES := \
     ir_build/ge_ir_build.cc \
@@ -86,8 +88,10 @@ OMG_HOST_SRC_FILES := \
     graph/passes/resource_pair_remove_control_pass.cc \
     graph/passes/pass_utils.cc \
     graph/passes/base_pass.cc \
+    graph/passes/pass_report.cc \
     graph/passes/bitcast_pass.cc \
     graph/passes/constant_folding_pass.cc \
+    graph/passes/folding_cache.cc \
     graph/passes/aicpu_constant_folding_pass.cc \
     graph/passes/reshape_remove_pass.cc \
     graph/passes/reshape_recovery_pass.cc \
@@ -220,6 +224,8 @@ OMG_HOST_SRC_FILES := \
     graph/passes/memcpy_addr_async_pass.cc \
     graph/passes/set_input_output_offset_pass.cc \
     graph/passes/buffer_pool_memory_pass.cc \
+    graph/passes/rematerialization_pass.cc \
+    graph/passes/activation_offload_pass.cc \
 
 OMG_DEVICE_SRC_FILES := $(OMG_HOST_SRC_FILES)
 
@@ -87,10 +87,12 @@ LIBGE_LOCAL_SRC_FILES := \
     graph/load/model_manager/zero_copy_task.cc \
     graph/load/model_manager/zero_copy_offset.cc    \
     graph/manager/graph_context.cc \
+    graph/manager/graph_compile_cache.cc \
     graph/manager/graph_manager.cc \
     graph/manager/graph_manager_utils.cc \
     graph/manager/graph_mem_allocator.cc \
     graph/manager/graph_caching_allocator.cc \
+    graph/manager/graph_slab_allocator.cc \
     graph/manager/graph_var_manager.cc \
     graph/manager/host_mem_manager.cc \
     graph/manager/rdma_pool_allocator.cc \
@@ -119,6 +121,7 @@ LIBGE_LOCAL_SRC_FILES := \
     graph/partition/dynamic_shape_partition.cc \
     graph/partition/stage_partition.cc \
     graph/passes/base_pass.cc \
+    graph/passes/pass_report.cc \
     graph/passes/bitcast_pass.cc \
     graph/passes/cast_remove_pass.cc \
     graph/passes/cast_translate_pass.cc \
@@ -126,6 +129,7 @@ LIBGE_LOCAL_SRC_FILES := \
     graph/passes/transop_symmetry_elimination_pass.cc \
     graph/passes/compile_nodes_pass.cc \
     graph/passes/constant_folding_pass.cc \
+    graph/passes/folding_cache.cc \
     graph/passes/constant_fuse_same_pass.cc \
     graph/passes/fuse_data_nodes_with_common_input_pass.cc \
     graph/passes/remove_same_const_pass.cc \
@@ -245,6 +249,8 @@ LIBGE_LOCAL_SRC_FILES := \
     graph/passes/memcpy_addr_async_pass.cc \
     graph/passes/set_input_output_offset_pass.cc \
     graph/passes/buffer_pool_memory_pass.cc \
+    graph/passes/rematerialization_pass.cc \
+    graph/passes/activation_offload_pass.cc \
     graph/preprocess/graph_preprocess.cc \
     graph/preprocess/insert_op/ge_aipp_op.cc \
     graph/preprocess/insert_op/util_insert_aipp_op.cc \
@@ -268,6 +274,7 @@ LIBGE_LOCAL_SRC_FILES := \
     single_op/task/aicpu_kernel_task_builder.cc \
     hybrid/common/tensor_value.cc                                        \
     hybrid/common/npu_memory_allocator.cc                                \
+    hybrid/common/node_latency_stats.cc                                  \
     hybrid/executor/rt_callback_manager.cc                               \
     hybrid/executor/node_state.cc                                        \
     hybrid/executor/node_done_manager.cc                                 \
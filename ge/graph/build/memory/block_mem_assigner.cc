@@ -892,11 +892,12 @@ void BlockMemAssigner::InitReuseFlag() {
     int64_t mem_type = RT_MEMORY_HBM;
     GetSymbolMemType(pair.second, mem_type);
     GELOGD("The memory type of symbol[%s] is [%ld]].", symbol.c_str(), mem_type);
-    if (mem_type == RT_MEMORY_P2P_DDR) {
+    bool is_host_swap = ((static_cast<uint64_t>(mem_type) & kHostSwapMemory) == kHostSwapMemory);
+    if ((mem_type == RT_MEMORY_P2P_DDR) || is_host_swap) {
       UpdateOpTensorMemType(pair.second, mem_type);
     }
     // Only the memory with special requirements is processed. The HBM uses the default processing mode.
-    if (mem_type == RT_MEMORY_P2P_DDR) {
+    if ((mem_type == RT_MEMORY_P2P_DDR) || is_host_swap) {
       symbol_to_mem_type_[symbol] = mem_type;
     }
 
@@ -1151,7 +1152,7 @@ MemoryBlock *BlockMemAssigner::ApplyMemory(size_t block_size, size_t real_size,
                           !((workspace_reuse_flag.size() > out_index) && !workspace_reuse_flag[out_index]);
     is_reuse_memory = !node_op_desc->HasAttr(kL2FusionDynamicConvergeOp) &&
                       !node_op_desc->HasAttr(kOpNoReuseMem) && reuse_mem_flag && is_op_reuse_mem;
-    bool do_reuse = is_reuse_memory && !continuous && !reusable_blocks_[memory_type].empty();
+    bool do_reuse = is_reuse_memory && !continuous && ReuseReleasedBlocks() && !reusable_blocks_[memory_type].empty();
     if (do_reuse) {
       auto stream_id = node_op_desc->GetStreamId();
       for (auto it = reusable_blocks_[memory_type][stream_id].rbegin();
@@ -2075,19 +2076,26 @@ void BlockMemAssigner::ResizeDynamicBatchBlocks() {
 /// |-not dynamic batch block-||-dynamic batch block batch3--|  |-zero copy block-|
 ///
 void BlockMemAssigner::ResizeMemoryBlocks() {
+  AssignBlockOffsets();
+  ResizeDynamicBatchBlocks();
+  for (auto it : mem_offsets_) {
+    GELOGI("Memory type:%ld mem_offset exclude zero_copy_memory:%zu, theory_min_memory_size:%zu", it.first, it.second,
+           theory_min_memory_size_);
+  }
+}
+
+void BlockMemAssigner::AssignBlockOffsets() {
   for (auto &memory_block : memory_blocks_) {
-    if (memory_block == nullptr || memory_block->deleted_block_ || memory_block->is_zero_copy_
-        || DynamicBatchBlockReuse(*memory_block)) {
+    if (!NeedAssignOffset(memory_block)) {
       continue;
     }
 
     AddBlockMemOffset(mem_offsets_, *memory_block);
   }
-  ResizeDynamicBatchBlocks();
-  for (auto it : mem_offsets_) {
-    GELOGI("Memory type:%ld mem_offset exclude zero_copy_memory:%zu, theory_min_memory_size:%zu", it.first, it.second,
-           theory_min_memory_size_);
-  }
+}
+
+bool BlockMemAssigner::NeedAssignOffset(MemoryBlock *block) {
+  return (block != nullptr) && !block->deleted_block_ && !block->is_zero_copy_ && !DynamicBatchBlockReuse(*block);
 }
 
 ///
@@ -37,6 +37,10 @@ const size_t kMaxLifeTime = 0xffffffff;
 const int32_t kInvalidThreadScopeId = -1;
 const uint64_t kSessionScopeMemory = 0x100000000;
 const uint64_t kMemoryTypeMask = 0xffffffff;
+// feature map swapped out to host memory by ActivationOffloadPass, allocated as pinned host memory when loading
+const uint64_t kHostSwapMemory = 0x200000000;
+// attr of the model, size of the host swap memory
+const char *const kAttrNameHostSwapMemorySize = "_host_swap_memory_size";
 
 enum MemoryNoReuseScope { kReuse, kSessionNoReuse, kGraphNoReuse };
 
@@ -261,6 +265,25 @@ class BlockMemAssigner : public MemAssigner {
   ///
   void ResizeMemoryBlocks();
 
+  ///
+  /// @ingroup GE
+  /// @brief calculate offsets of the blocks placed one after another, dynamic batch blocks are placed above them
+  ///
+  virtual void AssignBlockOffsets();
+
+  ///
+  /// @ingroup GE
+  /// @brief whether a memory applied reuses the released blocks of the stream at once
+  /// @return bool false if the offsets of the blocks are planned by their life time only
+  ///
+  virtual bool ReuseReleasedBlocks() const { return true; }
+
+  ///
+  /// @ingroup GE
+  /// @brief deleted, zero copy and dynamic batch blocks are not placed by AssignBlockOffsets
+  ///
+  static bool NeedAssignOffset(MemoryBlock *block);
+
   void GetOutAndWorkSpaceMem(std::vector<int64_t> &all_memory_size);
 
   void GetNodeWorkSpaceSize(const ge::NodePtr &node, std::vector<int64_t> &workspace_memory, int64_t &total_size);
@@ -346,6 +369,13 @@ class BlockMemAssigner : public MemAssigner {
   std::map<std::string, size_t> symbol_size_;
   std::map<std::string, int64_t> symbol_to_mem_type_;
 
+  ///
+  /// @          [stream1][nodeid]
+  /// @[nodeid]  [stream2][nodeid]
+  /// @          [stream2][nodeid]
+  ///
+  DependStreamLife total_node_depend_stream_life_;
+
  private:
   ///
   /// @ingroup GE
@@ -499,12 +529,6 @@ class BlockMemAssigner : public MemAssigner {
   std::string max_batch_label_;
 
   size_t continuous_life_begin_ = 0;
-  ///
-  /// @          [stream1][nodeid]
-  /// @[nodeid]  [stream2][nodeid]
-  /// @          [stream2][nodeid]
-  ///
-  DependStreamLife total_node_depend_stream_life_;
 
   bool root_unknown_shape_flag_ = false;
 };
@@ -16,8 +16,12 @@
  */
 
 #include "graph/build/memory/graph_mem_assigner.h"
+#include <algorithm>
 #include <cstring>
+#include <fstream>
 #include <set>
+#include <nlohmann/json.hpp>
+#include "external/ge/ge_api_types.h"
 #include "common/math/math_util.h"
 #include "common/util/error_manager/error_manager.h"
 #include "framework/common/debug/ge_log.h"
@@ -28,7 +32,9 @@
 #include "common/omg_util.h"
 #include "graph/debug/ge_attr_define.h"
 #include "graph/ge_attr_value.h"
+#include "graph/ge_context.h"
 #include "graph/manager/graph_var_manager.h"
+#include "graph/passes/rematerialization_pass.h"
 #include "graph/utils/tensor_utils.h"
 #include "graph/utils/type_utils.h"
 #include "graph/build/memory/buffer_pool_mem_assigner.h"
@@ -150,10 +156,138 @@ Status GraphMemoryAssigner::AssignMemory() {
   GELOGD("GraphMemoryAssigner::AssignMemory variable size = %ld", var_size_assign);
 
   mem_assigner_ = std::move(mem_assigner);
+  ReportRematerialization();
 
   return ge::SUCCESS;
 }
 
+void GraphMemoryAssigner::ReportRematerialization() const {
+  int64_t peak_before = 0;
+  int64_t peak_after = 0;
+  if (!AttrUtils::GetInt(compute_graph_, kAttrNameRematerializationPeakBefore, peak_before) ||
+      !AttrUtils::GetInt(compute_graph_, kAttrNameRematerializationPeakAfter, peak_after)) {
+    return;
+  }
+  auto iter = memory_offset_.find(RT_MEMORY_HBM);
+  size_t block_size = (iter == memory_offset_.end()) ? 0 : iter->second.mem_offset_;
+  GEEVENT("[Rematerialization] graph %s, estimated feature map peak %ld -> %ld, assigned %zu by %s assigner.",
+          compute_graph_->GetName().c_str(), peak_before, peak_after, block_size,
+          mem_assigner_->GetPriorityAssignerName().c_str());
+}
+
+Status GraphMemoryAssigner::GetMemoryPlan(std::string &plan) const {
+  nlohmann::json plan_json;
+  plan_json["graph_id"] = compute_graph_->GetGraphID();
+  plan_json["graph_name"] = compute_graph_->GetName();
+  nlohmann::json memory_json = nlohmann::json::array();
+  for (const auto &pair : memory_offset_) {
+    nlohmann::json type_json;
+    type_json["memory_type"] = pair.first;
+    type_json["size"] = pair.second.mem_offset_;
+    // size of blocks only, the rest is of continuous, atomic and zero copy memory assigned later
+    size_t block_size = 0;
+    if (mem_assigner_ != nullptr) {
+      auto iter = mem_assigner_->GetMemOffsets().find(pair.first);
+      block_size = (iter == mem_assigner_->GetMemOffsets().end()) ? 0 : iter->second;
+    }
+    type_json["block_size"] = block_size;
+    memory_json.push_back(type_json);
+  }
+  plan_json["memory"] = memory_json;
+
+  nlohmann::json blocks_json = nlohmann::json::array();
+  BlockMemAssignerPtr priority_assigner = (mem_assigner_ == nullptr) ? nullptr : mem_assigner_->GetPriorityAssinger();
+  if (priority_assigner != nullptr) {
+    plan_json["assigner"] = mem_assigner_->GetPriorityAssignerName();
+    auto memory_blocks = priority_assigner->GetMemoryBlocks();
+    // blocks merged into a larger one by life time are its children
+    std::map<const MemoryBlock *, size_t> parent_ids;
+    for (size_t i = 0; i < memory_blocks.size(); ++i) {
+      GE_IF_BOOL_EXEC(memory_blocks[i] == nullptr, continue);
+      for (auto child : memory_blocks[i]->ChildBlockList()) {
+        parent_ids[child] = i;
+      }
+    }
+    for (size_t i = 0; i < memory_blocks.size(); ++i) {
+      auto block = memory_blocks[i];
+      GE_IF_BOOL_EXEC(block == nullptr, continue);
+      nlohmann::json block_json;
+      block_json["id"] = i;
+      block_json["offset"] = block->HeadOffset();
+      block_json["size"] = block->Size();
+      block_json["memory_type"] = block->memory_type_;
+      block_json["stream"] = block->stream_id_;
+      block_json["life_begin"] = block->GetLifeBegin();
+      block_json["life_end"] = (block->GetLifeEnd() == kMaxLifeTime) ? -1 : static_cast<int64_t>(block->GetLifeEnd());
+      block_json["reuse"] = block->reuse_mem_;
+      block_json["zero_copy"] = block->is_zero_copy_;
+      block_json["continuous"] =
+          block->continuous_block_ || block->first_continuous_block_ || block->last_continuous_block_;
+      block_json["batch_label"] = block->batch_label_;
+      auto iter = parent_ids.find(block);
+      block_json["parent"] = (iter == parent_ids.end()) ? -1 : static_cast<int64_t>(iter->second);
+      nlohmann::json tensors_json = nlohmann::json::array();
+      const auto &real_sizes = block->RealSizeList();
+      const auto &node_type_indexes = block->NodeTypeIndexList();
+      for (size_t j = 0; j < node_type_indexes.size(); ++j) {
+        const auto &node_type_index = node_type_indexes[j];
+        GE_IF_BOOL_EXEC(node_type_index.node == nullptr, continue);
+        nlohmann::json tensor_json;
+        tensor_json["node"] = node_type_index.node->GetName();
+        tensor_json["kind"] = node_type_index.GetMemType();
+        tensor_json["index"] = node_type_index.index;
+        tensor_json["size"] = (j < real_sizes.size()) ? real_sizes[j] : 0;
+        tensor_json["life_begin"] = node_type_index.GetLifeBegin();
+        tensor_json["life_end"] = (node_type_index.life_time_end == kMaxLifeTime) ? -1 :
+                                  static_cast<int64_t>(node_type_index.life_time_end);
+        tensors_json.push_back(tensor_json);
+      }
+      block_json["tensors"] = tensors_json;
+      blocks_json.push_back(block_json);
+    }
+  }
+  plan_json["blocks"] = blocks_json;
+  int64_t peak_before = 0;
+  int64_t peak_after = 0;
+  if (AttrUtils::GetInt(compute_graph_, kAttrNameRematerializationPeakBefore, peak_before) &&
+      AttrUtils::GetInt(compute_graph_, kAttrNameRematerializationPeakAfter, peak_after)) {
+    plan_json["rematerialization"] = {{"estimated_peak_before", peak_before}, {"estimated_peak_after", peak_after}};
+  }
+  try {
+    plan = plan_json.dump();
+  } catch (const nlohmann::json::exception &e) {
+    GELOGE(FAILED, "[Dump][Json]Failed to dump memory plan of graph %s, reason: %s.",
+           compute_graph_->GetName().c_str(), e.what());
+    REPORT_INNER_ERROR("E19999", "Failed to dump memory plan of graph %s, reason: %s.",
+                       compute_graph_->GetName().c_str(), e.what());
+    return FAILED;
+  }
+  return SUCCESS;
+}
+
+void GraphMemoryAssigner::DumpMemoryPlan() const {
+  std::string path;
+  (void)ge::GetContext().GetOption(MEMORY_PLAN_PATH, path);  // option may not be set up
+  if (path.empty()) {
+    return;
+  }
+  std::string plan;
+  if (GetMemoryPlan(plan) != SUCCESS) {
+    return;
+  }
+  std::string graph_name = compute_graph_->GetName();
+  std::replace(graph_name.begin(), graph_name.end(), '/', '_');
+  const std::string plan_file =
+      path + "/ge_memory_plan_" + std::to_string(compute_graph_->GetGraphID()) + "_" + graph_name + ".json";
+  std::ofstream ofs(plan_file, std::ios::trunc);
+  if (!ofs.is_open()) {
+    GELOGW("Open %s failed, skip writing memory plan.", plan_file.c_str());
+    return;
+  }
+  ofs << plan << std::endl;
+  GELOGI("Memory plan of graph %s is written to %s.", compute_graph_->GetName().c_str(), plan_file.c_str());
+}
+
 ge::Status GraphMemoryAssigner::AssignVarAttr2Nodes() {
   auto variable_assigner =
       std::unique_ptr<ge::VariableMemoryAssigner>(new(std::nothrow) ge::VariableMemoryAssigner(compute_graph_));
@@ -259,7 +393,10 @@ Status GraphMemoryAssigner::ReAssignMemory(bool is_loop_graph, map<uint64_t, siz
   size_t total_mem_offset = 0;
   for (auto pair : memory_offset_) {
     mem_type_to_offset[pair.first] = pair.second.mem_offset_;
-    total_mem_offset += pair.second.mem_offset_;
+    // host swap memory is not taken from the device
+    if ((static_cast<uint64_t>(pair.first) & kHostSwapMemory) != kHostSwapMemory) {
+      total_mem_offset += pair.second.mem_offset_;
+    }
   }
 
   auto session_id = compute_graph_->GetSessionID();
@@ -94,6 +94,27 @@ class GraphMemoryAssigner {
   ///
   ge::Status AssignMemory();
 
+  ///
+  /// @ingroup ge_graph
+  /// @brief get memory plan as json, the sizes of each memory type, and the offset, size, life time, stream, memory
+  /// type and tensors of each block, tensors are in the order they reuse the block
+  /// @param [out] plan json of memory plan
+  /// @return Status result of function
+  ///
+  ge::Status GetMemoryPlan(std::string &plan) const;
+
+  ///
+  /// @ingroup ge_graph
+  /// @brief write memory plan to <path>/ge_memory_plan_<graph id>_<graph name>.json if option MEMORY_PLAN_PATH is set
+  ///
+  void DumpMemoryPlan() const;
+
+  ///
+  /// @ingroup ge_graph
+  /// @brief report feature map peaks estimated by RematerializationPass along with the size assigned
+  ///
+  void ReportRematerialization() const;
+
   ///
   /// @ingroup ge_graph
   /// @brief assign variable attr to nodes,
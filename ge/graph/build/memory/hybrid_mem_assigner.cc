@@ -16,11 +16,15 @@
  */
 
 #include "graph/build/memory/hybrid_mem_assigner.h"
+#include <string>
 #include <utility>
 #include <vector>
+#include "external/ge/ge_api_types.h"
 #include "framework/common/debug/ge_log.h"
 #include "graph/build/memory/binary_block_mem_assigner.h"
+#include "graph/build/memory/interval_mem_assigner.h"
 #include "graph/build/memory/max_block_mem_assigner.h"
+#include "graph/ge_context.h"
 
 namespace ge {
 HybridMemAssigner::HybridMemAssigner(ge::ComputeGraphPtr compute_graph)
@@ -44,6 +48,30 @@ Status HybridMemAssigner::AssignMemory(std::unique_ptr<BlockMemAssigner> &block_
   return SUCCESS;
 }
 
+Status HybridMemAssigner::AssignByIntervalPacking(std::unique_ptr<BlockMemAssigner> &priority_assigner,
+                                                  size_t priority_mem_size, std::string &priority_assigner_name) {
+  std::string interval_packing;
+  (void)ge::GetContext().GetOption(MEMORY_INTERVAL_PACKING, interval_packing);
+  if (interval_packing != "1") {
+    return SUCCESS;
+  }
+
+  std::unique_ptr<BlockMemAssigner> interval_assigner(new (std::nothrow) IntervalMemAssigner(
+      compute_graph_, anchor_to_symbol_, symbol_to_anchors_));
+  GE_CHECK_NOTNULL(interval_assigner);
+  size_t interval_mem_size = 0;
+  GE_CHK_STATUS_RET(AssignMemory(interval_assigner, interval_mem_size), "[Assign][Memory] Fail!");
+
+  GELOGI("Graph[%s] interval-packing memory size:%zu, block memory size:%zu", compute_graph_->GetName().c_str(),
+         interval_mem_size, priority_mem_size);
+  if (interval_mem_size < priority_mem_size) {
+    GELOGI("Use interval-packing memory assigner method");
+    priority_assigner = std::move(interval_assigner);
+    priority_assigner_name = "interval-packing";
+  }
+  return SUCCESS;
+}
+
 Status HybridMemAssigner::Assign() {
   if (GraphUtils::GetRefMapping(compute_graph_, symbol_to_anchors_, anchor_to_symbol_) != GRAPH_SUCCESS) {
     REPORT_CALL_ERROR("E19999", "Get ref-mapping for graph %s failed", compute_graph_->GetName().c_str());
@@ -66,19 +94,28 @@ Status HybridMemAssigner::Assign() {
   GE_CHK_STATUS_RET(AssignMemory(max_assigner, max_mem_size), "[Assign][Memory] Fail!");
 
   std::unique_ptr<BlockMemAssigner> priority_assigner;
+  size_t priority_mem_size = 0;
+  std::string priority_assigner_name;
 
   GELOGD("Binary-block memory size:%zu, max-block memory size:%zu", bin_mem_size, max_mem_size);
   if (bin_mem_size <= max_mem_size) {
     GELOGD("Use binary-block memory assigner method");
     priority_assigner = std::move(binary_assigner);
+    priority_mem_size = bin_mem_size;
+    priority_assigner_name = "binary-block";
   } else {
     GELOGI("Use max-block memory assigner method");
     priority_assigner = std::move(max_assigner);
+    priority_mem_size = max_mem_size;
+    priority_assigner_name = "max-block";
   }
+  GE_CHK_STATUS_RET(AssignByIntervalPacking(priority_assigner, priority_mem_size, priority_assigner_name),
+                    "[Assign][Memory] Fail!");
 
   priority_assigner->SetOpMemOffset(false);
   mem_offsets_ = priority_assigner->GetMemOffsets();
   priority_assigner_ = std::move(priority_assigner);
+  priority_assigner_name_ = priority_assigner_name;
 
   return SUCCESS;
 }
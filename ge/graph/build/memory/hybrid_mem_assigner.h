@@ -19,6 +19,7 @@
 #define GE_GRAPH_BUILD_MEMORY_HYBRID_MEM_ASSIGNER_H_
 
 #include <memory>
+#include <string>
 #include "graph/build/memory/mem_assigner.h"
 #include "graph/build/memory/block_mem_assigner.h"
 #include "graph/compute_graph.h"
@@ -47,15 +48,22 @@ class HybridMemAssigner : public MemAssigner {
 
   BlockMemAssignerPtr GetPriorityAssinger() const { return priority_assigner_; }
 
+  const std::string &GetPriorityAssignerName() const { return priority_assigner_name_; }
+
  private:
   Status AssignMemory(std::unique_ptr<BlockMemAssigner> &block_assigner, size_t &mem_size);
 
+  Status AssignByIntervalPacking(std::unique_ptr<BlockMemAssigner> &priority_assigner, size_t priority_mem_size,
+                                 std::string &priority_assigner_name);
+
   std::map<uint64_t, size_t> mem_offsets_;
 
   ge::ComputeGraphPtr compute_graph_;
 
   BlockMemAssignerPtr priority_assigner_;
 
+  std::string priority_assigner_name_;
+
   std::map<std::string, std::string> anchor_to_symbol_;
   std::map<std::string, std::list<NodeIndexIO>> symbol_to_anchors_;
 };
@@ -0,0 +1,325 @@
+/**
+* Copyright 2021, 2022 LuoJiaNET Research and Development Group, Wuhan University
+* Copyright 2021, 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "graph/build/memory/interval_mem_assigner.h"
+#include <algorithm>
+#include <cstdint>
+#include <numeric>
+#include "framework/common/debug/ge_log.h"
+
+namespace {
+// packing compares every two blocks and sorts the ranges a block can't share for each one, O(n^2 log n) in all.
+// More blocks are placed one after another
+const size_t kMaxPackItems = 4096;
+// all the orders of placing the blocks are searched for graphs with so many blocks at most
+const size_t kMaxExactPackItems = 8;
+
+using OffsetRange = std::pair<size_t, size_t>;
+
+///
+/// @brief the smallest gap between the used ranges that fits, or the end of them
+///
+size_t FindBestFitOffset(std::vector<OffsetRange> used, size_t size) {
+  std::sort(used.begin(), used.end());
+  size_t best_offset = 0;
+  size_t best_gap = SIZE_MAX;
+  size_t end = 0;
+  for (const auto &range : used) {
+    if (range.first > end) {
+      size_t gap = range.first - end;
+      if ((gap >= size) && (gap < best_gap)) {
+        best_gap = gap;
+        best_offset = end;
+      }
+    }
+    end = std::max(end, range.second);
+  }
+  return (best_gap == SIZE_MAX) ? end : best_offset;
+}
+
+///
+/// @brief the lowest gap between the used ranges that fits, or the end of them
+///
+size_t FindLowestFitOffset(std::vector<OffsetRange> used, size_t size) {
+  std::sort(used.begin(), used.end());
+  size_t end = 0;
+  for (const auto &range : used) {
+    if ((range.first > end) && (range.first - end >= size)) {
+      return end;
+    }
+    end = std::max(end, range.second);
+  }
+  return end;
+}
+
+struct ExactPackContext {
+  std::vector<size_t> sizes;
+  std::vector<std::vector<bool>> can_share;
+  std::vector<size_t> offsets;
+  std::vector<bool> placed;
+  size_t best_size = 0;
+  std::vector<size_t> best_offsets;
+};
+
+void SearchLowestFit(ExactPackContext &context, size_t placed_num, size_t packed_size) {
+  if (packed_size >= context.best_size) {
+    return;
+  }
+  if (placed_num == context.sizes.size()) {
+    context.best_size = packed_size;
+    context.best_offsets = context.offsets;
+    return;
+  }
+  for (size_t i = 0; i < context.sizes.size(); ++i) {
+    if (context.placed[i]) {
+      continue;
+    }
+    std::vector<OffsetRange> used;
+    for (size_t j = 0; j < context.sizes.size(); ++j) {
+      if (context.placed[j] && !context.can_share[i][j]) {
+        used.emplace_back(context.offsets[j], context.offsets[j] + context.sizes[j]);
+      }
+    }
+    size_t offset = FindLowestFitOffset(used, context.sizes[i]);
+    context.placed[i] = true;
+    context.offsets[i] = offset;
+    SearchLowestFit(context, placed_num + 1, std::max(packed_size, offset + context.sizes[i]));
+    context.placed[i] = false;
+  }
+}
+}  // namespace
+
+namespace ge {
+Status IntervalMemAssigner::GetMemoryRanges(std::vector<int64_t> &ranges) {
+  std::vector<int64_t> all_memory_size;
+
+  GetOutAndWorkSpaceMem(all_memory_size);
+
+  // only one range, so blocks are not merged by ReuseBlocksByLifeTime before packed
+  auto it = std::max_element(std::begin(all_memory_size), std::end(all_memory_size));
+  if (it != std::end(all_memory_size)) {
+    ranges.emplace_back(*it);
+  }
+  return SUCCESS;
+}
+
+void IntervalMemAssigner::AssignBlockOffsets() {
+  std::map<uint64_t, std::vector<PackItem>> mem_type_items;
+  CollectPackItems(mem_type_items);
+  size_t item_num = 0;
+  for (const auto &it : mem_type_items) {
+    item_num += it.second.size();
+  }
+  if (item_num > kMaxPackItems) {
+    GELOGI("Graph[%s] has %zu memory blocks, more than %zu to pack by life time, place them one after another.",
+           compute_graph_->GetName().c_str(), item_num, kMaxPackItems);
+    BlockMemAssigner::AssignBlockOffsets();
+    return;
+  }
+
+  for (auto &it : mem_type_items) {
+    auto &items = it.second;
+    size_t packed_size = PackBySize(items);
+    packed_size = PackExactly(items, packed_size);
+    auto &mem_offset = mem_offsets_[it.first];
+    for (const auto &item : items) {
+      SetItemOffset(item, mem_offset);
+    }
+    mem_offset += packed_size;
+    peak_mem_sizes_[it.first] = GetPeakSize(items);
+    GEEVENT("Graph[%s] memory type:%lu, %zu memory blocks packed by life time, peak size of alive blocks:%zu, "
+            "assigned size:%zu", compute_graph_->GetName().c_str(), it.first, items.size(),
+            peak_mem_sizes_[it.first], packed_size);
+  }
+}
+
+void IntervalMemAssigner::CollectPackItems(std::map<uint64_t, std::vector<PackItem>> &mem_type_items) {
+  for (size_t i = 0; i < memory_blocks_.size(); ++i) {
+    auto block = memory_blocks_[i];
+    if (!NeedAssignOffset(block)) {
+      continue;
+    }
+    PackItem item;
+    item.blocks.emplace_back(block);
+    // blocks of continuous inputs are put from the first one to the last one by AssignContinuousBlocks
+    if (block->first_continuous_block_) {
+      item.size = MEM_ALIGN_SIZE;
+      while (!block->last_continuous_block_ && (i + 1 < memory_blocks_.size())) {
+        block = memory_blocks_[++i];
+        if (NeedAssignOffset(block)) {
+          item.blocks.emplace_back(block);
+        }
+        GE_IF_BOOL_EXEC(block == nullptr, break);
+      }
+    }
+
+    item.life_begin = kMaxLifeTime;
+    for (auto mem_block : item.blocks) {
+      mem_block->Resize();
+      item.size += mem_block->Size();
+      item.continuous = item.continuous || mem_block->continuous_block_;
+      item.reusable = item.reusable && mem_block->reuse_mem_ && IsPostReuse(mem_block) &&
+                      (mem_block->batch_label_ == item.blocks.front()->batch_label_);
+      item.life_begin = std::min(item.life_begin, mem_block->GetLifeBegin());
+      item.life_end = std::max(item.life_end, mem_block->GetLifeEnd());
+    }
+    if (!item.reusable) {
+      item.life_begin = 0;
+      item.life_end = kMaxLifeTime;
+    }
+    mem_type_items[item.blocks.front()->memory_type_].emplace_back(std::move(item));
+  }
+}
+
+bool IntervalMemAssigner::FreedBefore(const PackItem &first, const PackItem &second) {
+  if ((first.life_end == kMaxLifeTime) || (first.life_end >= second.life_end)) {
+    return false;
+  }
+  // Different streams must use stream dependency to judge the life cycle
+  for (auto freed_block : first.blocks) {
+    auto life_end = freed_block->GetLifeEnd();
+    for (auto used_block : second.blocks) {
+      if (used_block->GetDependLifeBegin(freed_block->stream_id_, total_node_depend_stream_life_) <= life_end) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+///
+/// @brief blocks alive at the same node never share memory, a cheap test ahead of CanShareMemory.
+/// Disjoint lives still need CanShareMemory for the streams and the thread scopes
+///
+bool IntervalMemAssigner::LifeOverlapped(const PackItem &left, const PackItem &right) {
+  return (left.life_begin <= right.life_end) && (right.life_begin <= left.life_end);
+}
+
+bool IntervalMemAssigner::CanShareMemory(const PackItem &left, const PackItem &right) {
+  if (!left.reusable || !right.reusable || (left.blocks.front()->batch_label_ != right.blocks.front()->batch_label_)) {
+    return false;
+  }
+  // not same thread scode id can reuse
+  for (auto left_block : left.blocks) {
+    for (auto right_block : right.blocks) {
+      for (auto thread_scope_id : left_block->ThreadScopeId()) {
+        if (!right_block->CanReuse(thread_scope_id)) {
+          return false;
+        }
+      }
+    }
+  }
+  // If node is before atomic_addr_clean node, the continus memory can't be reused.
+  size_t atomic_addr_clean_id = static_cast<size_t>(std::max(GetAtomicAddrCleanId(), static_cast<int64_t>(0)));
+  if ((left.continuous && (right.life_begin < atomic_addr_clean_id)) ||
+      (right.continuous && (left.life_begin < atomic_addr_clean_id))) {
+    return false;
+  }
+  return FreedBefore(left, right) || FreedBefore(right, left);
+}
+
+///
+/// @brief larger blocks are placed first, each into the smallest gap left among the blocks it can't share with
+///
+size_t IntervalMemAssigner::PackBySize(std::vector<PackItem> &items) {
+  std::vector<size_t> order(items.size());
+  std::iota(order.begin(), order.end(), 0);
+  std::stable_sort(order.begin(), order.end(), [&items](size_t left, size_t right) {
+    if (items[left].size != items[right].size) {
+      return items[left].size > items[right].size;
+    }
+    return items[left].life_begin < items[right].life_begin;
+  });
+
+  size_t packed_size = 0;
+  for (size_t i = 0; i < order.size(); ++i) {
+    auto &item = items[order[i]];
+    std::vector<OffsetRange> used;
+    for (size_t j = 0; j < i; ++j) {
+      const auto &placed = items[order[j]];
+      if (LifeOverlapped(item, placed) || !CanShareMemory(item, placed)) {
+        used.emplace_back(placed.offset, placed.offset + placed.size);
+      }
+    }
+    item.offset = FindBestFitOffset(used, item.size);
+    packed_size = std::max(packed_size, item.offset + item.size);
+  }
+  return packed_size;
+}
+
+size_t IntervalMemAssigner::PackExactly(std::vector<PackItem> &items, size_t packed_size) {
+  if ((items.size() <= 1) || (items.size() > kMaxExactPackItems)) {
+    return packed_size;
+  }
+  ExactPackContext context;
+  context.can_share.assign(items.size(), std::vector<bool>(items.size(), false));
+  for (size_t i = 0; i < items.size(); ++i) {
+    context.sizes.emplace_back(items[i].size);
+    for (size_t j = i + 1; j < items.size(); ++j) {
+      context.can_share[i][j] = CanShareMemory(items[i], items[j]);
+      context.can_share[j][i] = context.can_share[i][j];
+    }
+  }
+  context.offsets.assign(items.size(), 0);
+  context.placed.assign(items.size(), false);
+  context.best_size = packed_size;
+  SearchLowestFit(context, 0, 0);
+  if (context.best_offsets.empty()) {
+    return packed_size;
+  }
+
+  GELOGD("Graph[%s] memory blocks are packed from size %zu to %zu by searching all orders.",
+         compute_graph_->GetName().c_str(), packed_size, context.best_size);
+  for (size_t i = 0; i < items.size(); ++i) {
+    items[i].offset = context.best_offsets[i];
+  }
+  return context.best_size;
+}
+
+///
+/// @brief blocks alive at the same node can't share memory, the packed size gets close to the peak at best
+///
+size_t IntervalMemAssigner::GetPeakSize(const std::vector<PackItem> &items) {
+  // allocated and freed sizes at node
+  std::map<size_t, std::pair<size_t, size_t>> changes;
+  for (const auto &item : items) {
+    changes[item.life_begin].first += item.size;
+    if (item.life_end != kMaxLifeTime) {
+      changes[item.life_end + 1].second += item.size;
+    }
+  }
+  size_t alive_size = 0;
+  size_t peak_size = 0;
+  for (const auto &change : changes) {
+    alive_size = alive_size - change.second.second + change.second.first;
+    peak_size = std::max(peak_size, alive_size);
+  }
+  return peak_size;
+}
+
+void IntervalMemAssigner::SetItemOffset(const PackItem &item, size_t mem_offset) {
+  size_t offset = mem_offset + item.offset;
+  if (item.blocks.front()->first_continuous_block_) {
+    offset += MEM_ALIGN_SIZE;
+  }
+  for (auto block : item.blocks) {
+    block->SetHeadOffset(offset);
+    offset += block->Size();
+    block->SetTailOffset(offset - 1);
+  }
+}
+}  // namespace ge
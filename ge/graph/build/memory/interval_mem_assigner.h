@@ -0,0 +1,90 @@
+/**
+* Copyright 2021, 2022 LuoJiaNET Research and Development Group, Wuhan University
+* Copyright 2021, 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef GE_GRAPH_BUILD_MEMORY_INTERVAL_MEM_ASSIGNER_H_
+#define GE_GRAPH_BUILD_MEMORY_INTERVAL_MEM_ASSIGNER_H_
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+#include "graph/build/memory/block_mem_assigner.h"
+
+namespace ge {
+///
+/// Every tensor gets its own block, then the blocks are packed into offsets by their life time, greedy by size
+/// with the best fit gap. Blocks may share memory only if one is released before the other is used, judged by
+/// the stream dependencies as the life time reuse of BlockMemAssigner does. For small graphs all the orders of
+/// placing the blocks at the lowest gaps are searched as well.
+///
+class IntervalMemAssigner : public BlockMemAssigner {
+ public:
+  IntervalMemAssigner(ComputeGraphPtr compute_graph, const std::map<std::string, std::string> &anchor_to_symbol,
+                      const std::map<std::string, std::list<NodeIndexIO>> &symbol_to_anchors)
+      : BlockMemAssigner(std::move(compute_graph), anchor_to_symbol, symbol_to_anchors) {}
+
+  IntervalMemAssigner(const IntervalMemAssigner &) = delete;
+
+  IntervalMemAssigner &operator=(const IntervalMemAssigner &) = delete;
+
+  ~IntervalMemAssigner() override = default;
+
+  Status GetMemoryRanges(std::vector<int64_t> &ranges) override;
+
+  ///
+  /// @brief peak size of the blocks alive at the same time in node order, of each memory type
+  ///
+  const std::map<uint64_t, size_t> &GetPeakMemSizes() const { return peak_mem_sizes_; }
+
+ protected:
+  void AssignBlockOffsets() override;
+
+  bool ReuseReleasedBlocks() const override { return false; }
+
+ private:
+  ///
+  /// blocks of continuous inputs are packed together, as they are placed one after another
+  ///
+  struct PackItem {
+    std::vector<MemoryBlock *> blocks;
+    size_t size = 0;
+    size_t life_begin = 0;
+    size_t life_end = 0;
+    bool reusable = true;
+    bool continuous = false;
+    size_t offset = 0;
+  };
+
+  void CollectPackItems(std::map<uint64_t, std::vector<PackItem>> &mem_type_items);
+
+  bool FreedBefore(const PackItem &first, const PackItem &second);
+
+  static bool LifeOverlapped(const PackItem &left, const PackItem &right);
+
+  bool CanShareMemory(const PackItem &left, const PackItem &right);
+
+  size_t PackBySize(std::vector<PackItem> &items);
+
+  size_t PackExactly(std::vector<PackItem> &items, size_t packed_size);
+
+  static size_t GetPeakSize(const std::vector<PackItem> &items);
+
+  static void SetItemOffset(const PackItem &item, size_t mem_offset);
+
+  std::map<uint64_t, size_t> peak_mem_sizes_;
+};
+}  // namespace ge
+#endif  // GE_GRAPH_BUILD_MEMORY_INTERVAL_MEM_ASSIGNER_H_
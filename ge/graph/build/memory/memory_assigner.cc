@@ -70,6 +70,7 @@ Status MemoryAssigner::AssignMemory(bool is_loop_graph, map<uint64_t, size_t> &m
   }
 
   graph_mem_assigner.MarkDistanceAttr();
+  graph_mem_assigner.DumpMemoryPlan();
   return SUCCESS;
 }
 }  // namespace ge
@@ -415,6 +415,15 @@ Status ModelBuilder::BuildModelDef(ge::Model &model) {
   GELOGE(FAILED, "SetInt of ATTR_NAME_SESSION_SCOPE_MEMORY_SIZE failed.");
   return FAILED);
 
+  auto host_swap_iter = mem_type_to_mem_offset_.find(kHostSwapMemory | RT_MEMORY_HBM);
+  if (host_swap_iter != mem_type_to_mem_offset_.end()) {
+    GE_CHK_BOOL_EXEC(ge::AttrUtils::SetInt(&model, kAttrNameHostSwapMemorySize, host_swap_iter->second),
+                     REPORT_INNER_ERROR("E19999", "Set Attr:%s in model failed", kAttrNameHostSwapMemorySize);
+                     GELOGE(FAILED, "[Set][Attr] %s in model failed", kAttrNameHostSwapMemorySize);
+                     return FAILED);
+    GELOGI("For model, host_swap_mem_size: %zu", host_swap_iter->second);
+  }
+
   GE_CHK_BOOL_EXEC(ge::AttrUtils::SetInt(&model, ATTR_MODEL_P2P_MEMORY_SIZE, p2p_mem_offset_),
                    REPORT_INNER_ERROR("E19999", "Set Attr:%s in model failed", ATTR_MODEL_P2P_MEMORY_SIZE.c_str());
                    GELOGE(FAILED, "[Set][Attr] %s in model failed", ATTR_MODEL_P2P_MEMORY_SIZE.c_str());
@@ -569,27 +569,21 @@ Status StreamAllocator::InsertEventsForSubgraph() {
 
 // Optimize the event in the graph, delete the redundant sync event according to the stream information
 Status StreamAllocator::OptimizeSyncEvents() {
-  map<int64_t, vector<NodePtr>> stream_nodes;
-
+  vector<NodePtr> nodes;
   for (const auto &node : whole_graph_->GetNodes(whole_graph_->GetGraphUnknownFlag())) {
     GE_CHECK_NOTNULL(node->GetOpDesc());
-    int64_t stream_id = node->GetOpDesc()->GetStreamId();
-    stream_nodes[stream_id].emplace_back(node);
+    nodes.emplace_back(node);
   }
+  vector<EventNodes> event_nodes;
+  GetEventNodes(event_nodes);
 
-  Status status = OptimizeBySendEvents(stream_nodes);
+  Status status = OptimizeByStreamClocks(nodes, event_nodes);
   if (status != SUCCESS) {
-    GELOGE(status, "[Optimize][StreamNodes] By Send Events failed! graph:%s", whole_graph_->GetName().c_str());
+    GELOGE(status, "[Optimize][StreamNodes] By Stream Clocks failed! graph:%s", whole_graph_->GetName().c_str());
     return status;
   }
 
-  status = OptimizeByRecvEvents(stream_nodes);
-  if (status != SUCCESS) {
-    GELOGE(status, "[Optimize][StreamNodes] By Recv Events failed! graph:%s", whole_graph_->GetName().c_str());
-    return status;
-  }
-
-  status = OptimizeByStreamActivate();
+  status = OptimizeByStreamActivate(event_nodes);
   if (status != SUCCESS) {
     GELOGE(status, "[Call][OptimizeByStreamActivate] failed! graph:%s", whole_graph_->GetName().c_str());
     return status;
@@ -599,7 +593,9 @@ Status StreamAllocator::OptimizeSyncEvents() {
       for (auto event_id : pair.second) {
         GELOGI("Curren switch node is %s, remove send event_id %d.", pair.first->GetName().c_str(), event_id);
         RmvSendEventId(pair.first, event_id);
-        auto recv_node = GetNodeFromRecvEventId(event_id);
+        GE_CHECK_LE(event_id + 1, event_nodes.size());
+        const auto &recv_node = event_nodes[event_id].recv_node;
+        GE_CHECK_NOTNULL(recv_node);
         GELOGI("Curren recv_node is %s, remove recv event_id %d.", recv_node->GetName().c_str(), event_id);
         RmvRecvEventId(recv_node, event_id);
       }
@@ -608,50 +604,15 @@ Status StreamAllocator::OptimizeSyncEvents() {
   return SUCCESS;
 }
 
-/// Optimization scenario: one stream has multiple send events in one node,
-/// and multiple nodes for recv events on another stream
-/// Example:
+/// Remove the events whose recv node is already ordered after the send node by the other events and the order of
+/// the nodes on the streams. It covers the scenarios below and the ones ordered through other streams.
+/// Scenario 1: one stream has multiple send events in one node, and multiple nodes for recv events on another stream
 /// Stream0            Stream1
 ///   N1 - - - event - > N1
 ///     \                |
 ///      \               v
 ///        - - event - > N2
-Status StreamAllocator::OptimizeBySendEvents(const map<int64_t, vector<NodePtr>> &stream_nodes) {
-  for (const auto &one_pair : stream_nodes) {
-    // The nodes on a stream in order
-    const vector<NodePtr> &nodes = one_pair.second;
-
-    map<NodePtr, uint32_t> send_node_to_event_id;
-
-    for (const auto &recv_node_ptr : nodes) {
-      GE_CHECK_NOTNULL(recv_node_ptr);
-      // Get all recv events of the current node, then traverse the event
-      vector<uint32_t> recv_events;
-      GetRecvEventIdList(recv_node_ptr, recv_events);
-
-      for (const auto &event_id : recv_events) {
-        NodePtr send_node_ptr = GetNodeFromSendEventId(event_id);
-        GE_CHECK_NOTNULL(send_node_ptr);
-
-        /// If the record to the stream is found in the map,
-        /// and the recv node is the node, then remove sync event
-        if (send_node_to_event_id.find(send_node_ptr) != send_node_to_event_id.end()) {
-          RmvSendEventId(send_node_ptr, event_id);
-          RmvRecvEventId(recv_node_ptr, event_id);
-          GELOGI("Remove event %u between node %s and node %s", event_id, send_node_ptr->GetName().c_str(),
-                 recv_node_ptr->GetName().c_str());
-        } else {
-          send_node_to_event_id[send_node_ptr] = event_id;
-        }
-      }
-    }
-  }
-
-  return SUCCESS;
-}
-
-/// Scenario: multiple send nodes on a stream sent to a single recv node on the destination stream
-/// Example:
+/// Scenario 2: multiple send nodes on a stream sent to a single recv node on the destination stream
 /// Stream0            Stream1
 ///   N1 - -
 ///   |    |
@@ -659,50 +620,113 @@ Status StreamAllocator::OptimizeBySendEvents(const map<int64_t, vector<NodePtr>>
 ///   |                  |
 ///   V                  V
 ///   N2 - - - event - > N2
-Status StreamAllocator::OptimizeByRecvEvents(const map<int64_t, vector<NodePtr>> &stream_nodes) {
-  for (const auto &one_pair : stream_nodes) {
-    // The nodes on a stream in order
-    const vector<NodePtr> &nodes = one_pair.second;
-
-    map<NodePtr, uint32_t> recv_node_to_event_id;
-
-    for (const auto &send_node_ptr : nodes) {
-      GE_CHECK_NOTNULL(send_node_ptr);
-      //  Get all send events of the current node, then traverse the event
-      vector<uint32_t> send_id_list;
-      GetSendEventIdList(send_node_ptr, send_id_list);
-
-      for (const auto &event_id : send_id_list) {
-        NodePtr recv_node_ptr = GetNodeFromRecvEventId(event_id);
-        GE_CHECK_NOTNULL(recv_node_ptr);
-
-        /// If the record to the stream is found in the map,
-        /// and the send node is the node, then remove sync event
-        auto it = recv_node_to_event_id.find(recv_node_ptr);
-        if (it != recv_node_to_event_id.end()) {
-          uint32_t pre_event_id = it->second;
-          NodePtr pre_send_node_ptr = GetNodeFromSendEventId(pre_event_id);
-          GE_CHECK_NOTNULL(pre_send_node_ptr);
-
-          RmvSendEventId(pre_send_node_ptr, pre_event_id);
-          RmvRecvEventId(recv_node_ptr, pre_event_id);
-          GELOGI("Remove event %u between node %s and node %s.", event_id, pre_send_node_ptr->GetName().c_str(),
-                 recv_node_ptr->GetName().c_str());
-        }
-        recv_node_to_event_id[recv_node_ptr] = event_id;
-      }
+/// Each stream keeps a vector clock, the last position on every stream known to be done before its next node.
+/// Nodes are visited in order and the recv events of a node are checked from the latest send node on. An event is
+/// redundant if the clock of the recv stream covers the send node already, otherwise the clock of the send node is
+/// merged. Streams activated by other nodes may run again, e.g. in loops, so their send nodes only pass their own
+/// positions on. It takes O(N + E * S) time for N nodes, E events and S streams.
+Status StreamAllocator::OptimizeByStreamClocks(const vector<NodePtr> &nodes, const vector<EventNodes> &event_nodes) {
+  struct NodePosition {
+    size_t order;
+    size_t stream;
+    int64_t position;
+  };
+  using SendEvent = std::pair<const NodePosition *, uint32_t>;
+  map<int64_t, size_t> stream_indexes;
+  vector<int64_t> stream_node_nums;
+  std::unordered_map<const Node *, NodePosition> node_positions;
+  set<int64_t> activated_stream_ids = specific_activated_streams_;
+  for (const auto &label_streams : labeled_streams_) {
+    activated_stream_ids.insert(label_streams.second.begin(), label_streams.second.end());
+  }
+  for (size_t order = 0; order < nodes.size(); ++order) {
+    const auto &op_desc = nodes[order]->GetOpDesc();
+    vector<uint32_t> active_streams;
+    if (AttrUtils::GetListInt(op_desc, ATTR_NAME_ACTIVE_STREAM_LIST, active_streams)) {
+      activated_stream_ids.insert(active_streams.begin(), active_streams.end());
+    }
+    int64_t stream_id = op_desc->GetStreamId();
+    if (stream_id == kInvalidStream) {
+      continue;
+    }
+    size_t stream = stream_indexes.emplace(stream_id, stream_indexes.size()).first->second;
+    if (stream >= stream_node_nums.size()) {
+      stream_node_nums.emplace_back(0);
     }
+    node_positions[nodes[order].get()] = {order, stream, stream_node_nums[stream]++};
   }
+  const size_t stream_num = stream_indexes.size();
+  vector<bool> activated_streams(stream_num, false);
+  for (const auto &stream_index : stream_indexes) {
+    activated_streams[stream_index.second] = (activated_stream_ids.count(stream_index.first) > 0);
+  }
+
+  vector<vector<int64_t>> stream_clocks(stream_num, vector<int64_t>(stream_num, -1));
+  std::unordered_map<const Node *, vector<int64_t>> send_clocks;
+  size_t removed_num = 0;
+  for (const auto &recv_node : nodes) {
+    auto recv_iter = node_positions.find(recv_node.get());
+    if (recv_iter == node_positions.end()) {
+      continue;
+    }
+    const NodePosition &recv_position = recv_iter->second;
+    vector<int64_t> &clock = stream_clocks[recv_position.stream];
 
+    vector<uint32_t> recv_events;
+    GetRecvEventIdList(recv_node, recv_events);
+    vector<SendEvent> visited_events;
+    for (const auto &event_id : recv_events) {
+      GE_CHECK_LE(event_id + 1, event_nodes.size());
+      const auto &send_node = event_nodes[event_id].send_node;
+      GE_CHECK_NOTNULL(send_node);
+      auto send_iter = node_positions.find(send_node.get());
+      // events from nodes not visited yet are kept, they tell nothing about the order
+      if ((send_iter != node_positions.end()) && (send_iter->second.order < recv_position.order)) {
+        visited_events.emplace_back(&send_iter->second, event_id);
+      }
+    }
+    // the latest send node knows the most
+    std::sort(visited_events.begin(), visited_events.end(),
+              [](const SendEvent &lhs, const SendEvent &rhs) { return lhs.first->order > rhs.first->order; });
+    for (const auto &visited_event : visited_events) {
+      const NodePosition &send_position = *visited_event.first;
+      const uint32_t event_id = visited_event.second;
+      const auto &send_node = event_nodes[event_id].send_node;
+      if (clock[send_position.stream] >= send_position.position) {
+        RmvSendEventId(send_node, event_id);
+        RmvRecvEventId(recv_node, event_id);
+        GELOGI("Remove event %u between node %s and node %s", event_id, send_node->GetName().c_str(),
+               recv_node->GetName().c_str());
+        ++removed_num;
+        continue;
+      }
+      auto clock_iter = send_clocks.find(send_node.get());
+      if (activated_streams[send_position.stream] || (clock_iter == send_clocks.end())) {
+        clock[send_position.stream] = send_position.position;
+        continue;
+      }
+      for (size_t stream = 0; stream < stream_num; ++stream) {
+        clock[stream] = std::max(clock[stream], clock_iter->second[stream]);
+      }
+    }
+
+    clock[recv_position.stream] = recv_position.position;
+    auto send_events_iter = node_to_send_events_.find(recv_node);
+    if ((send_events_iter != node_to_send_events_.end()) && !send_events_iter->second.empty()) {
+      send_clocks[recv_node.get()] = clock;
+    }
+  }
+  GELOGI("Optimize events by stream clocks, %zu events removed, stream num: %zu.", removed_num, stream_num);
   return SUCCESS;
 }
 
-Status StreamAllocator::OptimizeByStreamActivate() {
+Status StreamAllocator::OptimizeByStreamActivate(const vector<EventNodes> &event_nodes) {
   auto node_to_send_events_temp = node_to_send_events_;
   for (const auto &node_event_id_pair : node_to_send_events_temp) {
     const NodePtr &send_node_ptr = node_event_id_pair.first;
     for (const auto &event_id : node_event_id_pair.second) {
-      NodePtr recv_node_ptr = GetNodeFromRecvEventId(event_id);
+      GE_CHECK_LE(event_id + 1, event_nodes.size());
+      NodePtr recv_node_ptr = event_nodes[event_id].recv_node;
       GE_CHECK_NOTNULL(recv_node_ptr);
       if (IsRecvNodeActivatedBySendNode(send_node_ptr, recv_node_ptr)) {
         RmvSendEventId(send_node_ptr, event_id);
@@ -1670,32 +1694,25 @@ void StreamAllocator::GetRecvEventIdList(const NodePtr &node, vector<uint32_t> &
   }
 }
 
-// Get a specific send node according to the recv event
-NodePtr StreamAllocator::GetNodeFromSendEventId(uint32_t send_event_id) const {
+// Get the send and recv nodes of each event
+void StreamAllocator::GetEventNodes(vector<EventNodes> &event_nodes) const {
+  event_nodes.assign(event_num_, EventNodes());
   for (const auto &one_pair : node_to_send_events_) {
-    const vector<uint32_t> &events = one_pair.second;
-    for (const auto &event_id : events) {
-      if (event_id == send_event_id) {
-        return one_pair.first;
+    for (const auto &event_id : one_pair.second) {
+      if (event_id >= event_nodes.size()) {
+        event_nodes.resize(event_id + 1);
       }
+      event_nodes[event_id].send_node = one_pair.first;
     }
   }
-
-  return nullptr;
-}
-
-// Get a specific recv node according to the recv event
-NodePtr StreamAllocator::GetNodeFromRecvEventId(uint32_t recv_event_id) const {
   for (const auto &one_pair : node_to_recv_events_) {
-    const vector<uint32_t> &events = one_pair.second;
-    for (const auto &event_id : events) {
-      if (event_id == recv_event_id) {
-        return one_pair.first;
+    for (const auto &event_id : one_pair.second) {
+      if (event_id >= event_nodes.size()) {
+        event_nodes.resize(event_id + 1);
       }
+      event_nodes[event_id].recv_node = one_pair.first;
     }
   }
-
-  return nullptr;
 }
 
 Status StreamAllocator::AddEventId(const NodePtr &pre_node, const NodePtr &not_cur, const NodePtr &cur_node,
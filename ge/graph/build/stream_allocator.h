@@ -21,6 +21,7 @@
 #include <map>
 #include <set>
 #include <string>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 #include "engine_manager/dnnengine_manager.h"
@@ -51,9 +52,14 @@ class StreamAllocator {
   Status InsertEventsForSubgraph();
 
   Status OptimizeSyncEvents();
-  Status OptimizeBySendEvents(const std::map<int64_t, std::vector<NodePtr>> &stream_nodes);
-  Status OptimizeByRecvEvents(const std::map<int64_t, std::vector<NodePtr>> &stream_nodes);
-  Status OptimizeByStreamActivate();
+  // send and recv node of an event, indexed by event id
+  struct EventNodes {
+    NodePtr send_node;
+    NodePtr recv_node;
+  };
+  void GetEventNodes(std::vector<EventNodes> &event_nodes) const;
+  Status OptimizeByStreamClocks(const std::vector<NodePtr> &nodes, const std::vector<EventNodes> &event_nodes);
+  Status OptimizeByStreamActivate(const std::vector<EventNodes> &event_nodes);
   // Determine if the successor node of RecvNode is directly or indirectly activated by the SendNode precursor node
   bool IsRecvNodeActivatedBySendNode(const NodePtr &send_node_ptr, const NodePtr &recv_node_ptr) const;
   bool IsActiveAfterNextIteration(const NodePtr &active_node_ptr) const;
@@ -92,8 +98,6 @@ class StreamAllocator {
   void RmvRecvEventId(const NodePtr &node, uint32_t event_id);
   void GetSendEventIdList(const NodePtr &node, std::vector<uint32_t> &send_list) const;
   void GetRecvEventIdList(const NodePtr &node, std::vector<uint32_t> &recv_list) const;
-  NodePtr GetNodeFromSendEventId(uint32_t send_event_id) const;
-  NodePtr GetNodeFromRecvEventId(uint32_t recv_event_id) const;
   Status AddEventId(const NodePtr &pre_node, const NodePtr &not_cur, const NodePtr &cur_node, bool not_use_cur);
 
   Status AddActiveNodes(NodePtr &switch_node, const std::vector<std::string> &ori_active_label_list,
@@ -129,6 +129,20 @@ class DataInputer {
     return success ? domi::SUCCESS : domi::INTERNAL_ERROR;
   }
 
+  ///
+  /// @ingroup domi_ome
+  /// @brief pop input data without waiting, only valid for a single consumer
+  /// @param [out] save popped input data
+  /// @return true pop success
+  /// @return false no data queued or pop fail
+  ///
+  bool TryPop(std::shared_ptr<InputDataWrapper> &data) {
+    if (queue_.Size() == 0) {
+      return false;
+    }
+    return queue_.Pop(data);
+  }
+
   ///
   /// @ingroup domi_ome
   /// @brief stop receiving data, invoke thread at Pop
@@ -104,6 +104,8 @@ const uint32_t kInteval = 2;
 const uint32_t kFftsTbeHandleElementSize = 2;
 const uint32_t kNonTailBlock = 0;
 const uint32_t kTailBlock = 1;
+const int64_t kMinInputStagingDepth = 2;
+const int64_t kMaxInputStagingDepth = 8;
 const char *const kModelName = "model_name";
 const char *const kModeleId = "model_id";
 const char *const kLoadStartTime = "load_start_time";
@@ -167,8 +169,6 @@ inline bool IsNoTaskAndDumpNeeded(const OpDescPtr &op_desc) {
 }
 }  // namespace
 
-std::mutex DavinciModel::tvm_bin_mutex_;
-
 DavinciModel::DavinciModel(int32_t priority, const std::shared_ptr<ModelListener> &listener)
     : weights_mem_base_(nullptr),
       var_mem_base_(nullptr),
@@ -371,6 +371,15 @@ Status DavinciModel::InitWeightMem(void *dev_ptr, void *weight_ptr, size_t weigh
   if (weights_size != 0) {
     weights_mem_base_ = static_cast<uint8_t *>(weight_ptr);
     is_inner_weight_base_ = false;
+    if ((weight_ptr == nullptr) && IsWeightsShared()) {
+      GE_CHK_STATUS_RET(ModelManager::GetInstance()->AcquireSharedWeights(GetDeviceId(), weights, shared_weights_key_,
+                                                                          weights_mem_base_),
+                        "[Acquire][SharedWeights] failed, size:%zu, model_id:%u", weights_size, model_id_);
+      if (!shared_weights_key_.empty()) {
+        runtime_param_.weight_base = weights_mem_base_;
+        return SUCCESS;
+      }
+    }
     if (weight_ptr == nullptr) {
       weights_mem_base_ = MallocWeightsMem(weights_size);
       if (weights_mem_base_ == nullptr) {
@@ -426,7 +435,7 @@ Status DavinciModel::InitFeatureMapAndP2PMem(void *dev_ptr, size_t mem_size) {
     GEEVENT("[IMAS]InitFeatureMapAndP2PMem graph_%u MallocMemory type[F] memaddr[%p] mem_size[%zu]",
             runtime_param_.graph_id, mem_base_, data_size);
 
-    if (!is_inner_weight_base_) {
+    if (!is_inner_weight_base_ && shared_weights_key_.empty()) {
       weights_mem_base_ = mem_base_;
       is_inner_weight_base_ = true;
     }
@@ -499,6 +508,13 @@ void DavinciModel::InitRuntimeParams() {
   session_scope_mem_info.memory_size = static_cast<size_t>(ret ? value : 0);
   runtime_param_.memory_infos[kSessionScopeMemory | RT_MEMORY_HBM] = std::move(session_scope_mem_info);
 
+  ret = ge::AttrUtils::GetInt(ge_model_, kAttrNameHostSwapMemorySize, value);
+  MemInfo host_swap_mem_info;
+  host_swap_mem_info.memory_size = static_cast<size_t>(ret ? value : 0);
+  host_swap_mem_info.memory_type = RT_MEMORY_HBM;
+  host_swap_mem_info.memory_key = "_h";
+  runtime_param_.memory_infos[kHostSwapMemory | RT_MEMORY_HBM] = std::move(host_swap_mem_info);
+
   ret = ge::AttrUtils::GetInt(ge_model_, ATTR_MODEL_ZERO_COPY_MEMORY_SIZE, value);
   runtime_param_.zero_copy_size = ret ? value : 0;
   GELOGI("InitRuntimeParams(), %s.", runtime_param_.ToString().c_str());
@@ -584,6 +600,7 @@ Status DavinciModel::DoTaskSink() {
   GE_CHK_RT_RET(rtModelLoadComplete(rt_model_handle_));
 
   SetCopyOnlyOutput();
+  InitZeroCopyPatchTable();
   return SUCCESS;
 }
 
@@ -2316,7 +2333,7 @@ Status DavinciModel::GetOutputDescInfo(vector<InputOutputDescInfo> &output_descs
   return SUCCESS;
 }
 
-Status DavinciModel::CopyInputData(const InputData &input_data) {
+Status DavinciModel::CopyInputData(const InputData &input_data, const map<uint32_t, void *> *staging_slot) {
   const std::vector<DataBuffer> &blobs = input_data.blobs;
   for (const auto &data : input_data_info_) {
     if (data.first >= blobs.size()) {
@@ -2340,6 +2357,13 @@ Status DavinciModel::CopyInputData(const InputData &input_data) {
                            "[Check][Param] input data size(%lu) does not match model required size(%lu), "
                            "op_name(%s), ret failed.", data_buf.length, data_size, data.second.GetOpName().c_str());
     void *mem_addr = data.second.GetBasicAddr();
+    if (staging_slot != nullptr) {
+      auto it = staging_slot->find(data.first);
+      GE_CHK_BOOL_RET_STATUS(it != staging_slot->end(), INTERNAL_ERROR,
+                             "[Check][Param] No staging memory for input[%u], op_name(%s).", data.first,
+                             data.second.GetOpName().c_str());
+      mem_addr = it->second;
+    }
     void *data_buf_addr = reinterpret_cast<void *>(reinterpret_cast<uintptr_t>(data_buf.data));
     uint64_t data_buf_length = data_buf.length;
     GELOGI("CopyPlainData memcpy graph_%u type[F] input[%s] rank[%u] dst[%p] src[%p] mem_size[%lu] datasize[%lu]",
@@ -2351,6 +2375,120 @@ Status DavinciModel::CopyInputData(const InputData &input_data) {
   return SUCCESS;
 }
 
+Status DavinciModel::InitInputStaging() {
+  string opt = "0";
+  (void)ge::GetContext().GetOption(OPTION_EXEC_INPUT_STAGING_DEPTH, opt);  // option may not be set up
+  int64_t depth = std::strtol(opt.c_str(), nullptr, kDecimal);
+  if (depth < kMinInputStagingDepth || input_data_info_.empty()) {
+    return SUCCESS;
+  }
+  if (depth > kMaxInputStagingDepth) {
+    GELOGW("Input staging depth %ld is larger than %ld, use %ld instead.", depth, kMaxInputStagingDepth,
+           kMaxInputStagingDepth);
+    depth = kMaxInputStagingDepth;
+  }
+
+  input_staging_slots_.resize(static_cast<size_t>(depth));
+  for (auto &slot : input_staging_slots_) {
+    for (const auto &data : input_data_info_) {
+      void *addr = nullptr;
+      uint64_t data_size = data.second.GetDataSize();
+      rtError_t rt_ret = rtMalloc(&addr, data_size, RT_MEMORY_HBM);
+      if (rt_ret != RT_ERROR_NONE) {
+        REPORT_CALL_ERROR("E19999", "Call rtMalloc failed, size:%lu, ret:0x%X, model_id:%u", data_size, rt_ret,
+                          model_id_);
+        GELOGE(RT_FAILED, "[Call][RtMalloc] failed, size:%lu, ret:0x%X, model_id:%u", data_size, rt_ret, model_id_);
+        FreeInputStaging();
+        return RT_ERROR_TO_GE_STATUS(rt_ret);
+      }
+      slot[data.first] = addr;
+    }
+  }
+  input_staging_depth_ = static_cast<uint32_t>(depth);
+  next_staging_slot_ = 0;
+  cur_staging_slot_ = 0;
+  GELOGI("Input staging enabled, depth:%u, input num:%zu, model_id:%u", input_staging_depth_,
+         input_data_info_.size(), model_id_);
+  return SUCCESS;
+}
+
+void DavinciModel::FreeInputStaging() {
+  for (auto &slot : input_staging_slots_) {
+    for (auto &it : slot) {
+      if (it.second != nullptr) {
+        GE_CHK_RT(rtFree(it.second));
+      }
+    }
+  }
+  input_staging_slots_.clear();
+  // requests taken from the data inputer but not run yet, their callers are still waiting for a result
+  for (const auto &staged : staged_inputs_) {
+    GELOGW("Input data %u staged but not run, model id:%u.", staged.data_wrapper->GetInput().index, model_id_);
+    (void)ReturnResult(staged.data_wrapper->GetInput().index, false, false, staged.data_wrapper->GetOutput());
+  }
+  staged_inputs_.clear();
+  input_staging_depth_ = 0;
+}
+
+Status DavinciModel::StageInputData(const std::shared_ptr<InputDataWrapper> &data_wrapper) {
+  size_t slot = next_staging_slot_;
+  next_staging_slot_ = (slot + 1) % input_staging_slots_.size();
+  Status ret = CopyInputData(data_wrapper->GetInput(), &input_staging_slots_[slot]);
+  if (ret != SUCCESS) {
+    GELOGE(ret, "[Stage][InputData] failed, data index:%u, model_id:%u", data_wrapper->GetInput().index, model_id_);
+  }
+  staged_inputs_.push_back({data_wrapper, slot, ret});
+  return ret;
+}
+
+Status DavinciModel::PopInputData(std::shared_ptr<InputDataWrapper> &data_wrapper, Status &staged_ret) {
+  staged_ret = SUCCESS;
+  if (input_staging_depth_ == 0) {
+    return data_inputer_->Pop(data_wrapper);
+  }
+  if (staged_inputs_.empty()) {
+    Status ret = data_inputer_->Pop(data_wrapper);
+    if (ret != SUCCESS || data_wrapper == nullptr) {
+      return ret;
+    }
+    (void)StageInputData(data_wrapper);
+  }
+  const StagedInput &staged = staged_inputs_.front();
+  data_wrapper = staged.data_wrapper;
+  staged_ret = staged.status;
+  cur_staging_slot_ = staged.slot;
+  staged_inputs_.pop_front();
+  return SUCCESS;
+}
+
+void DavinciModel::StageNextInputData() {
+  // the slot of the running request stays busy until the model stream is synchronized
+  while (staged_inputs_.size() + 1 < input_staging_slots_.size()) {
+    std::shared_ptr<InputDataWrapper> data_wrapper;
+    if (!data_inputer_->TryPop(data_wrapper) || data_wrapper == nullptr) {
+      break;
+    }
+    (void)StageInputData(data_wrapper);
+  }
+}
+
+Status DavinciModel::CopyStagedInputData(const InputData &input_data) {
+  const map<uint32_t, void *> &slot = input_staging_slots_[cur_staging_slot_];
+  for (const auto &data : input_data_info_) {
+    if (data.first >= input_data.blobs.size()) {
+      continue;
+    }
+    uint64_t data_buf_length = input_data.blobs[data.first].length;
+    auto it = slot.find(data.first);
+    if (data_buf_length == 0 || it == slot.end()) {
+      continue;
+    }
+    GE_CHK_RT_RET(rtMemcpyAsync(data.second.GetBasicAddr(), data.second.GetDataSize(), it->second, data_buf_length,
+                                RT_MEMCPY_DEVICE_TO_DEVICE, rt_model_stream_));
+  }
+  return SUCCESS;
+}
+
 Status DavinciModel::SyncVarData() {
   GELOGI("Sync var data, model id:%u", model_id_);
 
@@ -2843,7 +2981,8 @@ void *DavinciModel::Run(DavinciModel *model) {
     }
 
     std::shared_ptr<InputDataWrapper> data_wrapper;
-    Status ret = model->GetDataInputer()->Pop(data_wrapper);
+    Status staged_ret = SUCCESS;
+    Status ret = model->PopInputData(data_wrapper, staged_ret);
     // Model run indeedly start after received data.
     model->SetRunningFlag(true);
     if (data_wrapper == nullptr || ret != SUCCESS) {
@@ -2866,7 +3005,12 @@ void *DavinciModel::Run(DavinciModel *model) {
     GELOGI("Copy input data, model id:%u", model_id);
     GE_IF_BOOL_EXEC(ProfilingManager::Instance().ProfilingModelExecuteOn(),
                     model->SetProfileTime(MODEL_PRE_PROC_START));
-    ret = model->CopyInputData(current_data);
+    if (model->input_staging_depth_ > 0) {
+      // inputs were copied to the staging slot while the previous request ran
+      ret = (staged_ret != SUCCESS) ? staged_ret : model->CopyStagedInputData(current_data);
+    } else {
+      ret = model->CopyInputData(current_data);
+    }
     GE_CHK_BOOL_TRUE_EXEC_WITH_LOG(
         ret != SUCCESS, (void)model->ReturnResult(current_data.index, false, false, data_wrapper->GetOutput());
         continue,
@@ -2893,6 +3037,8 @@ void *DavinciModel::Run(DavinciModel *model) {
                     continue);
     GELOGI("rtModelExecute end");
     GE_IF_BOOL_EXEC(model->is_first_execute_, GE_TIMESTAMP_EVENT_END(rtModelExecute, "GraphExcute::rtModelExecute"));
+    // overlap host to device copies of queued requests with this execution
+    GE_IF_BOOL_EXEC(model->input_staging_depth_ > 0, model->StageNextInputData());
 
     GE_TIMESTAMP_START(rtStreamSynchronize);
     GELOGI("rtStreamSynchronize start.");
@@ -2957,6 +3103,7 @@ Status DavinciModel::DestroyThread() {
     thread_id_.join();
   }
 
+  FreeInputStaging();
   return SUCCESS;
 }
 
@@ -2977,6 +3124,8 @@ Status DavinciModel::ModelRunStart() {
 
   GE_CHK_BOOL_RET_STATUS(!run_flg_, INTERNAL_ERROR, "[Check][Param] Model already started, model id:%u.", model_id_);
 
+  // before the run flag, so a failed start can be retried
+  GE_CHK_STATUS_RET(InitInputStaging(), "[Init][InputStaging] failed, model id:%u.", model_id_);
   run_flg_ = true;
 
   // create stream instance which rt_model_handel is running on
@@ -3508,6 +3657,7 @@ bool DavinciModel::CheckUserAndModelSize(const int64_t &size, const int64_t &op_
 /// @return SUCCESS handle successfully / PARAM_INVALID for failed
 ///
 Status DavinciModel::CopyModelData(const InputData &input_data, OutputData &output_data, bool is_dynamic) {
+  uint64_t patch_start = GetCurrentTimestamp();
   if (UpdateIoTaskArgs(input_data_info_, true, input_data.blobs, is_dynamic, input_data.batch_label) != SUCCESS) {
     GELOGE(ACL_ERROR_GE_PARAM_INVALID, "[Call][UpdateIoTaskArgs] [ZCPY] Update input data to model:%u failed.",
            model_id_);
@@ -3520,6 +3670,11 @@ Status DavinciModel::CopyModelData(const InputData &input_data, OutputData &outp
            model_id_);
     return ACL_ERROR_GE_PARAM_INVALID;
   }
+  last_zero_copy_patch_time_ = GetCurrentTimestamp() - patch_start;
+  total_zero_copy_patch_time_ += last_zero_copy_patch_time_;
+  ++zero_copy_patch_count_;
+  GELOGD("[ZCPY] Patch args of data index:%u cost %lu us, avg %lu us, model_id:%u.", input_data.index,
+         last_zero_copy_patch_time_, GetAvgZeroCopyPatchTime(), model_id_);
 
   for (ZeroCopyTask &task : zero_copy_tasks_) {
     GE_CHK_STATUS_RET(task.DistributeParam(is_async_mode_, rt_model_stream_),
@@ -3552,6 +3707,10 @@ Status DavinciModel::UpdateIoTaskArgs(const std::map<uint32_t, ZeroCopyOffset> &
     return ACL_ERROR_GE_PARAM_INVALID;
   }
 
+  if (!zero_copy_patch_table_ready_) {
+    InitZeroCopyPatchTable();
+  }
+  const ZeroCopyPatchTable &patch_table = is_input ? input_patch_table_ : output_patch_table_;
   for (const auto &data : data_info) {
     if (data.first >= blobs.size()) {  // check data index.
       REPORT_INNER_ERROR("E19999", "is_input:%d, data index:%u from model >= blobs.size:%zu from user, mode_id:%u"
@@ -3593,26 +3752,70 @@ Status DavinciModel::UpdateIoTaskArgs(const std::map<uint32_t, ZeroCopyOffset> &
       continue;
     }
 
+    GELOGD("[ZCPY] Copy %s blobs_index %u, user_data_addr: %p, batch_label: %s", is_input ? "input" : "output",
+           data.first, buffer.data, batch_label.c_str());
+    // For input data, just copy for rts task.
+    auto it = patch_table.find(data.first);
+    if (it != patch_table.end()) {
+      PatchZeroCopyArgs(it->second, batch_label, buffer);
+    }
+  }
+
+  return SUCCESS;
+}
+
+void DavinciModel::PatchZeroCopyArgs(const map<string, vector<ZeroCopyPatch>> &label_patches,
+                                     const string &batch_label, const DataBuffer &buffer) {
+  // tasks without batch label are shared by all batches
+  for (const auto &label_patch : label_patches) {
+    if (label_patch.first != kDefaultBatchLable && label_patch.first != batch_label) {
+      continue;
+    }
+    for (const auto &patch : label_patch.second) {
+      void *buffer_addr = reinterpret_cast<void *>(reinterpret_cast<uintptr_t>(buffer.data) + patch.relative_offset);
+      zero_copy_tasks_[patch.task_index].PatchTaskParam(patch.args_offset, buffer_addr);
+    }
+  }
+}
+
+///
+/// @ingroup ge
+/// @brief Index the task args fed by each input/output, so a request only patches the args it owns.
+/// @return None.
+///
+void DavinciModel::InitZeroCopyPatchTable() {
+  std::lock_guard<std::mutex> lock(outside_addrs_mutex_);
+  InitZeroCopyPatchTable(input_data_info_, input_patch_table_);
+  InitZeroCopyPatchTable(output_data_info_, output_patch_table_);
+  zero_copy_patch_table_ready_ = true;
+}
+
+void DavinciModel::InitZeroCopyPatchTable(const map<uint32_t, ZeroCopyOffset> &data_info,
+                                          ZeroCopyPatchTable &patch_table) {
+  patch_table.clear();
+  size_t patch_num = 0;
+  for (const auto &data : data_info) {
+    auto &label_patches = patch_table[data.first];
     for (size_t count = 0; count < data.second.GetDataCount(); ++count) {
-      void *addr = data.second.GetDataInfo().at(count).second;
-      void *buffer_addr = reinterpret_cast<void *>(reinterpret_cast<uintptr_t>(buffer.data) +
-                                                   data.second.GetRelativeOffset().at(count));
-      GELOGI("[ZCPY] Copy %s blobs_index %u, virtual_addr: %p, size: %ld, user_data_addr: %p, batch_label: %s",
-             is_input ? "input" : "output", data.first, addr, data.second.GetDataInfo().at(count).first,
-             buffer_addr, batch_label.c_str());
-      // For input data, just copy for rts task.
-      for (auto &task : zero_copy_tasks_) {
-        bool not_same_batch = (task.GetBatchLabel() != kDefaultBatchLable && task.GetBatchLabel() != batch_label);
-        if (not_same_batch) {
+      uintptr_t addr_val = reinterpret_cast<uintptr_t>(data.second.GetDataInfo().at(count).second);
+      int64_t relative_offset = data.second.GetRelativeOffset().at(count);
+      for (size_t task_index = 0; task_index < zero_copy_tasks_.size(); ++task_index) {
+        const ZeroCopyTask &task = zero_copy_tasks_[task_index];
+        const auto &task_addr_offset = task.GetTaskArgsOffset();
+        auto it = task_addr_offset.find(addr_val);
+        if (it == task_addr_offset.end()) {
           continue;
         }
-        uintptr_t addr_val = reinterpret_cast<uintptr_t>(addr);
-        (void)task.UpdateTaskParam(addr_val, buffer_addr);
+        auto &patches = label_patches[task.GetBatchLabel()];
+        for (size_t args_offset : it->second) {
+          patches.push_back({task_index, args_offset, relative_offset});
+          ++patch_num;
+        }
       }
     }
   }
-
-  return SUCCESS;
+  GELOGI("[ZCPY] Init zero copy patch table, data num:%zu, task num:%zu, patch num:%zu, model_id:%u.",
+         data_info.size(), zero_copy_tasks_.size(), patch_num, model_id_);
 }
 
 ///
@@ -3790,7 +3993,7 @@ Status DavinciModel::FunctionRegister(const OpDescPtr &op_desc, string &bin_file
   }
 
   TBEHandleStore &kernel_store = TBEHandleStore::GetInstance();
-  std::lock_guard<std::mutex> lock(tvm_bin_mutex_);
+  std::lock_guard<std::mutex> lock(kernel_store.GetRegisterMutex());
   if (rtQueryFunctionRegistered(bin_file_key) != RT_ERROR_NONE) {
     void *bin_handle = nullptr;
     if (!kernel_store.FindTBEHandle(bin_file_key, bin_handle)) {
@@ -4239,7 +4442,12 @@ Status DavinciModel::MallocExMem() {
     auto mem_type = it.first & kMemoryTypeMask;
     uint8_t *mem_base = nullptr;
     const string purpose("p2p memory, used for some op related to hcom or session scope memory");
-    if (sessoion_scope) {
+    if ((kHostSwapMemory & it.first) == kHostSwapMemory) {
+      // pinned for the async copies of the offloaded feature map
+      void *host_mem = nullptr;
+      rtError_t rt_ret = rtMallocHost(&host_mem, mem_size);
+      mem_base = (rt_ret == RT_ERROR_NONE) ? static_cast<uint8_t *>(host_mem) : nullptr;
+    } else if (sessoion_scope) {
       mem_base = MemManager::Instance().SessionScopeMemInstance(mem_type).Malloc(mem_size, runtime_param_.session_id);
     } else if (res_static_memory == EN_OK) {
       string memory_key = std::to_string(0) + it.second.memory_key;
@@ -4306,6 +4514,12 @@ void DavinciModel::FreeExMem() {
     if ((kSessionScopeMemory & it.first) == kSessionScopeMemory) {
       continue;
     }
+    if ((kHostSwapMemory & it.first) == kHostSwapMemory) {
+      GE_IF_BOOL_EXEC(it.second.memory_base != nullptr,
+                      GE_CHK_RT(rtFreeHost(it.second.memory_base));
+                      it.second.memory_base = nullptr);
+      continue;
+    }
     auto mem_type = it.first & kMemoryTypeMask;
     if (res_static_memory == EN_OK) {
       std::string memory_key = std::to_string(0) + it.second.memory_key;
@@ -4324,7 +4538,24 @@ void DavinciModel::FreeExMem() {
   }
 }
 
+bool DavinciModel::IsWeightsShared() const {
+  // static memory keeps the weights of all models at the same key
+  char ge_static_mem_env[MMPA_MAX_PATH] = {0x00};
+  if (mmGetEnv(kEnvGeuseStaticMemory, ge_static_mem_env, MMPA_MAX_PATH) == EN_OK) {
+    return false;
+  }
+  std::string share_weights;
+  (void)ge::GetContext().GetOption(OPTION_EXEC_SHARE_MODEL_WEIGHTS, share_weights);  // not shared by default
+  return share_weights == "1";
+}
+
 void DavinciModel::FreeWeightsMem() {
+  if (!shared_weights_key_.empty()) {
+    ModelManager::GetInstance()->ReleaseSharedWeights(shared_weights_key_);
+    shared_weights_key_.clear();
+    weights_mem_base_ = nullptr;
+    return;
+  }
   char ge_static_mem_env[MMPA_MAX_PATH] = {0x00};
   INT32 res = mmGetEnv(kEnvGeuseStaticMemory, ge_static_mem_env, MMPA_MAX_PATH);
   if (res == EN_OK) {
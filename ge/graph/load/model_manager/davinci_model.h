@@ -18,6 +18,7 @@
 #ifndef GE_GRAPH_LOAD_NEW_MODEL_MANAGER_DAVINCI_MODEL_H_
 #define GE_GRAPH_LOAD_NEW_MODEL_MANAGER_DAVINCI_MODEL_H_
 
+#include <deque>
 #include <map>
 #include <memory>
 #include <set>
@@ -228,6 +229,16 @@ class DavinciModel {
     return data_inputer_->Size();
   }
 
+  ///
+  /// @ingroup ge
+  /// @brief get time of patching zero copy task args for user inputs/outputs
+  /// @return time of the last request and average of all requests, in us
+  ///
+  uint64_t GetLastZeroCopyPatchTime() const { return last_zero_copy_patch_time_; }
+  uint64_t GetAvgZeroCopyPatchTime() const {
+    return (zero_copy_patch_count_ == 0) ? 0 : (total_zero_copy_patch_time_ / zero_copy_patch_count_);
+  }
+
   // get Stream number
   uint32_t StreamNum() const { return runtime_param_.stream_num; }
 
@@ -596,6 +607,8 @@ class DavinciModel {
   uint8_t *mem_base_;
   bool is_inner_mem_base_;
   bool is_inner_weight_base_;
+  // key of the weights shared with other instances of the model, empty if not shared
+  std::string shared_weights_key_;
   // input data manager
   DataInputer *data_inputer_;
   int64_t load_begin_time_;
@@ -632,6 +645,24 @@ class DavinciModel {
   ///
   Status CopyModelData(const InputData &input_data, OutputData &output_data, bool is_dynamic);
 
+  struct ZeroCopyPatch {
+    size_t task_index;        // index in zero_copy_tasks_
+    size_t args_offset;       // offset in task args
+    int64_t relative_offset;  // offset in user data buffer
+  };
+  // data index -> { batch label of task -> args to patch }
+  using ZeroCopyPatchTable = map<uint32_t, map<string, vector<ZeroCopyPatch>>>;
+
+  ///
+  /// @ingroup ge
+  /// @brief Index the task args fed by each input/output, so a request only patches the args it owns.
+  /// @return None.
+  ///
+  void InitZeroCopyPatchTable();
+  void InitZeroCopyPatchTable(const map<uint32_t, ZeroCopyOffset> &data_info, ZeroCopyPatchTable &patch_table);
+  void PatchZeroCopyArgs(const map<string, vector<ZeroCopyPatch>> &label_patches, const string &batch_label,
+                         const DataBuffer &buffer);
+
   ///
   /// @ingroup ge
   /// @brief Copy Data addr to model for direct use.
@@ -645,7 +676,19 @@ class DavinciModel {
   Status UpdateIoTaskArgs(const map<uint32_t, ZeroCopyOffset> &data_info, bool is_input,
                           const vector<DataBuffer> &blobs, bool is_dynamic, const string &batch_label);
 
-  Status CopyInputData(const InputData &input_data);
+  Status CopyInputData(const InputData &input_data, const map<uint32_t, void *> *staging_slot = nullptr);
+
+  ///
+  /// @ingroup ge
+  /// @brief Input staging: copy inputs of queued requests into spare device slots while the model runs,
+  ///        then move them into the model input memory on the model stream.
+  ///
+  Status InitInputStaging();
+  void FreeInputStaging();
+  Status PopInputData(std::shared_ptr<InputDataWrapper> &data_wrapper, Status &staged_ret);
+  Status StageInputData(const std::shared_ptr<InputDataWrapper> &data_wrapper);
+  void StageNextInputData();
+  Status CopyStagedInputData(const InputData &input_data);
 
   Status CopyOutputData(uint32_t data_id, OutputData &output_data, rtMemcpyKind_t kind);
 
@@ -674,6 +717,8 @@ class DavinciModel {
 
   uint8_t *MallocWeightsMem(size_t weights_size);
 
+  bool IsWeightsShared() const;
+
   Status MallocExMem();
 
   void FreeFeatureMapMem();
@@ -982,6 +1027,13 @@ class DavinciModel {
   mutex outside_addrs_mutex_;
   vector<ZeroCopyTask> zero_copy_tasks_;  // Task used Data or NetOutput addr.
   set<const void *> copy_only_addrs_;     // Address need copy to original place.
+  ZeroCopyPatchTable input_patch_table_;
+  ZeroCopyPatchTable output_patch_table_;
+  bool zero_copy_patch_table_ready_ = false;
+  // time of patching zero copy args, in us
+  uint64_t last_zero_copy_patch_time_ = 0;
+  uint64_t total_zero_copy_patch_time_ = 0;
+  uint64_t zero_copy_patch_count_ = 0;
 
   vector<TaskInfoPtr> task_list_;
   // rt_moodel_handle
@@ -1021,7 +1073,6 @@ class DavinciModel {
   set<uint32_t> hcom_streams_;
   RuntimeParam runtime_param_;
 
-  static mutex tvm_bin_mutex_;
   set<string> tvm_bin_kernel_;
 
   map<string, uint32_t> used_tbe_handle_map_;
@@ -1068,6 +1119,19 @@ class DavinciModel {
   map<string, int64_t> tensor_name_to_peer_output_index_;
   // if model is first execute
   bool is_first_execute_;
+
+  struct StagedInput {
+    std::shared_ptr<InputDataWrapper> data_wrapper;
+    size_t slot;
+    Status status;
+  };
+  // number of input staging slots, staging is off when less than 2
+  uint32_t input_staging_depth_ = 0;
+  // slot -> { input index -> staging device memory }
+  vector<map<uint32_t, void *>> input_staging_slots_;
+  std::deque<StagedInput> staged_inputs_;
+  size_t next_staging_slot_ = 0;
+  size_t cur_staging_slot_ = 0;
   // for op debug
   mutex debug_reg_mutex_;
   bool is_op_debug_reg_ = false;
@@ -17,6 +17,8 @@
 
 #include "graph/load/model_manager/model_manager.h"
 
+#include <algorithm>
+#include <cstring>
 #include <string>
 
 #include "aicpu/aicpu_schedule/aicpu_op_type_list.h"
@@ -28,6 +30,7 @@
 #include "graph/load/model_manager/davinci_model.h"
 #include "common/model/ge_root_model.h"
 #include "common/formats/utils/formats_trans_utils.h"
+#include "graph/manager/graph_mem_manager.h"
 
 namespace ge {
 thread_local uint32_t device_count = 0;
@@ -49,6 +52,33 @@ const int kTimeSpecNano = 1000000000;
 const int kTimeSpecMiro = 1000000;
 const int kOpNameMaxSize = 100;
 const uint64_t kInferSessionId = 0;
+const int kDecimal = 10;
+const int64_t kMaxModelLoadThreadNum = 32;
+const uint64_t kFnvOffsetBasis = 14695981039346656037ULL;
+const uint64_t kFnvPrime = 1099511628211ULL;
+const uint64_t kMixMultiplier = 0x9E3779B97F4A7C15ULL;
+const uint32_t kMixShift = 29U;
+// weights on the device are read back by chunks of this size to be compared
+const size_t kWeightsCompareChunkSize = 4U * 1024U * 1024U;
+
+/// 128-bit hash of the weights, words are hashed instead of bytes as weights may be gigabytes
+std::string HashWeights(const uint8_t *data, size_t size) {
+  uint64_t high = kFnvOffsetBasis;
+  uint64_t low = kMixMultiplier;
+  size_t i = 0U;
+  for (; (i + sizeof(uint64_t)) <= size; i += sizeof(uint64_t)) {
+    uint64_t word = 0U;
+    (void)memcpy(&word, data + i, sizeof(uint64_t));
+    high = (high ^ word) * kFnvPrime;
+    low = ((low + word) * kMixMultiplier) ^ (low >> kMixShift);
+  }
+  for (; i < size; ++i) {
+    high = (high ^ data[i]) * kFnvPrime;
+    low = ((low + data[i]) * kMixMultiplier) ^ (low >> kMixShift);
+  }
+  return std::to_string(high) + "_" + std::to_string(low);
+}
+
 #pragma pack(push, 1)
 struct CustAicpuSoBuf {
   uint64_t kernelSoBuf;
@@ -1142,6 +1172,11 @@ Status ModelManager::LoadModelOffline(uint32_t &model_id, const ModelData &model
   mmTimespec timespec = mmGetTickCount();
 
   ModelHelper model_helper;
+  string load_thread_num = "0";
+  (void)GetContext().GetOption(OPTION_EXEC_MODEL_LOAD_THREAD_NUM, load_thread_num);  // option may not be set up
+  int64_t thread_num = std::strtol(load_thread_num.c_str(), nullptr, kDecimal);
+  thread_num = std::max<int64_t>(0, std::min(thread_num, kMaxModelLoadThreadNum));
+  model_helper.SetLoadThreadNum(static_cast<uint32_t>(thread_num));
   Status ret = model_helper.LoadRootModel(model);
   if (ret != SUCCESS) {
     GELOGE(ret, "[Load][RootModel] failed, ret:%d, model_id:%u.", ret, model_id);
@@ -1348,6 +1383,111 @@ Status ModelManager::CreateAicpuSession(uint64_t session_id) {
   return SUCCESS;
 }
 
+Status ModelManager::AcquireSharedWeights(uint32_t device_id, const Buffer &weights, std::string &weights_key,
+                                          uint8_t *&weights_addr) {
+  const size_t weights_size = weights.GetSize();
+  const std::string key = std::to_string(device_id) + "_" + std::to_string(weights_size) + "_" +
+                          HashWeights(weights.GetData(), weights_size);
+  weights_key.clear();
+  weights_addr = nullptr;
+  {
+    std::lock_guard<std::mutex> lock(shared_weights_mutex_);
+    auto iter = shared_weights_.find(key);
+    if ((iter != shared_weights_.end()) && !IsSameWeights(iter->second, weights)) {
+      GELOGW("Weights of size %zu collide with shared weights of key %s, upload them for the model only.",
+             weights_size, key.c_str());
+      return SUCCESS;
+    }
+    if (iter != shared_weights_.end()) {
+      iter->second.ref_count++;
+      weights_key = key;
+      weights_addr = iter->second.addr;
+      GELOGI("Share weights of key %s, addr[%p], size[%zu], ref count %u.", key.c_str(), weights_addr, weights_size,
+             iter->second.ref_count);
+      return SUCCESS;
+    }
+  }
+
+  // upload without the lock, so models of different weights are loaded at the same time
+  uint8_t *addr = MemManager::Instance().MemInstance(RT_MEMORY_HBM).MallocMemory("shared weights memory",
+                                                                                 weights_size, device_id);
+  if (addr == nullptr) {
+    REPORT_CALL_ERROR("E19999", "Malloc shared weights memory fail, size:%zu, device_id:%u", weights_size, device_id);
+    GELOGE(ACL_ERROR_GE_MEMORY_ALLOCATION, "[Alloc][Memory] for shared weights failed, size:%zu, device_id:%u",
+           weights_size, device_id);
+    return ACL_ERROR_GE_MEMORY_ALLOCATION;
+  }
+  rtError_t rt_ret = rtMemcpy(addr, weights_size, weights.GetData(), weights_size, RT_MEMCPY_HOST_TO_DEVICE);
+  if (rt_ret != RT_ERROR_NONE) {
+    REPORT_CALL_ERROR("E19999", "Call rtMemcpy failed, size:%zu, ret:0x%X", weights_size, rt_ret);
+    GELOGE(RT_FAILED, "[Call][RtMemcpy] of shared weights failed, size:%zu, ret:0x%X", weights_size, rt_ret);
+    (void)MemManager::Instance().MemInstance(RT_MEMORY_HBM).FreeMemory(addr, device_id);
+    return RT_ERROR_TO_GE_STATUS(rt_ret);
+  }
+
+  std::lock_guard<std::mutex> lock(shared_weights_mutex_);
+  auto &shared_weights = shared_weights_[key];
+  if (shared_weights.addr == nullptr) {
+    shared_weights.addr = addr;
+    shared_weights.device_id = device_id;
+    shared_weights.size = weights_size;
+    GELOGI("[IMAS]Shared weights of key %s MallocMemory type[W] memaddr[%p] mem_size[%zu]", key.c_str(), addr,
+           weights_size);
+  } else if (IsSameWeights(shared_weights, weights)) {
+    // uploaded by another model meanwhile
+    (void)MemManager::Instance().MemInstance(RT_MEMORY_HBM).FreeMemory(addr, device_id);
+  } else {
+    // a collision registered meanwhile, the upload is kept for the model only
+    GELOGW("Weights of size %zu collide with shared weights of key %s, upload them for the model only.",
+           weights_size, key.c_str());
+    (void)MemManager::Instance().MemInstance(RT_MEMORY_HBM).FreeMemory(addr, device_id);
+    return SUCCESS;
+  }
+  shared_weights.ref_count++;
+  weights_key = key;
+  weights_addr = shared_weights.addr;
+  return SUCCESS;
+}
+
+bool ModelManager::IsSameWeights(const SharedWeights &shared_weights, const Buffer &weights) {
+  // the hash only picks the candidate, the content on the device decides, no host copy is kept for it
+  if (shared_weights.size != weights.GetSize()) {
+    return false;
+  }
+  std::vector<uint8_t> chunk(std::min(weights.GetSize(), kWeightsCompareChunkSize));
+  for (size_t offset = 0U; offset < weights.GetSize(); offset += chunk.size()) {
+    const size_t chunk_size = std::min(chunk.size(), weights.GetSize() - offset);
+    rtError_t rt_ret = rtMemcpy(chunk.data(), chunk_size, shared_weights.addr + offset, chunk_size,
+                                RT_MEMCPY_DEVICE_TO_HOST);
+    if (rt_ret != RT_ERROR_NONE) {
+      GELOGW("Read shared weights back failed, offset:%zu, size:%zu, ret:0x%X.", offset, chunk_size, rt_ret);
+      return false;
+    }
+    if (memcmp(chunk.data(), weights.GetData() + offset, chunk_size) != 0) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void ModelManager::ReleaseSharedWeights(const std::string &weights_key) {
+  std::lock_guard<std::mutex> lock(shared_weights_mutex_);
+  auto iter = shared_weights_.find(weights_key);
+  if (iter == shared_weights_.end()) {
+    GELOGW("Shared weights of key %s not found.", weights_key.c_str());
+    return;
+  }
+  if (--iter->second.ref_count > 0U) {
+    GELOGD("Release shared weights of key %s, ref count %u.", weights_key.c_str(), iter->second.ref_count);
+    return;
+  }
+  GE_CHK_STATUS(MemManager::Instance().MemInstance(RT_MEMORY_HBM).FreeMemory(iter->second.addr,
+                                                                             iter->second.device_id),
+                "failed to free shared weights memory");
+  GELOGI("Free shared weights of key %s.", weights_key.c_str());
+  (void)shared_weights_.erase(iter);
+}
+
 Status ModelManager::LoadCustAicpuSo(const OpDescPtr &op_desc, const string &so_name, bool &loaded) {
   GELOGD("LoadCustAicpuSo in, op name %s, so name %s", op_desc->GetName().c_str(), so_name.c_str());
   std::lock_guard<std::mutex> lock(cust_aicpu_mutex_);
@@ -277,6 +277,26 @@ class FMK_FUNC_HOST_VISIBILITY FMK_FUNC_DEV_VISIBILITY ModelManager {
 
   ge::Status DestroyAicpuSessionForInfer(uint32_t model_id);
 
+  ///
+  /// @ingroup domi_ome
+  /// @brief get the device weights of the same content on the device, malloc and upload them if none.
+  ///        The weights are shared by the instances of a model and must not be written.
+  /// @param [in] device_id device of the model
+  /// @param [in] weights host weights of the model
+  /// @param [out] weights_key key to release the weights, empty if the weights can not be shared
+  /// @param [out] weights_addr device weights, nullptr if the weights can not be shared
+  /// @return Status run result
+  ///
+  ge::Status AcquireSharedWeights(uint32_t device_id, const Buffer &weights, std::string &weights_key,
+                                  uint8_t *&weights_addr);
+
+  ///
+  /// @ingroup domi_ome
+  /// @brief release the device weights acquired, they are freed when no model uses them
+  /// @param [in] weights_key key returned by AcquireSharedWeights
+  ///
+  void ReleaseSharedWeights(const std::string &weights_key);
+
   ge::Status LoadCustAicpuSo(const OpDescPtr &op_desc, const string &so_name, bool &loaded);
 
   ge::Status LaunchCustAicpuSo();
@@ -358,6 +378,16 @@ class FMK_FUNC_HOST_VISIBILITY FMK_FUNC_DEV_VISIBILITY ModelManager {
   std::vector<rtExceptionInfo> exception_infos_;
   std::mutex cust_aicpu_mutex_;
   std::map<uintptr_t, std::map<std::string, CustAICPUKernelPtr>> cust_aicpu_so_;
+  struct SharedWeights {
+    uint8_t *addr = nullptr;
+    uint32_t device_id = 0U;
+    uint32_t ref_count = 0U;
+    size_t size = 0U;
+  };
+  static bool IsSameWeights(const SharedWeights &shared_weights, const Buffer &weights);
+  std::mutex shared_weights_mutex_;
+  // keyed by the device, the size and the content hash of the weights
+  std::map<std::string, SharedWeights> shared_weights_;
 
   static DumpProperties dump_properties_;
   bool dump_exception_flag_ = false;
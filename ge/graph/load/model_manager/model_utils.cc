@@ -385,6 +385,12 @@ vector<void *> ModelUtils::GetInputDataAddrs(const RuntimeParam &model_param, Co
       GELOGI("[IMAS]GetInputDataAddrs graph_%u type[P] name[%s] input[%zu] memaddr[%p]", model_param.graph_id,
              op_desc->GetName().c_str(), i, p2p_mem_addr);
       continue;
+    } else if (tensor_has_mem_type && IsHostSwapMemory(mem_type)) {
+      uint8_t *host_mem_addr = model_param.memory_infos.at(kHostSwapMemory | RT_MEMORY_HBM).memory_base + input_offset;
+      v_input_data_addr.push_back(host_mem_addr);
+      GELOGI("[IMAS]GetInputDataAddrs graph_%u type[H] name[%s] input[%zu] memaddr[%p]", model_param.graph_id,
+             op_desc->GetName().c_str(), i, host_mem_addr);
+      continue;
     } else {
       // The input size and peer output size may be not consecutive, therefore, the tensor_size is not been checked.
       VALIDATE_MEM_RANGE(op_desc, model_param.mem_size, input_offset, static_cast<int64_t>(0));
@@ -500,6 +506,13 @@ vector<void *> ModelUtils::GetOutputDataAddrs(const RuntimeParam &model_param, C
       GELOGI("[IMAS]GetOutputDataAddrs graph_%u type[P] name[%s] output[%zu] memaddr[%p]", model_param.graph_id,
              op_desc->GetName().c_str(), i, p2p_mem_addr);
       continue;
+    } else if (tensor_has_mem_type && IsHostSwapMemory(mem_type)) {
+      uint8_t *host_mem_addr =
+          model_param.memory_infos.at(kHostSwapMemory | RT_MEMORY_HBM).memory_base + v_output_offset[i];
+      v_output_data_addr.push_back(host_mem_addr);
+      GELOGI("[IMAS]GetOutputDataAddrs graph_%u type[H] name[%s] output[%zu] memaddr[%p]", model_param.graph_id,
+             op_desc->GetName().c_str(), i, host_mem_addr);
+      continue;
     } else {
       VALIDATE_MEM_RANGE(op_desc, model_param.mem_size, v_output_offset[i], tensor_size);
       mem_addr = static_cast<uint8_t *>(model_param.mem_base + v_output_offset[i]);
@@ -511,6 +524,15 @@ vector<void *> ModelUtils::GetOutputDataAddrs(const RuntimeParam &model_param, C
   return v_output_data_addr;
 }
 
+///
+/// @ingroup ge
+/// @brief Check if memory type is of the host swap memory of offloaded feature map.
+/// @return bool
+///
+bool ModelUtils::IsHostSwapMemory(int64_t memory_type) {
+  return (static_cast<uint64_t>(memory_type) & kHostSwapMemory) == kHostSwapMemory;
+}
+
 ///
 /// @ingroup ge
 /// @brief Get workspace data address.
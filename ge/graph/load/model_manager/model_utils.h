@@ -109,6 +109,13 @@ class ModelUtils {
   ///
   static Status GetRtAddress(const RuntimeParam &model_param, uintptr_t logic_addr, uint8_t *&mem_addr);
 
+  ///
+  /// @ingroup ge
+  /// @brief Check if memory type is of the host swap memory of offloaded feature map.
+  /// @return bool
+  ///
+  static bool IsHostSwapMemory(int64_t memory_type);
+
  private:
   ///
   /// @ingroup ge
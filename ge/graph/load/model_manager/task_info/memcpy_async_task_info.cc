@@ -53,6 +53,17 @@ Status MemcpyAsyncTaskInfo::Init(const domi::TaskDef &task_def, DavinciModel *da
     return SUCCESS;
   }
 
+  // copies of offloaded feature map, between the feature map and the host swap memory
+  vector<int64_t> input_memory_types;
+  vector<int64_t> output_memory_types;
+  (void)AttrUtils::GetListInt(op_desc, ATTR_NAME_INPUT_MEM_TYPE_LIST, input_memory_types);
+  (void)AttrUtils::GetListInt(op_desc, ATTR_NAME_OUTPUT_MEM_TYPE_LIST, output_memory_types);
+  bool swap_out = !output_memory_types.empty() && ModelUtils::IsHostSwapMemory(output_memory_types[0]);
+  bool swap_in = !input_memory_types.empty() && ModelUtils::IsHostSwapMemory(input_memory_types[0]);
+  if (swap_out || swap_in) {
+    return InitHostSwap(op_desc, swap_out);
+  }
+
   const RuntimeParam &rts_param = davinci_model_->GetRuntimeParam();
   ret = ModelUtils::GetRtAddress(rts_param, memcpy_async.src(), src_);
   if (ret != SUCCESS) {
@@ -83,6 +94,28 @@ Status MemcpyAsyncTaskInfo::Init(const domi::TaskDef &task_def, DavinciModel *da
   return SUCCESS;
 }
 
+Status MemcpyAsyncTaskInfo::InitHostSwap(const OpDescPtr &op_desc, bool swap_out) {
+  const RuntimeParam &rts_param = davinci_model_->GetRuntimeParam();
+  vector<void *> input_addrs = ModelUtils::GetInputDataAddrs(rts_param, op_desc);
+  vector<void *> output_addrs = ModelUtils::GetOutputDataAddrs(rts_param, op_desc);
+  if (input_addrs.empty() || output_addrs.empty()) {
+    REPORT_INNER_ERROR("E19999", "Get addresses of op:%s failed, input size:%zu, output size:%zu",
+                       op_desc->GetName().c_str(), input_addrs.size(), output_addrs.size());
+    GELOGE(INTERNAL_ERROR, "[Get][Addrs] of op:%s failed, input size:%zu, output size:%zu",
+           op_desc->GetName().c_str(), input_addrs.size(), output_addrs.size());
+    return INTERNAL_ERROR;
+  }
+  src_ = static_cast<uint8_t *>(input_addrs[0]);
+  dst_ = static_cast<uint8_t *>(output_addrs[0]);
+  kind_ = swap_out ? RT_MEMCPY_DEVICE_TO_HOST : RT_MEMCPY_HOST_TO_DEVICE;
+  davinci_model_->DisableZeroCopy(src_);
+  davinci_model_->DisableZeroCopy(dst_);
+  io_addrs_ = {src_, dst_};
+  GELOGI("MemcpyAsyncTaskInfo Init Success, op:%s swapped %s, src:%p, dst:%p, max:%lu, count:%lu",
+         op_desc->GetName().c_str(), swap_out ? "out" : "in", src_, dst_, dst_max_, count_);
+  return SUCCESS;
+}
+
 Status MemcpyAsyncTaskInfo::Distribute() {
   GELOGI("MemcpyAsyncTaskInfo Distribute Start. dst_max:%lu, count:%lu, kind:%u", dst_max_, count_, kind_);
 
@@ -42,6 +42,8 @@ class MemcpyAsyncTaskInfo : public TaskInfo {
  private:
   Status SetIoAddrs(const OpDescPtr &op_desc, const domi::MemcpyAsyncDef &memcpy_async);
 
+  Status InitHostSwap(const OpDescPtr &op_desc, bool swap_out);
+
   uint8_t *dst_;
   uint64_t dst_max_;
   uint8_t *src_;
@@ -88,11 +88,20 @@ class FMK_FUNC_HOST_VISIBILITY FMK_FUNC_DEV_VISIBILITY TBEHandleStore {
   ///
   void EraseTBEHandle(const std::map<std::string, uint32_t> &names);
 
+  ///
+  /// @ingroup ge
+  /// @brief Mutex to hold from querying a kernel to registering it, so models loaded on several threads
+  ///        register the same binary only once.
+  /// @return mutex of registering
+  ///
+  std::mutex &GetRegisterMutex() { return register_mutex_; }
+
  private:
   TBEHandleStore() = default;
   ~TBEHandleStore() = default;
 
   std::mutex mutex_;
+  std::mutex register_mutex_;
   std::unordered_map<std::string, TbeHandleInfo> kernels_;
 };
 }  // namespace ge
@@ -72,6 +72,22 @@ class ZeroCopyTask {
    */
   ge::Status UpdateTaskParam(uintptr_t addr, void *buffer_addr);
 
+  /**
+   * @ingroup ge
+   * @brief Set user data addr to Task param at a known offset.
+   * @param [in] offset: offset in task args, from GetTaskArgsOffset.
+   * @param [in] buffer_addr: data buffer_addr from user.
+   * @return: void
+   */
+  void PatchTaskParam(size_t offset, void *buffer_addr) {
+    *reinterpret_cast<uintptr_t *>(args_info_.data() + offset) = reinterpret_cast<uintptr_t>(buffer_addr);
+    is_updated_ = true;
+  }
+
+  const map<uintptr_t, set<size_t>> &GetTaskArgsOffset() const {
+    return task_addr_offset_;
+  }
+
   /**
    * @ingroup ge
    * @brief Update task param to device.
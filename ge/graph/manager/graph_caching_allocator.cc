@@ -17,13 +17,20 @@
 
 #include "graph/manager/graph_caching_allocator.h"
 
+#include <cstdlib>
 #include <set>
 #include <string>
 #include <utility>
 
+#include "external/ge/ge_api_types.h"
+#include "graph/ge_context.h"
 #include "graph/manager/graph_mem_manager.h"
 
 namespace ge {
+namespace {
+constexpr int32_t kDecimal = 10;
+}  // namespace
+
 const size_t bin_ranges[kNumBins] = {kRoundBlockSize * kKByteSize,
                                      kBinSizeUnit8 * kMByteSize,
                                      kBinSizeUnit32 * kMByteSize,
@@ -95,7 +102,8 @@ void IncreaseCount(std::map<size_t, size_t> &count, size_t size) {
 }
 
 CachingAllocator::CachingAllocator(rtMemType_t memory_type)
-    : memory_type_(memory_type), memory_allocator_(nullptr), called_malloc_counts_(0), called_free_counts_(0) {
+    : memory_type_(memory_type), memory_allocator_(nullptr), called_malloc_counts_(0), called_free_counts_(0),
+      slab_device_id_(0) {
   for (uint32_t i = 0; i < kNumBins; i++) {
     free_block_bins_[i] = nullptr;
   }
@@ -104,6 +112,11 @@ CachingAllocator::CachingAllocator(rtMemType_t memory_type)
 Status CachingAllocator::Initialize(uint32_t device_id) {
   GELOGI("Device id %u", device_id);
   // when redo Initialize free old memory
+  if (slab_allocator_ != nullptr) {
+    // same lock order as TryFreeBlocks
+    std::lock_guard<std::recursive_mutex> lock(mutex_);
+    slab_allocator_->Release();
+  }
   FreeBlocks();
   std::lock_guard<std::recursive_mutex> lock(mutex_);
   for (uint32_t i = 0; i < kNumBins; i++) {
@@ -124,12 +137,43 @@ Status CachingAllocator::Initialize(uint32_t device_id) {
   }
   called_malloc_counts_ = 0;
   called_free_counts_ = 0;
+  InitSlabAllocator(device_id);
   return ge::SUCCESS;
 }
 
+void CachingAllocator::InitSlabAllocator(uint32_t device_id) {
+  std::string threshold_option = std::to_string(kDefaultSlabThreshold);
+  (void)GetContext().GetOption(OPTION_EXEC_SLAB_ALLOC_THRESHOLD, threshold_option);  // option may not be set up
+  int64_t threshold = std::strtol(threshold_option.c_str(), nullptr, kDecimal);
+  if (threshold <= 0) {
+    GELOGI("Slab allocator is disabled, threshold %s.", threshold_option.c_str());
+    slab_allocator_.reset();
+    return;
+  }
+  if (static_cast<uint64_t>(threshold) > kMaxSlabThreshold) {
+    GELOGW("Slab threshold %ld is bigger than %zu, use %zu.", threshold, kMaxSlabThreshold, kMaxSlabThreshold);
+    threshold = static_cast<int64_t>(kMaxSlabThreshold);
+  }
+  // slabs come from the block bins, uncounted since the user did not call
+  slab_allocator_.reset(new (std::nothrow) SlabAllocator(
+      static_cast<size_t>(threshold),
+      [this, device_id](size_t size) { return MallocBlock(GetBlockSize(size), nullptr, device_id); },
+      [this, device_id](uint8_t *ptr) { (void)FreeBlockMemory(ptr, device_id); }));
+  if (slab_allocator_ == nullptr) {
+    GELOGW("Create slab allocator failed, small memory is malloced from the block bins.");
+    return;
+  }
+  slab_device_id_ = device_id;
+}
+
 void CachingAllocator::Finalize(uint32_t device_id) {
   GELOGI("Device id %u", device_id);
   PrintStatics();
+  if (slab_allocator_ != nullptr) {
+    // same lock order as TryFreeBlocks
+    std::lock_guard<std::recursive_mutex> lock(mutex_);
+    slab_allocator_->Release();
+  }
   FreeBlocks();
   FreeBlockBins();
 }
@@ -137,7 +181,19 @@ void CachingAllocator::Finalize(uint32_t device_id) {
 uint8_t *CachingAllocator::Malloc(size_t size, uint8_t *org_ptr, uint32_t device_id) {
   GELOGI("Start malloc pool memory, size = %zu, device id = %u", size, device_id);
   called_malloc_counts_++;
-  size = GetBlockSize(size);
+  // the slabs can not reuse org_ptr, the block bins try it
+  if ((slab_allocator_ != nullptr) && (org_ptr == nullptr) && (device_id == slab_device_id_) &&
+      slab_allocator_->IsSlabSize(size)) {
+    uint8_t *ptr = slab_allocator_->Malloc(size);
+    if (ptr != nullptr) {
+      return ptr;
+    }
+    GELOGW("Malloc size %zu from slabs failed, try the block bins.", size);
+  }
+  return MallocBlock(GetBlockSize(size), org_ptr, device_id);
+}
+
+uint8_t *CachingAllocator::MallocBlock(size_t size, uint8_t *org_ptr, uint32_t device_id) {
   uint8_t *ptr = nullptr;
   Block *block = FindFreeBlock(size, org_ptr, device_id);
   if (block == nullptr) {
@@ -166,7 +222,13 @@ Status CachingAllocator::Free(uint8_t *ptr, uint32_t device_id) {
     GELOGE(PARAM_INVALID, "[Check][Param] Invalid memory pointer, device_id:%u", device_id);
     return ge::PARAM_INVALID;
   }
+  if ((slab_allocator_ != nullptr) && slab_allocator_->Free(ptr)) {
+    return ge::SUCCESS;
+  }
+  return FreeBlockMemory(ptr, device_id);
+}
 
+Status CachingAllocator::FreeBlockMemory(uint8_t *ptr, uint32_t device_id) {
   std::lock_guard<std::recursive_mutex> lock(mutex_);
   auto it = allocated_blocks_.find(ptr);
   if (it == allocated_blocks_.end()) {
@@ -374,6 +436,10 @@ void CachingAllocator::FreeBlocks() {
 void CachingAllocator::TryFreeBlocks() {
   GELOGI("Try free blocks.");
   std::lock_guard<std::recursive_mutex> lock(mutex_);
+  // slabs are allocated blocks, give them back first when none of their memory is used
+  if (slab_allocator_ != nullptr) {
+    (void)slab_allocator_->TryRelease();
+  }
   if (allocated_blocks_.empty()) {
     (void) FreeCachedBlocks();
   }
@@ -445,5 +511,8 @@ void CachingAllocator::PrintStatics(int32_t level) {
   PrintCount(malloc_block_stat, "Malloc", total_malloc_size, total_malloc_count);
   PrintCount(using_block_stat, "Using", total_using_size, total_using_count);
   PrintCount(free_block_stat, "Free", total_free_size, total_free_count);
+  if (slab_allocator_ != nullptr) {
+    slab_allocator_->PrintStatics();
+  }
 }
 }  // namespace ge
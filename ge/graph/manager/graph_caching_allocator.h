@@ -32,6 +32,7 @@
 #include "framework/common/ge_inner_error_codes.h"
 #include "graph/node.h"
 #include "graph/manager/block_memory.h"
+#include "graph/manager/graph_slab_allocator.h"
 #include "runtime/mem.h"
 
 namespace ge {
@@ -105,6 +106,33 @@ class CachingAllocator {
 
  private:
 
+  ///
+  /// @ingroup ge_graph
+  /// @brief malloc memory from the block bins
+  /// @param [in] size memory size, rounded
+  /// @param [in] try to reuse the same memory
+  /// @param [in] device id
+  /// @return  memory address
+  ///
+  uint8_t *MallocBlock(size_t size, uint8_t *org_ptr, uint32_t device_id);
+
+  ///
+  /// @ingroup ge_graph
+  /// @brief free memory malloced from the block bins
+  /// @param [in] memory_ptr memory address ptr
+  /// @param [in] device_id device id
+  /// @return Status result of function
+  ///
+  Status FreeBlockMemory(uint8_t *ptr, uint32_t device_id);
+
+  ///
+  /// @ingroup ge_graph
+  /// @brief create the slab allocator for small memory according to ge.exec.slabAllocThreshold
+  /// @param [in] device id
+  /// @return void
+  ///
+  void InitSlabAllocator(uint32_t device_id);
+
   ///
   /// @ingroup ge_graph
   /// @brief extend cache by size
@@ -222,6 +250,10 @@ class CachingAllocator {
 
   //user call Free total counts
   std::atomic<size_t> called_free_counts_;
+
+  // small memory of slab_device_id_ is served by slabs malloced from the block bins, nullptr if disabled
+  std::unique_ptr<SlabAllocator> slab_allocator_;
+  uint32_t slab_device_id_;
 };
 }  // namespace ge
 #endif  // GE_GRAPH_MANAGER_GRAPH_CACHING_ALLOCATOR_H_
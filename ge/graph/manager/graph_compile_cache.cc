@@ -0,0 +1,344 @@
+/**
+* Copyright 2021, 2022 LuoJiaNET Research and Development Group, Wuhan University
+* Copyright 2021, 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "graph/manager/graph_compile_cache.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <set>
+#include <sstream>
+
+#include "framework/common/helper/model_helper.h"
+#include "common/model_parser/mapped_model_file.h"
+#include "framework/common/debug/ge_log.h"
+#include "framework/common/types.h"
+#include "framework/common/util.h"
+#include "graph/debug/ge_attr_define.h"
+#include "graph/utils/attr_utils.h"
+#include "graph/utils/graph_utils.h"
+#include "graph/utils/type_utils.h"
+#include "init/gelib.h"
+#include "mmpa/mmpa_api.h"
+
+namespace ge {
+namespace {
+const char *const kDefaultCachePath = "./ge_incre_build_cache";
+const char *const kCacheFilePrefix = "/ge_graph_";
+const char *const kCacheFileSuffix = ".om";
+const char *const kKeyFileSuffix = ".key";
+// bump when the key or the file layout changes, so stale files are never matched
+const char *const kCacheVersion = "2";
+const char *const kVersionInfoFile = "/version.info";
+const char *const kVersionFlag = "Version=";
+const char *const kEnvOppPath = "ASCEND_OPP_PATH";
+const char *const kEnvCustomOppPath = "ASCEND_CUSTOM_OPP_PATH";
+const uint64_t kFnvOffsetBasis = 14695981039346656037ULL;
+const uint64_t kFnvPrime = 1099511628211ULL;
+
+// options which differ between processes without changing the built model
+const std::set<std::string> kIgnoredOptions = {
+    OPTION_EXEC_SESSION_ID, OPTION_EXEC_JOB_ID, OPTION_EXEC_ENABLE_INCRE_BUILD, OPTION_EXEC_INCRE_BUILD_CACHE_PATH};
+
+// FNV-1a, stable between processes and builds unlike std::hash
+uint64_t HashString(const std::string &str) {
+  uint64_t hash = kFnvOffsetBasis;
+  for (const char c : str) {
+    hash ^= static_cast<uint8_t>(c);
+    hash *= kFnvPrime;
+  }
+  return hash;
+}
+
+// the package version in the first line of version.info, e.g. Version=1.78.T10.0.B100
+std::string ReadVersion(const std::string &dir) {
+  std::ifstream fs(dir + kVersionInfoFile, std::ifstream::in);
+  std::string line;
+  if (!fs.is_open() || !std::getline(fs, line)) {
+    return "unknown";
+  }
+  std::string::size_type pos = line.find(kVersionFlag);
+  return (pos == std::string::npos) ? "unknown" : line.substr(pos + strlen(kVersionFlag));
+}
+
+std::string GetVersions() {
+  std::stringstream ss;
+  std::string ge_path = GELib::GetPath();
+  ge_path = ge_path.substr(0, ge_path.rfind('/'));
+  ge_path = ge_path.substr(0, ge_path.rfind('/'));
+  ss << "ge:" << ReadVersion(ge_path) << ";";
+  const char *opp_path = std::getenv(kEnvOppPath);
+  ss << "opp:" << ((opp_path == nullptr) ? "none" : ReadVersion(opp_path)) << ";";
+  // custom op libs, separated by ':'
+  const char *custom_opp_path = std::getenv(kEnvCustomOppPath);
+  if (custom_opp_path != nullptr) {
+    std::stringstream paths(custom_opp_path);
+    std::string path;
+    while (std::getline(paths, path, ':')) {
+      if (!path.empty()) {
+        ss << "custom_opp:" << path << "=" << ReadVersion(path) << ";";
+      }
+    }
+  }
+  return ss.str();
+}
+
+bool ReadFile(const std::string &file, std::string &content) {
+  std::ifstream fs(file, std::ifstream::in | std::ifstream::binary);
+  if (!fs.is_open()) {
+    return false;
+  }
+  std::stringstream ss;
+  ss << fs.rdbuf();
+  content = ss.str();
+  return !fs.bad();
+}
+
+bool WriteFile(const std::string &file, const std::string &content) {
+  std::ofstream fs(file, std::ofstream::out | std::ofstream::binary | std::ofstream::trunc);
+  if (!fs.is_open()) {
+    return false;
+  }
+  fs << content;
+  fs.close();
+  return !fs.fail();
+}
+
+void AppendTensorDesc(const GeTensorDesc &tensor_desc, std::stringstream &ss) {
+  ss << TypeUtils::DataTypeToSerialString(tensor_desc.GetDataType()) << ","
+     << TypeUtils::FormatToSerialString(tensor_desc.GetFormat()) << ","
+     << tensor_desc.GetShape().ToString() << ";";
+}
+
+void AppendNode(const NodePtr &node, std::stringstream &ss) {
+  const auto &op_desc = node->GetOpDesc();
+  ss << node->GetName() << "|" << node->GetType() << "|in:";
+  for (const auto &in_anchor : node->GetAllInDataAnchors()) {
+    const auto &peer_anchor = in_anchor->GetPeerOutAnchor();
+    if (peer_anchor != nullptr) {
+      ss << in_anchor->GetIdx() << "-" << peer_anchor->GetOwnerNode()->GetName() << ":" << peer_anchor->GetIdx()
+         << ";";
+    }
+  }
+  ss << "ctrl:";
+  std::set<std::string> control_in_node_names;
+  for (const auto &src_node : node->GetInControlNodes()) {
+    control_in_node_names.insert(src_node->GetName());
+  }
+  for (const auto &name : control_in_node_names) {
+    ss << name << ";";
+  }
+  if (op_desc != nullptr) {
+    ss << "desc:";
+    for (const auto &tensor_desc : op_desc->GetAllInputsDescPtr()) {
+      AppendTensorDesc(*tensor_desc, ss);
+    }
+    for (const auto &tensor_desc : op_desc->GetAllOutputsDescPtr()) {
+      AppendTensorDesc(*tensor_desc, ss);
+    }
+    ss << "attrs:" << AttrUtils::GetAllAttrsStr(op_desc);
+  }
+  ss << "\n";
+}
+}  // namespace
+
+Status GraphCompileCache::Initialize(const std::map<std::string, std::string> &options) {
+  enabled_ = false;
+  auto it = options.find(OPTION_EXEC_ENABLE_INCRE_BUILD);
+  if (it == options.end() || (it->second != "1" && it->second != "true")) {
+    return SUCCESS;
+  }
+
+  it = options.find(OPTION_EXEC_INCRE_BUILD_CACHE_PATH);
+  cache_path_ = (it == options.end() || it->second.empty()) ? kDefaultCachePath : it->second;
+  while (cache_path_.size() > 1 && cache_path_.back() == '/') {
+    cache_path_.pop_back();
+  }
+  if (CreateDirectory(cache_path_) != 0) {
+    GELOGW("[IncreBuild] Create cache path %s failed, compile cache is disabled.", cache_path_.c_str());
+    return SUCCESS;
+  }
+  versions_ = GetVersions();
+  enabled_ = true;
+  GELOGI("[IncreBuild] Compile cache is enabled, path:%s, versions:%s.", cache_path_.c_str(), versions_.c_str());
+  return SUCCESS;
+}
+
+bool GraphCompileCache::IsGraphCacheable(const ComputeGraphPtr &compute_graph) const {
+  if (!enabled_ || compute_graph == nullptr) {
+    return false;
+  }
+  for (const auto &node : compute_graph->GetAllNodes()) {
+    if (node->GetType() == VARIABLE || node->GetType() == VARIABLEV2) {
+      GELOGI("[IncreBuild] Graph %s has variable %s, skip compile cache.", compute_graph->GetName().c_str(),
+             node->GetName().c_str());
+      return false;
+    }
+  }
+  return true;
+}
+
+std::string GraphCompileCache::GenerateKey(const ComputeGraphPtr &compute_graph, const std::vector<GeTensor> &inputs,
+                                           const std::map<std::string, std::string> &options) const {
+  std::stringstream ss;
+  ss << "version:" << kCacheVersion << "\npackages:" << versions_ << "\ngraph:" << compute_graph->GetName() << "\n";
+  for (const auto &node : compute_graph->GetAllNodes()) {
+    AppendNode(node, ss);
+  }
+  ss << "inputs:";
+  for (const auto &input : inputs) {
+    AppendTensorDesc(input.GetTensorDesc(), ss);
+  }
+  ss << "\noptions:";
+  for (const auto &option : options) {  // std::map keeps the options sorted
+    if (kIgnoredOptions.count(option.first) == 0) {
+      ss << option.first << "=" << option.second << ";";
+    }
+  }
+
+  return ss.str();
+}
+
+std::string GraphCompileCache::GetKeyId(const std::string &key) {
+  std::stringstream key_id;
+  key_id << std::hex << HashString(key) << "_" << key.size();
+  return key_id.str();
+}
+
+std::string GraphCompileCache::GetCacheFile(const std::string &key) const {
+  return cache_path_ + kCacheFilePrefix + GetKeyId(key) + kCacheFileSuffix;
+}
+
+std::string GraphCompileCache::GetKeyFile(const std::string &key) const {
+  return cache_path_ + kCacheFilePrefix + GetKeyId(key) + kKeyFileSuffix;
+}
+
+void GraphCompileCache::Invalidate(const std::string &key, const std::string &reason) {
+  const std::string cache_file = GetCacheFile(key);
+  const std::string key_file = GetKeyFile(key);
+  (void)std::remove(cache_file.c_str());
+  (void)std::remove(key_file.c_str());
+  ++invalid_count_;
+  GEEVENT("[IncreBuild] Cache of key %s is invalidated: %s, hit:%lu, miss:%lu, invalidated:%lu.",
+          GetKeyId(key).c_str(), reason.c_str(), hit_count_.load(), miss_count_.load(), invalid_count_.load());
+}
+
+Status GraphCompileCache::Load(const std::string &key, uint64_t session_id, GeRootModelPtr &ge_root_model) {
+  ge_root_model = nullptr;
+  const std::string key_id = GetKeyId(key);
+  const std::string cache_file = GetCacheFile(key);
+  // a cache file is replaced by rename and never written in place, so the mapping stays consistent
+  MappedModelFile model_file;
+  {
+    std::lock_guard<std::mutex> lock(file_mutex_);
+    if (mmAccess2(cache_file.c_str(), M_F_OK) != EN_OK) {
+      ++miss_count_;
+      GEEVENT("[IncreBuild] Cache miss, key:%s, hit:%lu, miss:%lu, invalidated:%lu.", key_id.c_str(),
+              hit_count_.load(), miss_count_.load(), invalid_count_.load());
+      return SUCCESS;
+    }
+    // the file name only holds a hash of the key, the full key decides
+    std::string saved_key;
+    if (!ReadFile(GetKeyFile(key), saved_key) || (saved_key != key)) {
+      Invalidate(key, "key differs");
+      ++miss_count_;
+      return SUCCESS;
+    }
+    if (model_file.Map(cache_file, 0) != SUCCESS) {
+      Invalidate(key, "read file failed");
+      ++miss_count_;
+      return SUCCESS;
+    }
+  }
+
+  ModelHelper model_helper;
+  Status ret = model_helper.LoadRootModel(model_file.GetModelData());
+  model_file.Unmap();
+  if (ret != SUCCESS || model_helper.GetGeRootModel() == nullptr) {
+    Invalidate(key, "parse model failed");
+    ++miss_count_;
+    return SUCCESS;
+  }
+
+  GeRootModelPtr root_model = model_helper.GetGeRootModel();
+  ComputeGraphPtr root_graph = root_model->GetRootGraph();
+  if (root_graph == nullptr) {
+    Invalidate(key, "no root graph");
+    ++miss_count_;
+    return SUCCESS;
+  }
+  // a known shape om only holds one model, which is not registered to the root model by ModelHelper
+  if (root_model->GetSubgraphInstanceNameToModel().empty()) {
+    root_model->SetSubgraphInstanceNameToModel(root_graph->GetName(), model_helper.GetGeModel());
+  }
+  // the cached models carry the session of the process which built them
+  root_graph->SetSessionID(session_id);
+  for (const auto &name_to_model : root_model->GetSubgraphInstanceNameToModel()) {
+    if (name_to_model.second != nullptr) {
+      (void)AttrUtils::SetInt(name_to_model.second, MODEL_ATTR_SESSION_ID, static_cast<int64_t>(session_id));
+    }
+  }
+  ge_root_model = root_model;
+  ++hit_count_;
+  GEEVENT("[IncreBuild] Cache hit, key:%s, graph:%s, hit:%lu, miss:%lu, invalidated:%lu.", key_id.c_str(),
+          root_graph->GetName().c_str(), hit_count_.load(), miss_count_.load(), invalid_count_.load());
+  return SUCCESS;
+}
+
+Status GraphCompileCache::Save(const std::string &key, const GeRootModelPtr &ge_root_model) {
+  GE_CHECK_NOTNULL(ge_root_model);
+  bool is_unknown_shape = false;
+  GE_CHK_STATUS_RET(ge_root_model->CheckIsUnknownShape(is_unknown_shape),
+                    "[Check][IsUnknownShape] failed, key:%s", GetKeyId(key).c_str());
+
+  // write to a private file first, so readers in other processes never see a partial om
+  const std::string key_id = GetKeyId(key);
+  const std::string cache_file = GetCacheFile(key);
+  const std::string key_file = GetKeyFile(key);
+  const std::string tmp_file = cache_file + "." + std::to_string(mmGetPid()) + ".tmp";
+  const std::string tmp_key_file = key_file + "." + std::to_string(mmGetPid()) + ".tmp";
+  ModelHelper model_helper;
+  model_helper.SetSaveMode(true);
+  ModelBufferData model_buffer;
+  SaveParam save_param;
+  std::lock_guard<std::mutex> lock(file_mutex_);
+  Status ret = model_helper.SaveToOmRootModel(ge_root_model, save_param, tmp_file, model_buffer, is_unknown_shape);
+  if (ret != SUCCESS) {
+    (void)std::remove(tmp_file.c_str());
+    GELOGW("[IncreBuild] Save cache of key %s failed, ret:%u.", key_id.c_str(), ret);
+    return ret;
+  }
+  if (!WriteFile(tmp_key_file, key)) {
+    (void)std::remove(tmp_file.c_str());
+    (void)std::remove(tmp_key_file.c_str());
+    GELOGW("[IncreBuild] Save key of %s to %s failed.", key_id.c_str(), tmp_key_file.c_str());
+    return FAILED;
+  }
+  // the key goes last, a model without its key is never loaded
+  (void)std::remove(key_file.c_str());
+  if ((std::rename(tmp_file.c_str(), cache_file.c_str()) != 0) ||
+      (std::rename(tmp_key_file.c_str(), key_file.c_str()) != 0)) {
+    (void)std::remove(tmp_file.c_str());
+    (void)std::remove(tmp_key_file.c_str());
+    GELOGW("[IncreBuild] Rename %s and %s failed.", tmp_file.c_str(), tmp_key_file.c_str());
+    return FAILED;
+  }
+  GELOGI("[IncreBuild] Save cache of key %s to %s.", key_id.c_str(), cache_file.c_str());
+  return SUCCESS;
+}
+}  // namespace ge
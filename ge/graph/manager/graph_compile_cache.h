@@ -0,0 +1,87 @@
+/**
+* Copyright 2021, 2022 LuoJiaNET Research and Development Group, Wuhan University
+* Copyright 2021, 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef GE_GRAPH_MANAGER_GRAPH_COMPILE_CACHE_H_
+#define GE_GRAPH_MANAGER_GRAPH_COMPILE_CACHE_H_
+
+#include <atomic>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "external/ge/ge_api_error_codes.h"
+#include "graph/compute_graph.h"
+#include "graph/ge_tensor.h"
+#include "common/model/ge_root_model.h"
+
+namespace ge {
+///
+/// On-disk cache of built models, enabled by ge.exec.enableIncreBuild.
+/// A graph is keyed by its nodes, edges, attributes, tensor descs, the shapes of the user inputs,
+/// the compile options and the versions of GE and the op packages. The built GeRootModel is saved
+/// as an om file named after a hash of the key in ge.exec.increBuildCachePath, with the full key
+/// next to it, and loaded instead of compiling next time if the full key is the same.
+///
+class GraphCompileCache {
+ public:
+  Status Initialize(const std::map<std::string, std::string> &options);
+
+  bool IsEnabled() const { return enabled_; }
+
+  ///
+  /// Graphs owning variables depend on the variable memory of the process which built them,
+  /// so they are always compiled.
+  ///
+  bool IsGraphCacheable(const ComputeGraphPtr &compute_graph) const;
+
+  ///
+  /// @return the full key, which is kept with the cache file and compared when loading
+  ///
+  std::string GenerateKey(const ComputeGraphPtr &compute_graph, const std::vector<GeTensor> &inputs,
+                          const std::map<std::string, std::string> &options) const;
+
+  ///
+  /// @return SUCCESS and a model bound to session_id when hit, SUCCESS and nullptr when missed.
+  /// A cache file which can not be loaded is removed and counted as invalidated.
+  ///
+  Status Load(const std::string &key, uint64_t session_id, GeRootModelPtr &ge_root_model);
+
+  Status Save(const std::string &key, const GeRootModelPtr &ge_root_model);
+
+  uint64_t GetHitCount() const { return hit_count_.load(); }
+  uint64_t GetMissCount() const { return miss_count_.load(); }
+  uint64_t GetInvalidCount() const { return invalid_count_.load(); }
+
+ private:
+  static std::string GetKeyId(const std::string &key);
+  std::string GetCacheFile(const std::string &key) const;
+  std::string GetKeyFile(const std::string &key) const;
+  void Invalidate(const std::string &key, const std::string &reason);
+
+  bool enabled_ = false;
+  std::string cache_path_;
+  // versions of GE and the op packages, models built by others are not reused
+  std::string versions_;
+  std::mutex file_mutex_;
+  std::atomic<uint64_t> hit_count_{0};
+  std::atomic<uint64_t> miss_count_{0};
+  std::atomic<uint64_t> invalid_count_{0};
+};
+}  // namespace ge
+
+#endif  // GE_GRAPH_MANAGER_GRAPH_COMPILE_CACHE_H_
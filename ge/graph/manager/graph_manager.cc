@@ -26,13 +26,15 @@
 #include <thread>
 
 #include "common/math/math_util.h"
-#include "common/thread_pool.h"
+#include "common/compile_executor.h"
 #include "common/dump/dump_manager.h"
 #include "ge_opt_info/ge_opt_info.h"
 #include "analyzer/analyzer.h"
 #include "common/ge_call_wrapper.h"
 #include "common/local_context.h"
+#include "common/thread_context_guard.h"
 #include "common/transop_util.h"
+#include "framework/common/scope_guard.h"
 #include "graph/ge_context.h"
 #include "graph/ge_global_options.h"
 #include "graph/manager/util/rt_context_util.h"
@@ -56,6 +58,7 @@
 #include "graph/passes/dimension_adjust_pass.h"
 #include "graph/passes/dimension_compute_pass.h"
 #include "graph/passes/flow_ctrl_pass.h"
+#include "graph/passes/folding_cache.h"
 #include "graph/passes/fuse_data_nodes_with_common_input_pass.h"
 #include "graph/passes/hccl_tailing_optimization_pass.h"
 #include "graph/passes/identity_pass.h"
@@ -69,6 +72,7 @@
 #include "graph/passes/merge_to_stream_merge_pass.h"
 #include "graph/passes/multi_batch_pass.h"
 #include "graph/passes/next_iteration_pass.h"
+#include "graph/passes/pass_report.h"
 #include "graph/passes/permute_pass.h"
 #include "graph/passes/prune_pass.h"
 #include "graph/passes/ref_identity_delete_op_pass.h"
@@ -99,6 +103,8 @@
 #include "graph/passes/hccl_continuous_memcpy_pass.h"
 #include "graph/passes/parallel_group_pass.h"
 #include "graph/passes/buffer_pool_memory_pass.h"
+#include "graph/passes/rematerialization_pass.h"
+#include "graph/passes/activation_offload_pass.h"
 #include "graph/build/label_allocator.h"
 #include "graph/utils/tensor_adapter.h"
 #include "inc/pass_manager.h"
@@ -197,6 +203,12 @@ Status GraphManager::Initialize(const std::map<string, string> &options, Executo
     return ret;
   }
 
+  ret = compile_cache_.Initialize(options);
+  if (ret != SUCCESS) {
+    GELOGE(ret, "[Initialize][CompileCache] failed.");
+    return ret;
+  }
+
   executor_ = executor;
   init_flag_ = true;
 
@@ -676,54 +688,42 @@ Status GraphManager::OptimizeSubGraphWithMultiThreads(ComputeGraphPtr compute_gr
     GEEVENT("OptimizeSubGraphWithMultiThreads thread num: %u", thread_num);
   }
 
-
-  ThreadPool executor(thread_num);
-  std::vector<std::future<Status>> vector_future;
-  const auto &root_subgraph_list = sub_graph_map[compute_graph];
+  std::vector<SubGraphInfoPtr> subgraphs(sub_graph_map[compute_graph]);
+  for (auto &function_graph : compute_graph->GetAllSubgraphs()) {
+    const auto &subgraph_list = sub_graph_map[function_graph];
+    subgraphs.insert(subgraphs.end(), subgraph_list.begin(), subgraph_list.end());
+  }
   std::string op_compile_strategy;
   (void)AttrUtils::GetStr(compute_graph, ATTR_NAME_OP_COMPILE_STRATEGY, op_compile_strategy);
   GELOGD("OptimizeSubGraphWithMultiThreads Process op_compile_strategy:%s", op_compile_strategy.c_str());
-  for (const auto &subgraph : root_subgraph_list) {
+  const auto error_context = ErrorManager::GetInstance().GetErrorManagerContext();
+  const GEThreadLocalContext ge_context = GetThreadLocalContext();
+  std::vector<CompileExecutor::Task> tasks;
+  for (const auto &subgraph : subgraphs) {
+    GE_CHECK_NOTNULL(subgraph);
+    GE_CHECK_NOTNULL(subgraph->GetSubGraph());
     if (!op_compile_strategy.empty()) {
       (void) AttrUtils::SetStr(subgraph->GetSubGraph(), ATTR_NAME_OP_COMPILE_STRATEGY, op_compile_strategy);
     }
-    std::future<Status> f = executor.commit(GraphManager::ProcessSubGraphWithMultiThreads, this,
-                                            compute_graph->GetGraphID(), subgraph,
-                                            compute_graph->GetName(), session_id,
-                                            ErrorManager::GetInstance().GetErrorManagerContext(),
-                                            GetThreadLocalContext());
-    if (!f.valid()) {
-      GELOGE(FAILED, "[Call][Commit] failed, Future is invalid, session_id:%lu", session_id);
-      return FAILED;
-    }
-    vector_future.emplace_back(std::move(f));
-  }
-  for (auto &function_graph : compute_graph->GetAllSubgraphs()) {
-    auto subgraph_list = sub_graph_map[function_graph];
-    for (const auto &subgraph : subgraph_list) {
-      if (!op_compile_strategy.empty()) {
-        (void) AttrUtils::SetStr(subgraph->GetSubGraph(), ATTR_NAME_OP_COMPILE_STRATEGY, op_compile_strategy);
-      }
-      std::future<Status> f = executor.commit(GraphManager::ProcessSubGraphWithMultiThreads, this,
-                                              compute_graph->GetGraphID(), subgraph,
-                                              compute_graph->GetName(), session_id,
-                                              ErrorManager::GetInstance().GetErrorManagerContext(),
-                                              GetThreadLocalContext());
-      if (!f.valid()) {
-        GELOGE(FAILED, "[Call][Commit] failed, Future is invalid, session_id:%lu", session_id);
-        return FAILED;
-      }
-      vector_future.emplace_back(std::move(f));
-    }
-  }
-  GELOGD("All sub graph num is %zu", vector_future.size());
-  for (size_t i = 0; i < vector_future.size(); ++i) {
-    Status ret_status = vector_future[i].get();
-    if (ret_status != SUCCESS) {
-      REPORT_CALL_ERROR("E19999", "subgraph %zu optimize failed", i);
-      GELOGE(ret_status, "[Check][Param] subgraph %zu optimize failed", i);
-      return ret_status;
-    }
+    CompileExecutor::Task task;
+    // subgraphs of the same graph compiled again, e.g. by another session, are estimated by the last time,
+    // subgraph names alone are reused by other graphs
+    task.name = compute_graph->GetName() + "::" + subgraph->GetEngineName() + "::" +
+                subgraph->GetSubGraph()->GetName();
+    task.node_num = subgraph->GetSubGraph()->GetDirectNodesSize();
+    task.func = [this, &compute_graph, &subgraph, &error_context, &ge_context, session_id]() {
+      return ProcessSubGraphWithMultiThreads(this, compute_graph->GetGraphID(), subgraph, compute_graph->GetName(),
+                                             session_id, error_context, ge_context);
+    };
+    tasks.emplace_back(std::move(task));
+  }
+  GELOGD("All sub graph num is %zu", tasks.size());
+  Status ret = CompileExecutor::GetInstance().Run("OptimizeSubGraph", tasks, thread_num);
+  if (ret != SUCCESS) {
+    REPORT_CALL_ERROR("E19999", "Optimize subgraphs of graph %s failed", compute_graph->GetName().c_str());
+    GELOGE(ret, "[Optimize][SubGraph] of graph %s failed, session_id:%lu", compute_graph->GetName().c_str(),
+           session_id);
+    return ret;
   }
   return SUCCESS;
 }
@@ -949,6 +949,16 @@ Status GraphManager::PreRun(const GraphNodePtr &graph_node, const std::vector<Ge
           compute_graph->GetDirectNodesSize(), session_id, compute_graph->GetGraphID(),
           compute_graph->GetName().c_str());
   GE_DUMP(compute_graph, "PreRunBegin");
+  // the passes out of the optimize stages are reported as PreRun
+  PassReportScope report_scope(compute_graph->GetGraphID(), "PreRun");
+  if (PassReportScope::GetCurrent() != nullptr) {
+    PassReport::GetInstance().Clear(compute_graph->GetGraphID());
+  }
+  GE_MAKE_GUARD(pass_report, [&report_scope]() {
+    if (PassReportScope::GetCurrent() == &report_scope) {
+      (void)PassReport::GetInstance().Dump(report_scope.GetGraphId(), report_scope.GetPath());
+    }
+  });
   // rtContext_t
   Status ret = SetRtContext(rtContext_t(), RT_CTX_GEN_MODE, session_id, compute_graph->GetGraphID());
   if (ret != SUCCESS) {
@@ -1057,7 +1067,7 @@ Status GraphManager::StartForRunGraph(const GraphNodePtr &graph_node, const std:
       return PARAM_INVALID;
     }
 
-    ret = PreRun(graph_node, inputs, ge_root_model, session_id);
+    ret = PreRunWithCompileCache(graph_node, inputs, ge_root_model, session_id);
     // release rts generate context
     RtContextUtil::GetInstance().DestroyRtContexts(session_id, graph_node->GetGraphId());
     if (ret != SUCCESS) {
@@ -2277,6 +2287,7 @@ Status GraphManager::OptimizeStage1(ge::ComputeGraphPtr &compute_graph) {
   GE_CHK_STATUS_RET(after_merge_passes.AddPass("OptimizeStage1_1::TransOpBreadthFusionPass",
                                                new (std::nothrow) TransOpBreadthFusionPass))
 
+  PassReportScope stage1_1_report_scope(compute_graph->GetGraphID(), "OptimizeStage1_1");
   GE_TIMESTAMP_START(after_merge_passes);
   auto ret = after_merge_passes.Run(compute_graph);
   GE_TIMESTAMP_END(after_merge_passes, "GraphManager::OptimizeStage1_1");
@@ -2316,6 +2327,7 @@ Status GraphManager::OptimizeStage1(ge::ComputeGraphPtr &compute_graph) {
   names_to_passes.emplace_back("ConstantFoldingPass", &constant_folding_pass);
   names_to_passes.emplace_back("DimensionAdjustPass", &dimension_adjust_pass);
   names_to_passes.emplace_back("UselessControlOutRemovePass", &useless_control_out_remove_pass);
+  PassReportScope stage1_2_report_scope(compute_graph->GetGraphID(), "OptimizeStage1_2");
   GE_TIMESTAMP_START(names_to_passes);
   ret = GEPass(compute_graph).Run(names_to_passes);
   GE_TIMESTAMP_END(names_to_passes, "GraphManager::OptimizeStage1_2");
@@ -2336,6 +2348,8 @@ Status GraphManager::OptimizeStage1(ge::ComputeGraphPtr &compute_graph) {
     GELOGI("The time cost of %s constant folding is [%lu] micro second, calls is %lu.",
            it.first.c_str(), it.second.second, it.second.first);
   }
+  GELOGI("Constant folding cache hits %lu, misses %lu in total.", FoldingCache::GetInstance().GetHitCount(),
+         FoldingCache::GetInstance().GetMissCount());
 
   GE_DUMP(compute_graph, "OptimizeStage1_2");
   PassManager graph_pass;
@@ -2372,6 +2386,7 @@ Status GraphManager::OptimizeStage1(ge::ComputeGraphPtr &compute_graph) {
         graph_pass.AddPass("OptimizeStage1_3::HcclTailingOptimizationPass", new (std::nothrow) HcclTailingOptimizationPass))
     }
   }
+  PassReportScope stage1_3_report_scope(compute_graph->GetGraphID(), "OptimizeStage1_3");
   GE_TIMESTAMP_START(graph_pass);
   ret = graph_pass.Run(compute_graph);
   GE_TIMESTAMP_END(graph_pass, "GraphManager::OptimizeStage1_3");
@@ -2394,6 +2409,7 @@ Status GraphManager::OptimizeStage1(ge::ComputeGraphPtr &compute_graph) {
 
 Status GraphManager::OptimizeStage2(ge::ComputeGraphPtr &compute_graph) {
   GELOGD("Start optimize after merge sub graph.");
+  PassReportScope report_scope(compute_graph->GetGraphID(), "OptimizeStage2");
 
   PassManager after_merge_passes;
   GE_CHK_STATUS_RET(after_merge_passes.AddPass("OptimizeStage2::AfterMergePasses::LinkGenMaskNodesPass",
@@ -2516,6 +2532,18 @@ Status GraphManager::OptimizeStage2(ge::ComputeGraphPtr &compute_graph) {
   GE_CHK_STATUS_RET(parallel_group_pass.Run(compute_graph), "[Handle][ParallelGroup] failed.");
   GE_TIMESTAMP_END(ParallelGroup, "ParallelGroupPass::Run.");
 
+  // Recompute cheap outputs near their later consumers to cut the feature map peak, switched by graph options.
+  GE_TIMESTAMP_START(RematerializationPass);
+  RematerializationPass rematerialization_pass;
+  GE_CHK_STATUS_RET(rematerialization_pass.Run(compute_graph), "[Call][Run] Rematerialization failed.");
+  GE_TIMESTAMP_END(RematerializationPass, "RematerializationPass::Run.");
+
+  // Swap long idle outputs out to host memory and back on their own stream, switched by graph options.
+  GE_TIMESTAMP_START(ActivationOffloadPass);
+  ActivationOffloadPass activation_offload_pass;
+  GE_CHK_STATUS_RET(activation_offload_pass.Run(compute_graph), "[Call][Run] Activation offload failed.");
+  GE_TIMESTAMP_END(ActivationOffloadPass, "ActivationOffloadPass::Run.");
+
   // After while sub graph handle, mark all node rw type
   auto result = GetCompilerStages(compute_graph->GetGraphID()).optimizer.HandleMemoryRWConflict(compute_graph);
   if (result != SUCCESS) {
@@ -2548,6 +2576,7 @@ Status GraphManager::ProcessSubGraphWithMultiThreads(GraphManager *graph_manager
                                                      uint64_t session_id,
                                                      const struct error_message::Context &error_context,
                                                      const GEThreadLocalContext &ge_context) {
+  ThreadContextGuard context_guard;
   ErrorManager::GetInstance().SetErrorContext(error_context);
   if (sub_graph_info_ptr != nullptr && graph_manager != nullptr) {
     GetContext().SetSessionId(session_id);
@@ -2575,6 +2604,7 @@ Status GraphManager::ProcessSubGraphWithMultiThreads(GraphManager *graph_manager
       return FAILED;
     }
     compute_graph_tmp->SetSessionID(session_id);
+    PassReportScope report_scope(root_graph_id, "OptimizeSubGraph");
     Status ret = graph_manager->GetCompilerStages(root_graph_id).optimizer.OptimizeSubGraph(compute_graph_tmp,
                                                                                             engine_name);
     if (ret != SUCCESS) {
@@ -2634,7 +2664,7 @@ Status GraphManager::CheckIncreBuildAndPreRun(const PreRunArgs &args,
   for (const auto &item: args.input_tensor) {
     ge_inputs.emplace_back(TensorAdapter::AsGeTensor(item));
   }
-  Status ret = PreRun(graph_node, ge_inputs, ge_root_model, args.session_id);
+  Status ret = PreRunWithCompileCache(graph_node, ge_inputs, ge_root_model, args.session_id);
   // release rts generate context
   RtContextUtil::GetInstance().DestroyRtContexts(args.session_id, graph_node->GetGraphId());
   if (ret != SUCCESS) {
@@ -2647,6 +2677,34 @@ Status GraphManager::CheckIncreBuildAndPreRun(const PreRunArgs &args,
   return SUCCESS;
 }
 
+Status GraphManager::PreRunWithCompileCache(const GraphNodePtr &graph_node, const std::vector<GeTensor> &inputs,
+                                            GeRootModelPtr &ge_root_model, uint64_t session_id) {
+  GE_CHECK_NOTNULL(graph_node);
+  GE_CHECK_NOTNULL(graph_node->GetGraph());
+  auto compute_graph = GraphUtils::GetComputeGraph(*graph_node->GetGraph());
+  // tuning builds stop halfway and never produce a complete model
+  if ((options_.build_mode == BUILD_MODE_TUNING) || !compile_cache_.IsGraphCacheable(compute_graph)) {
+    return PreRun(graph_node, inputs, ge_root_model, session_id);
+  }
+
+  // key is taken before PreRun, which optimizes the graph in place
+  const std::string key = compile_cache_.GenerateKey(compute_graph, inputs, GetThreadLocalContext().GetAllOptions());
+  GE_CHK_STATUS_RET(compile_cache_.Load(key, session_id, ge_root_model),
+                    "[Load][CompileCache] failed, graph_id:%u.", graph_node->GetGraphId());
+  if (ge_root_model != nullptr) {
+    SetRunContext(graph_node);
+    graph_node->SetGeRootModel(ge_root_model);
+    GELOGI("[IncreBuild] Graph %u skips PreRun with cached model.", graph_node->GetGraphId());
+    return SUCCESS;
+  }
+
+  GE_CHK_STATUS_RET_NOLOG(PreRun(graph_node, inputs, ge_root_model, session_id));
+  if ((ge_root_model != nullptr) && (compile_cache_.Save(key, ge_root_model) != SUCCESS)) {
+    GELOGW("[IncreBuild] Save compile cache of graph %u failed.", graph_node->GetGraphId());
+  }
+  return SUCCESS;
+}
+
 void GraphManager::PreRunThread() {
   if (prctl(PR_SET_NAME, ("GE_PreRun")) != 0) {
     GELOGW("Set thread name failed.");
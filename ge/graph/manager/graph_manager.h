@@ -32,6 +32,7 @@
 #include "external/ge/ge_api_types.h"
 #include "graph/build/graph_builder.h"
 #include "graph/ge_local_context.h"
+#include "graph/manager/graph_compile_cache.h"
 #include "graph/manager/graph_manager_utils.h"
 #include "graph/manager/util/variable_accelerate_ctrl.h"
 #include "graph/optimize/graph_optimize.h"
@@ -382,6 +383,9 @@ class GraphManager {
 
   Status CheckIncreBuildAndPreRun(const PreRunArgs &args, GraphNodePtr &graph_node, GeRootModelPtr &ge_root_model);
 
+  Status PreRunWithCompileCache(const GraphNodePtr &graph_node, const std::vector<GeTensor> &inputs,
+                                GeRootModelPtr &ge_root_model, uint64_t session_id);
+
   Status CheckRepeatAdd(uint32_t graph_id, bool &is_added);
 
   Status NotifyWaittingGraph(uint32_t graph_id);
@@ -419,6 +423,8 @@ class GraphManager {
 
   VarAccelerateCtrl var_acc_ctrl_;
 
+  GraphCompileCache compile_cache_;
+
   std::mutex run_mutex_;
 
   std::mutex member_mutex_;
@@ -0,0 +1,396 @@
+/**
+* Copyright 2021, 2022 LuoJiaNET Research and Development Group, Wuhan University
+* Copyright 2021, 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "graph/manager/graph_slab_allocator.h"
+
+#include <algorithm>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+
+namespace ge {
+namespace {
+constexpr size_t kMinClassSize = 512;           // same as the block rounding of CachingAllocator
+constexpr size_t kMinSlabSize = 2097152;        // 2 MB
+constexpr size_t kMinObjectsPerSlab = 16;
+constexpr size_t kBatchBytes = 131072;          // 128 KB moved between a thread and the class list at once
+constexpr size_t kMinBatch = 4;
+constexpr size_t kMaxBatch = 64;
+constexpr size_t kMaxCachedBatches = 2;         // objects kept by a thread per class, in batches
+constexpr double kPercent = 100.0;
+
+std::atomic<uint64_t> g_next_allocator_id(1);
+
+// live allocators, so a thread exiting can give its cached objects back. Never destructed, a
+// thread may exit after static destruction started.
+std::mutex &RegistryMutex() {
+  static auto *registry_mutex = new std::mutex();
+  return *registry_mutex;
+}
+
+std::unordered_map<uint64_t, SlabAllocator *> &Registry() {
+  static auto *registry = new std::unordered_map<uint64_t, SlabAllocator *>();
+  return *registry;
+}
+
+double Percent(uint64_t part, uint64_t total) {
+  return (total == 0) ? 0.0 : (kPercent * static_cast<double>(part) / static_cast<double>(total));
+}
+}  // namespace
+
+SlabAllocator::ThreadCache::~ThreadCache() {
+  if (allocator_id == 0) {
+    return;
+  }
+  std::lock_guard<std::mutex> lock(RegistryMutex());
+  auto it = Registry().find(allocator_id);
+  if (it == Registry().end()) {
+    return;
+  }
+  for (size_t i = 0; i < objects.size(); ++i) {
+    it->second->GiveBack(i, generation, objects[i], objects[i].size());
+  }
+}
+
+SlabAllocator::SlabAllocator(size_t threshold, ChunkMalloc chunk_malloc, ChunkFree chunk_free)
+    : id_(g_next_allocator_id++),
+      threshold_(std::min(threshold, kMaxSlabThreshold)),
+      chunk_malloc_(std::move(chunk_malloc)),
+      chunk_free_(std::move(chunk_free)),
+      slab_index_(nullptr),
+      index_readers_(0),
+      generation_(1),
+      in_use_count_(0),
+      hit_count_(0),
+      miss_count_(0),
+      slab_bytes_(0),
+      using_bytes_(0),
+      requested_bytes_(0),
+      granted_bytes_(0) {
+  // 512, then two classes per power of two: 1K, 1.5K, 2K, 3K, 4K, 6K ... up to the threshold,
+  // an object wastes less than a third of itself
+  std::vector<size_t> class_sizes;
+  if (threshold_ > 0) {
+    class_sizes.emplace_back(kMinClassSize);
+  }
+  for (size_t size = kMinClassSize * 2; size <= threshold_; size *= 2) {
+    class_sizes.emplace_back(size);
+    if (size + size / 2 <= threshold_) {
+      class_sizes.emplace_back(size + size / 2);
+    }
+  }
+  if (!class_sizes.empty() && (class_sizes.back() < threshold_)) {
+    class_sizes.emplace_back((threshold_ + kMinClassSize - 1) / kMinClassSize * kMinClassSize);
+  }
+  for (size_t class_size : class_sizes) {
+    std::unique_ptr<SizeClass> size_class(new (std::nothrow) SizeClass());
+    if (size_class == nullptr) {
+      GELOGW("Alloc size class %zu failed, sizes from it are not served by slabs.", class_size);
+      break;
+    }
+    size_class->size = class_size;
+    size_class->slab_size = std::max(kMinSlabSize, class_size * kMinObjectsPerSlab);
+    size_class->batch = std::min(kMaxBatch, std::max(kMinBatch, kBatchBytes / class_size));
+    size_classes_.emplace_back(std::move(size_class));
+  }
+  {
+    std::lock_guard<std::mutex> lock(RegistryMutex());
+    Registry()[id_] = this;
+  }
+  GELOGI("Slab allocator %lu created, threshold %zu, size classes %zu.", id_, threshold_, size_classes_.size());
+}
+
+SlabAllocator::~SlabAllocator() {
+  {
+    std::lock_guard<std::mutex> lock(RegistryMutex());
+    Registry().erase(id_);
+  }
+  Release();
+}
+
+SlabAllocator::ThreadCache &SlabAllocator::GetThreadCache() {
+  thread_local std::unordered_map<uint64_t, ThreadCache> thread_caches;
+  ThreadCache &cache = thread_caches[id_];
+  if (cache.allocator_id == 0) {
+    cache.allocator_id = id_;
+    cache.objects.resize(size_classes_.size());
+  }
+  const uint64_t generation = generation_.load();
+  if (cache.generation != generation) {
+    // the slabs of the objects cached were released
+    for (auto &objects : cache.objects) {
+      objects.clear();
+    }
+    cache.generation = generation;
+  }
+  return cache;
+}
+
+size_t SlabAllocator::GetClassIndex(size_t size) const {
+  auto it = std::lower_bound(size_classes_.begin(), size_classes_.end(), size,
+                             [](const std::unique_ptr<SizeClass> &size_class, size_t value) {
+                               return size_class->size < value;
+                             });
+  return static_cast<size_t>(it - size_classes_.begin());
+}
+
+uint8_t *SlabAllocator::Malloc(size_t size) {
+  if (!IsSlabSize(size)) {
+    return nullptr;
+  }
+  const size_t class_index = GetClassIndex(size);
+  if (class_index >= size_classes_.size()) {
+    return nullptr;
+  }
+  // counted before the thread cache is checked, TryRelease never frees slabs under a malloc
+  in_use_count_++;
+  ThreadCache &cache = GetThreadCache();
+  std::vector<uint8_t *> &objects = cache.objects[class_index];
+  if (!objects.empty()) {
+    hit_count_++;
+  } else {
+    miss_count_++;
+    if (!Refill(class_index, objects)) {
+      in_use_count_--;
+      return nullptr;
+    }
+  }
+  uint8_t *ptr = objects.back();
+  objects.pop_back();
+  const size_t class_size = size_classes_[class_index]->size;
+  using_bytes_ += class_size;
+  requested_bytes_ += size;
+  granted_bytes_ += class_size;
+  return ptr;
+}
+
+bool SlabAllocator::Free(uint8_t *ptr) {
+  size_t class_index = 0;
+  if (!FindSlab(ptr, class_index)) {
+    return false;
+  }
+  const SizeClass &size_class = *size_classes_[class_index];
+  ThreadCache &cache = GetThreadCache();
+  std::vector<uint8_t *> &objects = cache.objects[class_index];
+  objects.emplace_back(ptr);
+  if (objects.size() > size_class.batch * kMaxCachedBatches) {
+    GiveBack(class_index, cache.generation, objects, size_class.batch);
+  }
+  using_bytes_ -= size_class.size;
+  in_use_count_--;
+  return true;
+}
+
+bool SlabAllocator::Refill(size_t class_index, std::vector<uint8_t *> &objects) {
+  SizeClass &size_class = *size_classes_[class_index];
+  {
+    std::lock_guard<std::mutex> lock(size_class.mutex);
+    if (!size_class.free_objects.empty()) {
+      size_t count = std::min(size_class.batch, size_class.free_objects.size());
+      objects.insert(objects.end(), size_class.free_objects.end() - count, size_class.free_objects.end());
+      size_class.free_objects.resize(size_class.free_objects.size() - count);
+      return true;
+    }
+  }
+  return AddSlab(class_index, objects);
+}
+
+bool SlabAllocator::AddSlab(size_t class_index, std::vector<uint8_t *> &objects) {
+  SizeClass &size_class = *size_classes_[class_index];
+  // no lock held, chunk_malloc_ takes the lock of CachingAllocator
+  uint8_t *base = chunk_malloc_(size_class.slab_size);
+  if (base == nullptr) {
+    GELOGW("Malloc slab of size %zu for size class %zu failed.", size_class.slab_size, size_class.size);
+    return false;
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(slab_mutex_);
+    std::unique_ptr<SlabIndex> index(new (std::nothrow) SlabIndex());
+    if (index == nullptr) {
+      GELOGW("Alloc slab index failed, size class %zu.", size_class.size);
+      chunk_free_(base);
+      return false;
+    }
+    if (current_index_ != nullptr) {
+      index->reserve(current_index_->size() + 1);
+      *index = *current_index_;
+    }
+    Slab slab = {base, size_class.slab_size, class_index};
+    auto pos = std::upper_bound(index->begin(), index->end(), base,
+                                [](const uint8_t *ptr, const Slab &item) { return ptr < item.base; });
+    (void)index->insert(pos, slab);
+    PublishSlabIndex(std::move(index), false);
+  }
+  size_class.slab_count++;
+  slab_bytes_ += size_class.slab_size;
+
+  // the caller takes a batch, the rest goes to the class list
+  const size_t object_num = size_class.slab_size / size_class.size;
+  const size_t batch = std::min(size_class.batch, object_num);
+  for (size_t i = batch; i > 0; --i) {
+    objects.emplace_back(base + (i - 1) * size_class.size);
+  }
+  std::lock_guard<std::mutex> lock(size_class.mutex);
+  for (size_t i = object_num; i > batch; --i) {
+    size_class.free_objects.emplace_back(base + (i - 1) * size_class.size);
+  }
+  GELOGI("Add slab %p of size %zu for size class %zu.", base, size_class.slab_size, size_class.size);
+  return true;
+}
+
+void SlabAllocator::GiveBack(size_t class_index, uint64_t generation, std::vector<uint8_t *> &objects,
+                             size_t count) {
+  count = std::min(count, objects.size());
+  if (count == 0) {
+    return;
+  }
+  SizeClass &size_class = *size_classes_[class_index];
+  {
+    std::lock_guard<std::mutex> lock(size_class.mutex);
+    // the generation only changes with all class locks held
+    if (generation == generation_.load()) {
+      size_class.free_objects.insert(size_class.free_objects.end(), objects.end() - count, objects.end());
+    }
+  }
+  objects.resize(objects.size() - count);
+}
+
+bool SlabAllocator::FindSlab(const uint8_t *ptr, size_t &class_index) const {
+  if (ptr == nullptr) {
+    return false;
+  }
+  bool found = false;
+  index_readers_++;
+  const SlabIndex *index = slab_index_.load();
+  if (index != nullptr) {
+    auto it = std::upper_bound(index->begin(), index->end(), ptr,
+                               [](const uint8_t *value, const Slab &item) { return value < item.base; });
+    if (it != index->begin()) {
+      --it;
+      if (ptr < it->base + it->size) {
+        const size_t offset = static_cast<size_t>(ptr - it->base);
+        if (offset % size_classes_[it->class_index]->size == 0) {
+          class_index = it->class_index;
+          found = true;
+        } else {
+          GELOGW("Address %p is inside slab %p but not at an object of size class %zu.", ptr, it->base,
+                 size_classes_[it->class_index]->size);
+        }
+      }
+    }
+  }
+  index_readers_--;
+  return found;
+}
+
+void SlabAllocator::PublishSlabIndex(std::unique_ptr<SlabIndex> index, bool wait_readers) {
+  // slab_mutex_ held
+  slab_index_.store(index.get());
+  if (current_index_ != nullptr) {
+    retired_indexes_.emplace_back(std::move(current_index_));
+  }
+  current_index_ = std::move(index);
+  // a reader coming after the store sees the new index, the retired ones are free once the
+  // readers before it are gone
+  if (wait_readers) {
+    while (index_readers_.load() != 0) {
+      std::this_thread::yield();
+    }
+  }
+  if (index_readers_.load() == 0) {
+    retired_indexes_.clear();
+  }
+}
+
+bool SlabAllocator::TryRelease() {
+  std::lock_guard<std::mutex> lock(slab_mutex_);
+  if ((current_index_ == nullptr) || current_index_->empty() || (in_use_count_.load() != 0)) {
+    return false;
+  }
+  std::vector<std::unique_lock<std::mutex>> class_locks;
+  for (auto &size_class : size_classes_) {
+    class_locks.emplace_back(size_class->mutex);
+  }
+  generation_++;
+  // a malloc counted before the new generation may have taken an object cached by its thread
+  if (in_use_count_.load() != 0) {
+    GELOGI("Slabs are in use, skip releasing them.");
+    return false;
+  }
+  ReleaseSlabs();
+  return true;
+}
+
+void SlabAllocator::Release() {
+  std::lock_guard<std::mutex> lock(slab_mutex_);
+  std::vector<std::unique_lock<std::mutex>> class_locks;
+  for (auto &size_class : size_classes_) {
+    class_locks.emplace_back(size_class->mutex);
+  }
+  generation_++;
+  if (in_use_count_.load() > 0) {
+    GELOGW("Release slabs with %ld objects in use, size %zu.", in_use_count_.load(), using_bytes_.load());
+  }
+  ReleaseSlabs();
+  in_use_count_ = 0;
+  using_bytes_ = 0;
+}
+
+void SlabAllocator::ReleaseSlabs() {
+  // slab_mutex_ and all class locks held
+  if (current_index_ != nullptr) {
+    for (const auto &slab : *current_index_) {
+      chunk_free_(slab.base);
+    }
+  }
+  PublishSlabIndex(std::unique_ptr<SlabIndex>(new (std::nothrow) SlabIndex()), true);
+  for (auto &size_class : size_classes_) {
+    std::vector<uint8_t *>().swap(size_class->free_objects);
+    size_class->slab_count = 0;
+  }
+  slab_bytes_ = 0;
+  GELOGI("Slabs of allocator %lu released.", id_);
+}
+
+void SlabAllocator::PrintStatics() const {
+  const uint64_t hit_count = hit_count_.load();
+  const uint64_t miss_count = miss_count_.load();
+  const size_t slab_bytes = slab_bytes_.load();
+  const size_t using_bytes = using_bytes_.load();
+  const uint64_t requested_bytes = requested_bytes_.load();
+  const uint64_t granted_bytes = granted_bytes_.load();
+  GEEVENT("Slab threshold[%zu] counts[hit:%11lu miss:%11lu hit rate:%6.2f%%].", threshold_, hit_count, miss_count,
+          Percent(hit_count, hit_count + miss_count));
+  // unused: slab memory no object is malloced from; internal: what the rounding to classes costs
+  GEEVENT("  Slab total[size:%11zu using:%11zu unused:%6.2f%% internal fragmentation:%6.2f%%].", slab_bytes,
+          using_bytes, Percent(slab_bytes - std::min(using_bytes, slab_bytes), slab_bytes),
+          Percent(granted_bytes - std::min(requested_bytes, granted_bytes), granted_bytes));
+  for (const auto &size_class : size_classes_) {
+    const size_t slab_count = size_class->slab_count.load();
+    if (slab_count == 0) {
+      continue;
+    }
+    size_t free_count = 0;
+    {
+      std::lock_guard<std::mutex> lock(size_class->mutex);
+      free_count = size_class->free_objects.size();
+    }
+    GEEVENT("    |- class[size:%11zu slabs:%11zu free:%11zu].", size_class->size, slab_count, free_count);
+  }
+}
+}  // namespace ge
@@ -0,0 +1,152 @@
+/**
+* Copyright 2021, 2022 LuoJiaNET Research and Development Group, Wuhan University
+* Copyright 2021, 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef GE_GRAPH_MANAGER_GRAPH_SLAB_ALLOCATOR_H_
+#define GE_GRAPH_MANAGER_GRAPH_SLAB_ALLOCATOR_H_
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "framework/common/debug/ge_log.h"
+
+namespace ge {
+constexpr size_t kDefaultSlabThreshold = 0;    // off unless ge.exec.slabAllocThreshold is set
+constexpr size_t kMaxSlabThreshold = 1048576;  // 1 MB
+
+///
+/// Size class allocator for small memory, placed in front of CachingAllocator.
+/// Memory is carved out of large slabs malloced from CachingAllocator, each slab holds objects of
+/// a single size class. Every thread keeps a few free objects of each class, so a malloc or free
+/// usually touches no lock; the per class lists behind them are refilled a batch at a time.
+/// Slabs are only given back as a whole, when no object is in use or when released.
+///
+class SlabAllocator {
+ public:
+  using ChunkMalloc = std::function<uint8_t *(size_t size)>;
+  using ChunkFree = std::function<void(uint8_t *ptr)>;
+
+  ///
+  /// @param [in] threshold: sizes up to threshold are served by slabs, at most kMaxSlabThreshold
+  /// @param [in] chunk_malloc: mallocs a slab
+  /// @param [in] chunk_free: frees a slab malloced by chunk_malloc
+  ///
+  SlabAllocator(size_t threshold, ChunkMalloc chunk_malloc, ChunkFree chunk_free);
+
+  SlabAllocator(const SlabAllocator &) = delete;
+
+  SlabAllocator &operator=(const SlabAllocator &) = delete;
+
+  ~SlabAllocator();
+
+  bool IsSlabSize(size_t size) const { return (size > 0) && (size <= threshold_); }
+
+  ///
+  /// @ingroup ge_graph
+  /// @brief malloc memory of a size accepted by IsSlabSize
+  /// @return memory address, nullptr when no slab can be malloced
+  ///
+  uint8_t *Malloc(size_t size);
+
+  ///
+  /// @ingroup ge_graph
+  /// @brief free memory
+  /// @return false if the memory was not malloced by this allocator
+  ///
+  bool Free(uint8_t *ptr);
+
+  ///
+  /// @ingroup ge_graph
+  /// @brief give all slabs back when no memory is in use
+  /// @return whether the slabs are released
+  ///
+  bool TryRelease();
+
+  ///
+  /// @ingroup ge_graph
+  /// @brief give all slabs back, memory still in use becomes invalid
+  ///
+  void Release();
+
+  void PrintStatics() const;
+
+  uint64_t GetHitCount() const { return hit_count_.load(); }
+  uint64_t GetMissCount() const { return miss_count_.load(); }
+  size_t GetSlabBytes() const { return slab_bytes_.load(); }
+  size_t GetUsingBytes() const { return using_bytes_.load(); }
+
+ private:
+  struct Slab {
+    uint8_t *base;
+    size_t size;
+    size_t class_index;
+  };
+  using SlabIndex = std::vector<Slab>;  // sorted by base
+
+  struct SizeClass {
+    size_t size = 0;
+    size_t slab_size = 0;
+    size_t batch = 0;
+    std::mutex mutex;
+    std::vector<uint8_t *> free_objects;
+    std::atomic<size_t> slab_count{0};
+  };
+
+  struct ThreadCache {
+    ~ThreadCache();
+    uint64_t allocator_id = 0;
+    uint64_t generation = 0;
+    std::vector<std::vector<uint8_t *>> objects;  // free objects by size class
+  };
+
+  ThreadCache &GetThreadCache();
+  size_t GetClassIndex(size_t size) const;
+  bool Refill(size_t class_index, std::vector<uint8_t *> &objects);
+  bool AddSlab(size_t class_index, std::vector<uint8_t *> &objects);
+  void GiveBack(size_t class_index, uint64_t generation, std::vector<uint8_t *> &objects, size_t count);
+  bool FindSlab(const uint8_t *ptr, size_t &class_index) const;
+  void PublishSlabIndex(std::unique_ptr<SlabIndex> index, bool wait_readers);
+  void ReleaseSlabs();
+
+  const uint64_t id_;
+  const size_t threshold_;
+  ChunkMalloc chunk_malloc_;
+  ChunkFree chunk_free_;
+  std::vector<std::unique_ptr<SizeClass>> size_classes_;
+
+  // frees walk the published index without locking, a replaced index is deleted once no one reads
+  std::mutex slab_mutex_;
+  std::atomic<const SlabIndex *> slab_index_;
+  std::unique_ptr<SlabIndex> current_index_;
+  std::vector<std::unique_ptr<SlabIndex>> retired_indexes_;
+  mutable std::atomic<int64_t> index_readers_;
+
+  // thread caches holding an older generation drop their objects
+  std::atomic<uint64_t> generation_;
+  std::atomic<int64_t> in_use_count_;
+
+  std::atomic<uint64_t> hit_count_;
+  std::atomic<uint64_t> miss_count_;
+  std::atomic<size_t> slab_bytes_;
+  std::atomic<size_t> using_bytes_;
+  std::atomic<uint64_t> requested_bytes_;
+  std::atomic<uint64_t> granted_bytes_;
+};
+}  // namespace ge
+#endif  // GE_GRAPH_MANAGER_GRAPH_SLAB_ALLOCATOR_H_
@@ -26,7 +26,8 @@
 #include "graph/manager/graph_var_manager.h"
 #include "external/graph/types.h"
 #include "graph/utils/type_utils.h"
-#include "common/thread_pool.h"
+#include "common/compile_executor.h"
+#include "common/thread_context_guard.h"
 #include <algorithm>
 
 namespace ge {
@@ -421,8 +422,50 @@ Status TransVarDataUtils::TransAllVarData(const vector<NodePtr> &variable_nodes,
                                           rtContext_t context,
                                           uint32_t graph_id,
                                           uint32_t thread_num) {
-  ThreadPool executor(thread_num);
-  std::vector<std::future<Status>> vector_future;
+  const auto error_context = ErrorManager::GetInstance().GetErrorManagerContext();
+  const auto trans_var = [session_id, context, graph_id, &error_context](const NodePtr &node) -> Status {
+    ThreadContextGuard context_guard;
+    ErrorManager::GetInstance().SetErrorContext(error_context);
+    rtError_t rt_ret = rtCtxSetCurrent(context);
+    if (rt_ret != RT_ERROR_NONE) {
+      REPORT_CALL_ERROR("E19999", "Call rtCtxSetCurrent failed, session_id:%lu, graph_id:%u, ret:0x%X,",
+                        session_id, graph_id, rt_ret);
+      GELOGE(RT_FAILED, "[Call][RtCtxSetCurrent] failed, session_id:%lu, graph_id:%u, ret:0x%X,",
+             session_id, graph_id, rt_ret);
+      return RT_ERROR_TO_GE_STATUS(rt_ret);
+    }
+    uint32_t allocated_graph_id = 0;
+    Status ret = VarManager::Instance(session_id)->GetAllocatedGraphId(node->GetName(), allocated_graph_id);
+    if (ret != SUCCESS) {
+      REPORT_CALL_ERROR("E19999", "Get allocated GraphId failed, session_id:%lu, graph_id:%u, ret:0x%X,",
+                        session_id, graph_id, ret);
+      GELOGE(INTERNAL_ERROR, "[Get][AllocatedGraphId] failed, node:%s, graph_id:%u.",
+             node->GetName().c_str(), graph_id);
+      return INTERNAL_ERROR;
+    }
+    uint32_t changed_graph_id = 0;
+    ret = VarManager::Instance(session_id)->GetChangedGraphId(node->GetName(), changed_graph_id);
+    bool call_trans_var =
+        (ret == SUCCESS && changed_graph_id == graph_id && changed_graph_id != allocated_graph_id);
+    if (call_trans_var) {
+      GELOGI("VarManager::GetChangedGraphId() success, node:%s, graph_id:%u.", node->GetName().c_str(), graph_id);
+      VarTransRoad *trans_road = VarManager::Instance(session_id)->GetTransRoad(node->GetName());
+      if (trans_road == nullptr) {
+        GELOGI("The variable %s does not have any trans road", node->GetName().c_str());
+        return SUCCESS;
+      }
+      ret = TransVarData(node, *trans_road, session_id);
+      if (ret != SUCCESS) {
+        GELOGE(INTERNAL_ERROR, "[Trans][VarData] failed, node:%s, graph_id:%u, session_id:%lu.",
+               node->GetName().c_str(), graph_id, session_id);
+        return INTERNAL_ERROR;
+      }
+      VarManager::Instance(session_id)->RemoveChangedGraphId(node->GetName());
+    }
+    return SUCCESS;
+  };
+
+  std::vector<CompileExecutor::Task> tasks;
   for (auto &node : variable_nodes) {
     if (node == nullptr) {
       continue;
@@ -432,63 +475,15 @@ Status TransVarDataUtils::TransAllVarData(const vector<NodePtr> &variable_nodes,
       continue;
     }
 
-    std::future<Status> f = executor.commit(
-        [](const ge::NodePtr &node, uint64_t session_id, rtContext_t ctx, uint32_t graph_id,
-           const struct error_message::Context &error_context) -> Status {
-          ErrorManager::GetInstance().SetErrorContext(error_context);
-          rtError_t rt_ret = rtCtxSetCurrent(ctx);
-          if (rt_ret != RT_ERROR_NONE) {
-            REPORT_CALL_ERROR("E19999", "Call rtCtxSetCurrent failed, session_id:%lu, graph_id:%u, ret:0x%X,",
-                              session_id, graph_id, rt_ret);
-            GELOGE(RT_FAILED, "[Call][RtCtxSetCurrent] failed, session_id:%lu, graph_id:%u, ret:0x%X,",
-                   session_id, graph_id, rt_ret);
-            return RT_ERROR_TO_GE_STATUS(rt_ret);
-          }
-          uint32_t allocated_graph_id = 0;
-          Status ret = VarManager::Instance(session_id)->GetAllocatedGraphId(node->GetName(), allocated_graph_id);
-          if (ret != SUCCESS) {
-            REPORT_CALL_ERROR("E19999", "Get allocated GraphId failed, session_id:%lu, graph_id:%u, ret:0x%X,",
-                              session_id, graph_id, ret);
-            GELOGE(INTERNAL_ERROR, "[Get][AllocatedGraphId] failed, node:%s, graph_id:%u.",
-                   node->GetName().c_str(), graph_id);
-            return INTERNAL_ERROR;
-          }
-          uint32_t changed_graph_id = 0;
-          ret = VarManager::Instance(session_id)->GetChangedGraphId(node->GetName(), changed_graph_id);
-          bool call_trans_var =
-              (ret == SUCCESS && changed_graph_id == graph_id && changed_graph_id != allocated_graph_id);
-          if (call_trans_var) {
-            GELOGI("VarManager::GetChangedGraphId() success, node:%s, graph_id:%u.", node->GetName().c_str(), graph_id);
-            VarTransRoad *trans_road = VarManager::Instance(session_id)->GetTransRoad(node->GetName());
-            if (trans_road == nullptr) {
-              GELOGI("The variable %s does not have any trans road", node->GetName().c_str());
-              return SUCCESS;
-            }
-            ret = TransVarData(node, *trans_road, session_id);
-            if (ret != SUCCESS) {
-              GELOGE(INTERNAL_ERROR, "[Trans][VarData] failed, node:%s, graph_id:%u, session_id:%lu.",
-                     node->GetName().c_str(), graph_id, session_id);
-              return INTERNAL_ERROR;
-            }
-            VarManager::Instance(session_id)->RemoveChangedGraphId(node->GetName());
-          }
-          return SUCCESS;
-        },
-        node, session_id, context, graph_id, ErrorManager::GetInstance().GetErrorManagerContext());
-    if (!f.valid()) {
-      GELOGE(FAILED, "[Check][Param] Future is invalid, session id:%lu, graph id:%u", session_id, graph_id);
-      return FAILED;
-    }
-    vector_future.push_back(std::move(f));
+    CompileExecutor::Task task;
+    task.func = [&trans_var, node]() { return trans_var(node); };
+    tasks.emplace_back(std::move(task));
   }
 
-  Status ret_status;
-  for (size_t i = 0; i < vector_future.size(); ++i) {
-    ret_status = vector_future[i].get();
-    if (ret_status != SUCCESS) {
-      GELOGE(ret_status, "[Check][Param] trans %zu vardata failed", i);
-      return ret_status;
-    }
+  Status ret_status = CompileExecutor::GetInstance().Run("TransAllVarData", tasks, thread_num);
+  if (ret_status != SUCCESS) {
+    GELOGE(ret_status, "[Trans][VarData] failed, session id:%lu, graph id:%u", session_id, graph_id);
+    return ret_status;
   }
 
   return SUCCESS;
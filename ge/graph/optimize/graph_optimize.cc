@@ -20,6 +20,7 @@
 #include "graph/ge_context.h"
 #include "common/local_context.h"
 #include "graph/passes/dimension_adjust_pass.h"
+#include "graph/passes/pass_report.h"
 #include "inc/pass_manager.h"
 #include "init/gelib.h"
 
@@ -124,7 +125,10 @@ Status GraphOptimize::OptimizeSubGraph(ComputeGraphPtr &compute_graph, const std
     }
 
     for (auto iter = graph_optimizer.begin(); iter != graph_optimizer.end(); ++iter) {
+      const size_t node_num = compute_graph->GetDirectNodesSize();
+      GraphPassRecorder recorder("graph_optimizer", engine_name + "::OptimizeFusedGraph", node_num);
       ret = (*iter)->OptimizeFusedGraph(*(compute_graph));
+      recorder.Finish(node_num, compute_graph->GetDirectNodesSize(), ret == SUCCESS);
       if (ret != SUCCESS) {
         REPORT_INNER_ERROR("E19999", "Call OptimizeFusedGraph failed, ret:%d, engine_name:%s, "
                            "graph_name:%s", ret, engine_name.c_str(),
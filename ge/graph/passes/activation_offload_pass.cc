@@ -0,0 +1,355 @@
+/**
+* Copyright 2021, 2022 LuoJiaNET Research and Development Group, Wuhan University
+* Copyright 2021, 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "graph/passes/activation_offload_pass.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <limits>
+#include <set>
+
+#include "common/ge/ge_util.h"
+#include "external/ge/ge_api_types.h"
+#include "framework/common/debug/ge_log.h"
+#include "framework/common/types.h"
+#include "graph/build/memory/block_mem_assigner.h"
+#include "graph/debug/ge_attr_define.h"
+#include "graph/ge_context.h"
+#include "graph/utils/attr_utils.h"
+#include "graph/utils/graph_utils.h"
+#include "graph/utils/op_desc_utils.h"
+#include "graph/utils/tensor_utils.h"
+
+namespace ge {
+namespace {
+const int kDecimal = 10;
+const int64_t kKiloBytes = 1024;
+const size_t kDefaultMinGap = 32U;
+const int64_t kDefaultMinSize = 1024 * kKiloBytes;
+// the copy back is started this part of the minimum gap ahead of the first late use
+const size_t kPrefetchGapDivisor = 4U;
+// about 16GB/s between host and device, to estimate the time the copies add to a run
+const int64_t kHostCopyBytesPerUs = 16 * kKiloBytes;
+
+// outputs of these nodes are not feature map
+const std::set<std::string> kNotFeatureMapTypes = {DATA, AIPPDATA, VARIABLE, VARIABLEV2, CONSTANT, CONSTANTOP,
+                                                    FILECONSTANT};
+
+int64_t GetTensorSize(const GeTensorDesc &tensor_desc) {
+  int64_t size = 0;
+  if ((TensorUtils::GetSize(tensor_desc, size) == GRAPH_SUCCESS) && (size > 0)) {
+    return size;
+  }
+  // sizes are not calculated before building, shapes of unknown ones fail here
+  if ((TensorUtils::GetTensorSizeInBytes(tensor_desc, size) != GRAPH_SUCCESS) || (size < 0)) {
+    return 0;
+  }
+  return size;
+}
+
+// nodes in control flow, of special memory or already on side streams are left as they are
+bool IsOrdinaryNode(const NodePtr &node) {
+  const auto &op_desc = node->GetOpDesc();
+  return (op_desc != nullptr) && (node->GetType() != NETOUTPUT) && op_desc->GetSubgraphInstanceNames().empty() &&
+         !op_desc->HasAttr(ATTR_NAME_STREAM_LABEL) && !op_desc->HasAttr(ATTR_NAME_PARALLEL_GROUP) &&
+         !op_desc->HasAttr(ATTR_NAME_OUTPUT_MEM_TYPE_LIST) && !op_desc->HasAttr(ATTR_NAME_INPUT_MEM_TYPE_LIST);
+}
+
+bool IsHostSwapOutput(const OpDescPtr &op_desc, int32_t index) {
+  std::vector<int64_t> mem_types;
+  if (!AttrUtils::GetListInt(op_desc, ATTR_NAME_OUTPUT_MEM_TYPE_LIST, mem_types) || (index < 0) ||
+      (static_cast<size_t>(index) >= mem_types.size())) {
+    return false;
+  }
+  return (static_cast<uint64_t>(mem_types[index]) & kHostSwapMemory) == kHostSwapMemory;
+}
+}  // namespace
+
+ActivationOffloadPass::ActivationOffloadPass() {
+  std::string enabled;
+  (void)GetContext().GetOption(MEMORY_ACTIVATION_OFFLOAD, enabled);  // option may not be set up
+  enabled_ = (enabled == "1");
+  std::string min_gap = std::to_string(kDefaultMinGap);
+  (void)GetContext().GetOption(MEMORY_ACTIVATION_OFFLOAD_MIN_GAP, min_gap);
+  min_gap_ = static_cast<size_t>(std::max<int64_t>(0, std::strtol(min_gap.c_str(), nullptr, kDecimal)));
+  std::string min_size = std::to_string(kDefaultMinSize / kKiloBytes);
+  (void)GetContext().GetOption(MEMORY_ACTIVATION_OFFLOAD_MIN_SIZE, min_size);
+  int64_t size = std::strtol(min_size.c_str(), nullptr, kDecimal);
+  min_size_ = std::max<int64_t>(0, std::min(size, std::numeric_limits<int64_t>::max() / kKiloBytes)) * kKiloBytes;
+}
+
+Status ActivationOffloadPass::Run(ComputeGraphPtr graph) {
+  GE_CHECK_NOTNULL(graph);
+  if (!enabled_) {
+    return SUCCESS;
+  }
+  if ((graph->GetParentGraph() != nullptr) || graph->GetGraphUnknownFlag()) {
+    GELOGD("Graph %s is a subgraph or of unknown shape, skip activation offload.", graph->GetName().c_str());
+    return SUCCESS;
+  }
+  if (graph->TopologicalSorting() != GRAPH_SUCCESS) {
+    GELOGE(FAILED, "[TopoSort][Graph]Graph:%s topological sort failed.", graph->GetName().c_str());
+    REPORT_CALL_ERROR("E19999", "Graph:%s topological sort failed when ActivationOffloadPass run.",
+                      graph->GetName().c_str());
+    return FAILED;
+  }
+  EstimateLives(graph);
+  offloads_.clear();
+  offload_num_ = 0;
+  copy_size_ = 0;
+  copy_time_us_ = 0;
+  size_t peak_order = 0;
+  peak_before_ = GetPeak(peak_order);
+  peak_after_ = peak_before_;
+
+  std::vector<Offload> candidates;
+  for (const auto &life : lives_) {
+    Offload offload;
+    if (IsOffloadable(life) && GetGap(life, offload)) {
+      candidates.emplace_back(offload);
+    }
+  }
+  // an offload only lowers the peak if the output is idle there, pick the largest size times gap of these each time
+  std::vector<bool> picked(candidates.size(), false);
+  while (true) {
+    size_t best = candidates.size();
+    double best_score = 0.0;
+    for (size_t i = 0; i < candidates.size(); ++i) {
+      const auto &candidate = candidates[i];
+      if (picked[i] || (candidate.idle_begin > peak_order) || (candidate.idle_end < peak_order)) {
+        continue;
+      }
+      double score = static_cast<double>(candidate.output->size) *
+                     static_cast<double>(candidate.first_late_order - candidate.last_early_order);
+      if (score > best_score) {
+        best_score = score;
+        best = i;
+      }
+    }
+    if (best == candidates.size()) {
+      break;
+    }
+    picked[best] = true;
+    offloads_.emplace_back(candidates[best]);
+    copy_size_ += candidates[best].output->size * 2;  // out to host and back
+    peak_after_ = GetPeak(peak_order);
+  }
+  if (offloads_.empty()) {
+    GELOGD("No output of graph %s is worth offloading, %zu candidates.", graph->GetName().c_str(), candidates.size());
+    return SUCCESS;
+  }
+
+  for (size_t i = 0; i < offloads_.size(); ++i) {
+    GE_CHK_STATUS_RET(InsertSwapNodes(graph, offloads_[i], i), "[Insert][SwapNodes] for node %s of graph %s failed.",
+                      offloads_[i].output->node->GetName().c_str(), graph->GetName().c_str());
+  }
+  if (graph->TopologicalSorting() != GRAPH_SUCCESS) {
+    GELOGE(FAILED, "[TopoSort][Graph]Graph:%s topological sort failed.", graph->GetName().c_str());
+    REPORT_CALL_ERROR("E19999", "Graph:%s topological sort failed when ActivationOffloadPass run.",
+                      graph->GetName().c_str());
+    return FAILED;
+  }
+  // the plan was made on the order before the copies were inserted, estimate the peak again on the new order
+  offload_num_ = offloads_.size();
+  offloads_.clear();
+  EstimateLives(graph);
+  peak_after_ = GetPeak(peak_order);
+  if (peak_after_ >= peak_before_) {
+    GELOGW("[ActivationOffload] feature map peak of graph %s is not lowered after re-sorting, %ld -> %ld.",
+           graph->GetName().c_str(), peak_before_, peak_after_);
+  }
+  (void)AttrUtils::SetInt(graph, kAttrNameActivationOffloadPeakBefore, peak_before_);
+  (void)AttrUtils::SetInt(graph, kAttrNameActivationOffloadPeakAfter, peak_after_);
+  // the copies run on the stream of the compute, nothing overlaps them
+  copy_time_us_ = copy_size_ / kHostCopyBytesPerUs;
+  (void)AttrUtils::SetInt(graph, kAttrNameActivationOffloadCopySize, copy_size_);
+  (void)AttrUtils::SetInt(graph, kAttrNameActivationOffloadCopyTime, copy_time_us_);
+  GEEVENT("[ActivationOffload] graph %s, %zu outputs offloaded, estimated feature map peak %ld -> %ld, "
+          "%ld bytes saved against %ld bytes copied per run, adding about %ld us of serialized copies.",
+          graph->GetName().c_str(), offload_num_, peak_before_, peak_after_, peak_before_ - peak_after_, copy_size_,
+          copy_time_us_);
+  return SUCCESS;
+}
+
+void ActivationOffloadPass::EstimateLives(const ComputeGraphPtr &graph) {
+  nodes_.clear();
+  node_orders_.clear();
+  lives_.clear();
+  for (const auto &node : graph->GetDirectNode()) {
+    node_orders_[node.get()] = nodes_.size();
+    nodes_.emplace_back(node);
+  }
+
+  for (size_t order = 0; order < nodes_.size(); ++order) {
+    const auto &node = nodes_[order];
+    if ((node->GetOpDesc() == nullptr) || (kNotFeatureMapTypes.count(node->GetType()) > 0)) {
+      continue;
+    }
+    for (const auto &out_anchor : node->GetAllOutDataAnchors()) {
+      if (IsHostSwapOutput(node->GetOpDesc(), out_anchor->GetIdx())) {
+        continue;
+      }
+      OutputLife life;
+      life.node = node;
+      life.index = out_anchor->GetIdx();
+      life.begin = order;
+      life.end = order;
+      auto output_desc = node->GetOpDesc()->GetOutputDescPtr(static_cast<uint32_t>(out_anchor->GetIdx()));
+      life.size = (output_desc == nullptr) ? 0 : GetTensorSize(*output_desc);
+      for (const auto &in_anchor : out_anchor->GetPeerInDataAnchors()) {
+        auto iter = node_orders_.find(in_anchor->GetOwnerNode().get());
+        if (iter != node_orders_.end()) {
+          life.consumer_orders.emplace_back(iter->second);
+          life.end = std::max(life.end, iter->second);
+        }
+      }
+      std::sort(life.consumer_orders.begin(), life.consumer_orders.end());
+      lives_.emplace_back(life);
+    }
+  }
+}
+
+bool ActivationOffloadPass::IsOffloadable(const OutputLife &life) const {
+  if ((life.size <= 0) || (life.size < min_size_) || life.consumer_orders.empty() || !IsOrdinaryNode(life.node)) {
+    return false;
+  }
+  for (const auto &order : life.consumer_orders) {
+    if (!IsOrdinaryNode(nodes_[order])) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool ActivationOffloadPass::GetGap(const OutputLife &life, Offload &offload) const {
+  // the longest span between two adjacent uses, the producer included
+  size_t last_use = life.begin;
+  size_t max_gap = 0;
+  for (const auto &order : life.consumer_orders) {
+    if (order - last_use > max_gap) {
+      max_gap = order - last_use;
+      offload.last_early_order = last_use;
+      offload.first_late_order = order;
+    }
+    last_use = order;
+  }
+  if ((max_gap < min_gap_) || (max_gap <= 1)) {
+    return false;
+  }
+  // the copy back runs some nodes ahead of the first late use, instead of right before it. Any node ordered before
+  // the use is a valid anchor, it is not a successor of the use
+  size_t prefetch_distance = std::max<size_t>(1U, min_gap_ / kPrefetchGapDivisor);
+  if (offload.first_late_order <= offload.last_early_order + prefetch_distance + 1U) {
+    return false;
+  }
+  size_t prefetch_order = offload.first_late_order - prefetch_distance - 1U;
+  offload.output = &life;
+  offload.idle_begin = offload.last_early_order + 1;
+  offload.idle_end = prefetch_order;
+  return true;
+}
+
+int64_t ActivationOffloadPass::GetPeak(size_t &peak_order) const {
+  std::vector<int64_t> changes(nodes_.size() + 1, 0);
+  for (const auto &life : lives_) {
+    changes[life.begin] += life.size;
+    changes[life.end + 1] -= life.size;
+  }
+  for (const auto &offload : offloads_) {
+    changes[offload.idle_begin] -= offload.output->size;
+    changes[offload.idle_end + 1] += offload.output->size;
+  }
+  int64_t peak = 0;
+  int64_t alive_size = 0;
+  peak_order = 0;
+  for (size_t order = 0; order < nodes_.size(); ++order) {
+    alive_size += changes[order];
+    if (alive_size > peak) {
+      peak = alive_size;
+      peak_order = order;
+    }
+  }
+  return peak;
+}
+
+Status ActivationOffloadPass::InsertSwapNodes(const ComputeGraphPtr &graph, const Offload &offload, size_t index) {
+  const auto &node = offload.output->node;
+  auto out_anchor = node->GetOutDataAnchor(offload.output->index);
+  GE_CHECK_NOTNULL(out_anchor);
+  const GeTensorDesc &tensor_desc = node->GetOpDesc()->GetOutputDesc(static_cast<uint32_t>(offload.output->index));
+  const std::vector<int64_t> host_mem_types = {static_cast<int64_t>(kHostSwapMemory | RT_MEMORY_HBM)};
+
+  OpDescBuilder swap_out_builder(node->GetName() + "_swap_out_" + std::to_string(index), MEMCPYASYNC);
+  auto swap_out_op = swap_out_builder.AddInput("x", tensor_desc).AddOutput("y", tensor_desc).Build();
+  OpDescBuilder swap_in_builder(node->GetName() + "_swap_in_" + std::to_string(index), MEMCPYASYNC);
+  auto swap_in_op = swap_in_builder.AddInput("x", tensor_desc).AddOutput("y", tensor_desc).Build();
+  GE_CHECK_NOTNULL(swap_out_op);
+  GE_CHECK_NOTNULL(swap_in_op);
+  (void)AttrUtils::SetListInt(swap_out_op, ATTR_NAME_OUTPUT_MEM_TYPE_LIST, host_mem_types);
+  (void)AttrUtils::SetListInt(swap_in_op, ATTR_NAME_INPUT_MEM_TYPE_LIST, host_mem_types);
+  (void)AttrUtils::SetStr(swap_out_op, kAttrNameActivationOffloadFrom, node->GetName());
+  (void)AttrUtils::SetStr(swap_in_op, kAttrNameActivationOffloadFrom, node->GetName());
+  NodePtr swap_out_node = graph->AddNode(swap_out_op);
+  NodePtr swap_in_node = graph->AddNode(swap_in_op);
+  if ((swap_out_node == nullptr) || (swap_in_node == nullptr)) {
+    GELOGE(FAILED, "[Add][Node] swap nodes of %s to graph %s failed.", node->GetName().c_str(),
+           graph->GetName().c_str());
+    REPORT_CALL_ERROR("E19999", "Add swap nodes of %s to graph %s failed.", node->GetName().c_str(),
+                      graph->GetName().c_str());
+    return FAILED;
+  }
+
+  GE_CHK_GRAPH_STATUS_RET(GraphUtils::AddEdge(out_anchor, swap_out_node->GetInDataAnchor(0)),
+                          "[Add][Edge] from %s to %s failed.", node->GetName().c_str(),
+                          swap_out_node->GetName().c_str());
+  GE_CHK_GRAPH_STATUS_RET(GraphUtils::AddEdge(swap_out_node->GetOutDataAnchor(0), swap_in_node->GetInDataAnchor(0)),
+                          "[Add][Edge] from %s to %s failed.", swap_out_node->GetName().c_str(),
+                          swap_in_node->GetName().c_str());
+  for (auto iter = std::lower_bound(offload.output->consumer_orders.begin(), offload.output->consumer_orders.end(),
+                                    offload.first_late_order);
+       iter != offload.output->consumer_orders.end(); ++iter) {
+    const auto &consumer = nodes_[*iter];
+    for (const auto &in_anchor : consumer->GetAllInDataAnchors()) {
+      if (in_anchor->GetPeerOutAnchor() != out_anchor) {
+        continue;
+      }
+      GE_CHK_GRAPH_STATUS_RET(GraphUtils::RemoveEdge(out_anchor, in_anchor), "[Remove][Edge] from %s to %s failed.",
+                              node->GetName().c_str(), consumer->GetName().c_str());
+      GE_CHK_GRAPH_STATUS_RET(GraphUtils::AddEdge(swap_in_node->GetOutDataAnchor(0), in_anchor),
+                              "[Add][Edge] from %s to %s failed.", swap_in_node->GetName().c_str(),
+                              consumer->GetName().c_str());
+    }
+  }
+
+  // copy out once the early uses are done, copy back once the other inputs of the first late use are ready
+  const auto &last_early_node = nodes_[offload.last_early_order];
+  if (last_early_node != node) {
+    GE_CHK_GRAPH_STATUS_RET(
+        GraphUtils::AddEdge(last_early_node->GetOutControlAnchor(), swap_out_node->GetInControlAnchor()),
+        "[Add][ControlEdge] from %s to %s failed.", last_early_node->GetName().c_str(),
+        swap_out_node->GetName().c_str());
+  }
+  const auto &prefetch_node = nodes_[offload.idle_end];
+  GE_CHK_GRAPH_STATUS_RET(GraphUtils::AddEdge(prefetch_node->GetOutControlAnchor(), swap_in_node->GetInControlAnchor()),
+                          "[Add][ControlEdge] from %s to %s failed.", prefetch_node->GetName().c_str(),
+                          swap_in_node->GetName().c_str());
+  GELOGD("Output %d of node %s, size %ld, is swapped out after %s and in after %s, idle from %zu to %zu.",
+         offload.output->index, node->GetName().c_str(), offload.output->size, last_early_node->GetName().c_str(),
+         prefetch_node->GetName().c_str(), offload.idle_begin, offload.idle_end);
+  return SUCCESS;
+}
+}  // namespace ge
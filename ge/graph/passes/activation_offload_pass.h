@@ -0,0 +1,116 @@
+/**
+* Copyright 2021, 2022 LuoJiaNET Research and Development Group, Wuhan University
+* Copyright 2021, 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef GE_GRAPH_PASSES_ACTIVATION_OFFLOAD_PASS_H_
+#define GE_GRAPH_PASSES_ACTIVATION_OFFLOAD_PASS_H_
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include "inc/graph_pass.h"
+
+namespace ge {
+// attrs of the graph, estimated feature map peaks before and after offloading and the bytes copied per iteration
+const char *const kAttrNameActivationOffloadPeakBefore = "_activation_offload_peak_before";
+const char *const kAttrNameActivationOffloadPeakAfter = "_activation_offload_peak_after";
+const char *const kAttrNameActivationOffloadCopySize = "_activation_offload_copy_size";
+// attr of the graph, estimated time in us the copies add to an iteration
+const char *const kAttrNameActivationOffloadCopyTime = "_activation_offload_copy_time_us";
+// attr of the swap nodes, name of the node whose output is offloaded
+const char *const kAttrNameActivationOffloadFrom = "_activation_offload_from";
+
+///
+/// Trade feature map memory for host transfers by swapping long idle outputs out to host memory.
+/// Life times of the outputs are estimated like BlockMemAssigner does. The idle gap of an output is the longest span
+/// between two adjacent uses of it. The planner picks the output with the largest size times gap among those idle at
+/// the feature map peak, as long as its gap and size reach the thresholds, and repeats on the new peak. For each
+/// output picked, a MemcpyAsync copies it to host memory after its early uses and another one copies it back a quarter
+/// of the minimum gap ahead of its first late use. The copies stay on the stream of the producer and the consumers, so
+/// the block assigner releases the device blocks on that stream and reuses them. They are serialized with the compute
+/// there, the time they add is estimated and reported next to the bytes saved.
+///
+class ActivationOffloadPass : public GraphPass {
+ public:
+  ActivationOffloadPass();
+  ~ActivationOffloadPass() override = default;
+
+  Status Run(ComputeGraphPtr graph) override;
+
+  ///
+  /// @brief set by option MEMORY_ACTIVATION_OFFLOAD
+  ///
+  void SetEnabled(bool enabled) { enabled_ = enabled; }
+
+  ///
+  /// @brief set by option MEMORY_ACTIVATION_OFFLOAD_MIN_GAP, in nodes between two adjacent uses of an output
+  ///
+  void SetMinGap(size_t min_gap) { min_gap_ = min_gap; }
+
+  ///
+  /// @brief set in bytes by option MEMORY_ACTIVATION_OFFLOAD_MIN_SIZE
+  ///
+  void SetMinSize(int64_t min_size) { min_size_ = min_size; }
+
+  int64_t GetPeakBefore() const { return peak_before_; }
+  int64_t GetPeakAfter() const { return peak_after_; }
+  int64_t GetCopySize() const { return copy_size_; }
+  int64_t GetCopyTimeUs() const { return copy_time_us_; }
+  size_t GetOffloadNum() const { return offload_num_; }
+
+ private:
+  struct OutputLife {
+    NodePtr node;
+    int32_t index = 0;
+    int64_t size = 0;
+    size_t begin = 0;
+    size_t end = 0;
+    std::vector<size_t> consumer_orders;
+  };
+
+  struct Offload {
+    const OutputLife *output = nullptr;
+    // last use before the gap and first use after it
+    size_t last_early_order = 0;
+    size_t first_late_order = 0;
+    // the output is not on device from idle_begin to idle_end, both included
+    size_t idle_begin = 0;
+    size_t idle_end = 0;
+  };
+
+  void EstimateLives(const ComputeGraphPtr &graph);
+  bool IsOffloadable(const OutputLife &life) const;
+  bool GetGap(const OutputLife &life, Offload &offload) const;
+  int64_t GetPeak(size_t &peak_order) const;
+  Status InsertSwapNodes(const ComputeGraphPtr &graph, const Offload &offload, size_t index);
+
+  bool enabled_ = false;
+  size_t min_gap_ = 0;
+  int64_t min_size_ = 0;
+  int64_t peak_before_ = 0;
+  int64_t peak_after_ = 0;
+  int64_t copy_size_ = 0;
+  int64_t copy_time_us_ = 0;
+  size_t offload_num_ = 0;
+  std::vector<NodePtr> nodes_;
+  std::map<const Node *, size_t> node_orders_;
+  std::vector<OutputLife> lives_;
+  std::vector<Offload> offloads_;
+};
+}  // namespace ge
+
+#endif  // GE_GRAPH_PASSES_ACTIVATION_OFFLOAD_PASS_H_
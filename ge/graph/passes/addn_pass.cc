@@ -24,6 +24,10 @@ namespace {
 const size_t kInputSizeSingle = 1;
 }  // namespace
 
+AddNPass::AddNPass() {
+  SetInterestedTypes({ADDN});
+}
+
 Status AddNPass::Run(NodePtr &node) {
   GELOGD("AddNPass running");
   if (node == nullptr) {
@@ -29,6 +29,7 @@
 namespace ge {
 class AddNPass : public BaseNodePass {
  public:
+  AddNPass();
   Status Run(ge::NodePtr &node) override;
 };
 }  // namespace ge
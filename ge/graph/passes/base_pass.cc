@@ -17,18 +17,34 @@
 
 #include "graph/passes/base_pass.h"
 
+#include <chrono>
 #include <queue>
 #include <unordered_set>
 
 #include "common/debug/log.h"
+#include "framework/common/types.h"
+#include "graph/passes/pass_report.h"
 #include "graph/utils/graph_utils.h"
 
 namespace ge {
 namespace {
 constexpr int kMaxRePassTimes = 10000;
 constexpr size_t kMaxOneInNodes = 1000;
-// Each iteration, we take about 0.3k memory on the stack, we should change the recursion to loop later
-constexpr int kMaxRecursiveDepth = 20;
+// The sub graphs are passed by a stack on heap, the limit only stops the sub graphs referring to themselves
+constexpr size_t kMaxSubGraphDepth = 1024;
+
+bool IsAllInNodesSeen(const NodePtr &node, const GEPass::GraphLevelState &g_state) {
+  // the same as Node::IsAllInNodesSeen, by the seen bits
+  for (const auto &in_node : node->GetInAllNodes()) {
+    if ((in_node->GetType() == NEXTITERATION) || (in_node->GetType() == REFNEXTITERATION)) {
+      continue;
+    }
+    if (!g_state.HasState(in_node.get(), GEPass::kNodeSeen)) {
+      return false;
+    }
+  }
+  return true;
+}
 
 void GetAllNodesNoInputEdge(const ComputeGraphPtr &graph,
                             GEPass::GraphLevelState &g_state) {
@@ -40,14 +56,17 @@ void GetAllNodesNoInputEdge(const ComputeGraphPtr &graph,
     if (in_nums == 0) {
       g_state.AddNodeToQueueIfNotSeen(node);
     } else if (in_nums > kMaxOneInNodes) {
-      g_state.nodes_last.insert(node);
+      g_state.AddNodeLast(node);
     }
   }
 }
 
-bool AnyNodesIn(const Node::Vistor<NodePtr> &nodes, const std::unordered_set<NodePtr> &nodes_set) {
+bool AnyNodesSuspend(const Node::Vistor<NodePtr> &nodes, const GEPass::GraphLevelState &g_state) {
+  if (g_state.suspend_num == 0U) {
+    return false;
+  }
   return std::any_of(nodes.begin(), nodes.end(), [&](const NodePtr &n) {
-    return nodes_set.count(n) > 0;
+    return g_state.HasState(n.get(), GEPass::kNodeSuspend);
   });
 }
 
@@ -57,27 +76,27 @@ bool IsNodeReadyToQueue(const NodePtr &node, GEPass::GraphLevelState &g_state) {
     GELOGW("node is null");
     return false;
   }
-  if (g_state.nodes_deleted.count(node) > 0) {
+  if (g_state.HasState(node.get(), GEPass::kNodeDeleted)) {
     GELOGD("The node %s was deleted before, skip it.", node->GetName().c_str());
     return false;
   }
 
-  if (g_state.nodes_last.count(node) != 0) {
+  if (g_state.HasState(node.get(), GEPass::kNodeLast)) {
     return false;
   }
 
   // all in_node seen && all in_node not suspend
-  if (!node->IsAllInNodesSeen(g_state.nodes_seen)) {
+  if (!IsAllInNodesSeen(node, g_state)) {
     return false;
   }
 
-  if (g_state.nodes_suspend.count(node) > 0) {
+  if (g_state.HasState(node.get(), GEPass::kNodeSuspend)) {
     GELOGD("The node %s has been added to suspend-iteration nodes list, the iteration of it will be suspend.",
            node->GetName().c_str());
     return false;
   }
 
-  if (AnyNodesIn(node->GetInAllNodes(), g_state.nodes_suspend)) {
+  if (AnyNodesSuspend(node->GetInAllNodes(), g_state)) {
     GELOGD("The node %s has been added to suspend-iteration nodes list, the iteration of it will be suspend.",
            node->GetName().c_str());
     return false;
@@ -127,7 +146,7 @@ void AddImmediateRepassNodesToQueue(NodePtr &cur_node,
              cur_node->GetName().c_str(), cur_node->GetType().c_str());
       continue;
     }
-    if (g_state.nodes_passed.count(imme_repass_node) > 0) {
+    if (g_state.HasState(imme_repass_node.get(), GEPass::kNodePassed)) {
       GELOGD("The node %s specified by pass %s has been passed, it will repass immediately",
              imme_repass_node->GetName().c_str(), node_2_pass_names.second.c_str());
       g_state.AddNodeToQueueFront(imme_repass_node);
@@ -140,11 +159,11 @@ void AddImmediateRepassNodesToQueue(NodePtr &cur_node,
 
 void AddLastNodesToQueue(GEPass::GraphLevelState &g_state) {
   for (auto &node : g_state.nodes_last) {
-    if (node->IsAllInNodesSeen(g_state.nodes_seen)) {
+    if (IsAllInNodesSeen(node, g_state)) {
       g_state.AddNodeToQueueIfNotSeen(node);
     }
   }
-  g_state.nodes_last.clear();
+  g_state.ClearNodesLast();
 }
 
 void AddResumeNodesToQueue(const std::unordered_map<NodePtr, std::string> resume_node_2_pass_names,
@@ -154,8 +173,8 @@ void AddResumeNodesToQueue(const std::unordered_map<NodePtr, std::string> resume
   // Better way to record the order, and here suspend or resume in order.
   for (const auto &node_2_pass_names : resume_node_2_pass_names) {
     auto node = node_2_pass_names.first;
-    if (g_state.nodes_suspend.erase(node) > 0) {
-      if (g_state.nodes_seen.count(node.get()) > 0 || node->IsAllInNodesSeen(g_state.nodes_seen)) {
+    if (g_state.EraseNodeSuspend(node)) {
+      if (g_state.HasState(node.get(), GEPass::kNodeSeen) || IsAllInNodesSeen(node, g_state)) {
         g_state.nodes.push_back(node);
         GELOGD("Node %s has been resumed by pass %s, and add to pass queue",
                node->GetName().c_str(), node_2_pass_names.second.c_str());
@@ -165,16 +184,16 @@ void AddResumeNodesToQueue(const std::unordered_map<NodePtr, std::string> resume
 }
 
 void PushToRePassIfSeen(NodePtr &node, const std::pair<std::string, BaseNodePass *> &name_to_pass,
-                        std::unordered_set<Node *> &nodes_seen, const std::vector<NodePtr> &nodes_to_re_pass,
-                        GEPass::RepassLevelState &rp_state) {
+                        const std::vector<NodePtr> &nodes_to_re_pass,
+                        GEPass::GraphLevelState &g_state, GEPass::RepassLevelState &rp_state) {
   for (const auto &node_to_re_pass : nodes_to_re_pass) {
     if (node_to_re_pass == nullptr) {
       GELOGW("Found null re-pass node when executing %s on node %s type %s", name_to_pass.first.c_str(),
              node->GetName().c_str(), node->GetType().c_str());
       continue;
     }
-    if (nodes_seen.count(node_to_re_pass.get()) > 0 || node_to_re_pass->IsAllInNodesSeen(nodes_seen)) {
-      if (rp_state.AddNodeToRepass(node_to_re_pass)) {
+    if (g_state.HasState(node_to_re_pass.get(), GEPass::kNodeSeen) || IsAllInNodesSeen(node_to_re_pass, g_state)) {
+      if (rp_state.AddNodeToRepass(g_state, node_to_re_pass)) {
         GELOGD("The node %s will be re-pass.", node_to_re_pass->GetName().c_str());
         continue;
       }
@@ -196,8 +215,38 @@ void ClearOption(NamesToPass names_to_pass) {
     name_to_pass.second->ClearOptions();
   }
 }
+
+void NotifyPassGraphStart(const ComputeGraphPtr &graph, const NamesToPass &names_to_pass) {
+  for (auto &name_to_pass : names_to_pass) {
+    name_to_pass.second->OnStartPassGraph(graph);
+  }
+}
 }  // namespace
 
+struct GEPass::GraphFrame {
+  enum Stage {
+    kStart,          // notify the passes and find the start nodes
+    kResumeLeaked,   // resume the suspended nodes leaked by the last loop
+    kRePassLoop,     // begin one loop, queue the nodes to re-pass
+    kNextNode,       // pass the nodes in queue
+    kSubGraphs,      // pass the sub graphs of the node one by one
+    kRePassLoopEnd   // all nodes in queue passed, begin the next loop if any node to re-pass or leaked
+  };
+
+  explicit GraphFrame(const ComputeGraphPtr &compute_graph) : graph(compute_graph) {}
+
+  ComputeGraphPtr graph;
+  Stage stage = kStart;
+  GraphLevelState g_state;
+  RepassLevelState rp_state;
+  // the node whose sub graphs are being passed
+  NodePtr node;
+  std::unordered_set<NodePtr> out_nodes_before_pass;
+  std::vector<std::string> sub_graph_names;
+  size_t sub_graph_index = 0U;
+  bool has_sub_graph = false;
+};
+
 Status BaseNodePass::IsolateAndDeleteNode(NodePtr &node, const std::vector<int> &io_map,
                                           bool is_repass_io_immediately) {
   if (node == nullptr) {
@@ -249,22 +298,96 @@ Status GEPass::Run(const NamesToPass &names_to_passes) {
       return INTERNAL_ERROR;
     }
   }
-
-  if (depth_ > kMaxRecursiveDepth) {
-    GELOGE(PARAM_INVALID,
-        "[Check][Param] The pass for root graph %s will be terminated because too many nesting"
-        " levels(%d) of subgraphs, last subgraph is %s",
-        root_graph_->GetName().c_str(), depth_, graph_->GetName().c_str());
-    return PARAM_INVALID;
+  statistics_by_index_.assign(names_to_passes.size(), PassStatistic());
+  node_run_count_ = 0;
+  const bool report_active = PassReport::IsActive();
+  const int64_t mem_kb = report_active ? PassReport::GetResidentMemoryKb() : 0;
+  const auto start = std::chrono::steady_clock::now();
+
+  // the frame on top is the graph being passed, the ones below wait for the sub graphs of their nodes
+  std::vector<std::unique_ptr<GraphFrame>> frames;
+  frames.emplace_back(new (std::nothrow) GraphFrame(graph_));
+  Status ret = SUCCESS;
+  while (!frames.empty()) {
+    if (frames.back() == nullptr) {
+      REPORT_INNER_ERROR("E19999", "New GraphFrame failed.");
+      GELOGE(MEMALLOC_FAILED, "[New][GraphFrame] failed.");
+      ret = MEMALLOC_FAILED;
+      break;
+    }
+    ComputeGraphPtr sub_graph;
+    ret = RunPassesOnFrame(*frames.back(), names_to_passes, sub_graph);
+    if (ret != SUCCESS) {
+      break;
+    }
+    if (sub_graph == nullptr) {
+      // all nodes of the graph passed
+      frames.pop_back();
+      continue;
+    }
+    if (frames.size() > kMaxSubGraphDepth) {
+      GELOGE(PARAM_INVALID,
+             "[Check][Param] The pass for root graph %s will be terminated because too many nesting"
+             " levels(%zu) of subgraphs, last subgraph is %s",
+             root_graph_->GetName().c_str(), frames.size(), sub_graph->GetName().c_str());
+      ret = PARAM_INVALID;
+      break;
+    }
+    frames.emplace_back(new (std::nothrow) GraphFrame(sub_graph));
   }
 
-  return RunPassesOneGraph(names_to_passes);
+  // unwind the parents of the graph failed
+  if (ret != SUCCESS) {
+    frames.pop_back();
+    while (!frames.empty()) {
+      const auto &frame = frames.back();
+      GELOGE(ret, "[Run][Passes] for sub graph:%s from node:%s failed",
+             frame->sub_graph_names[frame->sub_graph_index - 1U].c_str(), frame->node->GetName().c_str());
+      frames.pop_back();
+    }
+  }
+  ReportPassStatistics(names_to_passes);
+  if (report_active) {
+    PassRecord record;
+    record.calls = 1U;
+    record.time_us = static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count());
+    record.nodes_visited = node_run_count_;
+    record.mem_delta_kb = PassReport::GetResidentMemoryKb() - mem_kb;
+    for (const auto &name_to_statistic : pass_statistics_) {
+      record.re_pass_count += name_to_statistic.second.re_pass_count;
+    }
+    PassReport::GetInstance().Record("ge_pass", "GEPass", record);
+  }
+  return ret;
   // todo debug mode is on, find first node in topo order which is not passed. and give a warning
 }
 
-void NotifyPassGraphStart(const ComputeGraphPtr &graph, const NamesToPass &names_to_pass) {
-  for (auto &name_to_pass : names_to_pass) {
-    name_to_pass.second->OnStartPassGraph(graph);
+void GEPass::ReportPassStatistics(const NamesToPass &names_to_passes) {
+  pass_statistics_.clear();
+  for (size_t i = 0U; i < names_to_passes.size(); ++i) {
+    auto &statistic = pass_statistics_[names_to_passes[i].first];
+    statistic.visit_count += statistics_by_index_[i].visit_count;
+    statistic.skip_count += statistics_by_index_[i].skip_count;
+    statistic.cost_time += statistics_by_index_[i].cost_time;
+    statistic.changed_count += statistics_by_index_[i].changed_count;
+    statistic.re_pass_count += statistics_by_index_[i].re_pass_count;
+  }
+  const bool report_active = PassReport::IsActive();
+  for (const auto &name_to_statistic : pass_statistics_) {
+    const auto &statistic = name_to_statistic.second;
+    GELOGI("[GEPass] Pass %s on graph %s visits %lu nodes, skips %lu nodes, changes %lu nodes, cost %lu us.",
+           name_to_statistic.first.c_str(), root_graph_->GetName().c_str(), statistic.visit_count,
+           statistic.skip_count, statistic.changed_count, statistic.cost_time);
+    if (report_active) {
+      PassRecord record;
+      record.calls = 1U;
+      record.time_us = statistic.cost_time;
+      record.nodes_visited = statistic.visit_count;
+      record.nodes_changed = statistic.changed_count;
+      record.re_pass_count = statistic.re_pass_count;
+      PassReport::GetInstance().Record("node_pass", name_to_statistic.first, record);
+    }
   }
 }
 
@@ -285,133 +408,145 @@ Status GEPass::HandleLeakedSuspendNodes(const NamesToPass &names_to_passes, Grap
   return SUCCESS;
 }
 
-Status GEPass::RunPassesOneGraph(const NamesToPass &names_to_passes) {
-  GELOGD("Begin to run pass on graph, passes count %zu", names_to_passes.size());
-  NotifyPassGraphStart(graph_, names_to_passes);
-  GraphLevelState g_state;
-  g_state.re_pass_times = 0;
-  GetAllNodesNoInputEdge(graph_, g_state);
-  GELOGD("Start points count %zu", g_state.nodes.size());
-
-  do {
-    if (!g_state.nodes_suspend.empty()) {
-      auto ret = HandleLeakedSuspendNodes(names_to_passes, g_state);
-      if (ret != SUCCESS) {
-        // log inside upper function
-        return ret;
+Status GEPass::RunPassesOnFrame(GraphFrame &frame, const NamesToPass &names_to_passes, ComputeGraphPtr &sub_graph) {
+  auto &g_state = frame.g_state;
+  auto &rp_state = frame.rp_state;
+  while (true) {
+    switch (frame.stage) {
+      case GraphFrame::kStart: {
+        GELOGD("Begin to run pass on graph %s, passes count %zu", frame.graph->GetName().c_str(),
+               names_to_passes.size());
+        NotifyPassGraphStart(frame.graph, names_to_passes);
+        g_state.re_pass_times = 0;
+        GetAllNodesNoInputEdge(frame.graph, g_state);
+        GELOGD("Start points count %zu", g_state.nodes.size());
+        frame.stage = GraphFrame::kRePassLoop;
+        break;
       }
-      if (g_state.nodes.empty()) {
-        GELOGE(INTERNAL_ERROR, "There are some suspended nodes leaked and no pass resume them.");
-        return INTERNAL_ERROR;
+      case GraphFrame::kResumeLeaked: {
+        auto ret = HandleLeakedSuspendNodes(names_to_passes, g_state);
+        if (ret != SUCCESS) {
+          // log inside upper function
+          return ret;
+        }
+        if (g_state.nodes.empty()) {
+          GELOGE(INTERNAL_ERROR, "There are some suspended nodes leaked and no pass resume them.");
+          return INTERNAL_ERROR;
+        }
+        // a new loop forgets the nodes to re-pass of the last one
+        rp_state.ClearRepass(g_state);
+        frame.stage = GraphFrame::kRePassLoop;
+        break;
       }
-    }
-    auto ret = RunPassesGraphRepass(names_to_passes, g_state);
-    if (ret != SUCCESS) {
-      return ret;
-    }
-  } while (!g_state.nodes_suspend.empty());
-
-  return SUCCESS;
-}
-
-
-Status GEPass::RunPassesGraphRepass(const NamesToPass &names_to_passes, GraphLevelState &g_state) {
-  RepassLevelState rp_state;
-  do {
-    for (auto &node : rp_state.nodes_re_pass) {
-      if (rp_state.nodes_re_pass_set.count(node) > 0) {
-        GELOGD("Add node %s to queue for re-pass", node->GetName().c_str());
-        g_state.AddNodeToQueue(node);
+      case GraphFrame::kRePassLoop: {
+        for (auto &node : rp_state.nodes_re_pass) {
+          if (g_state.HasState(node.get(), kNodeRePass)) {
+            GELOGD("Add node %s to queue for re-pass", node->GetName().c_str());
+            g_state.AddNodeToQueue(node);
+          }
+        }
+        rp_state.ClearRepass(g_state);
+        frame.stage = GraphFrame::kNextNode;
+        break;
       }
-    }
-    rp_state.ClearRepass();
-
-    while (!g_state.nodes.empty()) {
-      auto node = g_state.PopFront();
-      if (g_state.nodes_deleted.count(node) > 0) {
-        GELOGD("The node %s was deleted before, skip it.", node->GetName().c_str());
-        continue;
+      case GraphFrame::kNextNode: {
+        if (g_state.nodes.empty()) {
+          AddLastNodesToQueue(g_state);
+          frame.stage = GraphFrame::kRePassLoopEnd;
+          break;
+        }
+        auto node = g_state.PopFront();
+        if (g_state.HasState(node.get(), kNodeDeleted)) {
+          GELOGD("The node %s was deleted before, skip it.", node->GetName().c_str());
+          break;
+        }
+        (void)g_state.ClearState(node.get(), kNodeRePass);
+        (void)g_state.SetState(node, kNodeSeen);
+
+        // collect out nodes before pass
+        frame.out_nodes_before_pass.clear();
+        for (const auto &out_node : node->GetOutNodes()) {
+          frame.out_nodes_before_pass.insert(out_node);
+        }
+        auto ret = RunPassesOnNode(node, names_to_passes, g_state, rp_state);
+        if (ret != SUCCESS) {
+          GELOGE(ret, "[Process][Passes] on node %s type %s failed, error code:%u", node->GetName().c_str(),
+                 node->GetType().c_str(), ret);
+          return ret;
+        }
+        frame.node = node;
+        frame.sub_graph_names = node->GetOpDesc()->GetSubgraphInstanceNames();
+        frame.sub_graph_index = 0U;
+        frame.has_sub_graph = false;
+        frame.stage = GraphFrame::kSubGraphs;
+        break;
       }
-      rp_state.EraseNodeFromRepass(node);
-      g_state.nodes_seen.insert(node.get());
-
-      // collect out nodes before pass
-      std::unordered_set<NodePtr> out_nodes_before_pass;
-      for (const auto &out_node : node->GetOutNodes()) {
-        out_nodes_before_pass.insert(out_node);
+      case GraphFrame::kSubGraphs: {
+        while (frame.sub_graph_index < frame.sub_graph_names.size()) {
+          const auto &name = frame.sub_graph_names[frame.sub_graph_index++];
+          auto graph = root_graph_->GetSubgraph(name);
+          if (graph == nullptr) {
+            GELOGW("Can not find the sub graph %s from node %s, the pass-process will skip it",
+                   name.c_str(), frame.node->GetName().c_str());
+            continue;
+          }
+          frame.has_sub_graph = true;
+          GELOGI("Begin to run passes on the sub graph %s of node %s", name.c_str(), frame.node->GetName().c_str());
+          // the frame resumes here after the sub graph passed
+          sub_graph = graph;
+          return SUCCESS;
+        }
+        auto ret = RunPassesOnNodeAfterSubGraphs(frame, names_to_passes);
+        if (ret != SUCCESS) {
+          return ret;
+        }
+        AddNextIterNodes(frame.node, frame.out_nodes_before_pass, g_state);
+        frame.node = nullptr;
+        frame.stage = GraphFrame::kNextNode;
+        break;
       }
-      auto ret = RunPassesNodeOnce(node, names_to_passes, g_state, rp_state);
-      if (ret != SUCCESS) {
-        GELOGE(ret, "[Process][Passes] on node %s type %s failed, error code:%u", node->GetName().c_str(),
-               node->GetType().c_str(), ret);
-        return ret;
+      case GraphFrame::kRePassLoopEnd: {
+        if ((!rp_state.nodes_re_pass.empty() || !g_state.nodes.empty()) &&
+            ++g_state.re_pass_times < kMaxRePassTimes) {
+          frame.stage = GraphFrame::kRePassLoop;
+          break;
+        }
+        if (g_state.re_pass_times == kMaxRePassTimes) {
+          GELOGW("re_pass_times should not come to %d", kMaxRePassTimes);
+        }
+        GELOGD("All passes runs end");
+        if (g_state.suspend_num > 0U) {
+          frame.stage = GraphFrame::kResumeLeaked;
+          break;
+        }
+        return SUCCESS;
       }
-      AddNextIterNodes(node, out_nodes_before_pass, g_state);
-
+      default:
+        GELOGE(INTERNAL_ERROR, "[Check][Param] Invalid stage %d of graph %s", static_cast<int>(frame.stage),
+               frame.graph->GetName().c_str());
+        return INTERNAL_ERROR;
     }
-    AddLastNodesToQueue(g_state);
-  } while ((!rp_state.nodes_re_pass.empty() || !g_state.nodes.empty()) && ++g_state.re_pass_times < kMaxRePassTimes);
-
-  if (g_state.re_pass_times == kMaxRePassTimes) {
-    GELOGW("re_pass_times should not come to %d", kMaxRePassTimes);
   }
-  GELOGD("All passes runs end");
-  return SUCCESS;
 }
 
-Status GEPass::RunPassesOnSubGraph(const NodePtr &node, const NamesToPass &names_to_passes, bool &has_sub_graph) {
-  auto sub_graph_names = node->GetOpDesc()->GetSubgraphInstanceNames();
-  has_sub_graph = false;
-  for (const auto &name : sub_graph_names) {
-    auto graph = root_graph_->GetSubgraph(name);
-    if (graph == nullptr) {
-      GELOGW("Can not find the sub graph %s from node %s, the pass-process will skip it",
-          name.c_str(), node->GetName().c_str());
-      continue;
-    }
-    has_sub_graph = true;
-    GELOGI("Begin to run passes on the sub graph %s of node %s", name.c_str(), node->GetName().c_str());
-    GEPass pass(graph, root_graph_, depth_ + 1);
-    auto ret = pass.Run(names_to_passes);
-    if (ret != SUCCESS) {
-      GELOGE(ret, "[Run][Passes] for sub graph:%s from node:%s failed", name.c_str(), node->GetName().c_str());
-      return ret;
-    }
+Status GEPass::RunPassesOnNodeAfterSubGraphs(GraphFrame &frame, const NamesToPass &names_to_passes) {
+  if (!frame.has_sub_graph) {
+    return SUCCESS;
   }
-  return SUCCESS;
-}
-
-Status GEPass::RunPassesNodeOnce(NodePtr &node, const NamesToPass &names_to_passes,
-                                 GraphLevelState &g_state, RepassLevelState &rp_state) {
-  auto ret = RunPassesOnNode(node, names_to_passes, g_state, rp_state);
+  auto &node = frame.node;
+  GELOGD("There are subgraphs on node %s, run passes for for the second time", node->GetName().c_str());
+  SetFlagOption(kOptimizeAfterSubGraph, names_to_passes);
+  auto ret = RunPassesOnNode(node, names_to_passes, frame.g_state, frame.rp_state);
   if (ret != SUCCESS) {
-    GELOGE(ret, "[Process][Passes] on node %s type %s failed, error code:%u", node->GetName().c_str(),
+    GELOGE(ret, "[Process][Passes] on node %s type %s failed, error code: %u", node->GetName().c_str(),
            node->GetType().c_str(), ret);
     return ret;
   }
 
-  bool has_sub_graph = false;
-  ret = RunPassesOnSubGraph(node, names_to_passes, has_sub_graph);
-  if (ret != SUCCESS) {
-    GELOGE(ret, "[Run][Passes] on the sub graph of node %s failed", node->GetName().c_str());
-    return ret;
-  }
-
-  if (has_sub_graph) {
-    GELOGD("There are subgraphs on node %s, run passes for for the second time", node->GetName().c_str());
-    SetFlagOption(kOptimizeAfterSubGraph, names_to_passes);
-    ret = RunPassesOnNode(node, names_to_passes, g_state, rp_state);
-    if (ret != SUCCESS) {
-      GELOGE(ret, "[Process][Passes] on node %s type %s failed, error code: %u", node->GetName().c_str(),
-             node->GetType().c_str(), ret);
-      return ret;
-    }
-
-    // There is only one option scene, so set and clear options around the `RunPasses` func.
-    // if there are more than one scene to set options, the `ClearOption` function
-    // should be called each time at the begin of the iteration
-    ClearOption(names_to_passes);
-  }
+  // There is only one option scene, so set and clear options around the `RunPasses` func.
+  // if there are more than one scene to set options, the `ClearOption` function
+  // should be called each time at the begin of the iteration
+  ClearOption(names_to_passes);
   return SUCCESS;
 }
 
@@ -423,10 +558,23 @@ Status GEPass::RunPassesOnNode(NodePtr &node, const NamesToPass &names_to_passes
     return FAILED;
   }
   GELOGD("Begin to run pass for node %s", node->GetName().c_str());
-  for (const auto &name_to_pass : names_to_passes) {
-    GELOGD("Begin to run pass %s for node %s", name_to_pass.first.c_str(), node->GetName().c_str());
+  node_run_count_++;
+  // the passes after the one deleting the node do not run, nor have their results cleared
+  size_t run_pass_num = names_to_passes.size();
+  for (size_t i = 0U; i < names_to_passes.size(); ++i) {
+    const auto &name_to_pass = names_to_passes[i];
+    // the results of the last node are cleared even if the pass skips this one
     name_to_pass.second->init();
+    if (!name_to_pass.second->IsInterested(node)) {
+      statistics_by_index_[i].skip_count++;
+      continue;
+    }
+    GELOGD("Begin to run pass %s for node %s", name_to_pass.first.c_str(), node->GetName().c_str());
+    auto start = std::chrono::steady_clock::now();
     auto result = name_to_pass.second->Run(node);
+    statistics_by_index_[i].visit_count++;
+    statistics_by_index_[i].cost_time += static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count());
     if (result != SUCCESS) {
       REPORT_CALL_ERROR("E19999", "process pass %s on node:%s failed, ret:%u",
                         name_to_pass.first.c_str(), node->GetName().c_str(), result);
@@ -438,19 +586,27 @@ Status GEPass::RunPassesOnNode(NodePtr &node, const NamesToPass &names_to_passes
     if (name_to_pass.second->GetNodesDeleted().count(node) > 0) {
       GELOGD("The node %s was deleted by pass %s, stop the remain passes", node->GetName().c_str(),
              name_to_pass.first.c_str());
+      run_pass_num = i + 1U;
       break;
     }
   }
 
-  g_state.nodes_passed.insert(node);
+  (void)g_state.SetState(node, kNodePassed);
 
   std::unordered_map<NodePtr, std::string> re_pass_imm_nodes_to_pass_names;
   std::unordered_map<NodePtr, std::string> resume_nodes_to_pass_names;
   // if muti psss repass one same node, it will add to queue many times, so collect and duplicate
-  for (const auto &name_to_pass : names_to_passes) {
-    PushToRePassIfSeen(node, name_to_pass, g_state.nodes_seen,
-                       name_to_pass.second->GetNodesNeedRePass(),
-                       rp_state);
+  for (size_t i = 0U; i < names_to_passes.size(); ++i) {
+    const auto &name_to_pass = names_to_passes[i];
+    if (i < run_pass_num) {
+      const size_t re_pass_num = name_to_pass.second->GetNodesNeedRePass().size() +
+                                 name_to_pass.second->GetNodesNeedRePassImmediately().size();
+      statistics_by_index_[i].re_pass_count += re_pass_num;
+      if ((re_pass_num > 0U) || !name_to_pass.second->GetNodesDeleted().empty()) {
+        statistics_by_index_[i].changed_count++;
+      }
+    }
+    PushToRePassIfSeen(node, name_to_pass, name_to_pass.second->GetNodesNeedRePass(), g_state, rp_state);
     // collect imm_node && resume_node among these passes
     for (const auto &imm_node : name_to_pass.second->GetNodesNeedRePassImmediately()){
       re_pass_imm_nodes_to_pass_names[imm_node].append(name_to_pass.first + ",");
@@ -462,10 +618,11 @@ Status GEPass::RunPassesOnNode(NodePtr &node, const NamesToPass &names_to_passes
     for (const auto &suspend_node : name_to_pass.second->GetNodesSuspend()) {
       GELOGD("The iteration suspend of node %s has been set by pass %s", suspend_node->GetName().c_str(),
              name_to_pass.first.c_str());
-      g_state.nodes_suspend.insert(suspend_node);
+      g_state.AddNodeSuspend(suspend_node);
+    }
+    for (const auto &deleted_node : name_to_pass.second->GetNodesDeleted()) {
+      (void)g_state.SetState(deleted_node, kNodeDeleted);
     }
-    const auto &nodes_deleted_by_pass = name_to_pass.second->GetNodesDeleted();
-    g_state.nodes_deleted.insert(nodes_deleted_by_pass.begin(), nodes_deleted_by_pass.end());
   }
 
   AddImmediateRepassNodesToQueue(node, re_pass_imm_nodes_to_pass_names, g_state);
@@ -18,8 +18,12 @@
 #ifndef GE_GRAPH_PASSES_BASE_PASS_H_
 #define GE_GRAPH_PASSES_BASE_PASS_H_
 
+#include <deque>
+#include <map>
+#include <memory>
 #include <set>
 #include <string>
+#include <unordered_map>
 #include <unordered_set>
 #include <utility>
 #include <vector>
@@ -80,7 +84,19 @@ class BaseNodePass {
     current_graph_name_ = graph->GetName();
   }
 
+  ///
+  /// Types of the nodes the pass handles, GEPass does not run the pass on nodes of other types.
+  /// Empty means all types. Only for passes picking nodes by Node::GetType, not by the original types.
+  ///
+  const std::unordered_set<std::string> &GetInterestedTypes() const { return interested_types_; }
+
+  bool IsInterested(const NodePtr &node) const {
+    return interested_types_.empty() || (interested_types_.count(node->GetType()) > 0);
+  }
+
  protected:
+  void SetInterestedTypes(const std::unordered_set<std::string> &types) { interested_types_ = types; }
+
   const string &GetCurrentGraphName() const {
     return current_graph_name_;
   }
@@ -170,42 +186,100 @@ class BaseNodePass {
   std::unordered_set<NodePtr> nodes_resume_;
   std::map<NodePassOption, std::string> options_;
   std::string current_graph_name_;
+  std::unordered_set<std::string> interested_types_;
 };
 
 using NamesToPass = std::vector<std::pair<std::string, BaseNodePass *>>;
 
 class GEPass {
  public:
-  explicit GEPass(ComputeGraphPtr &graph) : graph_(graph), root_graph_(graph), depth_(1) {}
+  explicit GEPass(ComputeGraphPtr &graph) : graph_(graph), root_graph_(graph) {}
   virtual ~GEPass() = default;
   Status Run(const NamesToPass &names_to_passes);
+
+  struct PassStatistic {
+    uint64_t visit_count = 0;  // nodes the pass runs on
+    uint64_t skip_count = 0;   // nodes skipped for the types not interested
+    uint64_t cost_time = 0;    // us
+    uint64_t changed_count = 0;  // nodes the pass deleted or asked to re-pass after it
+    uint64_t re_pass_count = 0;  // nodes the pass asked to re-pass
+  };
+  ///
+  /// @brief statistics of the passes by names, over the root graph and all the sub graphs of the last Run
+  ///
+  const std::map<std::string, PassStatistic> &GetPassStatistics() const { return pass_statistics_; }
+
   /*
-* todo
 * OneGraph: nodes_deleted, nodes_seen, nodes_passed, nodes_suspended
 * RePass: nodes_re_pass
 * GraphOneTime: nodes_last
 * NodeOneTime: nodes_re_pass_immediately, nodes_resume
 */
+  enum NodeState : uint8_t {
+    kNodeSeen = 1U << 0U,
+    kNodePassed = 1U << 1U,
+    kNodeDeleted = 1U << 2U,
+    kNodeSuspend = 1U << 3U,
+    kNodeLast = 1U << 4U,
+    kNodeRePass = 1U << 5U
+  };
+
+  // all the states of a node are bits of one byte, looked up through one hash map instead of a set per state
   struct GraphLevelState {
-    std::unordered_set<NodePtr> nodes_deleted;
-    std::unordered_set<Node *> nodes_seen;
-    std::unordered_set<NodePtr> nodes_passed;
-    std::unordered_set<NodePtr> nodes_suspend;
-    std::unordered_set<NodePtr> nodes_last;
+    std::unordered_map<const Node *, size_t> node_indexes;
+    // keeps nodes deleted alive, so their addresses are not reused by new nodes
+    std::vector<NodePtr> indexed_nodes;
+    std::vector<uint8_t> node_states;
+    size_t suspend_num = 0;
+    std::vector<NodePtr> nodes_last;
     std::deque<NodePtr> nodes;
-    int re_pass_times;
+    int re_pass_times = 0;
+
+    size_t GetIndex(const NodePtr &node) {
+      auto ret = node_indexes.emplace(node.get(), indexed_nodes.size());
+      if (ret.second) {
+        indexed_nodes.emplace_back(node);
+        node_states.emplace_back(0U);
+      }
+      return ret.first->second;
+    }
+
+    bool HasState(const Node *node, uint8_t state) const {
+      auto iter = node_indexes.find(node);
+      return (iter != node_indexes.end()) && ((node_states[iter->second] & state) != 0U);
+    }
+
+    // @return false if the node had the state already
+    bool SetState(const NodePtr &node, uint8_t state) {
+      uint8_t &states = node_states[GetIndex(node)];
+      if ((states & state) != 0U) {
+        return false;
+      }
+      states |= state;
+      return true;
+    }
+
+    // @return false if the node had not the state
+    bool ClearState(const Node *node, uint8_t state) {
+      auto iter = node_indexes.find(node);
+      if ((iter == node_indexes.end()) || ((node_states[iter->second] & state) == 0U)) {
+        return false;
+      }
+      node_states[iter->second] &= static_cast<uint8_t>(~state);
+      return true;
+    }
 
     void AddNodeToQueueFront(NodePtr node) {
-      nodes_seen.insert(node.get());
+      (void)SetState(node, kNodeSeen);
       nodes.emplace_front(std::move(node));
     }
 
     void AddNodeToQueue(NodePtr node) {
-      nodes_seen.insert(node.get());
+      (void)SetState(node, kNodeSeen);
       nodes.emplace_back(std::move(node));
     }
     void AddNodeToQueueIfNotSeen(NodePtr node) {
-      if (nodes_seen.insert(node.get()).second) {
+      if (SetState(node, kNodeSeen)) {
         nodes.emplace_back(std::move(node));
       }
     }
@@ -214,43 +288,65 @@ class GEPass {
       nodes.pop_front();
       return node;
     }
+
+    // nodes with many inputs wait till the queue is empty, kNodeLast and nodes_last always go together
+    void AddNodeLast(const NodePtr &node) {
+      if (SetState(node, kNodeLast)) {
+        nodes_last.emplace_back(node);
+      }
+    }
+    void ClearNodesLast() {
+      for (const auto &node : nodes_last) {
+        (void)ClearState(node.get(), kNodeLast);
+      }
+      nodes_last.clear();
+    }
+
+    void AddNodeSuspend(const NodePtr &node) {
+      if (SetState(node, kNodeSuspend)) {
+        ++suspend_num;
+      }
+    }
+    bool EraseNodeSuspend(const NodePtr &node) {
+      if (!ClearState(node.get(), kNodeSuspend)) {
+        return false;
+      }
+      --suspend_num;
+      return true;
+    }
   };
   struct RepassLevelState {
     std::vector<NodePtr> nodes_re_pass;
-    std::unordered_set<NodePtr> nodes_re_pass_set;
-    bool AddNodeToRepass(NodePtr node) {
-      if (!nodes_re_pass_set.insert(node).second) {
+    bool AddNodeToRepass(GraphLevelState &g_state, const NodePtr &node) {
+      if (!g_state.SetState(node, kNodeRePass)) {
         return false;
       }
       nodes_re_pass.emplace_back(node);
       return true;
     }
-    void EraseNodeFromRepass(NodePtr node) {
-      nodes_re_pass_set.erase(node);
-    }
-    void ClearRepass() {
-      nodes_re_pass_set.clear();
+    void ClearRepass(GraphLevelState &g_state) {
+      for (const auto &node : nodes_re_pass) {
+        (void)g_state.ClearState(node.get(), kNodeRePass);
+      }
       nodes_re_pass.clear();
     }
   };
-  struct GraphOneTimeLevelState {
-    std::unordered_set<NodePtr> nodes_last;
-  };
 
  private:
-  GEPass(ComputeGraphPtr &graph, ComputeGraphPtr &root_graph, int depth)
-      : graph_(graph), root_graph_(root_graph), depth_(depth) {}
-  Status RunPassesNodeOnce(NodePtr &node, const NamesToPass &names_to_passes,
-                           GraphLevelState &g_state, RepassLevelState &rp_state);
-  Status RunPassesGraphRepass(const NamesToPass &names_to_passes, GraphLevelState &g_state);
-  Status RunPassesOneGraph(const NamesToPass &names_to_passes);
-  Status RunPassesOnSubGraph(const NodePtr &node, const NamesToPass &names_to_passes, bool &has_sub_graph);
+  // a graph being passed, sub graphs are passed by a stack of them instead of recursion
+  struct GraphFrame;
+
   Status RunPassesOnNode(NodePtr &node, const NamesToPass &names_to_passes, GraphLevelState &g_state,
                          RepassLevelState &rp_state);
   Status HandleLeakedSuspendNodes(const NamesToPass &names_to_passes, GraphLevelState &g_state);
+  Status RunPassesOnFrame(GraphFrame &frame, const NamesToPass &names_to_passes, ComputeGraphPtr &sub_graph);
+  Status RunPassesOnNodeAfterSubGraphs(GraphFrame &frame, const NamesToPass &names_to_passes);
+  void ReportPassStatistics(const NamesToPass &names_to_passes);
   ComputeGraphPtr graph_;
   ComputeGraphPtr root_graph_;
-  int depth_;
+  std::vector<PassStatistic> statistics_by_index_;
+  uint64_t node_run_count_ = 0;
+  std::map<std::string, PassStatistic> pass_statistics_;
 };
 }  // namespace ge
 
@@ -16,44 +16,132 @@
  */
 #include "graph/passes/common_subexpression_elimination_pass.h"
 
-#include <sstream>
+#include <algorithm>
+#include <cstdint>
 #include <string>
-#include <set>
+#include <unordered_map>
+#include <vector>
 
-#include "common/base64.h"
 #include "graph/utils/node_utils.h"
 #include "ge_local_engine/engine/host_cpu_engine.h"
 #include "graph/passes/folding_pass.h"
 
 namespace ge {
 namespace {
+const uint64_t kFnvOffsetBasis = 14695981039346656037ULL;
+const uint64_t kFnvPrime = 1099511628211ULL;
+const uint64_t kHighOffsetBasis = 0x9E3779B97F4A7C15ULL;
+const uint64_t kHighPrime = 0xFF51AFD7ED558CCDULL;
+const size_t kNullAnchor = SIZE_MAX;
+
+/// 128-bit structural hash of a node: its type, the peer out anchors of its data inputs and its control
+/// inputs. Peers are hashed by identity, they are compared the same way, so no names are serialized.
+struct CseKey {
+  uint64_t high;
+  uint64_t low;
+  bool operator==(const CseKey &other) const { return (high == other.high) && (low == other.low); }
+};
+
+struct CseKeyHash {
+  size_t operator()(const CseKey &key) const { return static_cast<size_t>(key.low ^ (key.high >> 1U)); }
+};
+
+class CseKeyBuilder {
+ public:
+  void Append(const void *data, size_t size) {
+    const uint8_t *bytes = static_cast<const uint8_t *>(data);
+    for (size_t i = 0U; i < size; ++i) {
+      low_ = (low_ ^ bytes[i]) * kFnvPrime;
+      high_ = (high_ ^ bytes[i]) * kHighPrime;
+    }
+  }
+
+  template <typename T>
+  void AppendValue(const T &value) {
+    Append(&value, sizeof(value));
+  }
+
+  void AppendString(const std::string &str) {
+    AppendValue(str.size());
+    Append(str.data(), str.size());
+  }
 
-std::string GetCseKey(const NodePtr &node) {
-  std::stringstream ss;
-  ss << node->GetType() << "-data-inputs-";
-  for (auto &in_anchor : node->GetAllInDataAnchors()) {
-    auto src_anchor = in_anchor->GetPeerOutAnchor();
+  CseKey Get() const {
+    return {Mix(high_), Mix(low_)};
+  }
+
+ private:
+  static uint64_t Mix(uint64_t value) {
+    value ^= value >> 33U;
+    value *= kHighPrime;
+    value ^= value >> 33U;
+    return value;
+  }
+
+  uint64_t high_ = kHighOffsetBasis;
+  uint64_t low_ = kFnvOffsetBasis;
+};
+
+std::vector<const Node *> GetSortedControlInputs(const NodePtr &node) {
+  std::vector<const Node *> control_inputs;
+  for (const auto &src_node : node->GetInControlNodes()) {
+    control_inputs.emplace_back(src_node.get());
+  }
+  std::sort(control_inputs.begin(), control_inputs.end());
+  return control_inputs;
+}
+
+CseKey GetCseKey(const NodePtr &node, const std::vector<const Node *> &control_inputs) {
+  CseKeyBuilder builder;
+  builder.AppendString(node->GetType());
+  for (const auto &in_anchor : node->GetAllInDataAnchors()) {
+    builder.AppendValue(in_anchor->GetIdx());
+    const auto &src_anchor = in_anchor->GetPeerOutAnchor();
     if (src_anchor == nullptr) {
-      ss << in_anchor->GetIdx() << "-null-";
+      builder.AppendValue(kNullAnchor);
     } else {
-      ss << in_anchor->GetIdx() << "-"
-         << src_anchor->GetOwnerNode()->GetName() << "-"
-         << src_anchor->GetIdx() << "-";
+      builder.AppendValue(reinterpret_cast<uintptr_t>(src_anchor->GetOwnerNode().get()));
+      builder.AppendValue(src_anchor->GetIdx());
     }
   }
-
-  ss << "control-inputs-";
-  std::set<std::string> control_in_node_names;
-  for (auto &src_node : node->GetInControlNodes()) {
-    control_in_node_names.insert(src_node->GetName());
-  }
-  for (auto &name : control_in_node_names) {
-    ss << name << "-";
+  builder.AppendValue(control_inputs.size());
+  for (const auto control_input : control_inputs) {
+    builder.AppendValue(reinterpret_cast<uintptr_t>(control_input));
   }
+  return builder.Get();
+}
 
-  ss << "attrs-" << AttrUtils::GetAllAttrsStr(node->GetOpDesc());
+/// A node already met with the same key. The attributes are compared only when the structure is the
+/// same, most nodes never have them serialized.
+struct CseCandidate {
+  NodePtr node;
+  std::vector<const Node *> control_inputs;
+  std::string attrs;
+  bool attrs_ready;
+};
+
+const std::string &GetCandidateAttrs(CseCandidate &candidate) {
+  if (!candidate.attrs_ready) {
+    candidate.attrs = AttrUtils::GetAllAttrsStr(candidate.node->GetOpDesc());
+    candidate.attrs_ready = true;
+  }
+  return candidate.attrs;
+}
 
-  return ss.str();
+bool IsSameStructure(const NodePtr &node, const std::vector<const Node *> &control_inputs,
+                     const CseCandidate &candidate) {
+  const auto &other = candidate.node;
+  if ((node->GetType() != other->GetType()) || (control_inputs != candidate.control_inputs) ||
+      (node->GetAllInDataAnchorsSize() != other->GetAllInDataAnchorsSize())) {
+    return false;
+  }
+  for (const auto &in_anchor : node->GetAllInDataAnchors()) {
+    const auto &other_anchor = other->GetInDataAnchor(in_anchor->GetIdx());
+    if ((other_anchor == nullptr) || (in_anchor->GetPeerOutAnchor() != other_anchor->GetPeerOutAnchor())) {
+      return false;
+    }
+  }
+  return true;
 }
 
 /// As the operator category has not been defined, we do not know what types of node can be processed by CSE.
@@ -69,7 +157,7 @@ bool IsNodeSupportCse(const NodePtr &node) {
 Status CommonSubexpressionEliminationPass::Run(ComputeGraphPtr graph) {
   GELOGD("Begin to run the CSE process on the graph");
   GE_CHECK_NOTNULL(graph);
-  std::map<std::string, NodePtr> keys_to_node;
+  std::unordered_map<CseKey, std::vector<CseCandidate>, CseKeyHash> keys_to_nodes;
   for (const auto &node : graph->GetDirectNode()) {
     if (!IsNodeSupportCse(node)) {
       continue;
@@ -86,17 +174,36 @@ Status CommonSubexpressionEliminationPass::Run(ComputeGraphPtr graph) {
              node->GetName().c_str(), node->GetType().c_str());
       continue;
     }
-    auto key = GetCseKey(node);
-    GELOGD("The node %s cse key %s", node->GetName().c_str(), ge::base64::EncodeToBase64(key).c_str());
-    auto iter = keys_to_node.find(key);
-    if (iter == keys_to_node.end()) {
-      keys_to_node[key] = node;
+    auto control_inputs = GetSortedControlInputs(node);
+    auto key = GetCseKey(node, control_inputs);
+    GELOGD("The node %s cse key %016lx%016lx", node->GetName().c_str(), key.high, key.low);
+    auto &candidates = keys_to_nodes[key];
+    std::string attrs;
+    bool attrs_ready = false;
+    auto iter = candidates.begin();
+    for (; iter != candidates.end(); ++iter) {
+      if (!IsSameStructure(node, control_inputs, *iter)) {
+        GELOGD("The node %s and %s have the same CSE key by hash collision", node->GetName().c_str(),
+               iter->node->GetName().c_str());
+        continue;
+      }
+      if (!attrs_ready) {
+        attrs = AttrUtils::GetAllAttrsStr(node->GetOpDesc());
+        attrs_ready = true;
+      }
+      if (attrs == GetCandidateAttrs(*iter)) {
+        break;
+      }
+    }
+    if (iter == candidates.end()) {
+      candidates.push_back({node, std::move(control_inputs), std::move(attrs), attrs_ready});
       continue;
     }
 
-    if (node->GetAllOutDataAnchorsSize() != iter->second->GetAllOutDataAnchorsSize()) {
+    const auto &same_node = iter->node;
+    if (node->GetAllOutDataAnchorsSize() != same_node->GetAllOutDataAnchorsSize()) {
       GELOGW("The node %s and %s have the same CSE key, but different output anchor count, skip to fusion them",
-          iter->second->GetName().c_str(), node->GetName().c_str());
+          same_node->GetName().c_str(), node->GetName().c_str());
       continue;
     }
 
@@ -105,13 +212,13 @@ Status CommonSubexpressionEliminationPass::Run(ComputeGraphPtr graph) {
       output_map[i] = i;
     }
 
-    ret = GraphUtils::ReplaceNodeAnchors(iter->second, node, {}, output_map);
+    ret = GraphUtils::ReplaceNodeAnchors(same_node, node, {}, output_map);
     if (ret != GRAPH_SUCCESS) {
       REPORT_CALL_ERROR("E19999", "Replace node:%s(%s)'s anchor by node:%s(%s) failed",
                         node->GetName().c_str(), node->GetType().c_str(),
-                        iter->second->GetName().c_str(), iter->second->GetType().c_str());
+                        same_node->GetName().c_str(), same_node->GetType().c_str());
       GELOGE(INTERNAL_ERROR, "[Replace][Node] %s by node %s failed, ret:%u",
-             node->GetName().c_str(), iter->second->GetName().c_str(), ret);
+             node->GetName().c_str(), same_node->GetName().c_str(), ret);
       return INTERNAL_ERROR;
     }
 
@@ -127,7 +234,7 @@ Status CommonSubexpressionEliminationPass::Run(ComputeGraphPtr graph) {
     }
 
     GELOGI("Remove node %s by the CSE process, replace it with node %s",
-        node->GetName().c_str(), iter->second->GetName().c_str());
+        node->GetName().c_str(), same_node->GetName().c_str());
   }
   return SUCCESS;
 }
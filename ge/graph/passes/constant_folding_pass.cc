@@ -17,8 +17,17 @@
 
 #include "graph/passes/constant_folding_pass.h"
 
+#include <algorithm>
+#include <cstdlib>
+#include <limits>
 #include <vector>
+#include "common/util/error_manager/error_manager.h"
+#include "external/ge/ge_api_types.h"
 #include "external/graph/operator_factory.h"
+#include "framework/common/util.h"
+#include "graph/ge_context.h"
+#include "graph/passes/folding_cache.h"
+#include "graph/utils/attr_utils.h"
 #include "graph/utils/node_utils.h"
 #include "graph/utils/type_utils.h"
 #include "ge_local_engine/engine/host_cpu_engine.h"
@@ -28,6 +37,34 @@ namespace ge {
 const int64_t kStartCallNum = 1;
 const std::string kKernelLibName = "aicpu_tf_kernel";
 const std::string kOpsFlagClose = "0";
+const int kDecimal = 10;
+const int64_t kMaxConstantFoldingThreadNum = 32;
+const int64_t kMaxConstantFoldingCacheSize = 4096;  // MB
+const size_t kMegaBytes = 1024U * 1024U;
+const std::string kCacheHitSuffix = ":cache_hit";
+// work stream of the errors reported by kernels computed in a wave
+const uint64_t kWaveWorkStreamId = std::numeric_limits<uint64_t>::max();
+
+ConstantFoldingPass::ConstantFoldingPass() {
+  std::string thread_num = "0";
+  (void)GetContext().GetOption(CONSTANT_FOLDING_THREAD_NUM, thread_num);  // option may not be set up
+  int64_t num = std::strtol(thread_num.c_str(), nullptr, kDecimal);
+  SetThreadNum(static_cast<uint32_t>(std::max<int64_t>(0, std::min(num, kMaxConstantFoldingThreadNum))));
+
+  std::string cache_size;
+  if (GetContext().GetOption(CONSTANT_FOLDING_CACHE_SIZE, cache_size) == GRAPH_SUCCESS) {
+    int64_t size = std::strtol(cache_size.c_str(), nullptr, kDecimal);
+    size = std::max<int64_t>(0, std::min(size, kMaxConstantFoldingCacheSize));
+    // the cache is shared, the capacity set first applies to all, a session of size 0 still does not use it
+    FoldingCache::GetInstance().InitCapacity(static_cast<size_t>(size) * kMegaBytes);
+    use_cache_ = (size > 0) && (FoldingCache::GetInstance().GetCapacity() > 0U);
+  }
+}
+
+void ConstantFoldingPass::SetThreadNum(uint32_t thread_num) {
+  thread_num_ = thread_num;
+  thread_pool_.reset();
+}
 
 const map<string, pair<uint64_t, uint64_t>> &ConstantFoldingPass::GetGeConstantFoldingPerfStatistic() const {
   return statistic_of_ge_constant_folding_;
@@ -63,6 +100,164 @@ Status ConstantFoldingPass::RunOpKernel(NodePtr &node,
   return HostCpuEngine::GetInstance().Run(node, inputs, outputs);
 }
 
+void ConstantFoldingPass::ComputeKernel(NodePtr &node, KernelResult &result) {
+  result.op_desc = node->GetOpDesc();
+  result.outputs.clear();
+  result.cache_hit = false;
+  uint64_t start_time = GetCurrentTimestamp();
+  std::string cache_key;
+  bool cacheable = use_cache_ && FoldingCache::GenerateKey(result.op_desc, result.inputs, cache_key);
+  if (cacheable && FoldingCache::GetInstance().Find(cache_key, result.inputs, result.outputs)) {
+    GELOGD("Node %s type %s is folded by the cached result.", node->GetName().c_str(), node->GetType().c_str());
+    result.ret = SUCCESS;
+    result.cache_hit = true;
+    result.statistic = &statistic_of_ge_constant_folding_;
+    result.cost_time = GetCurrentTimestamp() - start_time;
+    return;
+  }
+
+  // Statistic of ge constant folding kernel
+  start_time = GetCurrentTimestamp();
+  result.ret = RunOpKernelWithCheck(node, result.inputs, result.outputs);
+  if (result.ret == SUCCESS) {
+    result.statistic = &statistic_of_op_constant_folding_;
+    result.cost_time = GetCurrentTimestamp() - start_time;
+    if (cacheable) {
+      FoldingCache::GetInstance().Insert(cache_key, result.inputs, result.outputs);
+    }
+    return;
+  }
+  auto op_kernel = folding_pass::GetKernelByType(node);
+  if (op_kernel == nullptr) {
+    GELOGD("No op kernel for node %s type %s, skip the constant folding", node->GetName().c_str(),
+           node->GetType().c_str());
+    result.ret = NOT_CHANGED;
+    result.statistic = nullptr;
+    return;
+  }
+
+  // Statistic of op and fe constant folding kernel
+  start_time = GetCurrentTimestamp();
+  result.outputs.clear();
+  result.ret = op_kernel->Compute(result.op_desc, result.inputs, result.outputs);
+  result.statistic = &statistic_of_ge_constant_folding_;
+  result.cost_time = GetCurrentTimestamp() - start_time;
+  if (result.ret == NOT_CHANGED) {
+    GELOGD("Node %s type %s, compute terminates and exits the constant folding.", node->GetName().c_str(),
+           node->GetType().c_str());
+  } else if (result.ret == SUCCESS) {
+    GELOGI("Node %s type %s, constant folding compute success.", node->GetName().c_str(), node->GetType().c_str());
+    if (cacheable) {
+      FoldingCache::GetInstance().Insert(cache_key, result.inputs, result.outputs);
+    }
+  }
+}
+
+bool ConstantFoldingPass::TakeWaveResult(const NodePtr &node, const vector<ConstGeTensorPtr> &inputs,
+                                         KernelResult &result) {
+  auto iter = wave_results_.find(node);
+  if (iter == wave_results_.end()) {
+    return false;
+  }
+  result = std::move(iter->second);
+  (void)wave_results_.erase(iter);
+  // errors of a wave are dropped, a failed node is computed again to report them
+  if ((result.ret != SUCCESS) && (result.ret != NOT_CHANGED)) {
+    GELOGD("Node %s failed in a wave, compute it again.", node->GetName().c_str());
+    return false;
+  }
+  // inputs, attrs or output descs of the node may be changed by passes run since the wave, compute it again then
+  const auto &op_desc = node->GetOpDesc();
+  if ((result.op_desc != op_desc) || (result.inputs.size() != inputs.size()) ||
+      !std::equal(inputs.begin(), inputs.end(), result.inputs.begin()) ||
+      (result.output_descs.size() != op_desc->GetOutputsSize())) {
+    GELOGD("Node %s is changed since computed in a wave.", node->GetName().c_str());
+    return false;
+  }
+  for (size_t i = 0; i < result.output_descs.size(); ++i) {
+    if (!(result.output_descs[i] == op_desc->GetOutputDesc(static_cast<uint32_t>(i)))) {
+      GELOGD("Output %zu of node %s is changed since computed in a wave.", i, node->GetName().c_str());
+      return false;
+    }
+  }
+  if (result.attrs != AttrUtils::GetAllAttrsStr(op_desc)) {
+    GELOGD("Attrs of node %s are changed since computed in a wave.", node->GetName().c_str());
+    return false;
+  }
+  return true;
+}
+
+Status ConstantFoldingPass::ComputeWave(const NodePtr &node) {
+  std::vector<NodePtr> candidates;
+  const auto &graph = node->GetOwnerComputeGraph();
+  if ((graph != nullptr) && wave_graphs_.insert(graph.get()).second) {
+    for (const auto &graph_node : graph->GetDirectNode()) {
+      candidates.emplace_back(graph_node);
+    }
+  }
+  candidates.insert(candidates.end(), wave_candidates_.begin(), wave_candidates_.end());
+  candidates.emplace_back(node);
+  wave_candidates_.clear();
+
+  std::unordered_set<NodePtr> visited;
+  std::vector<NodePtr> nodes;
+  std::vector<KernelResult> results;
+  for (auto &candidate : candidates) {
+    if ((candidate == nullptr) || !visited.insert(candidate).second || (wave_results_.count(candidate) > 0) ||
+        folding_pass::IsNoNeedConstantFolding(candidate)) {
+      continue;
+    }
+    auto input_nodes = OpDescUtils::GetConstInputNode(*candidate);
+    if (input_nodes.empty() || (input_nodes.size() != candidate->GetOpDesc()->GetInputsSize())) {
+      continue;
+    }
+    nodes.emplace_back(candidate);
+    results.emplace_back();
+    auto &result = results.back();
+    result.inputs = OpDescUtils::GetInputData(input_nodes);
+    const auto &op_desc = candidate->GetOpDesc();
+    result.attrs = AttrUtils::GetAllAttrsStr(op_desc);
+    for (size_t i = 0; i < op_desc->GetOutputsSize(); ++i) {
+      result.output_descs.emplace_back(op_desc->GetOutputDesc(static_cast<uint32_t>(i)));
+    }
+  }
+
+  // only the kernels run in parallel, statistics are recorded when the nodes are folded.
+  // a wave computes nodes the pass may never reach, their kernels report errors to a scratch work stream, which is
+  // dropped. the nodes failed are computed again when the pass reaches them.
+  const auto error_context = ErrorManager::GetInstance().GetErrorManagerContext();
+  auto wave_error_context = error_context;
+  wave_error_context.work_stream_id = kWaveWorkStreamId;
+  const uint64_t start_time = GetCurrentTimestamp();
+  Status ret = thread_pool_->ParallelFor(nodes.size(), 1, [&](size_t begin, size_t end) -> Status {
+    ErrorManager::GetInstance().SetErrorContext(wave_error_context);
+    for (size_t i = begin; i < end; ++i) {
+      ComputeKernel(nodes[i], results[i]);
+    }
+    return SUCCESS;
+  });
+  ErrorManager::GetInstance().SetErrorContext(wave_error_context);
+  (void)ErrorManager::GetInstance().GetErrorMessage();
+  (void)ErrorManager::GetInstance().GetWarningMessage();
+  ErrorManager::GetInstance().SetErrorContext(error_context);
+  if (ret != SUCCESS) {
+    GELOGE(ret, "[Compute][Wave] of %zu nodes failed.", nodes.size());
+    return ret;
+  }
+  GELOGD("Kernels of %zu nodes are computed in a wave by %u threads, cost %lu us.", nodes.size(), thread_num_,
+         GetCurrentTimestamp() - start_time);
+  for (size_t i = 0; i < nodes.size(); ++i) {
+    wave_results_[nodes[i]] = std::move(results[i]);
+  }
+  return SUCCESS;
+}
+
+void ConstantFoldingPass::AddWaveCandidates(const NodePtr &node) {
+  for (const auto &out_node : node->GetOutDataNodes()) {
+    wave_candidates_.emplace_back(out_node);
+  }
+}
+
 Status ConstantFoldingPass::Run(ge::NodePtr &node) {
   GE_CHECK_NOTNULL(node);
   GELOGD("Begin to run constant folding on node %s", node->GetName().c_str());
@@ -83,55 +278,43 @@ Status ConstantFoldingPass::Run(ge::NodePtr &node) {
   }
 
   auto inputs = OpDescUtils::GetInputData(input_nodes);
-  vector<GeTensorPtr> outputs;
-  // Statistic of ge constant folding kernel
-  uint64_t start_time = GetCurrentTimestamp();
-  auto ret = RunOpKernelWithCheck(node, inputs, outputs);
-  if (ret != SUCCESS) {
-    auto op_kernel = folding_pass::GetKernelByType(node);
-    if (op_kernel == nullptr) {
-      GELOGD("No op kernel for node %s type %s, skip the constant folding", node->GetName().c_str(),
-             node->GetType().c_str());
-      return SUCCESS;
+  KernelResult result;
+  bool computed = TakeWaveResult(node, inputs, result);
+  if (!computed && (thread_num_ > 1U)) {
+    if (thread_pool_ == nullptr) {
+      // the thread running the pass computes kernels as well
+      thread_pool_.reset(new (std::nothrow) WorkStealingThreadPool(thread_num_ - 1U));
+      GE_CHECK_NOTNULL(thread_pool_);
     }
+    GE_CHK_STATUS_RET_NOLOG(ComputeWave(node));
+    computed = TakeWaveResult(node, inputs, result);
+  }
+  if (!computed) {
+    result.inputs = inputs;
+    ComputeKernel(node, result);
+  }
 
-    // Statistic of op and fe constant folding kernel
-    start_time = GetCurrentTimestamp();
-    ret = op_kernel->Compute(node_desc, inputs, outputs);
-    uint64_t cost_time = GetCurrentTimestamp() - start_time;
-    if (statistic_of_ge_constant_folding_.find(node->GetType()) != statistic_of_ge_constant_folding_.end()) {
-      uint64_t &cnt = statistic_of_ge_constant_folding_[node->GetType()].first;
-      uint64_t &cur_cost_time = statistic_of_ge_constant_folding_[node->GetType()].second;
-      cnt++;
-      cur_cost_time += cost_time;
-    } else {
-      statistic_of_ge_constant_folding_[node->GetType()] = std::pair<uint64_t, uint64_t>(kStartCallNum, cost_time);
-    }
-    if (ret != SUCCESS) {
-      if (ret == NOT_CHANGED) {
-        GELOGD("Node %s type %s, compute terminates and exits the constant folding.", node->GetName().c_str(),
-               node->GetType().c_str());
-        return SUCCESS;
-      }
-      REPORT_CALL_ERROR("E19999", "Calculate for node %s(%s) failed",
-                        node->GetName().c_str(), node->GetType().c_str());
-      GELOGE(INTERNAL_ERROR, "[Call][Calculate] for node %s failed in constant folding", node->GetName().c_str());
-      return ret;
-    }
-    GELOGI("Node %s type %s, constant folding compute success.", node->GetName().c_str(), node->GetType().c_str());
-  } else {
-    if (statistic_of_op_constant_folding_.find(node->GetType()) != statistic_of_op_constant_folding_.end()) {
-      uint64_t &cnt = statistic_of_op_constant_folding_[node->GetType()].first;
-      uint64_t &cost_time = statistic_of_op_constant_folding_[node->GetType()].second;
-      cnt++;
-      cost_time += GetCurrentTimestamp() - start_time;
+  if (result.statistic != nullptr) {
+    const std::string statistic_name = result.cache_hit ? (node->GetType() + kCacheHitSuffix) : node->GetType();
+    auto iter = result.statistic->find(statistic_name);
+    if (iter != result.statistic->end()) {
+      iter->second.first++;
+      iter->second.second += result.cost_time;
     } else {
-      statistic_of_op_constant_folding_[node->GetType()] =
-          std::pair<uint64_t, uint64_t>(kStartCallNum, GetCurrentTimestamp() - start_time);
+      (*result.statistic)[statistic_name] = std::pair<uint64_t, uint64_t>(kStartCallNum, result.cost_time);
     }
   }
+  if (result.ret == NOT_CHANGED) {
+    return SUCCESS;
+  }
+  if (result.ret != SUCCESS) {
+    REPORT_CALL_ERROR("E19999", "Calculate for node %s(%s) failed",
+                      node->GetName().c_str(), node->GetType().c_str());
+    GELOGE(INTERNAL_ERROR, "[Call][Calculate] for node %s failed in constant folding", node->GetName().c_str());
+    return result.ret;
+  }
 
-  if (outputs.empty()) {
+  if (result.outputs.empty()) {
     REPORT_INNER_ERROR("E19999", "After calculate for node %s(%s), output weight is empty, check invalid",
                        node->GetName().c_str(), node->GetType().c_str());
     GELOGE(INTERNAL_ERROR, "[Check][Param] After calculate for node %s(%s), output weight is empty",
@@ -139,6 +322,9 @@ Status ConstantFoldingPass::Run(ge::NodePtr &node) {
     return INTERNAL_ERROR;
   }
 
-  return Folding(node, outputs);
+  if (thread_num_ > 1U) {
+    AddWaveCandidates(node);
+  }
+  return Folding(node, result.outputs);
 }
 }  // namespace ge
@@ -19,13 +19,20 @@
 #define GE_GRAPH_PASSES_CONSTANT_FOLDING_PASS_H_
 
 #include <map>
+#include <memory>
+#include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
+#include "common/work_stealing_thread_pool.h"
 #include "graph/passes/folding_pass.h"
 
 namespace ge {
 class ConstantFoldingPass : public FoldingPass {
  public:
+  ConstantFoldingPass();
+  ~ConstantFoldingPass() override = default;
+
   Status Run(ge::NodePtr &node) override;
   const std::map<std::string, std::pair<std::uint64_t, uint64_t>> &GetGeConstantFoldingPerfStatistic() const;
   const std::map<std::string, std::pair<std::uint64_t, uint64_t>> &GetOpConstantFoldingPerfStatistic() const;
@@ -34,9 +41,52 @@ class ConstantFoldingPass : public FoldingPass {
   static Status RunOpKernelWithCheck(NodePtr &node, const vector<ConstGeTensorPtr> &inputs,
                                      std::vector<GeTensorPtr> &outputs);
 
+  ///
+  /// @brief with more than one thread, once a node to fold is met, the kernels of all nodes whose inputs are
+  /// constants are computed in parallel, as a wave. The nodes are still folded one by one when the pass runs on
+  /// them, so the graph is changed in the same order as computing them one by one.
+  /// Set by option ge.constantFoldingThreadNum by default.
+  ///
+  void SetThreadNum(uint32_t thread_num);
+
+  ///
+  /// @brief fold nodes by the results in FoldingCache, enabled by option ge.constantFoldingCacheSize by default.
+  /// The hits of a type are counted in GetGeConstantFoldingPerfStatistic as "<type>:cache_hit".
+  ///
+  void SetUseCache(bool use_cache) { use_cache_ = use_cache; }
+
  private:
+  struct KernelResult {
+    Status ret = SUCCESS;
+    bool cache_hit = false;
+    // statistic of the kernel computed the node, nullptr if no kernel
+    std::map<std::string, std::pair<std::uint64_t, uint64_t>> *statistic = nullptr;
+    uint64_t cost_time = 0;
+    OpDescPtr op_desc;
+    vector<ConstGeTensorPtr> inputs;
+    vector<GeTensorPtr> outputs;
+    // taken when computed in a wave, passes run since then, e.g. InferShapePass, may change them
+    std::string attrs;
+    vector<GeTensorDesc> output_descs;
+  };
+
+  void ComputeKernel(NodePtr &node, KernelResult &result);
+  bool TakeWaveResult(const NodePtr &node, const vector<ConstGeTensorPtr> &inputs, KernelResult &result);
+  Status ComputeWave(const NodePtr &node);
+  void AddWaveCandidates(const NodePtr &node);
+
   std::map<std::string, std::pair<std::uint64_t, uint64_t>> statistic_of_op_constant_folding_;
   std::map<std::string, std::pair<std::uint64_t, uint64_t>> statistic_of_ge_constant_folding_;
+
+  bool use_cache_ = false;
+  uint32_t thread_num_ = 0;
+  std::unique_ptr<WorkStealingThreadPool> thread_pool_;
+  // results computed by waves, not folded yet
+  std::unordered_map<NodePtr, KernelResult> wave_results_;
+  // graphs of which all nodes are computed by a wave, later waves only compute the candidates
+  std::unordered_set<const ComputeGraph *> wave_graphs_;
+  // consumers of the nodes folded since the last wave, which may get all inputs constant
+  std::vector<NodePtr> wave_candidates_;
 };
 }  // namespace ge
 
@@ -28,6 +28,10 @@ const size_t kInCtrlNodesNum = 1;
 }
 
 namespace ge {
+EnterPass::EnterPass() {
+  SetInterestedTypes({ENTER, REFENTER});
+}
+
 Status EnterPass::Run(NodePtr &node) {
   GELOGD("EnterPass running");
   GE_CHECK_NOTNULL(node);
@@ -23,6 +23,7 @@
 namespace ge {
 class EnterPass : public BaseNodePass {
  public:
+  EnterPass();
   Status Run(NodePtr &node) override;
 
  private:
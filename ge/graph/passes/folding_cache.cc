@@ -0,0 +1,215 @@
+/**
+* Copyright 2021, 2022 LuoJiaNET Research and Development Group, Wuhan University
+* Copyright 2021, 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "graph/passes/folding_cache.h"
+
+#include <cstring>
+#include <sstream>
+
+#include "common/ge/ge_util.h"
+#include "framework/common/debug/ge_log.h"
+#include "graph/utils/attr_utils.h"
+#include "graph/utils/type_utils.h"
+
+namespace ge {
+namespace {
+// folding results worth caching come from small tensors, e.g. shapes, larger ones cost more to hash and keep
+const size_t kMaxCachedInputSize = 1024U * 1024U;
+const uint64_t kFnvOffsetBasis = 14695981039346656037ULL;
+const uint64_t kFnvPrime = 1099511628211ULL;
+
+uint64_t HashBytes(const uint8_t *data, size_t size) {
+  uint64_t hash = kFnvOffsetBasis;
+  for (size_t i = 0U; i < size; ++i) {
+    hash ^= data[i];
+    hash *= kFnvPrime;
+  }
+  return hash;
+}
+
+void AppendTensorDesc(const GeTensorDesc &tensor_desc, std::stringstream &ss) {
+  ss << TypeUtils::DataTypeToSerialString(tensor_desc.GetDataType()) << ","
+     << TypeUtils::FormatToSerialString(tensor_desc.GetFormat()) << ","
+     << tensor_desc.GetShape().ToString() << ";";
+}
+
+GeTensorPtr CopyTensor(const GeTensor &tensor) {
+  return MakeShared<GeTensor>(tensor.GetTensorDesc(), tensor.GetData().data(), tensor.GetData().size());
+}
+}  // namespace
+
+FoldingCache &FoldingCache::GetInstance() {
+  static FoldingCache instance;
+  return instance;
+}
+
+void FoldingCache::SetCapacity(size_t capacity) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  capacity_ = capacity;
+  EvictLocked(capacity_);
+}
+
+void FoldingCache::InitCapacity(size_t capacity) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (capacity_inited_) {
+    if (capacity != capacity_) {
+      GELOGW("Capacity of folding cache is already %zu by the first session, ignore %zu. The cache is shared by "
+             "the process.", capacity_, capacity);
+    }
+    return;
+  }
+  capacity_inited_ = true;
+  capacity_ = capacity;
+  EvictLocked(capacity_);
+}
+
+size_t FoldingCache::GetCapacity() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return capacity_;
+}
+
+bool FoldingCache::GenerateKey(const OpDescPtr &op_desc, const std::vector<ConstGeTensorPtr> &inputs,
+                               std::string &key) {
+  if (op_desc == nullptr) {
+    return false;
+  }
+  size_t input_size = 0U;
+  for (const auto &input : inputs) {
+    if (input == nullptr) {
+      return false;
+    }
+    input_size += input->GetData().size();
+    if (input_size > kMaxCachedInputSize) {
+      return false;
+    }
+  }
+
+  std::stringstream ss;
+  const std::string attrs = AttrUtils::GetAllAttrsStr(op_desc);
+  // the attrs are kept in full, they are compared by the key when hit
+  ss << op_desc->GetType() << "|attrs:" << attrs.size() << ":" << attrs << "|desc:";
+  // kernels may decide the outputs by the descs of the op, e.g. the data type of Cast
+  for (const auto &tensor_desc : op_desc->GetAllInputsDescPtr()) {
+    AppendTensorDesc(*tensor_desc, ss);
+  }
+  for (const auto &tensor_desc : op_desc->GetAllOutputsDescPtr()) {
+    AppendTensorDesc(*tensor_desc, ss);
+  }
+  ss << "|inputs:";
+  for (const auto &input : inputs) {
+    AppendTensorDesc(input->GetTensorDesc(), ss);
+    ss << input->GetData().size() << "," << HashBytes(input->GetData().data(), input->GetData().size()) << ";";
+  }
+  key = ss.str();
+  return true;
+}
+
+bool FoldingCache::Find(const std::string &key, const std::vector<ConstGeTensorPtr> &inputs,
+                        std::vector<GeTensorPtr> &outputs) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto iter = key_to_entry_.find(key);
+  if (iter == key_to_entry_.end()) {
+    miss_count_++;
+    return false;
+  }
+  auto &entry = *iter->second;
+  if (entry.inputs.size() != inputs.size()) {
+    miss_count_++;
+    return false;
+  }
+  for (size_t i = 0U; i < inputs.size(); ++i) {
+    const auto &data = inputs[i]->GetData();
+    if ((entry.inputs[i].size() != data.size()) ||
+        ((data.size() > 0U) && (memcmp(entry.inputs[i].data(), data.data(), data.size()) != 0))) {
+      GELOGD("Folding cache key of %s collides, inputs are different.", entry.key.c_str());
+      miss_count_++;
+      return false;
+    }
+  }
+
+  std::vector<GeTensorPtr> copies;
+  for (const auto &output : entry.outputs) {
+    auto copy = CopyTensor(*output);
+    if (copy == nullptr) {
+      miss_count_++;
+      return false;
+    }
+    copies.emplace_back(copy);
+  }
+  entries_.splice(entries_.begin(), entries_, iter->second);
+  outputs.swap(copies);
+  hit_count_++;
+  return true;
+}
+
+void FoldingCache::Insert(const std::string &key, const std::vector<ConstGeTensorPtr> &inputs,
+                          const std::vector<GeTensorPtr> &outputs) {
+  Entry entry;
+  entry.key = key;
+  entry.size = key.size();
+  for (const auto &input : inputs) {
+    const auto &data = input->GetData();
+    entry.inputs.emplace_back(data.data(), data.data() + data.size());
+    entry.size += data.size();
+  }
+  for (const auto &output : outputs) {
+    auto copy = (output == nullptr) ? nullptr : CopyTensor(*output);
+    if (copy == nullptr) {
+      return;
+    }
+    entry.outputs.emplace_back(copy);
+    entry.size += output->GetData().size();
+  }
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  // the same result may be computed by another thread meanwhile
+  if ((entry.size > capacity_) || (key_to_entry_.count(key) > 0U)) {
+    return;
+  }
+  size_ += entry.size;
+  entries_.emplace_front(std::move(entry));
+  key_to_entry_[key] = entries_.begin();
+  EvictLocked(capacity_);
+}
+
+void FoldingCache::Clear() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  EvictLocked(0U);
+  capacity_inited_ = false;
+  hit_count_ = 0U;
+  miss_count_ = 0U;
+}
+
+size_t FoldingCache::GetSize() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return size_;
+}
+
+size_t FoldingCache::GetEntryNum() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return entries_.size();
+}
+
+void FoldingCache::EvictLocked(size_t capacity) {
+  while ((size_ > capacity) && !entries_.empty()) {
+    const auto &entry = entries_.back();
+    size_ -= entry.size;
+    (void)key_to_entry_.erase(entry.key);
+    entries_.pop_back();
+  }
+}
+}  // namespace ge
@@ -0,0 +1,107 @@
+/**
+* Copyright 2021, 2022 LuoJiaNET Research and Development Group, Wuhan University
+* Copyright 2021, 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef GE_GRAPH_PASSES_FOLDING_CACHE_H_
+#define GE_GRAPH_PASSES_FOLDING_CACHE_H_
+
+#include <atomic>
+#include <cstdint>
+#include <list>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "graph/ge_tensor.h"
+#include "graph/op_desc.h"
+
+namespace ge {
+///
+/// Process wide cache of constant folding results, shared by graphs and sessions.
+/// A result is keyed by the op type, the attributes, the tensor descs of the op and the hashes of the input data.
+/// The input data is kept as well and compared when hit, so a hash collision never returns a wrong result.
+/// The least recently used results are evicted beyond the capacity.
+///
+class FoldingCache {
+ public:
+  static FoldingCache &GetInstance();
+
+  FoldingCache(const FoldingCache &) = delete;
+  FoldingCache &operator=(const FoldingCache &) = delete;
+
+  ///
+  /// @brief set capacity in bytes of the input and output data kept, 0 to clear and disable the cache
+  ///
+  void SetCapacity(size_t capacity);
+  size_t GetCapacity() const;
+
+  ///
+  /// @brief set capacity by option ge.constantFoldingCacheSize. The cache is shared by the process, so only the
+  /// first call takes effect, later ones of another capacity are ignored with a warning
+  ///
+  void InitCapacity(size_t capacity);
+
+  ///
+  /// @return false if the node is not cached, e.g. some input is null or the inputs are too large to be worth it
+  ///
+  static bool GenerateKey(const OpDescPtr &op_desc, const std::vector<ConstGeTensorPtr> &inputs, std::string &key);
+
+  ///
+  /// @brief outputs are copies, the caller may change them
+  /// @return true if hit
+  ///
+  bool Find(const std::string &key, const std::vector<ConstGeTensorPtr> &inputs, std::vector<GeTensorPtr> &outputs);
+
+  void Insert(const std::string &key, const std::vector<ConstGeTensorPtr> &inputs,
+              const std::vector<GeTensorPtr> &outputs);
+
+  ///
+  /// @brief drop all results and statistics, the next InitCapacity applies again
+  ///
+  void Clear();
+
+  size_t GetSize() const;
+  size_t GetEntryNum() const;
+  uint64_t GetHitCount() const { return hit_count_.load(); }
+  uint64_t GetMissCount() const { return miss_count_.load(); }
+
+ private:
+  struct Entry {
+    std::string key;
+    std::vector<std::vector<uint8_t>> inputs;
+    std::vector<GeTensorPtr> outputs;
+    size_t size = 0U;
+  };
+
+  FoldingCache() = default;
+  ~FoldingCache() = default;
+
+  void EvictLocked(size_t capacity);
+
+  mutable std::mutex mutex_;
+  size_t capacity_ = 0U;
+  bool capacity_inited_ = false;
+  size_t size_ = 0U;
+  // the most recently used entry in the front
+  std::list<Entry> entries_;
+  std::unordered_map<std::string, std::list<Entry>::iterator> key_to_entry_;
+  std::atomic<uint64_t> hit_count_{0};
+  std::atomic<uint64_t> miss_count_{0};
+};
+}  // namespace ge
+
+#endif  // GE_GRAPH_PASSES_FOLDING_CACHE_H_
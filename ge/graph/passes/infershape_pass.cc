@@ -15,13 +15,16 @@
  */
 
 #include "graph/passes/infershape_pass.h"
+#include <cstring>
 #include "common/util/error_manager/error_manager.h"
 #include "framework/common/debug/ge_log.h"
 #include "analyzer/analyzer.h"
 #include "framework/common/util.h"
 #include "graph/shape_refiner.h"
+#include "graph/utils/attr_utils.h"
 #include "graph/utils/graph_utils.h"
 #include "graph/utils/node_utils.h"
+#include "graph/utils/op_desc_utils.h"
 #include "common/omg_util.h"
 #include "graph/debug/ge_attr_define.h"
 #include "graph/utils/tensor_utils.h"
@@ -33,6 +36,102 @@ namespace ge {
 namespace {
 constexpr int kSwitchExitAnchorIndex = 0;
 constexpr int kSwitchPredAnchorIndex = 1;
+// infer functions may read the data of const inputs, larger ones cost more to hash than to infer
+constexpr size_t kMaxHashedConstSize = 1024U * 1024U;
+constexpr uint64_t kFnvOffsetBasis = 14695981039346656037ULL;
+constexpr uint64_t kFnvPrime = 1099511628211ULL;
+
+uint64_t HashBytes(const uint8_t *data, size_t size) {
+  uint64_t hash = kFnvOffsetBasis;
+  for (size_t i = 0U; i < size; ++i) {
+    hash ^= data[i];
+    hash *= kFnvPrime;
+  }
+  return hash;
+}
+
+void AppendShapeRange(const std::vector<std::pair<int64_t, int64_t>> &shape_range, std::stringstream &ss) {
+  ss << "[";
+  for (const auto &pair : shape_range) {
+    ss << pair.first << "~" << pair.second << ",";
+  }
+  ss << "]";
+}
+
+void AppendShapeAndType(const GeTensorDesc &desc, std::stringstream &ss) {
+  ss << desc.GetDataType() << "," << desc.GetOriginDataType() << "," << desc.GetFormat() << ","
+     << desc.GetOriginFormat() << "," << desc.GetShape().ToString() << "," << desc.GetOriginShape().ToString() << ",";
+  std::vector<std::pair<int64_t, int64_t>> shape_range;
+  (void)desc.GetShapeRange(shape_range);
+  AppendShapeRange(shape_range, ss);
+  shape_range.clear();
+  (void)desc.GetOriginShapeRange(shape_range);
+  AppendShapeRange(shape_range, ss);
+  ss << ";";
+}
+
+void RestoreShapeAndType(const GeTensorDesc &src, const GeTensorDescPtr &dst) {
+  dst->SetShape(src.GetShape());
+  dst->SetOriginShape(src.GetOriginShape());
+  dst->SetDataType(src.GetDataType());
+  dst->SetOriginDataType(src.GetOriginDataType());
+  dst->SetFormat(src.GetFormat());
+  dst->SetOriginFormat(src.GetOriginFormat());
+  std::vector<std::pair<int64_t, int64_t>> shape_range;
+  (void)src.GetShapeRange(shape_range);
+  dst->SetShapeRange(shape_range);
+  shape_range.clear();
+  (void)src.GetOriginShapeRange(shape_range);
+  dst->SetOriginShapeRange(shape_range);
+  ge::TensorUtils::SetRealDimCnt(*dst, static_cast<uint32_t>(src.GetOriginShape().GetDims().size()));
+}
+
+///
+/// Infer functions read the data of the const inputs, e.g. the shape input of Reshape. Only the hashes are in the key,
+/// the weights are collected to be compared when a result is reused.
+/// @return false if the data of some const input is too large to be hashed
+///
+bool AppendConstInputs(const NodePtr &node, std::stringstream &ss, std::vector<ConstGeTensorPtr> *const_weights) {
+  for (const auto &in_anchor : node->GetAllInDataAnchors()) {
+    auto peer_anchor = in_anchor->GetPeerOutAnchor();
+    if (peer_anchor == nullptr) {
+      continue;
+    }
+    auto peer_node = peer_anchor->GetOwnerNode();
+    if ((peer_node->GetType() == DATA) && (NodeUtils::GetParentInput(peer_node) != nullptr)) {
+      peer_node = NodeUtils::GetParentInput(peer_node);
+    }
+    if ((peer_node->GetType() != CONSTANT) && (peer_node->GetType() != CONSTANTOP)) {
+      continue;
+    }
+    ss << in_anchor->GetIdx() << ":";
+    for (const auto &weight : OpDescUtils::GetWeights(peer_node)) {
+      if ((weight == nullptr) || (weight->GetData().size() > kMaxHashedConstSize)) {
+        return false;
+      }
+      ss << weight->GetData().size() << "," << HashBytes(weight->GetData().data(), weight->GetData().size()) << ";";
+      if (const_weights != nullptr) {
+        const_weights->emplace_back(weight);
+      }
+    }
+  }
+  return true;
+}
+
+bool SameConstData(const std::vector<std::vector<uint8_t>> &const_data,
+                   const std::vector<ConstGeTensorPtr> &const_weights) {
+  if (const_data.size() != const_weights.size()) {
+    return false;
+  }
+  for (size_t i = 0U; i < const_data.size(); ++i) {
+    const auto &weight_data = const_weights[i]->GetData();
+    if ((const_data[i].size() != weight_data.size()) ||
+        ((weight_data.size() > 0U) && (memcmp(const_data[i].data(), weight_data.data(), weight_data.size()) != 0))) {
+      return false;
+    }
+  }
+  return true;
+}
 void SerialShapeRange(const GeTensorDescPtr &desc, std::string &desc_str) {
   desc_str += "[";
   std::vector<std::pair<int64_t, int64_t>> shape_range;
@@ -133,17 +232,30 @@ graphStatus InferShapePass::InferShapeAndType(NodePtr &node) {
     GELOGE(GRAPH_FAILED, "[Call][Verify] Verifying %s failed.", node->GetName().c_str());
     return GRAPH_FAILED;
   }
-  Operator op = OpDescUtils::CreateOperatorFromNode(node);
 
+  // the results depending on the inference contexts of the resource ops are not reused
+  std::string input_key;
+  std::string output_key;
+  std::vector<ConstGeTensorPtr> const_weights;
+  bool reusable = GenerateInferKey(node, is_unknown_graph, input_key, output_key, &const_weights);
+  InferenceContextPtr inference_context;
   if (!is_unknown_graph) {
-    auto inference_context = ShapeRefiner::CreateInferenceContext(node);
+    inference_context = ShapeRefiner::CreateInferenceContext(node);
     GE_CHECK_NOTNULL(inference_context);
     std::vector<AscendString> marks;
     inference_context->GetMarks(marks);
     GELOGD("create context for node:%s, marks %zu", node->GetName().c_str(), marks.size());
-    op.SetInferenceContext(inference_context);
+    reusable = reusable && marks.empty() && inference_context->GetInputHandleShapesAndTypes().empty();
+  }
+  if (reusable && ReuseInferResult(node, is_unknown_graph, input_key + output_key, const_weights)) {
+    return GRAPH_SUCCESS;
   }
 
+  Operator op = OpDescUtils::CreateOperatorFromNode(node);
+  if (inference_context != nullptr) {
+    op.SetInferenceContext(inference_context);
+  }
+  infer_count_++;
   graphStatus status = CallInferShapeFunc(node, op);
   if (status != GRAPH_NODE_NEED_REPASS && status != GRAPH_PARAM_INVALID && status != GRAPH_SUCCESS) {
     // node like netoutput return param_invalid, but valid ?
@@ -160,13 +272,112 @@ graphStatus InferShapePass::InferShapeAndType(NodePtr &node) {
         GELOGD("[%s] set inference context after. mark:%zu", node->GetName().c_str(),
                marks.size());
         ShapeRefiner::PushToContextMap(node, ctx_after_infer);
+        reusable = false;
       }
     }
   }
 
+  if (reusable && (status == GRAPH_SUCCESS)) {
+    SaveInferResult(node, is_unknown_graph, input_key, input_key + output_key, const_weights);
+  } else {
+    (void)nodes_2_infer_keys_.erase(node.get());
+  }
   return (status == GRAPH_NODE_NEED_REPASS) ? GRAPH_NODE_NEED_REPASS : GRAPH_SUCCESS;
 }
 
+bool InferShapePass::GenerateInferKey(const NodePtr &node, bool is_unknown_graph, std::string &input_key,
+                                      std::string &output_key, std::vector<ConstGeTensorPtr> *const_weights) const {
+  auto op_desc = node->GetOpDesc();
+  // the outputs of the nodes with subgraphs are updated from the subgraphs, not only by the infer functions
+  if (!op_desc->GetSubgraphInstanceNames().empty()) {
+    return false;
+  }
+  // the attributes are kept in full, a hash collision would silently reuse wrong shapes
+  const std::string attrs = AttrUtils::GetAllAttrsStr(op_desc);
+  std::stringstream ss;
+  ss << op_desc->GetType() << "|unknown:" << is_unknown_graph << "|attrs:" << attrs.size() << ":" << attrs << "|inputs:";
+  for (const auto &input_desc : op_desc->GetAllInputsDescPtr()) {
+    if (input_desc == nullptr) {
+      return false;
+    }
+    AppendShapeAndType(*input_desc, ss);
+    // value ranges and other attributes of the inputs may be read by the infer functions
+    const std::string input_attrs = AttrUtils::GetAllAttrsStr(input_desc);
+    ss << input_attrs.size() << ":" << input_attrs << ",";
+  }
+  ss << "|const:";
+  if (!AppendConstInputs(node, ss, const_weights)) {
+    return false;
+  }
+  // only the shapes and types of the outputs are restored when reused, the attributes must be the same
+  ss << "|output_attrs:";
+  std::stringstream outputs_ss;
+  outputs_ss << "|outputs:";
+  for (const auto &output_desc : op_desc->GetAllOutputsDescPtr()) {
+    if (output_desc == nullptr) {
+      return false;
+    }
+    const std::string output_attrs = AttrUtils::GetAllAttrsStr(output_desc);
+    ss << output_attrs.size() << ":" << output_attrs << ",";
+    AppendShapeAndType(*output_desc, outputs_ss);
+  }
+  input_key = ss.str();
+  output_key = outputs_ss.str();
+  return true;
+}
+
+bool InferShapePass::ReuseInferResult(const NodePtr &node, bool is_unknown_graph, const std::string &infer_key,
+                                      const std::vector<ConstGeTensorPtr> &const_weights) {
+  auto iter = nodes_2_infer_keys_.find(node.get());
+  if ((iter != nodes_2_infer_keys_.end()) && (iter->second == infer_key)) {
+    GELOGD("Node %s is not changed since the last infer, skip it.", node->GetName().c_str());
+    skipped_infer_count_++;
+    return true;
+  }
+  auto result = keys_2_infer_results_.find(infer_key);
+  if (result == keys_2_infer_results_.end()) {
+    return false;
+  }
+  const auto &outputs = result->second.outputs;
+  auto op_desc = node->GetOpDesc();
+  if ((outputs.size() != op_desc->GetOutputsSize()) || !SameConstData(result->second.const_data, const_weights)) {
+    return false;
+  }
+  for (size_t i = 0U; i < outputs.size(); ++i) {
+    RestoreShapeAndType(outputs[i], op_desc->MutableOutputDesc(static_cast<uint32_t>(i)));
+  }
+  GELOGD("Node %s reuses the infer result of the same type, attributes and tensor descs.", node->GetName().c_str());
+  memoized_infer_count_++;
+  std::string input_key;
+  std::string output_key;
+  if (GenerateInferKey(node, is_unknown_graph, input_key, output_key)) {
+    nodes_2_infer_keys_[node.get()] = input_key + output_key;
+  }
+  return true;
+}
+
+void InferShapePass::SaveInferResult(const NodePtr &node, bool is_unknown_graph, const std::string &input_key,
+                                     const std::string &infer_key, const std::vector<ConstGeTensorPtr> &const_weights) {
+  std::string input_key_after_infer;
+  std::string output_key_after_infer;
+  // the result is not reusable if the infer function changes the attributes or the inputs, the node may differ
+  // from other ones of the same key then
+  if (!GenerateInferKey(node, is_unknown_graph, input_key_after_infer, output_key_after_infer) ||
+      (input_key_after_infer != input_key)) {
+    (void)nodes_2_infer_keys_.erase(node.get());
+    return;
+  }
+  nodes_2_infer_keys_[node.get()] = input_key_after_infer + output_key_after_infer;
+  InferResult result;
+  for (const auto &output_desc : node->GetOpDesc()->GetAllOutputsDescPtr()) {
+    result.outputs.emplace_back(*output_desc);
+  }
+  for (const auto &weight : const_weights) {
+    result.const_data.emplace_back(weight->GetData().data(), weight->GetData().data() + weight->GetData().size());
+  }
+  keys_2_infer_results_[infer_key] = std::move(result);
+}
+
 void InferShapePass::UpdateCurNodeOutputDesc(NodePtr &node) {
   auto op_desc = node->GetOpDesc();
   for (const auto &out_anchor : node->GetAllOutDataAnchors()) {
@@ -19,6 +19,7 @@
 
 #include "graph/passes/infer_base_pass.h"
 #include <stack>
+#include <unordered_map>
 
 namespace ge {
 class InferShapePass : public InferBasePass {
@@ -33,8 +34,22 @@ class InferShapePass : public InferBasePass {
 
   Status OnSuspendNodesLeaked() override;
 
+  ///
+  /// Infer functions really called, and the ones skipped as the node is unchanged since its last infer or
+  /// as the result of a node with the same type, attributes and tensor descs is reused.
+  ///
+  uint64_t GetInferCount() const { return infer_count_; }
+  uint64_t GetSkippedInferCount() const { return skipped_infer_count_; }
+  uint64_t GetMemoizedInferCount() const { return memoized_infer_count_; }
+
  private:
   graphStatus InferShapeAndType(NodePtr &node);
+  bool GenerateInferKey(const NodePtr &node, bool is_unknown_graph, std::string &input_key, std::string &output_key,
+                        std::vector<ConstGeTensorPtr> *const_weights = nullptr) const;
+  bool ReuseInferResult(const NodePtr &node, bool is_unknown_graph, const std::string &infer_key,
+                        const std::vector<ConstGeTensorPtr> &const_weights);
+  void SaveInferResult(const NodePtr &node, bool is_unknown_graph, const std::string &input_key,
+                       const std::string &infer_key, const std::vector<ConstGeTensorPtr> &const_weights);
   graphStatus CallInferShapeFunc(NodePtr &node, Operator &op);
   bool SameTensorDesc(const GeTensorDescPtr &src, const GeTensorDescPtr &dst);
   void UpdateCurNodeOutputDesc(NodePtr &node);
@@ -51,6 +66,18 @@ class InferShapePass : public InferBasePass {
     }
   };
   std::map<std::string, SuspendNodes> graphs_2_suspend_nodes_;
+  // key of the node after its last infer, the node is not inferred again until its key changes
+  std::unordered_map<const Node *, std::string> nodes_2_infer_keys_;
+  struct InferResult {
+    std::vector<GeTensorDesc> outputs;
+    // data of the const inputs, only their hashes are in the key
+    std::vector<std::vector<uint8_t>> const_data;
+  };
+  // output descs inferred by the key before infer
+  std::unordered_map<std::string, InferResult> keys_2_infer_results_;
+  uint64_t infer_count_ = 0;
+  uint64_t skipped_infer_count_ = 0;
+  uint64_t memoized_infer_count_ = 0;
 };
 }  // namespace ge
 #endif  // GE_GRAPH_PASSES_INFERSHAPE_PASS_H_
@@ -34,6 +34,10 @@ namespace {
 const int kReshapeDataIndex = 0;
 const int kReshapeShapeIndex = 1;
 }  // namespace
+NoUseReshapeRemovePass::NoUseReshapeRemovePass() {
+  SetInterestedTypes({RESHAPE});
+}
+
 Status NoUseReshapeRemovePass::Run(ge::NodePtr &node) {
   GE_CHECK_NOTNULL(node);
   OpDescPtr op_desc_ptr = node->GetOpDesc();
@@ -23,6 +23,7 @@
 namespace ge {
 class NoUseReshapeRemovePass : public BaseNodePass {
  public:
+  NoUseReshapeRemovePass();
   ///
   /// Entry of the NoUseReshapeRemovePass optimizer
   /// To satisfy fusion rule of FE, remove reshape op which input & output format is same
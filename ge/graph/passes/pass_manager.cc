@@ -22,6 +22,7 @@
 #include "graph/utils/node_utils.h"
 #include "common/ge_call_wrapper.h"
 #include "framework/omg/omg_inner_types.h"
+#include "graph/passes/pass_report.h"
 
 namespace ge {
 const vector<std::pair<std::string, GraphPass *>>& PassManager::GraphPasses() const { return names_to_graph_passes_; }
@@ -47,9 +48,14 @@ Status PassManager::Run(const ComputeGraphPtr &graph, vector<std::pair<std::stri
     GE_CHECK_NOTNULL(pass);
 
     GE_TIMESTAMP_START(PassRun);
+    const bool report_active = PassReport::IsActive();
+    GraphPassRecorder recorder("graph_pass", pass_name, report_active ? graph->GetAllNodesSize() : 0U);
+    size_t nodes_visited = report_active ? graph->GetDirectNodesSize() : 0U;
+    bool pass_changed = false;
     Status status = pass->Run(graph);
     if (status == SUCCESS) {
       not_changed = false;
+      pass_changed = true;
     } else if (status != NOT_CHANGED) {
       GELOGE(status, "[Pass][Run] failed on graph %s", graph->GetName().c_str());
       return status;
@@ -61,14 +67,17 @@ Status PassManager::Run(const ComputeGraphPtr &graph, vector<std::pair<std::stri
       GE_TIMESTAMP_START(PassRunSubgraph);
       status = pass->Run(subgraph);
       GE_TIMESTAMP_END(PassRunSubgraph, subgraph_pass_name.c_str());
+      nodes_visited += report_active ? subgraph->GetDirectNodesSize() : 0U;
       if (status == SUCCESS) {
         not_changed = false;
+        pass_changed = true;
       } else if (status != NOT_CHANGED) {
         GELOGE(status, "[Pass][Run] failed on subgraph %s", subgraph->GetName().c_str());
         return status;
       }
     }
     GE_TIMESTAMP_END(PassRun, pass_name.c_str());
+    recorder.Finish(nodes_visited, report_active ? graph->GetAllNodesSize() : 0U, pass_changed);
   }
 
   return not_changed ? NOT_CHANGED : SUCCESS;
@@ -0,0 +1,194 @@
+/**
+* Copyright 2021, 2022 LuoJiaNET Research and Development Group, Wuhan University
+* Copyright 2021, 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "graph/passes/pass_report.h"
+
+#include <unistd.h>
+#include <cstdio>
+#include <fstream>
+#include <nlohmann/json.hpp>
+
+#include "external/ge/ge_api_types.h"
+#include "framework/common/debug/ge_log.h"
+#include "framework/common/debug/log.h"
+#include "graph/ge_context.h"
+
+namespace ge {
+namespace {
+thread_local const PassReportScope *current_scope = nullptr;
+
+const int64_t kKiloBytes = 1024;
+}  // namespace
+
+PassReport &PassReport::GetInstance() {
+  static PassReport instance;
+  return instance;
+}
+
+bool PassReport::IsActive() {
+  return current_scope != nullptr;
+}
+
+void PassReport::Record(const std::string &kind, const std::string &pass_name, const PassRecord &record) {
+  const PassReportScope *scope = current_scope;
+  if (scope == nullptr) {
+    return;
+  }
+  const std::string key = scope->GetStage() + "|" + kind + "|" + pass_name;
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto &report = graph_reports_[scope->GetGraphId()];
+  auto iter = report.keys_to_index.find(key);
+  if (iter == report.keys_to_index.end()) {
+    iter = report.keys_to_index.emplace(key, report.entries.size()).first;
+    PassEntry entry;
+    entry.stage = scope->GetStage();
+    entry.kind = kind;
+    entry.name = pass_name;
+    report.entries.emplace_back(std::move(entry));
+  }
+  auto &total = report.entries[iter->second].record;
+  total.calls += record.calls;
+  total.time_us += record.time_us;
+  total.nodes_visited += record.nodes_visited;
+  total.nodes_changed += record.nodes_changed;
+  total.graphs_changed += record.graphs_changed;
+  total.re_pass_count += record.re_pass_count;
+  total.node_num_delta += record.node_num_delta;
+  total.mem_delta_kb += record.mem_delta_kb;
+}
+
+Status PassReport::ToJson(uint32_t graph_id, std::string &json) const {
+  nlohmann::json passes_json = nlohmann::json::array();
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto iter = graph_reports_.find(graph_id);
+    if (iter != graph_reports_.end()) {
+      for (const auto &entry : iter->second.entries) {
+        nlohmann::json pass_json;
+        pass_json["stage"] = entry.stage;
+        pass_json["name"] = entry.name;
+        pass_json["kind"] = entry.kind;
+        pass_json["calls"] = entry.record.calls;
+        pass_json["time_us"] = entry.record.time_us;
+        pass_json["nodes_visited"] = entry.record.nodes_visited;
+        pass_json["nodes_changed"] = entry.record.nodes_changed;
+        pass_json["graphs_changed"] = entry.record.graphs_changed;
+        pass_json["re_pass_count"] = entry.record.re_pass_count;
+        pass_json["node_num_delta"] = entry.record.node_num_delta;
+        pass_json["mem_delta_kb"] = entry.record.mem_delta_kb;
+        passes_json.push_back(pass_json);
+      }
+    }
+  }
+  nlohmann::json report_json;
+  report_json["graph_id"] = graph_id;
+  report_json["passes"] = passes_json;
+  try {
+    json = report_json.dump();
+  } catch (const nlohmann::json::exception &e) {
+    GELOGE(FAILED, "[Dump][Json]Failed to dump pass report of graph %u, reason: %s.", graph_id, e.what());
+    REPORT_INNER_ERROR("E19999", "Failed to dump pass report of graph %u, reason: %s.", graph_id, e.what());
+    return FAILED;
+  }
+  return SUCCESS;
+}
+
+Status PassReport::Dump(uint32_t graph_id, const std::string &path) {
+  std::string json;
+  auto ret = ToJson(graph_id, json);
+  Clear(graph_id);
+  if (ret != SUCCESS) {
+    return ret;
+  }
+  const std::string report_file = path + "/ge_pass_report_" + std::to_string(graph_id) + ".json";
+  std::ofstream ofs(report_file, std::ios::trunc);
+  if (!ofs.is_open()) {
+    GELOGW("Open %s failed, skip writing pass report.", report_file.c_str());
+    return FAILED;
+  }
+  ofs << json << std::endl;
+  GELOGI("Pass report of graph %u is written to %s.", graph_id, report_file.c_str());
+  return SUCCESS;
+}
+
+void PassReport::Clear(uint32_t graph_id) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  (void)graph_reports_.erase(graph_id);
+}
+
+int64_t PassReport::GetResidentMemoryKb() {
+  FILE *file = fopen("/proc/self/statm", "r");
+  if (file == nullptr) {
+    return 0;
+  }
+  long size = 0;
+  long resident = 0;
+  const int num = fscanf(file, "%ld %ld", &size, &resident);
+  (void)fclose(file);
+  if (num != 2) {  // size and resident
+    return 0;
+  }
+  return static_cast<int64_t>(resident) * static_cast<int64_t>(sysconf(_SC_PAGESIZE)) / kKiloBytes;
+}
+
+PassReportScope::PassReportScope(uint32_t graph_id, const std::string &stage) : graph_id_(graph_id), stage_(stage) {
+  (void)GetContext().GetOption(PASS_REPORT_PATH, path_);  // option may not be set up
+  if (path_.empty()) {
+    return;
+  }
+  active_ = true;
+  outer_ = current_scope;
+  current_scope = this;
+}
+
+PassReportScope::~PassReportScope() {
+  if (active_) {
+    current_scope = outer_;
+  }
+}
+
+const PassReportScope *PassReportScope::GetCurrent() {
+  return current_scope;
+}
+
+GraphPassRecorder::GraphPassRecorder(const std::string &kind, const std::string &pass_name, size_t node_num)
+    : active_(PassReport::IsActive()) {
+  if (!active_) {
+    return;
+  }
+  kind_ = kind;
+  pass_name_ = pass_name;
+  node_num_ = node_num;
+  mem_kb_ = PassReport::GetResidentMemoryKb();
+  start_ = std::chrono::steady_clock::now();
+}
+
+void GraphPassRecorder::Finish(size_t nodes_visited, size_t node_num, bool changed) {
+  if (!active_) {
+    return;
+  }
+  PassRecord record;
+  record.calls = 1U;
+  record.time_us = static_cast<uint64_t>(
+      std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start_).count());
+  record.nodes_visited = nodes_visited;
+  record.graphs_changed = changed ? 1U : 0U;
+  record.node_num_delta = static_cast<int64_t>(node_num) - static_cast<int64_t>(node_num_);
+  record.mem_delta_kb = PassReport::GetResidentMemoryKb() - mem_kb_;
+  PassReport::GetInstance().Record(kind_, pass_name_, record);
+}
+}  // namespace ge
@@ -0,0 +1,141 @@
+/**
+* Copyright 2021, 2022 LuoJiaNET Research and Development Group, Wuhan University
+* Copyright 2021, 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef GE_GRAPH_PASSES_PASS_REPORT_H_
+#define GE_GRAPH_PASSES_PASS_REPORT_H_
+
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "framework/common/ge_inner_error_codes.h"
+
+namespace ge {
+struct PassRecord {
+  uint64_t calls = 0U;           // runs of the pass, a node pass runs once a GEPass
+  uint64_t time_us = 0U;
+  uint64_t nodes_visited = 0U;
+  uint64_t nodes_changed = 0U;   // node passes only, nodes the pass deleted or asked to re-pass after it
+  uint64_t graphs_changed = 0U;  // graph passes only, the runs not returning NOT_CHANGED
+  uint64_t re_pass_count = 0U;   // node passes only, nodes the pass asked to re-pass
+  int64_t node_num_delta = 0;    // graph passes only
+  int64_t mem_delta_kb = 0;      // change of the resident memory of the process, not per node pass
+};
+
+///
+/// Per graph report of the passes and graph optimizers, by the stages of PassReportScope.
+/// The records of the same pass in the same stage are added up, the report keeps the order they come first.
+///
+class PassReport {
+ public:
+  static PassReport &GetInstance();
+
+  PassReport(const PassReport &) = delete;
+  PassReport &operator=(const PassReport &) = delete;
+
+  ///
+  /// @return false if there is no active PassReportScope on the thread, nothing is recorded then
+  ///
+  static bool IsActive();
+
+  ///
+  /// @brief add up the record to the pass in the stage of the current scope
+  /// @param [in] kind: graph_pass, node_pass, ge_pass or graph_optimizer
+  ///
+  void Record(const std::string &kind, const std::string &pass_name, const PassRecord &record);
+
+  Status ToJson(uint32_t graph_id, std::string &json) const;
+
+  ///
+  /// @brief write the report of the graph to <path>/ge_pass_report_<graph id>.json and clear it
+  ///
+  Status Dump(uint32_t graph_id, const std::string &path);
+
+  void Clear(uint32_t graph_id);
+
+  static int64_t GetResidentMemoryKb();
+
+ private:
+  struct PassEntry {
+    std::string stage;
+    std::string kind;
+    std::string name;
+    PassRecord record;
+  };
+  struct GraphReport {
+    std::vector<PassEntry> entries;
+    std::map<std::string, size_t> keys_to_index;
+  };
+
+  PassReport() = default;
+  ~PassReport() = default;
+
+  mutable std::mutex mutex_;
+  std::map<uint32_t, GraphReport> graph_reports_;
+};
+
+///
+/// Passes run on the thread in the scope are recorded to the graph and stage, an inner scope replaces the outer
+/// one till it ends. The scope is active only if option PASS_REPORT_PATH is set.
+///
+class PassReportScope {
+ public:
+  PassReportScope(uint32_t graph_id, const std::string &stage);
+  ~PassReportScope();
+
+  PassReportScope(const PassReportScope &) = delete;
+  PassReportScope &operator=(const PassReportScope &) = delete;
+
+  ///
+  /// @return nullptr if no active scope on the thread
+  ///
+  static const PassReportScope *GetCurrent();
+
+  uint32_t GetGraphId() const { return graph_id_; }
+  const std::string &GetStage() const { return stage_; }
+  const std::string &GetPath() const { return path_; }
+
+ private:
+  uint32_t graph_id_;
+  std::string stage_;
+  std::string path_;
+  bool active_ = false;
+  const PassReportScope *outer_ = nullptr;
+};
+
+///
+/// Records the time, memory and node number from construction to Finish of a graph pass, if the report is active
+///
+class GraphPassRecorder {
+ public:
+  GraphPassRecorder(const std::string &kind, const std::string &pass_name, size_t node_num);
+  void Finish(size_t nodes_visited, size_t node_num, bool changed);
+
+ private:
+  bool active_;
+  std::string kind_;
+  std::string pass_name_;
+  size_t node_num_ = 0U;
+  int64_t mem_kb_ = 0;
+  std::chrono::steady_clock::time_point start_;
+};
+}  // namespace ge
+
+#endif  // GE_GRAPH_PASSES_PASS_REPORT_H_
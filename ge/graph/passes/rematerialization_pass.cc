@@ -0,0 +1,421 @@
+/**
+* Copyright 2021, 2022 LuoJiaNET Research and Development Group, Wuhan University
+* Copyright 2021, 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "graph/passes/rematerialization_pass.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <limits>
+#include <set>
+
+#include "common/ge/ge_util.h"
+#include "external/ge/ge_api_types.h"
+#include "framework/common/debug/ge_log.h"
+#include "framework/common/types.h"
+#include "graph/ge_context.h"
+#include "graph/utils/attr_utils.h"
+#include "graph/utils/graph_utils.h"
+#include "graph/utils/node_utils.h"
+#include "graph/utils/tensor_utils.h"
+
+namespace ge {
+namespace {
+const int kDecimal = 10;
+const int64_t kMegaBytes = 1024 * 1024;
+// every rematerialization sorts the graph again, bound the time spent on huge graphs
+const size_t kMaxRematerializationTimes = 1024U;
+// recomputing costs at most this many times the bytes saved
+const double kMaxCostPerByte = 4.0;
+
+// cost per byte read and written by the op, only ops listed are recomputed
+const std::map<std::string, double> kRecomputeCostFactors = {
+    {RELU, 1.0}, {RELU6, 1.0}, {ELU, 1.0}, {SIGMOID, 1.0}, {TANH, 1.0}, {CAST, 1.0}, {NEG, 1.0},
+    {EXP, 1.0}, {SQUARE, 1.0}, {SQRT, 1.0}, {ADD, 1.0}, {SUB, 1.0}, {MUL, 1.0}, {REALDIV, 1.0},
+    {MAXIMUM, 1.0}, {MINIMUM, 1.0}, {BIASADD, 1.0}, {ADDN, 1.0},
+    {TRANSPOSE, 2.0}, {TRANSPOSED, 2.0}, {TRANSDATA, 2.0}};
+
+// outputs of these nodes are not feature map, they are always available to the copies
+const std::set<std::string> kNotFeatureMapTypes = {DATA, AIPPDATA, VARIABLE, VARIABLEV2, CONSTANT, CONSTANTOP,
+                                                    FILECONSTANT};
+
+int64_t GetTensorSize(const GeTensorDesc &tensor_desc) {
+  int64_t size = 0;
+  if ((TensorUtils::GetSize(tensor_desc, size) == GRAPH_SUCCESS) && (size > 0)) {
+    return size;
+  }
+  // sizes are not calculated before building, shapes of unknown ones fail here
+  if ((TensorUtils::GetTensorSizeInBytes(tensor_desc, size) != GRAPH_SUCCESS) || (size < 0)) {
+    return 0;
+  }
+  return size;
+}
+}  // namespace
+
+RematerializationPass::RematerializationPass() {
+  std::string enabled;
+  (void)GetContext().GetOption(MEMORY_REMATERIALIZATION, enabled);  // option may not be set up
+  enabled_ = (enabled == "1");
+  std::string budget = "0";
+  (void)GetContext().GetOption(MEMORY_REMATERIALIZATION_BUDGET, budget);
+  int64_t size = std::strtol(budget.c_str(), nullptr, kDecimal);
+  budget_ = std::max<int64_t>(0, std::min(size, std::numeric_limits<int64_t>::max() / kMegaBytes)) * kMegaBytes;
+}
+
+Status RematerializationPass::Run(ComputeGraphPtr graph) {
+  GE_CHECK_NOTNULL(graph);
+  if (!enabled_) {
+    return SUCCESS;
+  }
+  if ((graph->GetParentGraph() != nullptr) || graph->GetGraphUnknownFlag()) {
+    GELOGD("Graph %s is a subgraph or of unknown shape, skip rematerialization.", graph->GetName().c_str());
+    return SUCCESS;
+  }
+  if (graph->TopologicalSorting() != GRAPH_SUCCESS) {
+    GELOGE(FAILED, "[TopoSort][Graph]Graph:%s topological sort failed.", graph->GetName().c_str());
+    REPORT_CALL_ERROR("E19999", "Graph:%s topological sort failed when RematerializationPass run.",
+                      graph->GetName().c_str());
+    return FAILED;
+  }
+  GE_CHK_STATUS_RET(EstimateLives(graph), "[Estimate][Lives] of graph %s failed.", graph->GetName().c_str());
+  size_t peak_order = 0;
+  peak_before_ = GetPeak(peak_order);
+  peak_after_ = peak_before_;
+  rematerialized_num_ = 0;
+
+  while (rematerialized_num_ < kMaxRematerializationTimes) {
+    if ((budget_ > 0) && (peak_after_ <= budget_)) {
+      break;
+    }
+    Candidate candidate;
+    if (!FindCandidate(peak_order, candidate)) {
+      break;
+    }
+    Change change;
+    GE_CHK_STATUS_RET(Rematerialize(graph, candidate, change), "[Rematerialize][Node] %s of graph %s failed.",
+                      candidate.node->GetName().c_str(), graph->GetName().c_str());
+    if (graph->TopologicalSorting() != GRAPH_SUCCESS) {
+      GELOGE(FAILED, "[TopoSort][Graph]Graph:%s topological sort failed.", graph->GetName().c_str());
+      REPORT_CALL_ERROR("E19999", "Graph:%s topological sort failed when RematerializationPass run.",
+                        graph->GetName().c_str());
+      return FAILED;
+    }
+    GE_CHK_STATUS_RET(EstimateLives(graph), "[Estimate][Lives] of graph %s failed.", graph->GetName().c_str());
+    int64_t peak = GetPeak(peak_order);
+    if (peak < peak_after_) {
+      peak_after_ = peak;
+      continue;
+    }
+    // the peak moved elsewhere instead of going down, later candidates would not do better
+    GELOGD("Peak %ld of graph %s is not lowered by recomputing %s, roll back.", peak, graph->GetName().c_str(),
+           candidate.node->GetName().c_str());
+    GE_CHK_STATUS_RET(Rollback(graph, candidate, change), "[Rollback][Node] %s of graph %s failed.",
+                      candidate.node->GetName().c_str(), graph->GetName().c_str());
+    if (graph->TopologicalSorting() != GRAPH_SUCCESS) {
+      GELOGE(FAILED, "[TopoSort][Graph]Graph:%s topological sort failed.", graph->GetName().c_str());
+      REPORT_CALL_ERROR("E19999", "Graph:%s topological sort failed when RematerializationPass run.",
+                        graph->GetName().c_str());
+      return FAILED;
+    }
+    break;
+  }
+
+  if (rematerialized_num_ > 0) {
+    (void)AttrUtils::SetInt(graph, kAttrNameRematerializationPeakBefore, peak_before_);
+    (void)AttrUtils::SetInt(graph, kAttrNameRematerializationPeakAfter, peak_after_);
+  }
+  if ((budget_ > 0) && (peak_after_ > budget_)) {
+    GELOGW("Estimated feature map peak %ld of graph %s is still beyond the budget %ld after rematerialization.",
+           peak_after_, graph->GetName().c_str(), budget_);
+  }
+  GEEVENT("[Rematerialization] graph %s, %zu nodes recomputed, estimated feature map peak %ld -> %ld.",
+          graph->GetName().c_str(), rematerialized_num_, peak_before_, peak_after_);
+  return SUCCESS;
+}
+
+Status RematerializationPass::EstimateLives(const ComputeGraphPtr &graph) {
+  nodes_.clear();
+  node_orders_.clear();
+  node_lives_.clear();
+  for (const auto &node : graph->GetDirectNode()) {
+    GE_CHECK_NOTNULL(node->GetOpDesc());
+    node_orders_[node.get()] = nodes_.size();
+    nodes_.emplace_back(node);
+  }
+
+  for (size_t order = 0; order < nodes_.size(); ++order) {
+    const auto &node = nodes_[order];
+    if (kNotFeatureMapTypes.count(node->GetType()) > 0) {
+      continue;
+    }
+    auto &lives = node_lives_[node.get()];
+    lives.resize(node->GetAllOutDataAnchors().size());
+    for (const auto &out_anchor : node->GetAllOutDataAnchors()) {
+      auto &life = lives[out_anchor->GetIdx()];
+      life.node = node;
+      life.index = out_anchor->GetIdx();
+      life.begin = order;
+      life.end = order;
+      auto output_desc = node->GetOpDesc()->GetOutputDescPtr(static_cast<uint32_t>(out_anchor->GetIdx()));
+      life.size = (output_desc == nullptr) ? 0 : GetTensorSize(*output_desc);
+      for (const auto &in_anchor : out_anchor->GetPeerInDataAnchors()) {
+        auto iter = node_orders_.find(in_anchor->GetOwnerNode().get());
+        if (iter != node_orders_.end()) {
+          life.consumer_orders.emplace_back(iter->second);
+          life.end = std::max(life.end, iter->second);
+        }
+      }
+      std::sort(life.consumer_orders.begin(), life.consumer_orders.end());
+    }
+  }
+  return SUCCESS;
+}
+
+int64_t RematerializationPass::GetPeak(size_t &peak_order) const {
+  std::vector<int64_t> changes(nodes_.size() + 1, 0);
+  for (const auto &node_lives : node_lives_) {
+    for (const auto &life : node_lives.second) {
+      changes[life.begin] += life.size;
+      changes[life.end + 1] -= life.size;
+    }
+  }
+  int64_t peak = 0;
+  int64_t alive_size = 0;
+  peak_order = 0;
+  for (size_t order = 0; order < nodes_.size(); ++order) {
+    alive_size += changes[order];
+    if (alive_size > peak) {
+      peak = alive_size;
+      peak_order = order;
+    }
+  }
+  return peak;
+}
+
+bool RematerializationPass::InputsKeptTill(const NodePtr &node, size_t order) const {
+  for (const auto &in_anchor : node->GetAllInDataAnchors()) {
+    auto peer_anchor = in_anchor->GetPeerOutAnchor();
+    if (peer_anchor == nullptr) {
+      continue;
+    }
+    auto src_node = peer_anchor->GetOwnerNode();
+    if (kNotFeatureMapTypes.count(src_node->GetType()) > 0) {
+      continue;
+    }
+    auto iter = node_lives_.find(src_node.get());
+    if ((iter == node_lives_.end()) || (static_cast<size_t>(peer_anchor->GetIdx()) >= iter->second.size())) {
+      return false;
+    }
+    const auto &life = iter->second[peer_anchor->GetIdx()];
+    if ((life.size <= 0) || (life.end < order)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool RematerializationPass::OnlyUsedFrom(const NodePtr &node, size_t order) const {
+  for (const auto &out_node : node->GetOutAllNodes()) {
+    auto iter = node_orders_.find(out_node.get());
+    if ((iter == node_orders_.end()) || (iter->second < order)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+NodePtr RematerializationPass::GetAnchor(const NodePtr &consumer, const NodePtr &node, size_t peak_order) const {
+  NodePtr anchor;
+  size_t anchor_order = peak_order;
+  for (const auto &in_node : consumer->GetInAllNodes()) {
+    auto iter = node_orders_.find(in_node.get());
+    if ((in_node == node) || (iter == node_orders_.end()) || (iter->second <= anchor_order)) {
+      continue;
+    }
+    anchor = in_node;
+    anchor_order = iter->second;
+  }
+  return anchor;
+}
+
+bool RematerializationPass::FindCandidate(size_t peak_order, Candidate &candidate) const {
+  double best_score = 0.0;
+  for (const auto &node : nodes_) {
+    auto iter = node_lives_.find(node.get());
+    auto factor_iter = kRecomputeCostFactors.find(node->GetType());
+    if ((iter == node_lives_.end()) || (factor_iter == kRecomputeCostFactors.end()) ||
+        !node->GetOpDesc()->GetSubgraphInstanceNames().empty()) {
+      continue;
+    }
+    int64_t read_size = 0;
+    for (const auto &input_desc : node->GetOpDesc()->GetAllInputsDescPtr()) {
+      read_size += (input_desc == nullptr) ? 0 : GetTensorSize(*input_desc);
+    }
+    for (const auto &life : iter->second) {
+      // alive at the peak, not used by the nodes around the peak
+      if ((life.size <= 0) || (life.begin >= peak_order) || (life.end <= peak_order) ||
+          std::binary_search(life.consumer_orders.begin(), life.consumer_orders.end(), peak_order)) {
+        continue;
+      }
+      auto first_late = std::upper_bound(life.consumer_orders.begin(), life.consumer_orders.end(), peak_order);
+      double cost = factor_iter->second * static_cast<double>(read_size + life.size);
+      if ((cost > kMaxCostPerByte * static_cast<double>(life.size)) || !InputsKeptTill(node, *first_late)) {
+        continue;
+      }
+      double score = static_cast<double>(life.size) / std::max(cost, 1.0);
+      if ((candidate.node != nullptr) &&
+          ((score < best_score) || ((score == best_score) && (life.size <= candidate.size)))) {
+        continue;
+      }
+      // computed before the peak unless another input of the consumer comes after it
+      NodePtr anchor = GetAnchor(nodes_[*first_late], node, peak_order);
+      if (anchor == nullptr) {
+        continue;
+      }
+      best_score = score;
+      candidate.node = life.node;
+      candidate.index = life.index;
+      candidate.size = life.size;
+      candidate.first_late_order = *first_late;
+      candidate.anchor = anchor;
+      candidate.cost = cost;
+      candidate.delay_only = (first_late == life.consumer_orders.begin()) && OnlyUsedFrom(node, *first_late);
+      candidate.late_consumers.clear();
+      for (auto order_iter = first_late; order_iter != life.consumer_orders.end(); ++order_iter) {
+        if (candidate.late_consumers.empty() || (candidate.late_consumers.back() != nodes_[*order_iter])) {
+          candidate.late_consumers.emplace_back(nodes_[*order_iter]);
+        }
+      }
+    }
+  }
+  return candidate.node != nullptr;
+}
+
+Status RematerializationPass::Rematerialize(const ComputeGraphPtr &graph, const Candidate &candidate,
+                                            Change &change) {
+  const auto &node = candidate.node;
+  const auto &anchor = candidate.anchor;
+  GE_CHECK_NOTNULL(anchor);
+  if (candidate.delay_only) {
+    // nothing uses the node before the consumers, compute it once right before them instead of copying it
+    GE_CHK_GRAPH_STATUS_RET(GraphUtils::AddEdge(anchor->GetOutControlAnchor(), node->GetInControlAnchor()),
+                            "[Add][ControlEdge] from %s to %s failed.", anchor->GetName().c_str(),
+                            node->GetName().c_str());
+    GELOGD("Node %s, output size %ld, is delayed till %s.", node->GetName().c_str(), candidate.size,
+           candidate.late_consumers.front()->GetName().c_str());
+    rematerialized_num_++;
+    return SUCCESS;
+  }
+
+  OpDescPtr op_desc = AttrUtils::CopyOpDesc(node->GetOpDesc());
+  if (op_desc == nullptr) {
+    GELOGE(FAILED, "[Copy][OpDesc] of node %s failed.", node->GetName().c_str());
+    REPORT_CALL_ERROR("E19999", "Copy op desc of node %s failed.", node->GetName().c_str());
+    return FAILED;
+  }
+  op_desc->SetName(node->GetName() + "_rematerialized_" + std::to_string(rematerialized_num_));
+  (void)AttrUtils::SetStr(op_desc, kAttrNameRematerializedFrom, node->GetName());
+  NodePtr copy_node = graph->AddNode(op_desc);
+  if (copy_node == nullptr) {
+    GELOGE(FAILED, "[Add][Node] %s to graph %s failed.", op_desc->GetName().c_str(), graph->GetName().c_str());
+    REPORT_CALL_ERROR("E19999", "Add node %s to graph %s failed.", op_desc->GetName().c_str(),
+                      graph->GetName().c_str());
+    return FAILED;
+  }
+  change.copy_node = copy_node;
+
+  std::set<NodePtr> src_nodes;
+  for (const auto &in_anchor : node->GetAllInDataAnchors()) {
+    auto peer_anchor = in_anchor->GetPeerOutAnchor();
+    if (peer_anchor == nullptr) {
+      continue;
+    }
+    GE_CHK_GRAPH_STATUS_RET(GraphUtils::AddEdge(peer_anchor, copy_node->GetInDataAnchor(in_anchor->GetIdx())),
+                            "[Add][Edge] from %s to %s failed.", peer_anchor->GetOwnerNode()->GetName().c_str(),
+                            copy_node->GetName().c_str());
+    (void)src_nodes.insert(peer_anchor->GetOwnerNode());
+  }
+  for (const auto &src_node : node->GetInControlNodes()) {
+    GE_CHK_GRAPH_STATUS_RET(GraphUtils::AddEdge(src_node->GetOutControlAnchor(), copy_node->GetInControlAnchor()),
+                            "[Add][ControlEdge] from %s to %s failed.", src_node->GetName().c_str(),
+                            copy_node->GetName().c_str());
+    (void)src_nodes.insert(src_node);
+  }
+
+  auto out_anchor = node->GetOutDataAnchor(candidate.index);
+  auto copy_out_anchor = copy_node->GetOutDataAnchor(candidate.index);
+  GE_CHECK_NOTNULL(out_anchor);
+  GE_CHECK_NOTNULL(copy_out_anchor);
+  for (const auto &consumer : candidate.late_consumers) {
+    for (const auto &in_anchor : consumer->GetAllInDataAnchors()) {
+      if (in_anchor->GetPeerOutAnchor() != out_anchor) {
+        continue;
+      }
+      GE_CHK_GRAPH_STATUS_RET(GraphUtils::RemoveEdge(out_anchor, in_anchor), "[Remove][Edge] from %s to %s failed.",
+                              node->GetName().c_str(), consumer->GetName().c_str());
+      GE_CHK_GRAPH_STATUS_RET(GraphUtils::AddEdge(copy_out_anchor, in_anchor), "[Add][Edge] from %s to %s failed.",
+                              copy_node->GetName().c_str(), consumer->GetName().c_str());
+      change.moved_in_anchors.emplace_back(in_anchor);
+    }
+  }
+
+  // recompute right before the consumer rather than right after the inputs, the anchor is an input of the consumer,
+  // so the copy is not ordered against unrelated branches
+  if (src_nodes.count(anchor) == 0) {
+    GE_CHK_GRAPH_STATUS_RET(GraphUtils::AddEdge(anchor->GetOutControlAnchor(), copy_node->GetInControlAnchor()),
+                            "[Add][ControlEdge] from %s to %s failed.", anchor->GetName().c_str(),
+                            copy_node->GetName().c_str());
+  }
+  GELOGD("Output %d of node %s, size %ld, is recomputed by %s before %s, cost %.0f.", candidate.index,
+         node->GetName().c_str(), candidate.size, copy_node->GetName().c_str(),
+         candidate.late_consumers.front()->GetName().c_str(), candidate.cost);
+  rematerialized_num_++;
+  return SUCCESS;
+}
+
+Status RematerializationPass::Rollback(const ComputeGraphPtr &graph, const Candidate &candidate,
+                                       const Change &change) {
+  const auto &node = candidate.node;
+  const auto &anchor = candidate.anchor;
+  rematerialized_num_--;
+  if (change.copy_node == nullptr) {
+    GE_CHK_GRAPH_STATUS_RET(GraphUtils::RemoveEdge(anchor->GetOutControlAnchor(), node->GetInControlAnchor()),
+                            "[Remove][ControlEdge] from %s to %s failed.", anchor->GetName().c_str(),
+                            node->GetName().c_str());
+    return SUCCESS;
+  }
+
+  auto out_anchor = node->GetOutDataAnchor(candidate.index);
+  auto copy_out_anchor = change.copy_node->GetOutDataAnchor(candidate.index);
+  GE_CHECK_NOTNULL(out_anchor);
+  GE_CHECK_NOTNULL(copy_out_anchor);
+  for (const auto &in_anchor : change.moved_in_anchors) {
+    GE_CHK_GRAPH_STATUS_RET(GraphUtils::RemoveEdge(copy_out_anchor, in_anchor), "[Remove][Edge] from %s failed.",
+                            change.copy_node->GetName().c_str());
+    GE_CHK_GRAPH_STATUS_RET(GraphUtils::AddEdge(out_anchor, in_anchor), "[Add][Edge] from %s failed.",
+                            node->GetName().c_str());
+  }
+  NodeUtils::UnlinkAll(*change.copy_node);
+  if (GraphUtils::RemoveNodeWithoutRelink(graph, change.copy_node) != GRAPH_SUCCESS) {
+    GELOGE(FAILED, "[Remove][Node] %s from graph %s failed.", change.copy_node->GetName().c_str(),
+           graph->GetName().c_str());
+    REPORT_CALL_ERROR("E19999", "Remove node %s from graph %s failed.", change.copy_node->GetName().c_str(),
+                      graph->GetName().c_str());
+    return FAILED;
+  }
+  return SUCCESS;
+}
+}  // namespace ge
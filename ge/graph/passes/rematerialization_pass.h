@@ -0,0 +1,115 @@
+/**
+* Copyright 2021, 2022 LuoJiaNET Research and Development Group, Wuhan University
+* Copyright 2021, 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef GE_GRAPH_PASSES_REMATERIALIZATION_PASS_H_
+#define GE_GRAPH_PASSES_REMATERIALIZATION_PASS_H_
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include "inc/graph_pass.h"
+
+namespace ge {
+// attrs of the graph, estimated feature map peaks before and after rematerialization
+const char *const kAttrNameRematerializationPeakBefore = "_rematerialization_peak_before";
+const char *const kAttrNameRematerializationPeakAfter = "_rematerialization_peak_after";
+// attr of the copies, name of the node recomputed
+const char *const kAttrNameRematerializedFrom = "_rematerialized_from";
+
+///
+/// Cut the feature map peak of a graph by recomputing cheap outputs instead of keeping them.
+/// Life times of the outputs are estimated like BlockMemAssigner does, from the producer to the last consumer in
+/// topological order. An output alive at the peak only for consumers after the peak is a candidate, if its producer
+/// is cheap by the cost model and the inputs of the producer are kept till these consumers anyway. The producer of
+/// the candidate with the most bytes saved per cost is copied right after the last other input of the first of these
+/// consumers, or moved there if nothing else uses it, until the peak is within the budget, no candidate is left or a
+/// change does not lower the peak, which is rolled back.
+///
+class RematerializationPass : public GraphPass {
+ public:
+  RematerializationPass();
+  ~RematerializationPass() override = default;
+
+  Status Run(ComputeGraphPtr graph) override;
+
+  ///
+  /// @brief set by option MEMORY_REMATERIALIZATION
+  ///
+  void SetEnabled(bool enabled) { enabled_ = enabled; }
+
+  ///
+  /// @brief set in bytes by option MEMORY_REMATERIALIZATION_BUDGET, 0 to rematerialize as long as the peak is reduced
+  ///
+  void SetBudget(int64_t budget) { budget_ = budget; }
+
+  int64_t GetPeakBefore() const { return peak_before_; }
+  int64_t GetPeakAfter() const { return peak_after_; }
+  size_t GetRematerializedNum() const { return rematerialized_num_; }
+
+ private:
+  struct OutputLife {
+    NodePtr node;
+    int32_t index = 0;
+    int64_t size = 0;
+    size_t begin = 0;
+    size_t end = 0;
+    std::vector<size_t> consumer_orders;
+  };
+
+  // copied out of the output life, the lives are rebuilt after every change
+  struct Candidate {
+    NodePtr node;
+    int32_t index = 0;
+    int64_t size = 0;
+    std::vector<NodePtr> late_consumers;
+    size_t first_late_order = 0;
+    // the last other input of the first late consumer, the copy runs after it
+    NodePtr anchor;
+    double cost = 0.0;
+    // used by the late consumers only, the node is moved instead of copied
+    bool delay_only = false;
+  };
+
+  // what Rematerialize changed, to roll it back
+  struct Change {
+    NodePtr copy_node;
+    std::vector<InDataAnchorPtr> moved_in_anchors;
+  };
+
+  Status EstimateLives(const ComputeGraphPtr &graph);
+  int64_t GetPeak(size_t &peak_order) const;
+  bool FindCandidate(size_t peak_order, Candidate &candidate) const;
+  bool InputsKeptTill(const NodePtr &node, size_t order) const;
+  bool OnlyUsedFrom(const NodePtr &node, size_t order) const;
+  NodePtr GetAnchor(const NodePtr &consumer, const NodePtr &node, size_t peak_order) const;
+  Status Rematerialize(const ComputeGraphPtr &graph, const Candidate &candidate, Change &change);
+  Status Rollback(const ComputeGraphPtr &graph, const Candidate &candidate, const Change &change);
+
+  bool enabled_ = false;
+  int64_t budget_ = 0;
+  int64_t peak_before_ = 0;
+  int64_t peak_after_ = 0;
+  size_t rematerialized_num_ = 0;
+  std::vector<NodePtr> nodes_;
+  std::map<const Node *, size_t> node_orders_;
+  // lives of the outputs of each node, by output index
+  std::map<const Node *, std::vector<OutputLife>> node_lives_;
+};
+}  // namespace ge
+
+#endif  // GE_GRAPH_PASSES_REMATERIALIZATION_PASS_H_
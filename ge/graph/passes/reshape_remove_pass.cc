@@ -40,6 +40,10 @@ std::map<std::string, OpHashValue> kToBeDeleteOp = {
 };
 }
 
+ReshapeRemovePass::ReshapeRemovePass() {
+  SetInterestedTypes({RESHAPE, REFORMAT});
+}
+
 Status ReshapeRemovePass::Run(NodePtr &node) {
   GE_CHECK_NOTNULL(node);
   GE_CHECK_NOTNULL(node->GetOpDesc());
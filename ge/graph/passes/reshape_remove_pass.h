@@ -23,6 +23,7 @@
 namespace ge {
 class ReshapeRemovePass : public BaseNodePass {
  public:
+  ReshapeRemovePass();
   Status Run(NodePtr &node) override;
 };
 }  // namespace ge
@@ -76,6 +76,10 @@ Status GetPredNode(const NodePtr &switch_node, PredNodeAndOut &pred_node_index)
 }
 }  // namespace
 
+SwitchLogicRemovePass::SwitchLogicRemovePass() {
+  SetInterestedTypes({SWITCH, REFSWITCH});
+}
+
 Status SwitchLogicRemovePass::Run(NodePtr &node) {
   GE_CHECK_NOTNULL(node);
   if (!IsSwitch(node->GetType())) {
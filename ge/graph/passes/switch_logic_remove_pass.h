@@ -21,6 +21,7 @@
 namespace ge {
 class SwitchLogicRemovePass : public BaseNodePass {
  public:
+  SwitchLogicRemovePass();
   Status Run(NodePtr &node) override;
  private:
   Status RemoveSwitchNodeLogically(int parent_index, NodePtr &switch_node);
@@ -33,6 +33,10 @@ const char *const kAttrNameSrcFormat = "src_format";
 }  // namespace
 
 namespace ge {
+TransposeTransDataPass::TransposeTransDataPass() {
+  SetInterestedTypes({TRANSPOSED});
+}
+
 Status TransposeTransDataPass::Run(NodePtr &node) {
   if (node == nullptr) {
     REPORT_INNER_ERROR("E19999", "Param node is nullptr, check invalid");
@@ -23,6 +23,7 @@
 namespace ge {
 class TransposeTransDataPass : public BaseNodePass {
  public:
+  TransposeTransDataPass();
   Status Run(NodePtr &node) override;
  private:
   Status CheckOneInAndOneOutDataAnchor(NodePtr &node) const;
@@ -1844,6 +1844,9 @@ Status GraphPrepare::GenerateInfershapeGraph(ConstGraphPtr graph) {
     GELOGE(ret, "[Run][GePasses] infershape for preprocess failed, ret:%u.", ret);
     return ret;
   }
+  GELOGI("Infershape for dump json process: %lu infer calls, %lu skipped as unchanged, %lu reused.",
+         infer_shape_pass.GetInferCount(), infer_shape_pass.GetSkippedInferCount(),
+         infer_shape_pass.GetMemoizedInferCount());
   ShapeRefiner::ClearContextMap();
   return SUCCESS;
 }
@@ -2067,6 +2070,9 @@ Status GraphPrepare::InferShapeForPreprocess() {
     GELOGE(ret, "[Run][GePasses] infershape for preprocess failed, ret:%u.", ret);
     return ret;
   }
+  GELOGI("Infershape for preprocess: %lu infer calls, %lu skipped as unchanged, %lu reused.",
+         infer_shape_pass.GetInferCount(), infer_shape_pass.GetSkippedInferCount(),
+         infer_shape_pass.GetMemoizedInferCount());
   return SUCCESS;
 }
 Status GraphPrepare::PrepareOptimize() {
@@ -36,94 +36,44 @@ const size_t kAddOutputSize = 1;
   case (DTYPE):                                         \
     ret = BCastAdd<TYPE>(op_desc_ptr, input, v_output); \
     break;
-}  // namespace
-
-template <typename T>
-Status AddKernel::OverflowCheck(const T &x, const T &y, DataType data_type) {
-  switch (data_type) {
-    case DT_INT8:
-      FMK_INT8_ADDCHECK(x, y)
-      break;
-    case DT_INT16:
-      FMK_INT16_ADDCHECK(x, y)
-      break;
-    case DT_INT32:
-      FMK_INT32_ADDCHECK(x, y)
-      break;
-    case DT_INT64:
-      FMK_INT64_ADDCHECK(x, y)
-      break;
-    case DT_UINT8:
-      FMK_UINT8_ADDCHECK(x, y)
-      break;
-    case DT_UINT16:
-      FMK_UINT16_ADDCHECK(x, y)
-      break;
-    case DT_UINT32:
-      FMK_UINT32_ADDCHECK(x, y)
-      break;
-    case DT_UINT64:
-      FMK_UINT64_ADDCHECK(x, y)
-      break;
-    case DT_FLOAT16:
-      FMK_FP16_ADDCHECK(x, y)
-      break;
-    case DT_FLOAT:
-      FMK_FLOAT_ADDCHECK(x, y)
-      break;
-    case DT_DOUBLE:
-      FMK_DOUBLE_ADDCHECK(x, y)
-      break;
-    default:
-      break;
-  }
 
-  return SUCCESS;
-}
+#define DEFINE_ADD_CHECK_BY_TYPE(TYPE, CHECK) \
+  bool IsAddValid(TYPE const &x, TYPE const &y) { return CHECK(x, y) == SUCCESS; }
+
+DEFINE_ADD_CHECK_BY_TYPE(int8_t, CheckInt8AddOverflow)
+DEFINE_ADD_CHECK_BY_TYPE(int16_t, CheckInt16AddOverflow)
+DEFINE_ADD_CHECK_BY_TYPE(int32_t, CheckInt32AddOverflow)
+DEFINE_ADD_CHECK_BY_TYPE(int64_t, CheckInt64AddOverflow)
+DEFINE_ADD_CHECK_BY_TYPE(uint8_t, CheckUint8AddOverflow)
+DEFINE_ADD_CHECK_BY_TYPE(uint16_t, CheckUint16AddOverflow)
+DEFINE_ADD_CHECK_BY_TYPE(uint32_t, CheckUint32AddOverflow)
+DEFINE_ADD_CHECK_BY_TYPE(uint64_t, CheckUint64AddOverflow)
+DEFINE_ADD_CHECK_BY_TYPE(fp16_t, CheckFp16AddOverflow)
+DEFINE_ADD_CHECK_BY_TYPE(float, CheckFloatAddOverflow)
+DEFINE_ADD_CHECK_BY_TYPE(double, CheckDoubleAddOverflow)
+}  // namespace
 
 template <typename InT>
 Status AddKernel::BCastAdd(const OpDescPtr &op_desc_ptr, const std::vector<ConstGeTensorPtr> &input,
                            std::vector<GeTensorPtr> &v_output) {
   // only broadcast shape
   BCast bcast;
-  Status ret = bcast.GenerateBcastInfo(BCast::TransShapeToDimVec(input[kAddFirstInput]->GetTensorDesc()),
-                                       BCast::TransShapeToDimVec(input[kAddSecondInput]->GetTensorDesc()));
+  std::vector<InT> y_data;
+  auto add = [](InT const &x, InT const &y) -> InT { return x + y; };
+  auto check = [](InT const &x, InT const &y) -> bool { return IsAddValid(x, y); };
+  Status ret = bcast.BCastComputeCheck<InT>(input, y_data, add, check);
   if (ret != SUCCESS) {
-    GELOGE(ret, "Greater broadcasting failed.");
+    GELOGE(ret, "Add broadcasting failed, result may be overflow.");
     return ret;
   }
 
-  std::vector<int64_t> x_indexes;
-  std::vector<int64_t> y_indexes;
-  bcast.BCastIndexes(x_indexes, y_indexes);
-
-  auto x1_data = reinterpret_cast<const InT *>(input[kAddFirstInput]->GetData().data());
-  auto x2_data = reinterpret_cast<const InT *>(input[kAddSecondInput]->GetData().data());
-
-  size_t data_num = x_indexes.size();
-  std::unique_ptr<InT[]> buf(new (std::nothrow) InT[data_num]());
-  if (buf == nullptr) {
-    GELOGE(MEMALLOC_FAILED, "New sizeof(T) * data_num(%zu) memory failed", static_cast<size_t>(sizeof(InT) * data_num));
-    return MEMALLOC_FAILED;
-  }
-
   DataType data_type = input[kAddFirstInput]->GetTensorDesc().GetDataType();
-  for (size_t i = 0; i < data_num; i++) {
-    auto x_index = *(x1_data + x_indexes[i]);
-    auto y_index = *(x2_data + y_indexes[i]);
-    if (OverflowCheck<InT>(x_index, y_index, data_type) != SUCCESS) {
-      GELOGE(PARAM_INVALID, "Result of add is overflow.");
-      return PARAM_INVALID;
-    }
-    *(buf.get() + i) = x_index + y_index;
-  }
-
   GeTensorPtr output_ptr = MakeShared<GeTensor>(op_desc_ptr->GetOutputDesc(kAddFirstOutput));
   if (output_ptr == nullptr) {
     GELOGE(MEMALLOC_FAILED, "Make shared failed");
     return MEMALLOC_FAILED;
   }
-  output_ptr->SetData(reinterpret_cast<uint8_t *>(buf.get()), data_num * sizeof(InT));
+  output_ptr->SetData(reinterpret_cast<uint8_t *>(y_data.data()), y_data.size() * sizeof(InT));
   output_ptr->MutableTensorDesc().SetDataType(data_type);
   vector<int64_t> bcast_dims = bcast.GetOutputShape();
   output_ptr->MutableTensorDesc().SetShape(GeShape(bcast_dims));
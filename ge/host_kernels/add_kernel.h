@@ -31,9 +31,6 @@ class AddKernel : public Kernel {
  private:
   Status AddCheck(const OpDescPtr &op_desc_ptr, const std::vector<ConstGeTensorPtr> &input);
 
-  template <typename T>
-  Status OverflowCheck(const T &x, const T &y, DataType data_type);
-
   template <typename InT>
   Status BCastAdd(const OpDescPtr &op_desc_ptr, const std::vector<ConstGeTensorPtr> &input,
                   std::vector<GeTensorPtr> &v_output);
@@ -48,35 +48,14 @@ T FloorDiv(T const &x, T const &y) {
   }
 }
 
-template <typename T>
-Status CheckYIsZero(T const &y, DataType &type) {
-  switch (type) {
-    case DT_INT32:
-      if (y == static_cast<T>(0)) {
-        GELOGE(INTERNAL_ERROR, "CheckYIsZero failed, y is zero.");
-        return INTERNAL_ERROR;
-      }
-      break;
-    default:
-      return INTERNAL_ERROR;
-  }
-  return SUCCESS;
-}
-
-// mod(x,y) equals to x - y * floor(x/y)
-#define DEFINE_FUNC_BY_TYPE(TYPE)                                                     \
-  std::function<TYPE(TYPE const &, TYPE const &, DataType &, Status &)> func_##TYPE = \
-    [](TYPE const &a, TYPE const &b, DataType &type, Status &ret) -> TYPE {           \
-    ret = CheckYIsZero(b, type);                                                      \
-    if (ret != SUCCESS) {                                                             \
-      return static_cast<TYPE>(0);                                                    \
-    }                                                                                 \
-    return (a - b * FloorDiv(a, b));                                                  \
-  };
-
-#define SET_BCAST_COMPUTE_CASE(DTYPE, TYPE)                           \
-  case DTYPE:                                                         \
-    ret = bcast.BCastComputeCheck(input, y_data_##TYPE, func_##TYPE); \
+// mod(x,y) equals to x - y * floor(x/y), y must not be zero
+#define DEFINE_FUNC_BY_TYPE(TYPE)                                                                          \
+  const auto func_##TYPE = [](TYPE const &a, TYPE const &b) -> TYPE { return (a - b * FloorDiv(a, b)); }; \
+  const auto check_##TYPE = [](TYPE const &, TYPE const &b) -> bool { return b != static_cast<TYPE>(0); };
+
+#define SET_BCAST_COMPUTE_CASE(DTYPE, TYPE)                                                \
+  case DTYPE:                                                                              \
+    ret = bcast.BCastComputeCheck<TYPE>(input, y_data_##TYPE, func_##TYPE, check_##TYPE); \
     break;
 
 #define SET_OUTPUT(DTYPE, TYPE)                                                                                  \
@@ -37,14 +37,14 @@ namespace ge {
 namespace {
 const size_t kGreaterInputNum = 2;
 
-#define DEFINE_FUNC_BY_TYPE(TYPE)                                                                                \
-  std::function<uint8_t(TYPE const &, TYPE const &)> func_##TYPE = [](TYPE const &a, TYPE const &b) -> uint8_t { \
-    return a > b;                                                                                                \
+#define DEFINE_FUNC_BY_TYPE(TYPE)                                        \
+  const auto func_##TYPE = [](TYPE const &a, TYPE const &b) -> uint8_t { \
+    return a > b;                                                        \
   };
 
-#define SET_BCAST_COMPUTE_CASE(DTYPE, TYPE)               \
-  case DTYPE:                                             \
-    ret = bcast.BCastCompute(input, y_data, func_##TYPE); \
+#define SET_BCAST_COMPUTE_CASE(DTYPE, TYPE)                     \
+  case DTYPE:                                                   \
+    ret = bcast.BCastCompute<TYPE>(input, y_data, func_##TYPE); \
     break;
 
 DEFINE_FUNC_BY_TYPE(int8_t)
@@ -34,63 +34,15 @@ namespace ge {
 namespace {
 const std::set<DataType> kMulSupportedType = {DT_INT8,   DT_INT16,  DT_INT32,   DT_INT64, DT_UINT8, DT_UINT16,
                                               DT_UINT32, DT_UINT64, DT_FLOAT16, DT_FLOAT, DT_DOUBLE};
-template <typename T>
-Status OverflowCheck(T const &x, T const &y, DataType &type) {
-  switch (type) {
-    case DT_INT8:
-      FMK_INT8_MULCHECK(x, y)
-      break;
-    case DT_INT16:
-      FMK_INT16_MULCHECK(x, y)
-      break;
-    case DT_INT32:
-      FMK_INT32_MULCHECK(x, y)
-      break;
-    case DT_INT64:
-      FMK_INT64_MULCHECK(x, y)
-      break;
-    case DT_UINT8:
-      FMK_UINT8_MULCHECK(x, y)
-      break;
-    case DT_UINT16:
-      FMK_UINT16_MULCHECK(x, y)
-      break;
-    case DT_UINT32:
-      FMK_UINT32_MULCHECK(x, y)
-      break;
-    case DT_UINT64:
-      FMK_UINT64_MULCHECK(x, y)
-      break;
-    case DT_FLOAT16:
-      FMK_FP16_MULCHECK(x, y)
-      break;
-    case DT_FLOAT:
-      FMK_FLOAT_MULCHECK(x, y)
-      break;
-    case DT_DOUBLE:
-      FMK_DOUBLE_MULCHECK(x, y)
-      break;
-    default:
-      break;
-  }
-
-  return SUCCESS;
-}
-
-#define DEFINE_FUNC_WITH_STATUS_BY_TYPE(TYPE)                                         \
-  std::function<TYPE(TYPE const &, TYPE const &, DataType &, Status &)> func_##TYPE = \
-    [](TYPE const &a, TYPE const &b, DataType &type, Status &ret) -> TYPE {           \
-    ret = OverflowCheck(a, b, type);                                                  \
-    if (ret != SUCCESS) {                                                             \
-      GELOGE(PARAM_INVALID, "Result of mul is overflow.");                            \
-      return static_cast<TYPE>(0);                                                    \
-    }                                                                                 \
-    return static_cast<TYPE>(a) * static_cast<TYPE>(b);                               \
-  };
-
-#define SET_BCAST_COMPUTE_CASE(DTYPE, TYPE)                              \
-  case DTYPE:                                                            \
-    ret = bcast.BCastComputeCheck(input, y_data_##TYPE##_, func_##TYPE); \
+#define DEFINE_FUNC_WITH_CHECK_BY_TYPE(TYPE, CHECK)                   \
+  const auto func_##TYPE = [](TYPE const &a, TYPE const &b) -> TYPE { \
+    return static_cast<TYPE>(a) * static_cast<TYPE>(b);               \
+  };                                                                  \
+  const auto check_##TYPE = [](TYPE const &a, TYPE const &b) -> bool { return CHECK(a, b) == SUCCESS; };
+
+#define SET_BCAST_COMPUTE_CASE(DTYPE, TYPE)                                                  \
+  case DTYPE:                                                                                \
+    ret = bcast.BCastComputeCheck<TYPE>(input, y_data_##TYPE##_, func_##TYPE, check_##TYPE); \
     break;
 
 #define SET_OUTPUT(DTYPE, TYPE)                                                                                        \
@@ -98,17 +50,17 @@ Status OverflowCheck(T const &x, T const &y, DataType &type) {
     (void)output_ptr->SetData(reinterpret_cast<uint8_t *>(y_data_##TYPE##_.data()), y_data_##TYPE##_.size() * length); \
     break;
 // [no need to check result]
-DEFINE_FUNC_WITH_STATUS_BY_TYPE(int8_t)
-DEFINE_FUNC_WITH_STATUS_BY_TYPE(int16_t)
-DEFINE_FUNC_WITH_STATUS_BY_TYPE(int32_t)
-DEFINE_FUNC_WITH_STATUS_BY_TYPE(int64_t)
-DEFINE_FUNC_WITH_STATUS_BY_TYPE(uint8_t)
-DEFINE_FUNC_WITH_STATUS_BY_TYPE(uint16_t)
-DEFINE_FUNC_WITH_STATUS_BY_TYPE(uint32_t)
-DEFINE_FUNC_WITH_STATUS_BY_TYPE(uint64_t)
-DEFINE_FUNC_WITH_STATUS_BY_TYPE(fp16_t)
-DEFINE_FUNC_WITH_STATUS_BY_TYPE(float)
-DEFINE_FUNC_WITH_STATUS_BY_TYPE(double)
+DEFINE_FUNC_WITH_CHECK_BY_TYPE(int8_t, CheckInt8MulOverflow)
+DEFINE_FUNC_WITH_CHECK_BY_TYPE(int16_t, CheckInt16MulOverflow)
+DEFINE_FUNC_WITH_CHECK_BY_TYPE(int32_t, CheckInt32MulOverflow)
+DEFINE_FUNC_WITH_CHECK_BY_TYPE(int64_t, Int64MulCheckOverflow)
+DEFINE_FUNC_WITH_CHECK_BY_TYPE(uint8_t, CheckUint8MulOverflow)
+DEFINE_FUNC_WITH_CHECK_BY_TYPE(uint16_t, CheckUint16MulOverflow)
+DEFINE_FUNC_WITH_CHECK_BY_TYPE(uint32_t, CheckUint32MulOverflow)
+DEFINE_FUNC_WITH_CHECK_BY_TYPE(uint64_t, CheckUint64MulOverflow)
+DEFINE_FUNC_WITH_CHECK_BY_TYPE(fp16_t, CheckFp16MulOverflow)
+DEFINE_FUNC_WITH_CHECK_BY_TYPE(float, CheckFloatMulOverflow)
+DEFINE_FUNC_WITH_CHECK_BY_TYPE(double, CheckDoubleMulOverflow)
 }  // namespace
 
 Status MulKernel::Compute(const OpDescPtr op_desc_ptr, const std::vector<ConstGeTensorPtr> &input,
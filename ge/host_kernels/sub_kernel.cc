@@ -36,63 +36,15 @@ const size_t kSubFirstOutput = 0;
 const size_t kSubOutputSize = 1;
 const size_t kSubInputSize = 2;
 
-template <typename T>
-Status OverflowCheck(T const &x, T const &y, DataType &data_type) {
-  switch (data_type) {
-    case DT_INT8:
-      FMK_INT8_SUBCHECK(x, y)
-      break;
-    case DT_INT16:
-      FMK_INT16_SUBCHECK(x, y)
-      break;
-    case DT_INT32:
-      FMK_INT32_SUBCHECK(x, y)
-      break;
-    case DT_INT64:
-      FMK_INT64_SUBCHECK(x, y)
-      break;
-    case DT_UINT8:
-      FMK_UINT8_SUBCHECK(x, y)
-      break;
-    case DT_UINT16:
-      FMK_UINT16_SUBCHECK(x, y)
-      break;
-    case DT_UINT32:
-      FMK_UINT32_SUBCHECK(x, y)
-      break;
-    case DT_UINT64:
-      FMK_UINT64_SUBCHECK(x, y)
-      break;
-    case DT_FLOAT16:
-      FMK_FP16_SUBCHECK(x, y)
-      break;
-    case DT_FLOAT:
-      FMK_FLOAT_SUBCHECK(x, y)
-      break;
-    case DT_DOUBLE:
-      FMK_DOUBLE_SUBCHECK(x, y)
-      break;
-    default:
-      break;
-  }
-
-  return SUCCESS;
-}
-
-#define DEFINE_FUNC_WITH_STATUS_BY_TYPE(TYPE)                                         \
-  std::function<TYPE(TYPE const &, TYPE const &, DataType &, Status &)> func_##TYPE = \
-    [](TYPE const &x, TYPE const &y, DataType &type, Status &ret) -> TYPE {           \
-    ret = OverflowCheck<TYPE>(x, y, type);                                            \
-    if (ret != SUCCESS) {                                                             \
-      GELOGE(PARAM_INVALID, "Result of sub is overflow.");                            \
-      return static_cast<TYPE>(0);                                                    \
-    }                                                                                 \
-    return static_cast<TYPE>(x) - static_cast<TYPE>(y);                               \
-  };
-
-#define SET_BCAST_COMPUTE_CASE(DTYPE, TYPE)                              \
-  case DTYPE:                                                            \
-    ret = bcast.BCastComputeCheck(input, y_data_##TYPE##_, func_##TYPE); \
+#define DEFINE_FUNC_WITH_CHECK_BY_TYPE(TYPE, CHECK)                   \
+  const auto func_##TYPE = [](TYPE const &x, TYPE const &y) -> TYPE { \
+    return static_cast<TYPE>(x) - static_cast<TYPE>(y);               \
+  };                                                                  \
+  const auto check_##TYPE = [](TYPE const &x, TYPE const &y) -> bool { return CHECK(x, y) == SUCCESS; };
+
+#define SET_BCAST_COMPUTE_CASE(DTYPE, TYPE)                                                  \
+  case DTYPE:                                                                                \
+    ret = bcast.BCastComputeCheck<TYPE>(input, y_data_##TYPE##_, func_##TYPE, check_##TYPE); \
     break;
 
 #define SET_OUTPUT(DTYPE, TYPE)                                                                                        \
@@ -100,17 +52,17 @@ Status OverflowCheck(T const &x, T const &y, DataType &data_type) {
     (void)output_ptr->SetData(reinterpret_cast<uint8_t *>(y_data_##TYPE##_.data()), y_data_##TYPE##_.size() * length); \
     break;
 
-DEFINE_FUNC_WITH_STATUS_BY_TYPE(int8_t)
-DEFINE_FUNC_WITH_STATUS_BY_TYPE(int16_t)
-DEFINE_FUNC_WITH_STATUS_BY_TYPE(int32_t)
-DEFINE_FUNC_WITH_STATUS_BY_TYPE(int64_t)
-DEFINE_FUNC_WITH_STATUS_BY_TYPE(uint8_t)
-DEFINE_FUNC_WITH_STATUS_BY_TYPE(uint16_t)
-DEFINE_FUNC_WITH_STATUS_BY_TYPE(uint32_t)
-DEFINE_FUNC_WITH_STATUS_BY_TYPE(uint64_t)
-DEFINE_FUNC_WITH_STATUS_BY_TYPE(fp16_t)
-DEFINE_FUNC_WITH_STATUS_BY_TYPE(float)
-DEFINE_FUNC_WITH_STATUS_BY_TYPE(double)
+DEFINE_FUNC_WITH_CHECK_BY_TYPE(int8_t, CheckInt8SubOverflow)
+DEFINE_FUNC_WITH_CHECK_BY_TYPE(int16_t, CheckInt16SubOverflow)
+DEFINE_FUNC_WITH_CHECK_BY_TYPE(int32_t, CheckInt32SubOverflow)
+DEFINE_FUNC_WITH_CHECK_BY_TYPE(int64_t, CheckInt64SubOverflow)
+DEFINE_FUNC_WITH_CHECK_BY_TYPE(uint8_t, CheckUint8SubOverflow)
+DEFINE_FUNC_WITH_CHECK_BY_TYPE(uint16_t, CheckUint16SubOverflow)
+DEFINE_FUNC_WITH_CHECK_BY_TYPE(uint32_t, CheckUint32SubOverflow)
+DEFINE_FUNC_WITH_CHECK_BY_TYPE(uint64_t, CheckUint64SubOverflow)
+DEFINE_FUNC_WITH_CHECK_BY_TYPE(fp16_t, CheckFp16SubOverflow)
+DEFINE_FUNC_WITH_CHECK_BY_TYPE(float, CheckFloatSubOverflow)
+DEFINE_FUNC_WITH_CHECK_BY_TYPE(double, CheckDoubleSubOverflow)
 }  // namespace
 
 Status SubKernel::Compute(const ge::OpDescPtr op_desc_ptr, const std::vector<ge::ConstGeTensorPtr> &input,
@@ -0,0 +1,213 @@
+/**
+* Copyright 2021, 2022 LuoJiaNET Research and Development Group, Wuhan University
+* Copyright 2021, 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "hybrid/common/node_latency_stats.h"
+#include <algorithm>
+#include <cmath>
+#include <new>
+#include "framework/common/debug/ge_log.h"
+
+namespace ge {
+namespace hybrid {
+namespace {
+const double kNanosPerMicro = 1000.0;
+const double kMaxPercentile = 100.0;
+const double kPercentiles[] = {50.0, 90.0, 99.0};
+const char *const kPercentileNames[] = {"p50_us", "p90_us", "p99_us"};
+
+size_t HighestBit(uint64_t value) {
+  size_t bit = 0U;
+  while ((value >>= 1U) != 0U) {
+    ++bit;
+  }
+  return bit;
+}
+
+double ToMicros(uint64_t nanos) {
+  return static_cast<double>(nanos) / kNanosPerMicro;
+}
+}  // namespace
+
+constexpr std::array<int64_t, 5U> NodeLatencyStats::kStages;
+
+LatencyHistogram::LatencyHistogram() : count_(0U), sum_(0U), max_(0U) {
+  for (auto &bucket : buckets_) {
+    bucket.store(0U, std::memory_order_relaxed);
+  }
+}
+
+size_t LatencyHistogram::GetBucketIndex(uint64_t nanos) {
+  if (nanos < kSubBucketNum) {
+    return static_cast<size_t>(nanos);
+  }
+  size_t bit = HighestBit(nanos);
+  if (bit >= kMaxValueBits) {
+    return kBucketNum - 1U;
+  }
+  // the bits right below the highest one select the sub bucket
+  size_t shift = bit - kSubBucketBits;
+  return (bit - kSubBucketBits + 1U) * kSubBucketNum + static_cast<size_t>((nanos >> shift) & (kSubBucketNum - 1U));
+}
+
+uint64_t LatencyHistogram::GetBucketUpperBound(size_t index) {
+  if (index < kSubBucketNum) {
+    return static_cast<uint64_t>(index);
+  }
+  size_t shift = index / kSubBucketNum - 1U;
+  uint64_t lower = static_cast<uint64_t>(kSubBucketNum + index % kSubBucketNum) << shift;
+  return lower + (static_cast<uint64_t>(1U) << shift) - 1U;
+}
+
+void LatencyHistogram::Record(uint64_t nanos) {
+  buckets_[GetBucketIndex(nanos)].fetch_add(1U, std::memory_order_relaxed);
+  count_.fetch_add(1U, std::memory_order_relaxed);
+  sum_.fetch_add(nanos, std::memory_order_relaxed);
+  uint64_t max_value = max_.load(std::memory_order_relaxed);
+  while ((nanos > max_value) && !max_.compare_exchange_weak(max_value, nanos, std::memory_order_relaxed)) {
+  }
+}
+
+uint64_t LatencyHistogram::GetPercentile(double percentile) const {
+  // buckets may be recorded meanwhile, count them instead of using count_
+  std::array<uint64_t, kBucketNum> counts;
+  uint64_t total = 0U;
+  for (size_t i = 0U; i < kBucketNum; ++i) {
+    counts[i] = buckets_[i].load(std::memory_order_relaxed);
+    total += counts[i];
+  }
+  if (total == 0U) {
+    return 0U;
+  }
+  percentile = std::min(std::max(percentile, 0.0), kMaxPercentile);
+  uint64_t rank = static_cast<uint64_t>(std::ceil(percentile / kMaxPercentile * static_cast<double>(total)));
+  rank = std::max(rank, static_cast<uint64_t>(1U));
+  uint64_t seen = 0U;
+  for (size_t i = 0U; i < kBucketNum; ++i) {
+    seen += counts[i];
+    if (seen >= rank) {
+      return std::min(GetBucketUpperBound(i), GetMax());
+    }
+  }
+  return GetMax();
+}
+
+void LatencyHistogram::Reset() {
+  for (auto &bucket : buckets_) {
+    bucket.store(0U, std::memory_order_relaxed);
+  }
+  count_.store(0U, std::memory_order_relaxed);
+  sum_.store(0U, std::memory_order_relaxed);
+  max_.store(0U, std::memory_order_relaxed);
+}
+
+NodeLatencyStats::NodeLatencyStats() {
+  for (auto &histogram : histograms_) {
+    histogram.store(nullptr, std::memory_order_relaxed);
+  }
+}
+
+NodeLatencyStats::~NodeLatencyStats() {
+  for (auto &histogram : histograms_) {
+    delete histogram.load(std::memory_order_relaxed);
+  }
+}
+
+int NodeLatencyStats::GetStageIndex(int64_t stage) {
+  for (size_t i = 0U; i < kStages.size(); ++i) {
+    if (kStages[i] == stage) {
+      return static_cast<int>(i);
+    }
+  }
+  return -1;
+}
+
+const char *NodeLatencyStats::GetStageName(int64_t stage) {
+  switch (stage) {
+    case profiling::kInferShape:
+      return "infer_shape";
+    case profiling::kTiling:
+      return "tiling";
+    case profiling::kPrepareTask:
+      return "prepare";
+    case profiling::kLaunchTask:
+      return "launch";
+    case profiling::kOnNodeDoneCallback:
+      return "callback";
+    default:
+      return "unknown";
+  }
+}
+
+void NodeLatencyStats::Record(int64_t stage, uint64_t nanos) {
+  int index = GetStageIndex(stage);
+  if (index < 0) {
+    GELOGW("Stage %ld is not a node latency stage.", stage);
+    return;
+  }
+  auto &slot = histograms_[static_cast<size_t>(index)];
+  LatencyHistogram *histogram = slot.load(std::memory_order_acquire);
+  if (histogram == nullptr) {
+    LatencyHistogram *created = new (std::nothrow) LatencyHistogram();
+    if (created == nullptr) {
+      return;
+    }
+    // another thread may create it first, use that one
+    if (slot.compare_exchange_strong(histogram, created, std::memory_order_acq_rel)) {
+      histogram = created;
+    } else {
+      delete created;
+    }
+  }
+  histogram->Record(nanos);
+}
+
+const LatencyHistogram *NodeLatencyStats::GetHistogram(int64_t stage) const {
+  int index = GetStageIndex(stage);
+  if (index < 0) {
+    return nullptr;
+  }
+  return histograms_[static_cast<size_t>(index)].load(std::memory_order_acquire);
+}
+
+void NodeLatencyStats::Reset() {
+  for (auto &histogram : histograms_) {
+    LatencyHistogram *current = histogram.load(std::memory_order_acquire);
+    if (current != nullptr) {
+      current->Reset();
+    }
+  }
+}
+
+void NodeLatencyStats::ToJson(nlohmann::json &stats_json) const {
+  for (size_t i = 0U; i < kStages.size(); ++i) {
+    const LatencyHistogram *histogram = histograms_[i].load(std::memory_order_acquire);
+    if ((histogram == nullptr) || (histogram->GetCount() == 0U)) {
+      continue;
+    }
+    nlohmann::json stage_json;
+    uint64_t count = histogram->GetCount();
+    stage_json["count"] = count;
+    stage_json["avg_us"] = ToMicros(histogram->GetSum()) / static_cast<double>(count);
+    for (size_t j = 0U; j < sizeof(kPercentiles) / sizeof(kPercentiles[0]); ++j) {
+      stage_json[kPercentileNames[j]] = ToMicros(histogram->GetPercentile(kPercentiles[j]));
+    }
+    stage_json["max_us"] = ToMicros(histogram->GetMax());
+    stats_json[GetStageName(kStages[i])] = stage_json;
+  }
+}
+}  // namespace hybrid
+}  // namespace ge
@@ -0,0 +1,134 @@
+/**
+* Copyright 2021, 2022 LuoJiaNET Research and Development Group, Wuhan University
+* Copyright 2021, 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef GE_HYBRID_COMMON_NODE_LATENCY_STATS_H_
+#define GE_HYBRID_COMMON_NODE_LATENCY_STATS_H_
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <nlohmann/json.hpp>
+#include "framework/common/profiling_definitions.h"
+
+namespace ge {
+namespace hybrid {
+///
+/// Latency histogram with log linear buckets: every power of two is split into 8 buckets, so a
+/// value is kept with an error below 12.5%. Recording is a few relaxed atomic adds.
+///
+class LatencyHistogram {
+ public:
+  static constexpr size_t kSubBucketBits = 3U;
+  static constexpr size_t kSubBucketNum = 1U << kSubBucketBits;
+  static constexpr size_t kMaxValueBits = 36U;  // about 68 seconds in nanoseconds, bigger ones are clamped
+  static constexpr size_t kBucketNum = (kMaxValueBits - kSubBucketBits + 1U) * kSubBucketNum;
+
+  LatencyHistogram();
+  LatencyHistogram(const LatencyHistogram &) = delete;
+  LatencyHistogram &operator=(const LatencyHistogram &) = delete;
+  ~LatencyHistogram() = default;
+
+  void Record(uint64_t nanos);
+
+  ///
+  /// @brief value at percentile, the upper bound of the bucket it falls in, at most the max value
+  /// @param [in] percentile: in [0, 100]
+  ///
+  uint64_t GetPercentile(double percentile) const;
+
+  uint64_t GetCount() const { return count_.load(std::memory_order_relaxed); }
+  uint64_t GetSum() const { return sum_.load(std::memory_order_relaxed); }
+  uint64_t GetMax() const { return max_.load(std::memory_order_relaxed); }
+
+  void Reset();
+
+  static size_t GetBucketIndex(uint64_t nanos);
+  static uint64_t GetBucketUpperBound(size_t index);
+
+ private:
+  std::array<std::atomic<uint64_t>, kBucketNum> buckets_;
+  std::atomic<uint64_t> count_;
+  std::atomic<uint64_t> sum_;
+  std::atomic<uint64_t> max_;
+};
+
+///
+/// Latencies of the execution stages of a node. A histogram is created the first time its stage is
+/// recorded, nodes never going through a stage, e.g. infer shape of static nodes, do not pay for it.
+///
+class NodeLatencyStats {
+ public:
+  // stages are named by the enums of profiling_definitions.h
+  static constexpr std::array<int64_t, 5U> kStages = {{profiling::kInferShape, profiling::kTiling,
+                                                       profiling::kPrepareTask, profiling::kLaunchTask,
+                                                       profiling::kOnNodeDoneCallback}};
+
+  NodeLatencyStats();
+  NodeLatencyStats(const NodeLatencyStats &) = delete;
+  NodeLatencyStats &operator=(const NodeLatencyStats &) = delete;
+  ~NodeLatencyStats();
+
+  void Record(int64_t stage, uint64_t nanos);
+
+  ///
+  /// @return nullptr if stage is not recorded
+  ///
+  const LatencyHistogram *GetHistogram(int64_t stage) const;
+
+  void Reset();
+
+  ///
+  /// @brief count, avg, p50, p90, p99 and max in microseconds of every recorded stage
+  ///
+  void ToJson(nlohmann::json &stats_json) const;
+
+  static const char *GetStageName(int64_t stage);
+
+ private:
+  static int GetStageIndex(int64_t stage);
+
+  std::array<std::atomic<LatencyHistogram *>, kStages.size()> histograms_;
+};
+
+///
+/// Records the time from construction to destruction to a stage, does nothing if stats is nullptr.
+///
+class ScopeLatency {
+ public:
+  ScopeLatency(NodeLatencyStats *stats, int64_t stage) : stats_(stats), stage_(stage) {
+    if (stats_ != nullptr) {
+      start_ = std::chrono::steady_clock::now();
+    }
+  }
+  ScopeLatency(const ScopeLatency &) = delete;
+  ScopeLatency &operator=(const ScopeLatency &) = delete;
+  ~ScopeLatency() {
+    if (stats_ != nullptr) {
+      auto cost = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start_);
+      stats_->Record(stage_, static_cast<uint64_t>(cost.count()));
+    }
+  }
+
+ private:
+  NodeLatencyStats *stats_;
+  int64_t stage_;
+  std::chrono::steady_clock::time_point start_;
+};
+}  // namespace hybrid
+}  // namespace ge
+#endif  // GE_HYBRID_COMMON_NODE_LATENCY_STATS_H_
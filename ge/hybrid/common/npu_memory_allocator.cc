@@ -16,6 +16,7 @@
  */
 
 #include "hybrid/common/npu_memory_allocator.h"
+#include <algorithm>
 #include <mutex>
 #include "framework/common/debug/log.h"
 #include "graph/manager/graph_mem_manager.h"
@@ -23,6 +24,7 @@
 namespace ge {
 namespace hybrid {
 const size_t kPaddingUnit = 2;
+const size_t kMaxStreamBlockReuseRatio = 2;  // a freed block is reused for sizes down to half of it
 
 size_t kMaxHbmMemorySize = 1024UL * 1024UL * 1024UL * 1024UL; // 1024G
 
@@ -49,6 +51,24 @@ NpuMemoryAllocator *NpuMemoryAllocator::GetAllocator() {
 
 NpuMemoryAllocator::NpuMemoryAllocator(uint32_t device_id) : device_id_(device_id) {}
 
+NpuMemoryAllocator::~NpuMemoryAllocator() {
+  std::lock_guard<std::mutex> lk(stream_mu_);
+  // tasks launched before the blocks were freed may still use them
+  for (auto &stream_and_blocks : stream_blocks_) {
+    for (auto &block : stream_and_blocks.second) {
+      for (auto event : block.events) {
+        GE_CHK_RT(rtEventSynchronize(event));
+      }
+      FreeStreamBlock(block);
+    }
+  }
+  stream_blocks_.clear();
+  stream_block_num_ = 0;
+  for (auto event : free_events_) {
+    GE_CHK_RT(rtEventDestroy(event));
+  }
+}
+
 void *NpuMemoryAllocator::Allocate(std::size_t size, AllocationAttr *attr) {
   size_t allocate_size = size;
   MemStorageType mem_type = HBM;
@@ -87,9 +107,13 @@ void *NpuMemoryAllocator::Allocate(std::size_t size, AllocationAttr *attr) {
     // padding up to multiple of padding, and add extra padding
     allocate_size = (size + kPaddingUnit * padding - 1) / padding * padding;
     GELOGD("Padding size %ld by %d. final size = %zu.", size, padding, allocate_size);
-    buffer = MemManager::Instance()
-                 .CachingInstance(RT_MEMORY_HBM)
-                 .Malloc(allocate_size, reinterpret_cast<uint8_t *>(try_reuse_addr), device_id_);
+    if ((attr != nullptr) && (attr->stream_ != nullptr)) {
+      buffer = AllocateOnStream(allocate_size, *attr);
+    } else {
+      buffer = MemManager::Instance()
+                   .CachingInstance(RT_MEMORY_HBM)
+                   .Malloc(allocate_size, reinterpret_cast<uint8_t *>(try_reuse_addr), device_id_);
+    }
   }
   if (buffer == nullptr) {
     GELOGE(MEMALLOC_FAILED, "[Malloc][Memory] Failed, device_id = %u, size = %zu",
@@ -111,12 +135,197 @@ void NpuMemoryAllocator::Deallocate(void *data, MemStorageType mem_type) {
       MemManager::Instance().RdmaPoolInstance(RT_MEMORY_HBM).Free(reinterpret_cast<uint8_t *>(data), device_id_);
     } else if (mem_type == HOST_DDR) {
       MemManager::Instance().HostMemInstance(RT_MEMORY_HBM).Free(data);
-    } else {
+    } else if (!DeallocateOnStream(data)) {
       MemManager::Instance().CachingInstance(RT_MEMORY_HBM).Free(reinterpret_cast<uint8_t *>(data), device_id_);
     }
   }
 }
 
+void *NpuMemoryAllocator::AllocateOnStream(size_t size, const AllocationAttr &attr) {
+  std::lock_guard<std::mutex> lk(stream_mu_);
+  void *buffer = nullptr;
+  size_t buffer_size = size;
+  auto it = stream_blocks_.find(attr.stream_);
+  if (it != stream_blocks_.end()) {
+    // tasks using the block were launched to the same stream before, the new user runs after them
+    auto &blocks = it->second;
+    auto best = blocks.end();
+    for (auto block_it = blocks.begin(); block_it != blocks.end(); ++block_it) {
+      // blocks used by other streams wait for their events
+      if ((block_it->events.size() == 1U) && (block_it->size >= size) && (block_it->size <= size * kMaxStreamBlockReuseRatio) &&
+          ((best == blocks.end()) || (block_it->size < best->size))) {
+        best = block_it;
+      }
+    }
+    if (best != blocks.end()) {
+      buffer = best->data;
+      buffer_size = best->size;
+      free_events_.emplace_back(best->events.front());
+      (void)blocks.erase(best);
+      stream_block_num_--;
+      GELOGD("Reuse block %p of size %zu freed on stream %p, size = %zu.", buffer, buffer_size, attr.stream_, size);
+    }
+  }
+
+  if (buffer == nullptr) {
+    ReclaimStreamBlocks(false);
+    auto &caching_allocator = MemManager::Instance().CachingInstance(RT_MEMORY_HBM);
+    buffer = caching_allocator.Malloc(size, reinterpret_cast<uint8_t *>(attr.try_reuse_addr_), device_id_);
+    if ((buffer == nullptr) && (stream_block_num_ > 0)) {
+      GELOGW("Malloc size %zu failed, wait for the tasks using %zu freed blocks.", size, stream_block_num_);
+      ReclaimStreamBlocks(true);
+      buffer = caching_allocator.Malloc(size, reinterpret_cast<uint8_t *>(attr.try_reuse_addr_), device_id_);
+    }
+  }
+  if (buffer != nullptr) {
+    stream_buffers_[buffer] = {buffer_size, attr.stream_};
+    has_stream_buffers_ = true;
+  }
+  return buffer;
+}
+
+bool NpuMemoryAllocator::DeallocateOnStream(void *data) {
+  if (!has_stream_buffers_) {
+    return false;
+  }
+  std::lock_guard<std::mutex> lk(stream_mu_);
+  auto it = stream_buffers_.find(data);
+  if (it == stream_buffers_.end()) {
+    return false;
+  }
+  StreamBlock block = {data, it->second.size, {}};
+  std::vector<rtStream_t> streams = {it->second.stream};
+  streams.insert(streams.end(), it->second.other_streams.begin(), it->second.other_streams.end());
+  (void)stream_buffers_.erase(it);
+  for (auto stream : streams) {
+    rtEvent_t event = GetEvent();
+    if ((event != nullptr) && (rtEventRecord(event, stream) == RT_ERROR_NONE)) {
+      block.events.emplace_back(event);
+      continue;
+    }
+    GELOGW("Record event on stream %p failed, synchronize the streams using %p to free it.", stream, data);
+    if (event != nullptr) {
+      free_events_.emplace_back(event);
+    }
+    free_events_.insert(free_events_.end(), block.events.begin(), block.events.end());
+    for (auto sync_stream : streams) {
+      GE_CHK_RT(rtStreamSynchronize(sync_stream));
+    }
+    return false;
+  }
+  stream_blocks_[streams.front()].emplace_back(std::move(block));
+  stream_block_num_++;
+  return true;
+}
+
+bool NpuMemoryAllocator::IsStreamOrdered(const void *data) {
+  if (!has_stream_buffers_) {
+    return false;
+  }
+  std::lock_guard<std::mutex> lk(stream_mu_);
+  return stream_buffers_.count(data) > 0;
+}
+
+void NpuMemoryAllocator::RecordStream(const void *data, rtStream_t stream) {
+  if (!has_stream_buffers_) {
+    return;
+  }
+  std::lock_guard<std::mutex> lk(stream_mu_);
+  auto it = stream_buffers_.find(data);
+  if ((it == stream_buffers_.end()) || (it->second.stream == stream)) {
+    return;
+  }
+  auto &other_streams = it->second.other_streams;
+  if (std::find(other_streams.begin(), other_streams.end(), stream) == other_streams.end()) {
+    other_streams.emplace_back(stream);
+  }
+}
+
+void NpuMemoryAllocator::ReleaseStreamBlocks(rtStream_t stream) {
+  std::lock_guard<std::mutex> lk(stream_mu_);
+  auto it = stream_blocks_.find(stream);
+  if (it != stream_blocks_.end()) {
+    for (const auto &block : it->second) {
+      // the other streams using the block are not synchronized
+      for (size_t i = 1U; i < block.events.size(); ++i) {
+        GE_CHK_RT(rtEventSynchronize(block.events[i]));
+      }
+      FreeStreamBlock(block);
+    }
+    stream_block_num_ -= it->second.size();
+    (void)stream_blocks_.erase(it);
+  }
+  // the stream may be destroyed before the buffers are freed, nothing recorded later refers to it. Buffers still
+  // used by other streams are handed to one of them, so their free waits for the others
+  for (auto buffer_it = stream_buffers_.begin(); buffer_it != stream_buffers_.end();) {
+    auto &buffer = buffer_it->second;
+    (void)buffer.other_streams.erase(std::remove(buffer.other_streams.begin(), buffer.other_streams.end(), stream),
+                                     buffer.other_streams.end());
+    if (buffer.stream != stream) {
+      ++buffer_it;
+    } else if (buffer.other_streams.empty()) {
+      buffer_it = stream_buffers_.erase(buffer_it);
+    } else {
+      buffer.stream = buffer.other_streams.front();
+      (void)buffer.other_streams.erase(buffer.other_streams.begin());
+      ++buffer_it;
+    }
+  }
+}
+
+void NpuMemoryAllocator::ReclaimStreamBlocks(bool wait) {
+  if (stream_block_num_ == 0) {
+    return;
+  }
+  for (auto it = stream_blocks_.begin(); it != stream_blocks_.end();) {
+    auto &blocks = it->second;
+    while (!blocks.empty()) {
+      const StreamBlock &block = blocks.front();
+      bool completed = true;
+      for (auto event : block.events) {
+        if (wait) {
+          GE_CHK_RT(rtEventSynchronize(event));
+        } else if (rtEventQuery(event) != RT_ERROR_NONE) {
+          completed = false;
+          break;
+        }
+      }
+      if (!completed) {
+        // blocks freed later on the stream wait for it
+        break;
+      }
+      FreeStreamBlock(block);
+      blocks.pop_front();
+      stream_block_num_--;
+    }
+    if (blocks.empty()) {
+      it = stream_blocks_.erase(it);
+    } else {
+      ++it;
+    }
+  }
+}
+
+void NpuMemoryAllocator::FreeStreamBlock(const StreamBlock &block) {
+  MemManager::Instance().CachingInstance(RT_MEMORY_HBM).Free(reinterpret_cast<uint8_t *>(block.data), device_id_);
+  free_events_.insert(free_events_.end(), block.events.begin(), block.events.end());
+}
+
+rtEvent_t NpuMemoryAllocator::GetEvent() {
+  if (!free_events_.empty()) {
+    rtEvent_t event = free_events_.back();
+    free_events_.pop_back();
+    return event;
+  }
+  rtEvent_t event = nullptr;
+  auto rt_ret = rtEventCreate(&event);
+  if (rt_ret != RT_ERROR_NONE) {
+    GELOGW("Create event failed, ret = %d.", rt_ret);
+    return nullptr;
+  }
+  return event;
+}
+
 NpuMemoryAllocator *NpuMemoryAllocator::GetAllocator(uint32_t device_id) {
   std::lock_guard<std::mutex> lk(mu_);
   auto it = allocators_.find(device_id);
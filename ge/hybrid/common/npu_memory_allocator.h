@@ -18,13 +18,17 @@
 #ifndef GE_HYBRID_COMMON_MEMORY_ALLOCATOR_H_
 #define GE_HYBRID_COMMON_MEMORY_ALLOCATOR_H_
 
+#include <atomic>
 #include <cstdint>
+#include <deque>
 #include <vector>
 #include <map>
 #include <memory>
 #include <mutex>
+#include <unordered_map>
 #include "external/ge/ge_api_error_codes.h"
 #include "framework/memory/memory_api.h"
+#include "runtime/rt.h"
 
 namespace ge {
 namespace hybrid {
@@ -38,16 +42,24 @@ class AllocationAttr {
   void SetMemType(MemStorageType memType) { mem_type_ = memType; }
   MemStorageType GetMemType() { return mem_type_; }
 
+  ///
+  /// @brief the memory is only touched by tasks of stream. It may take memory freed on stream whose
+  /// tasks are still pending, and when freed it is handed to other users only after the tasks of
+  /// stream launched before the free complete.
+  ///
+  void SetStream(rtStream_t stream) { stream_ = stream; }
+
  private:
   friend class NpuMemoryAllocator;
   int padding_ = 0;
   void *try_reuse_addr_ = nullptr;
   MemStorageType mem_type_ = HBM;
+  rtStream_t stream_ = nullptr;
 };
 
 class NpuMemoryAllocator {
  public:
-  ~NpuMemoryAllocator() = default;
+  ~NpuMemoryAllocator();
   static NpuMemoryAllocator *GetAllocator(uint32_t device_id);
   static NpuMemoryAllocator *GetAllocator();
   static void DestroyAllocator();
@@ -59,11 +71,54 @@ class NpuMemoryAllocator {
   void *Allocate(std::size_t size, AllocationAttr *attr = nullptr);
   void Deallocate(void *data, MemStorageType mem_type = HBM);
 
+  ///
+  /// @brief whether data was allocated with a stream and is freed in stream order
+  ///
+  bool IsStreamOrdered(const void *data);
+
+  ///
+  /// @brief tasks of stream use data allocated on another stream. When data is freed, an event is recorded on
+  /// stream too, and the memory is reused only after it completes
+  ///
+  void RecordStream(const void *data, rtStream_t stream);
+
+  ///
+  /// @brief stream is synchronized: give back the memory freed on it, and memory still in use
+  /// is no longer tied to it, but still waits for the other streams using it
+  ///
+  void ReleaseStreamBlocks(rtStream_t stream);
+
   static constexpr int kDefaultPadding = 32;
  private:
+  struct StreamBuffer {
+    size_t size;
+    rtStream_t stream;
+    std::vector<rtStream_t> other_streams;  // other streams using the buffer
+  };
+
+  struct StreamBlock {
+    void *data;
+    size_t size;
+    std::vector<rtEvent_t> events;  // recorded when freed, on the allocating stream first, then on the others
+  };
+
   explicit NpuMemoryAllocator(uint32_t device_id);
+  void *AllocateOnStream(size_t size, const AllocationAttr &attr);
+  bool DeallocateOnStream(void *data);
+  void ReclaimStreamBlocks(bool wait);
+  void FreeStreamBlock(const StreamBlock &block);
+  rtEvent_t GetEvent();
   uint32_t device_id_;
 
+  // guards the members below
+  std::mutex stream_mu_;
+  std::atomic_bool has_stream_buffers_{false};
+  std::unordered_map<const void *, StreamBuffer> stream_buffers_;
+  // in the order freed, so the events of a stream complete from the front
+  std::map<rtStream_t, std::deque<StreamBlock>> stream_blocks_;
+  size_t stream_block_num_ = 0;
+  std::vector<rtEvent_t> free_events_;
+
   static std::map<uint32_t, std::unique_ptr<NpuMemoryAllocator>> allocators_;
   static std::mutex mu_;
 };
@@ -19,6 +19,8 @@
 #define GE_HYBRID_EXECUTOR_HYBRID_EXECUTION_CONTEXT_H_
 
 #include <atomic>
+#include <set>
+#include <string>
 #include <unordered_map>
 #include "common/blocking_queue.h"
 #include "common/properties_manager.h"
@@ -72,6 +74,10 @@ struct GraphExecutionContext {
   DumpProperties dump_properties;
   bool trace_enabled = false;
   bool dump_enabled = false;
+  // memory of stream ordered nodes is tagged with stream and freed once their tasks are launched
+  bool stream_ordered_free = false;
+  // names of the node queues of the subgraph executors using the lock free queue
+  std::set<std::string> lock_free_queues;
   ExceptionDumper exception_dumper;
   std::vector<std::shared_ptr<ge::DavinciModel>> davinci_model;
   std::atomic_bool is_eos_{false};
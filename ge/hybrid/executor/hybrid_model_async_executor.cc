@@ -37,7 +37,7 @@ const int kDefaultLoopCount = 10;
 const size_t kAlignment = 64;
 }
 HybridModelAsyncExecutor::HybridModelAsyncExecutor(HybridModel *model)
-    : model_(model), run_flag_(false), data_dumper_(nullptr) {
+    : model_(model), run_flag_(false), latency_stats_reporter_(model), data_dumper_(nullptr) {
 }
 
 HybridModelAsyncExecutor::~HybridModelAsyncExecutor() {
@@ -101,6 +101,7 @@ Status HybridModelAsyncExecutor::Stop() {
   if (is_op_debug_reg_) {
     op_debug_register_.UnregisterDebugForStream(stream_);
   }
+  latency_stats_reporter_.Stop();
 
   if (stream_ != nullptr) {
     GE_CHK_RT(rtStreamDestroy(stream_));
@@ -131,6 +132,8 @@ Status HybridModelAsyncExecutor::Init() {
   }
 
   GE_CHK_STATUS_RET(InitInputDesc(), "[Init][InputDesc] failed, model_id:%u.", model_id_);
+  GE_CHK_STATUS_RET(latency_stats_reporter_.Start(),
+                    "[Start][LatencyStatsReporter] failed, model_id:%u.", model_id_);
 
   return SUCCESS;
 }
@@ -98,6 +98,7 @@ class HybridModelAsyncExecutor {
   std::unique_ptr<DataInputer> data_inputer_;
   std::unique_ptr<HybridModelExecutor> executor_;
   std::unique_ptr<HybridModelPipelineExecutor> pipe_executor_;
+  LatencyStatsReporter latency_stats_reporter_;
   std::future<Status> future_;
   uint64_t iterator_count_ = 0;
 
@@ -16,6 +16,8 @@
  */
 
 #include "hybrid/executor/hybrid_model_executor.h"
+#include "external/ge/ge_api_types.h"
+#include "framework/common/string_util.h"
 #include "graph/ge_context.h"
 #include "graph/runtime_inference_context.h"
 #include "graph/utils/tensor_utils.h"
@@ -102,6 +104,7 @@ Status HybridModelExecutor::ExecuteGraphInternal(HybridModelExecutor::ExecuteArg
     GE_CHK_STATUS_RET_NOLOG(prof_mgr.ProfileStepInfo(index_id, model_id, 1, stream_, device_id));
   }
 
+  // kept with stream ordered free as well, the outputs are copied back on host after it
   if (!model_->IsSingleOp()) {
     Status ret = root_graph_executor_->Synchronize();
     if (ret != ge::SUCCESS) {
@@ -165,6 +168,14 @@ Status HybridModelExecutor::InitExecutionContext() {
   if (IsLogEnable(GE_MODULE_NAME, DLOG_DEBUG)) {
     context_.trace_enabled = true;
   }
+  std::string stream_ordered_free;
+  (void)::ge::GetContext().GetOption(OPTION_EXEC_STREAM_ORDERED_FREE, stream_ordered_free);  // option may not be set up
+  context_.stream_ordered_free = (stream_ordered_free == "1");
+  std::string lock_free_queues;
+  (void)::ge::GetContext().GetOption(OPTION_EXEC_LOCK_FREE_NODE_QUEUES, lock_free_queues);  // option may not be set up
+  for (const auto &queue_name : StringUtils::Split(lock_free_queues, ',')) {
+    (void)context_.lock_free_queues.insert(queue_name);
+  }
   return SUCCESS;
 }
 
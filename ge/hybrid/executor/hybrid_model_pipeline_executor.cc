@@ -19,6 +19,8 @@
 
 #include "common/math/math_util.h"
 #include "common/dump/dump_manager.h"
+#include "external/ge/ge_api_types.h"
+#include "framework/common/string_util.h"
 #include "graph/ge_context.h"
 #include "graph/runtime_inference_context.h"
 #include "graph/load/model_manager/model_manager.h"
@@ -207,6 +209,14 @@ Status StageExecutor::InitExecutionContext() {
   if (IsLogEnable(GE_MODULE_NAME, DLOG_DEBUG)) {
     context_.trace_enabled = true;
   }
+  std::string stream_ordered_free;
+  (void)::ge::GetContext().GetOption(OPTION_EXEC_STREAM_ORDERED_FREE, stream_ordered_free);  // option may not be set up
+  context_.stream_ordered_free = (stream_ordered_free == "1");
+  std::string lock_free_queues;
+  (void)::ge::GetContext().GetOption(OPTION_EXEC_LOCK_FREE_NODE_QUEUES, lock_free_queues);  // option may not be set up
+  for (const auto &queue_name : StringUtils::Split(lock_free_queues, ',')) {
+    (void)context_.lock_free_queues.insert(queue_name);
+  }
   return SUCCESS;
 }
 
@@ -18,8 +18,16 @@
 #include "hybrid/executor/hybrid_profiler.h"
 #include <iomanip>
 #include <iostream>
+#include <fstream>
 #include <cstdarg>
+#include <cstdio>
+#include <cstdlib>
+#include <system_error>
+#include "external/ge/ge_api_types.h"
 #include "framework/common/debug/ge_log.h"
+#include "framework/common/debug/log.h"
+#include "graph/ge_context.h"
+#include "hybrid/model/hybrid_model.h"
 #include "securec.h"
 
 namespace ge {
@@ -29,6 +37,8 @@ const int kMaxEvents = 1024 * 500;
 const int kEventDescMax = 512;
 const int kMaxEventTypes = 8;
 const int kIndent = 8;
+const int kDecimal = 10;
+const char *const kDefaultLatencyStatsPath = ".";
 }
 
 HybridProfiler::HybridProfiler(): counter_(0) {
@@ -93,5 +103,88 @@ void HybridProfiler::Reset() {
   events_.clear();
   events_.resize(kMaxEvents);
 }
+
+LatencyStatsReporter::LatencyStatsReporter(HybridModel *model) : model_(model) {}
+
+LatencyStatsReporter::~LatencyStatsReporter() {
+  Stop();
+}
+
+Status LatencyStatsReporter::Start() {
+  std::string interval_option;
+  (void)GetContext().GetOption(OPTION_EXEC_LATENCY_STATS_INTERVAL, interval_option);  // option may not be set up
+  int64_t interval = std::strtol(interval_option.c_str(), nullptr, kDecimal);
+  if ((model_ == nullptr) || (interval <= 0)) {
+    GELOGD("Latency stats are not reported, interval option = %s.", interval_option.c_str());
+    return SUCCESS;
+  }
+  std::string path = kDefaultLatencyStatsPath;
+  (void)GetContext().GetOption(OPTION_EXEC_LATENCY_STATS_PATH, path);  // option may not be set up
+  if (path.empty()) {
+    path = kDefaultLatencyStatsPath;
+  }
+  report_file_ = path + "/hybrid_latency_stats_" + std::to_string(model_->GetModelId()) + ".json";
+  interval_ = std::chrono::seconds(interval);
+  // the executor of a model may be started again, e.g. when the model is reloaded, report this run only
+  model_->ResetNodeLatencyStats();
+  stopped_ = false;
+  try {
+    report_thread_ = std::thread(&LatencyStatsReporter::Run, this);
+  } catch (const std::system_error &e) {
+    GELOGE(INTERNAL_ERROR, "[Create][Thread]Failed to start latency stats reporter, reason: %s.", e.what());
+    REPORT_CALL_ERROR("E19999", "Failed to start latency stats reporter, reason: %s.", e.what());
+    return INTERNAL_ERROR;
+  }
+  GELOGI("Report latency stats of model %u to %s every %ld seconds.", model_->GetModelId(), report_file_.c_str(),
+         interval);
+  return SUCCESS;
+}
+
+void LatencyStatsReporter::Stop() {
+  {
+    std::lock_guard<std::mutex> lk(mu_);
+    stopped_ = true;
+  }
+  cv_.notify_all();
+  if (report_thread_.joinable()) {
+    report_thread_.join();
+    // the last stats since the previous report
+    (void)Report();
+  }
+}
+
+void LatencyStatsReporter::Run() {
+  std::unique_lock<std::mutex> lk(mu_);
+  while (!cv_.wait_for(lk, interval_, [this]() { return stopped_; })) {
+    lk.unlock();
+    (void)Report();
+    lk.lock();
+  }
+}
+
+Status LatencyStatsReporter::Report() {
+  if ((model_ == nullptr) || report_file_.empty()) {
+    return SUCCESS;
+  }
+  std::string stats;
+  GE_CHK_STATUS_RET(model_->GetNodeLatencyStats(stats), "[Get][LatencyStats] of model %u failed.",
+                    model_->GetModelId());
+  // readers never see a partly written file
+  const std::string tmp_file = report_file_ + ".tmp";
+  {
+    std::ofstream ofs(tmp_file, std::ios::trunc);
+    if (!ofs.is_open()) {
+      GELOGW("Open %s failed, skip reporting latency stats.", tmp_file.c_str());
+      return FAILED;
+    }
+    ofs << stats << std::endl;
+  }
+  if (std::rename(tmp_file.c_str(), report_file_.c_str()) != 0) {
+    GELOGW("Rename %s to %s failed, skip reporting latency stats.", tmp_file.c_str(), report_file_.c_str());
+    return FAILED;
+  }
+  GELOGD("Reported latency stats of model %u to %s.", model_->GetModelId(), report_file_.c_str());
+  return SUCCESS;
+}
 }  // namespace hybrid
 }  // namespace ge
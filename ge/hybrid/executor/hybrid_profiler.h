@@ -20,10 +20,13 @@
 
 #include <atomic>
 #include <chrono>
+#include <condition_variable>
 #include <mutex>
 #include <ostream>
 #include <string>
+#include <thread>
 #include <vector>
+#include "external/ge/ge_api_error_codes.h"
 
 namespace ge {
 namespace hybrid {
@@ -56,6 +59,41 @@ class HybridProfiler {
   std::vector<Event> events_;
   std::atomic_int counter_;
 };
+
+class HybridModel;
+///
+/// Writes the node latency stats of a model to a json file periodically, from its own thread
+///
+class LatencyStatsReporter {
+ public:
+  explicit LatencyStatsReporter(HybridModel *model);
+  ~LatencyStatsReporter();
+
+  ///
+  /// @brief start reporting if OPTION_EXEC_LATENCY_STATS_INTERVAL is set up, from fresh stats of the model
+  ///
+  Status Start();
+
+  void Stop();
+
+  ///
+  /// @brief write the stats once
+  ///
+  Status Report();
+
+  const std::string &GetReportFile() const { return report_file_; }
+
+ private:
+  void Run();
+
+  HybridModel *model_;
+  std::chrono::seconds interval_{0};
+  std::string report_file_;
+  std::thread report_thread_;
+  std::mutex mu_;
+  std::condition_variable cv_;
+  bool stopped_ = false;
+};
 }  // namespace hybrid
 }  // namespace ge
 #endif // GE_HYBRID_EXECUTOR_HYBRID_PROFILER_H_
@@ -16,6 +16,9 @@
  */
 
 #include "hybrid/executor/subgraph_executor.h"
+#include <algorithm>
+#include <tuple>
+#include <utility>
 #include "graph/ge_context.h"
 #include "hybrid/executor/worker/task_compile_engine.h"
 #include "hybrid/executor/worker/execution_engine.h"
@@ -27,6 +30,14 @@ namespace {
 constexpr int kDefaultThreadNum = 4;
 constexpr int kDefaultQueueSize = 16;
 constexpr int kDataInputIndex = 0;
+constexpr size_t kMaxPrepareQueueSize = 2048;
+const char *const kReadyQueueName = "ready";
+const char *const kScheduleQueueName = "schedule";
+const char *const kPrepareQueueName = "prepare";
+
+bool IsLockFreeQueue(const GraphExecutionContext *context, const char *queue_name) {
+  return (context != nullptr) && (context->lock_free_queues.count(queue_name) > 0);
+}
 }
 
 SubgraphExecutor::SubgraphExecutor(const GraphItem *graph_item, GraphExecutionContext *context, bool force_infer_shape,
@@ -36,7 +47,9 @@ SubgraphExecutor::SubgraphExecutor(const GraphItem *graph_item, GraphExecutionCo
       force_infer_shape_(force_infer_shape),
       pre_run_pool_(pre_run_pool),
       own_thread_pool_(false),
-      ready_queue_(kDefaultQueueSize) {
+      ready_queue_(IsLockFreeQueue(context, kReadyQueueName), kDefaultQueueSize),
+      lock_free_prepare_queues_(IsLockFreeQueue(context, kPrepareQueueName)),
+      schedule_queue_(IsLockFreeQueue(context, kScheduleQueueName)) {
 }
 
 SubgraphExecutor::~SubgraphExecutor() {
@@ -223,9 +236,18 @@ Status SubgraphExecutor::ExecuteAsync(TaskContext &task_context) {
   return SUCCESS;
 }
 
-BlockingQueue<const NodeItem *> &SubgraphExecutor::GetPrepareQueue(int group) {
+SelectableBlockingQueue<const NodeItem *> &SubgraphExecutor::GetPrepareQueue(int group) {
   std::lock_guard<std::mutex> lk(mu_);
-  return prepare_queues_[group];
+  auto it = prepare_queues_.find(group);
+  if (it == prepare_queues_.end()) {
+    // a lock free queue allocates all of its cells at once, no more than the nodes of the group are queued at a time
+    auto queue_size = lock_free_prepare_queues_ ? std::min(graph_item_->GetNodeSize(group), kMaxPrepareQueueSize)
+                                                : kMaxPrepareQueueSize;
+    it = prepare_queues_.emplace(std::piecewise_construct, std::forward_as_tuple(group),
+                                 std::forward_as_tuple(lock_free_prepare_queues_, static_cast<uint32_t>(queue_size)))
+             .first;
+  }
+  return it->second;
 }
 
 Status SubgraphExecutor::NodeEnqueue(NodeState *node_state) {
@@ -323,7 +345,7 @@ Status SubgraphExecutor::PrepareNodes(int group) {
   }
 
   GELOGD("[%s] Done preparing root nodes.", graph_item_->GetName().c_str());
-  BlockingQueue<const NodeItem *> &prepare_queue = GetPrepareQueue(group);
+  SelectableBlockingQueue<const NodeItem *> &prepare_queue = GetPrepareQueue(group);
   while (((group != -1) && (node_count < node_size)) || ((group == -1) && !node_complete)) {
     const NodeItem *node_item = nullptr;
     if (!prepare_queue.Pop(node_item)) {
@@ -368,7 +390,7 @@ Status SubgraphExecutor::NodeScheduled(NodeState *node_state) {
       const auto &node_name = node_item->node_name;
       int group = (node_state->GetGroup() != -1) ? node_item->group : -1;
       GELOGI("After [%s] scheduled, [%s] is ready for prepare.", node_state->GetName().c_str(), node_name.c_str());
-      BlockingQueue<const NodeItem *> &prepare_queue = GetPrepareQueue(group);
+      SelectableBlockingQueue<const NodeItem *> &prepare_queue = GetPrepareQueue(group);
       if (!prepare_queue.Push(node_item)) {
         if (!context_->is_eos_) {
           GELOGE(INTERNAL_ERROR, "[Check][State][%s] error occurs when push to queue.", graph_item_->GetName().c_str());
@@ -500,7 +522,10 @@ Status SubgraphExecutor::PrepareForExecution(GraphExecutionContext *ctx, NodeSta
   }
   GE_CHK_RT_RET(rtCtxSetCurrent(ctx->rt_context));
   RECORD_COMPILE_EVENT(ctx, node_item.NodeName().c_str(), "[UpdateTilingData] start");
-  GE_CHK_STATUS_RET_NOLOG(task->UpdateTilingData(*node_state.GetTaskContext())); // update op_desc before alloc ws
+  {
+    ScopeLatency latency(node_item.latency_stats.get(), profiling::kTiling);
+    GE_CHK_STATUS_RET_NOLOG(task->UpdateTilingData(*node_state.GetTaskContext())); // update op_desc before alloc ws
+  }
   RECORD_COMPILE_EVENT(ctx, node_item.NodeName().c_str(), "[UpdateTilingData] end");
   return SUCCESS;
 }
@@ -611,6 +636,9 @@ Status SubgraphExecutor::GetOutputs(vector<TensorValue> &outputs, std::vector<Co
 Status SubgraphExecutor::Synchronize() {
   GELOGD("[%s] Synchronize start.", graph_item_->GetName().c_str());
   GE_CHK_STATUS_RET_NOLOG(context_->Synchronize(context_->stream));
+  if (context_->stream_ordered_free && (context_->allocator != nullptr)) {
+    context_->allocator->ReleaseStreamBlocks(context_->stream);
+  }
   GELOGD("[%s] Done synchronizing successfully.", graph_item_->GetName().c_str());
   return SUCCESS;
 }
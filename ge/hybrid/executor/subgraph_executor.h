@@ -20,7 +20,7 @@
 
 #include <vector>
 
-#include "common/blocking_queue.h"
+#include "common/lock_free_blocking_queue.h"
 #include "common/thread_pool.h"
 #include "hybrid/executor/subgraph_context.h"
 #include "hybrid/executor/node_state.h"
@@ -114,7 +114,7 @@ class SubgraphExecutor {
   Status NodeEnqueue(NodeState *node_state);
   Status PrepareNode(const NodeItem &node_item, int group);
 
-  BlockingQueue<const NodeItem *> &GetPrepareQueue(int group);
+  SelectableBlockingQueue<const NodeItem *> &GetPrepareQueue(int group);
 
   Status ScheduleNodes();
   Status NodeScheduled(NodeState *node_state);
@@ -128,12 +128,15 @@ class SubgraphExecutor {
   bool force_infer_shape_;
   ThreadPool *pre_run_pool_;
   bool own_thread_pool_;
-  BlockingQueue<NodeState *> ready_queue_;
+  // node hand-offs between the prepare, schedule and launch threads are on the critical path of
+  // every node, each queue may be a lock free one by OPTION_EXEC_LOCK_FREE_NODE_QUEUES
+  SelectableBlockingQueue<NodeState *> ready_queue_;
   std::unique_ptr<ShapeInferenceEngine> shape_inference_engine_;
 
   std::mutex mu_; // Guard for prepare_queues_.
-  std::map<int, BlockingQueue<const NodeItem *>> prepare_queues_;
-  BlockingQueue<NodeState *> schedule_queue_;
+  std::map<int, SelectableBlockingQueue<const NodeItem *>> prepare_queues_;
+  bool lock_free_prepare_queues_;
+  SelectableBlockingQueue<NodeState *> schedule_queue_;
 };
 }  // namespace hybrid
 }  // namespace ge
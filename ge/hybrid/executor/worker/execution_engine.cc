@@ -58,6 +58,19 @@ Status LogOutputs(const NodeItem &node_item, const TaskContext &task_context) {
 
   return SUCCESS;
 }
+
+// the done callback dumps the inputs, they are released after it
+bool CanReleaseBeforeDone(const TaskContext &task_context) {
+  if (!task_context.IsStreamOrdered()) {
+    return false;
+  }
+  const DumpProperties &dump_properties = task_context.GetDumpProperties();
+  if (dump_properties.IsDumpOpen() || dump_properties.IsOpDebugOpen()) {
+    return false;
+  }
+  auto model_manager = ModelManager::GetInstance();
+  return (model_manager != nullptr) && !model_manager->IsDumpExceptionOpen();
+}
 }  // namespace
 
 NodeDoneCallback::NodeDoneCallback(GraphExecutionContext *graph_context,
@@ -288,6 +301,7 @@ Status NodeDoneCallback::OnNodeDone() {
   GELOGI("[%s] Start callback process.", node_item.NodeName().c_str());
   RECORD_CALLBACK_EVENT(graph_context_, context_->GetNodeName(), "[Compute] End");
   RECORD_CALLBACK_EVENT(graph_context_, context_->GetNodeName(), "[Callback] Start");
+  ScopeLatency latency(node_item.latency_stats.get(), profiling::kOnNodeDoneCallback);
 
   const DumpProperties &dump_properties = context_->GetDumpProperties();
   if (dump_properties.IsDumpOpen() || context_->IsOverFlow()) {
@@ -375,8 +389,11 @@ Status ExecutionEngine::DoExecuteAsync(NodeState &node_state,
   GE_CHECK_NOTNULL(executor);
   RECORD_EXECUTION_EVENT(&context, task_context.GetNodeName(), "[PrepareTask] Start");
   node_state.UpdatePersistTensor();
-  GE_CHK_STATUS_RET(executor->PrepareTask(*task, task_context), "[Prepare][Task] for [%s] failed.",
-                    node_state.GetName().c_str());
+  {
+    ScopeLatency latency(node_item.latency_stats.get(), profiling::kPrepareTask);
+    GE_CHK_STATUS_RET(executor->PrepareTask(*task, task_context), "[Prepare][Task] for [%s] failed.",
+                      node_state.GetName().c_str());
+  }
   RECORD_EXECUTION_EVENT(&context, task_context.GetNodeName(), "[PrepareTask] End");
   GELOGD("[%s] Done task preparation successfully.", node_state.GetName().c_str());
 
@@ -399,10 +416,20 @@ Status ExecutionEngine::DoExecuteAsync(NodeState &node_state,
     });
   }
   RECORD_EXECUTION_EVENT(&context, task_context.GetNodeName(), "[ExecuteTask] Start");
-  HYBRID_CHK_STATUS_RET(node_item.node_executor->ExecuteTask(*task, task_context, callback),
-                        "[%s] Failed to execute task",
-                        node_state.GetName().c_str());
+  {
+    ScopeLatency latency(node_item.latency_stats.get(), profiling::kLaunchTask);
+    HYBRID_CHK_STATUS_RET(node_item.node_executor->ExecuteTask(*task, task_context, callback),
+                          "[%s] Failed to execute task",
+                          node_state.GetName().c_str());
+  }
   RECORD_EXECUTION_EVENT(&context, task_context.GetNodeName(), "[ExecuteTask] End");
+  if (context.stream_ordered_free) {
+    task_context.RecordInputStreams();
+  }
+  if (CanReleaseBeforeDone(task_context)) {
+    // no need to wait for the callback, later tasks of the stream can reuse the memory
+    task_context.ReleaseStreamOrderedMemory();
+  }
 
   GELOGD("[%s] Done task launch successfully.", node_state.GetName().c_str());
   return SUCCESS;
@@ -73,6 +73,7 @@ Status ShapeInferenceEngine::InferShape(NodeState &node_state) {
   GELOGD("[%s] Start to invoke InferShapeAndType", node_item.NodeName().c_str());
   if (!node_state.MaySkipShapeInference()) {
     RECORD_SHAPE_INFERENCE_EVENT(execution_context_, node_item.NodeName().c_str(), "[InferShapeAndType] Start");
+    ScopeLatency latency(node_item.latency_stats.get(), profiling::kInferShape);
     GE_CHK_STATUS_RET(ShapeRefiner::InferShapeAndTypeForRunning(node_item.node, true),
         "[Invoke][InferShapeAndType] for %s failed.", node_item.NodeName().c_str());
     RECORD_SHAPE_INFERENCE_EVENT(execution_context_, node_item.NodeName().c_str(), "[InferShapeAndType] End");
@@ -132,6 +132,10 @@ class HybridDavinciModel::Impl {
     return model_.GetOpAttr(op_name, attr_name, attr_value);
   }
 
+  Status GetNodeLatencyStats(std::string &stats) {
+    return model_.GetNodeLatencyStats(stats);
+  }
+
  private:
   std::shared_ptr<ModelListener> listener_;
   HybridModel model_;
@@ -285,5 +289,10 @@ Status HybridDavinciModel::GetOpAttr(const std::string &op_name, const std::stri
   GE_CHECK_NOTNULL(impl_);
   return impl_->GetOpAttr(op_name, attr_name, attr_value);
 }
+
+Status HybridDavinciModel::GetNodeLatencyStats(std::string &stats) const {
+  GE_CHECK_NOTNULL(impl_);
+  return impl_->GetNodeLatencyStats(stats);
+}
 }  // namespace hybrid
 }  // namespace ge
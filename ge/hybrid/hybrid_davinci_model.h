@@ -87,6 +87,8 @@ class HybridDavinciModel {
 
   Status GetOpAttr(const std::string &op_name, const std::string &attr_name, std::string &attr_value) const;
 
+  Status GetNodeLatencyStats(std::string &stats) const;
+
  private:
   HybridDavinciModel() = default;
   class Impl;
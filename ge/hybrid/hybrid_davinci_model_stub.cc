@@ -112,5 +112,9 @@ Status HybridDavinciModel::GetOpAttr(const std::string &op_name, const std::stri
                                      std::string &attr_value) const {
   return UNSUPPORTED;
 }
+
+Status HybridDavinciModel::GetNodeLatencyStats(std::string &stats) const {
+  return UNSUPPORTED;
+}
 }  // namespace hybrid
 }  // namespace ge
@@ -455,5 +455,43 @@ Status HybridModel::GetOpAttr(const std::string &op_name, const std::string &att
   GELOGD("Get attr:%s of op:%s success, attr value:%s", attr_name.c_str(), op_name.c_str(), attr_value.c_str());
   return SUCCESS;
 }
+
+Status HybridModel::GetNodeLatencyStats(std::string &stats) const {
+  nlohmann::json nodes_json = nlohmann::json::object();
+  for (const auto &node_and_item : node_items_) {
+    const NodeItem &node_item = *node_and_item.second;
+    if (node_item.latency_stats == nullptr) {
+      continue;
+    }
+    nlohmann::json node_json;
+    node_item.latency_stats->ToJson(node_json);
+    if (node_json.empty()) {
+      continue;
+    }
+    node_json["type"] = node_item.NodeType();
+    nodes_json[node_item.NodeName()] = node_json;
+  }
+  nlohmann::json stats_json;
+  stats_json["model_id"] = model_id_;
+  stats_json["model_name"] = model_name_;
+  stats_json["nodes"] = nodes_json;
+  try {
+    stats = stats_json.dump();
+  } catch (const nlohmann::json::exception &e) {
+    GELOGE(FAILED, "[Dump][Json]Failed to dump latency stats of model %s, reason: %s.", model_name_.c_str(), e.what());
+    REPORT_INNER_ERROR("E19999", "Failed to dump latency stats of model %s, reason: %s.", model_name_.c_str(),
+                       e.what());
+    return FAILED;
+  }
+  return SUCCESS;
+}
+
+void HybridModel::ResetNodeLatencyStats() {
+  for (const auto &node_and_item : node_items_) {
+    if (node_and_item.second->latency_stats != nullptr) {
+      node_and_item.second->latency_stats->Reset();
+    }
+  }
+}
 }  // namespace hybrid
 }  // namespace ge
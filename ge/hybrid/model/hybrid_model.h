@@ -138,6 +138,16 @@ class HybridModel {
 
   Status GetOpAttr(const std::string &op_name, const std::string &attr_name, std::string &attr_value) const;
 
+  ///
+  /// @ingroup ge
+  /// @brief latencies of the execution stages of the nodes since loaded or reset, in json
+  /// @param [out] stats: {"model_id", "model_name", "nodes": {name: {"type", stage: {"count", "p99_us", ...}}}}
+  /// @return SUCCESS handle successfully / others handle failed
+  ///
+  Status GetNodeLatencyStats(std::string &stats) const;
+
+  void ResetNodeLatencyStats();
+
  private:
   friend class HybridModelBuilder;
   friend class HybridModelAsyncExecutor;
@@ -17,12 +17,18 @@
 
 #include "hybrid/model/hybrid_model_builder.h"
 #include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include "common/compile_executor.h"
 #include "common/math/math_util.h"
+#include "common/util/error_manager/error_manager.h"
 #include "framework/common/op/ge_op_utils.h"
 #include "graph/ge_context.h"
+#include "graph/ge_local_context.h"
 #include "graph/build/memory/var_mem_assign_util.h"
 #include "graph/debug/ge_attr_define.h"
 #include "common/omg_util.h"
+#include "common/thread_context_guard.h"
 #include "graph/load/model_manager/model_utils.h"
 #include "graph/load/model_manager/model_manager.h"
 #include "graph/manager/graph_var_manager.h"
@@ -51,6 +57,7 @@ const uint8_t kLoopMergeSize = 2;
 const uint8_t kStreamSwitchIdx = 1;
 const uint8_t kStreamSwitchNum = 2;
 const uint32_t kStringHeadElems = 2;
+const int64_t kMaxLoadTaskThreadNum = 32;
 const char *const kOwnerGraphIsUnknown = "OwnerGraphIsUnknown";
 const char *const kProfilingGraph = "ProfilingGraph";
 const char *const kProfilingFpNode = "ProfilingFpNode";
@@ -148,14 +155,19 @@ Status HybridModelBuilder::Build() {
   GE_CHK_STATUS_RET(ValidateParams(), "[Invoke][ValidateParams] failed, model_name_:[%s]", GetGraphName());
   hybrid_model_.model_name_ = ge_root_model_->GetModelName();
   GELOGI("[%s] Start to build hybrid model.", GetGraphName());
-  GE_CHK_STATUS_RET(CopyGraph(), "[Invoke][CopyGraph] failed, model_name_:[%s]", GetGraphName());
+  build_costs_.clear();
+  GE_CHK_STATUS_RET(RunBuildPhase("CopyGraph", &HybridModelBuilder::CopyGraph),
+                    "[Invoke][CopyGraph] failed, model_name_:[%s]", GetGraphName());
   GE_CHK_STATUS_RET(InitRuntimeParams(), "[Invoke][InitRuntimeParams] failed, model_name_:[%s]", GetGraphName());
   GE_CHK_STATUS_RET(RecoverGraphUnknownFlag(),
                     "[Invoke][RecoverGraphUnknownFlag] failed, model_name_:[%s]", GetGraphName());
   GE_CHK_STATUS_RET(IndexSpecialNodes(), "[Invoke][IndexSpecialNodes] failed, model_name_:[%s]", GetGraphName());
-  GE_CHK_STATUS_RET(IndexTaskDefs(), "[Invoke][IndexTaskDefs] failed, model_name_:[%s]", GetGraphName());
-  GE_CHK_STATUS_RET(InitWeights(), "[Invoke][InitWeights] failed, model_name_:[%s]", GetGraphName());
-  GE_CHK_STATUS_RET(LoadGraph(), "[Invoke][LoadGraph] failed, model_name_:[%s]", GetGraphName());
+  GE_CHK_STATUS_RET(RunBuildPhase("IndexTaskDefs", &HybridModelBuilder::IndexTaskDefs),
+                    "[Invoke][IndexTaskDefs] failed, model_name_:[%s]", GetGraphName());
+  GE_CHK_STATUS_RET(RunBuildPhase("InitWeights", &HybridModelBuilder::InitWeights),
+                    "[Invoke][InitWeights] failed, model_name_:[%s]", GetGraphName());
+  GE_CHK_STATUS_RET(RunBuildPhase("LoadGraph", &HybridModelBuilder::LoadGraph),
+                    "[Invoke][LoadGraph] failed, model_name_:[%s]", GetGraphName());
   GE_CHK_STATUS_RET(AssignUninitializedConstantOps(),
                     "[Invoke][AssignUninitializedConstantOps] failed, model_name_:[%s]", GetGraphName());
   GE_CHK_STATUS_RET(TransAllVarData(), "[Invoke][TransAllVarData] failed, model_name_:[%s]", GetGraphName());
@@ -163,7 +175,8 @@ Status HybridModelBuilder::Build() {
   GE_CHK_STATUS_RET(InitModelMem(), "[Invoke][InitModelMem] failed, model_name_:[%s]", GetGraphName());
   GE_CHK_STATUS_RET(InitConstantOps(), "[Invoke][InitConstantOps] failed, model_name_:[%s]", GetGraphName());
   GE_CHK_STATUS_RET(InitVariableTensors(), "[Invoke][InitVariableTensors], model_name_:[%s]", GetGraphName());
-  GE_CHK_STATUS_RET(LoadTasks(), "[Invoke][LoadTasks] failed, model_name_:[%s]", GetGraphName());
+  GE_CHK_STATUS_RET(RunBuildPhase("LoadTasks", &HybridModelBuilder::LoadTasks),
+                    "[Invoke][LoadTasks] failed, model_name_:[%s]", GetGraphName());
   GE_CHK_STATUS_RET(OptimizeDependenciesForConstantInputs(),
                     "[Invoke][OptimizeDependenciesForConstantInputs] failed, model_name_:[%s]",
                     GetGraphName());
@@ -171,6 +184,16 @@ Status HybridModelBuilder::Build() {
   return SUCCESS;
 }
 
+Status HybridModelBuilder::RunBuildPhase(const std::string &phase, Status (HybridModelBuilder::*func)()) {
+  const auto start = std::chrono::steady_clock::now();
+  const Status ret = (this->*func)();
+  const auto cost = static_cast<uint64_t>(
+      std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count());
+  build_costs_.emplace_back(phase, cost);
+  GELOGI("[%s] Build phase %s cost %lu us.", GetGraphName(), phase.c_str(), cost);
+  return ret;
+}
+
 Status HybridModelBuilder::BuildForSingleOp() {
   GE_CHK_STATUS_RET(ValidateParams(), "[Invoke][ValidateParams] failed, model_name_:[%s]", GetGraphName());
   hybrid_model_.root_graph_ = ge_root_model_->GetRootGraph();
@@ -304,6 +327,10 @@ Status HybridModelBuilder::GetOrCreateNodeItem(const NodePtr &node, NodeItem **n
   new_node->is_profiling_report = (executor_type == NodeExecutorManager::ExecutorType::AICORE) ||
                                   (executor_type == NodeExecutorManager::ExecutorType::AICPU_TF) ||
                                   (executor_type == NodeExecutorManager::ExecutorType::AICPU_CUSTOM);
+  // outputs of DEPEND_COMPUTE nodes are read on host after the tasks complete
+  new_node->is_stream_ordered = (new_node->is_profiling_report ||
+                                 (executor_type == NodeExecutorManager::ExecutorType::COMPILED_SUBGRAPH)) &&
+                                (new_node->shape_inference_type != DEPEND_COMPUTE);
   *node_item = new_node.get();
   node_items[node] = std::move(new_node);
   return SUCCESS;
@@ -1219,6 +1246,7 @@ Status HybridModelBuilder::LoadTask(NodeItem &node_item) {
 Status HybridModelBuilder::LoadTasks() {
   GE_CHK_STATUS_RET(CheckAicpuOpList(), "[Check][AicpuOpList] failed.");
   std::map<int, std::map<std::string, NodeItem *>> ordered_partitioned_calls;
+  std::vector<NodeItem *> node_items;
   for (auto &it : hybrid_model_.node_items_) {
     auto &node_item = it.second;
     if (node_item->node_type == NETOUTPUT) {
@@ -1228,8 +1256,9 @@ Status HybridModelBuilder::LoadTasks() {
       ordered_partitioned_calls[node_item->node_id][node_item->node_name] = node_item.get();
       continue;
     }
-    GE_CHK_STATUS_RET_NOLOG(LoadTask(*node_item));
+    node_items.emplace_back(node_item.get());
   }
+  GE_CHK_STATUS_RET_NOLOG(LoadTasksWithMultiThreads(node_items));
 
   // HCCL operators need to be loaded in the same order across different processes
   for (auto &it : ordered_partitioned_calls) {
@@ -1241,6 +1270,49 @@ Status HybridModelBuilder::LoadTasks() {
   return SUCCESS;
 }
 
+uint32_t HybridModelBuilder::GetLoadThreadNum() {
+  std::string load_thread_num = "0";
+  (void)GetContext().GetOption(OPTION_EXEC_MODEL_LOAD_THREAD_NUM, load_thread_num);  // option may not be set up
+  int64_t thread_num = std::strtol(load_thread_num.c_str(), nullptr, kDecimal);
+  thread_num = std::max<int64_t>(0, std::min(thread_num, kMaxLoadTaskThreadNum));
+  return static_cast<uint32_t>(thread_num);
+}
+
+Status HybridModelBuilder::LoadTasksWithMultiThreads(const std::vector<NodeItem *> &node_items) {
+  const uint32_t thread_num = GetLoadThreadNum();
+  if ((thread_num <= 1U) || (node_items.size() <= 1U)) {
+    for (auto node_item : node_items) {
+      GE_CHK_STATUS_RET_NOLOG(LoadTask(*node_item));
+    }
+    return SUCCESS;
+  }
+
+  // kernels are registered to the context of the model, set it up on the loading threads
+  rtContext_t rt_context = nullptr;
+  GE_CHK_RT_RET(rtCtxGetCurrent(&rt_context));
+  const auto error_context = ErrorManager::GetInstance().GetErrorManagerContext();
+  const GEThreadLocalContext ge_context = GetThreadLocalContext();
+  std::vector<CompileExecutor::Task> tasks;
+  for (auto node_item : node_items) {
+    CompileExecutor::Task task;
+    // not recorded, nodes with more tasks to load are started first
+    const auto task_defs = hybrid_model_.GetTaskDefs(node_item->node);
+    task.node_num = (task_defs == nullptr) ? 1U : std::max<size_t>(task_defs->size(), 1U);
+    task.func = [this, node_item, rt_context, &error_context, &ge_context]() -> Status {
+      ThreadContextGuard context_guard;
+      GE_CHK_RT_RET(rtCtxSetCurrent(rt_context));
+      ErrorManager::GetInstance().SetErrorContext(error_context);
+      GetThreadLocalContext() = ge_context;
+      return LoadTask(*node_item);
+    };
+    tasks.emplace_back(std::move(task));
+  }
+  GELOGD("[%s] Load %zu tasks with %u threads.", GetGraphName(), tasks.size(), thread_num);
+  GE_CHK_STATUS_RET(CompileExecutor::GetInstance().Run("LoadTasks", tasks, thread_num),
+                    "[Load][Tasks] of model %s failed.", GetGraphName());
+  return SUCCESS;
+}
+
 Status HybridModelBuilder::LoadGeModel(ComputeGraph &sub_graph, const GeModelPtr &ge_model) {
   auto parent_node = sub_graph.GetParentNode();
   GE_CHECK_NOTNULL(parent_node);
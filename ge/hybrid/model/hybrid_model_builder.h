@@ -21,6 +21,8 @@
 #include <vector>
 #include <queue>
 #include <memory>
+#include <string>
+#include <utility>
 #include "framework/common/ge_inner_error_codes.h"
 #include "graph/load/model_manager/task_info/task_info.h"
 #include "graph/node.h"
@@ -38,6 +40,13 @@ class HybridModelBuilder {
   Status Build();
   Status BuildForSingleOp();
 
+  ///
+  /// @brief time costs in microseconds of the main phases of the last Build, in the order they run
+  ///
+  const std::vector<std::pair<std::string, uint64_t>> &GetBuildCosts() const {
+    return build_costs_;
+  }
+
  private:
   static Status UpdateAnchorStatus(const NodePtr &node);
   static Status DoUnlinkDataAnchors(const OutDataAnchorPtr &out_data_anchor, const InDataAnchorPtr &in_data_anchor);
@@ -60,8 +69,11 @@ class HybridModelBuilder {
   Status CopyGraph();
   Status LoadGeModel(ComputeGraph &graph, const GeModelPtr &ge_model);
   static Status InitHcclExecutorOnDemand(const GeModelPtr &ge_model);
+  Status RunBuildPhase(const std::string &phase, Status (HybridModelBuilder::*func)());
   Status LoadTask(NodeItem &node_item);
   Status LoadTasks();
+  Status LoadTasksWithMultiThreads(const std::vector<NodeItem *> &node_items);
+  static uint32_t GetLoadThreadNum();
   Status IdentifyVariableOutputs(NodeItem &node_item, const ComputeGraphPtr &subgraph);
   Status BuildNodeItem(const NodePtr &node, NodeItem &node_item);
   Status GetOrCreateNodeItem(const NodePtr &node, NodeItem **node_item);
@@ -136,6 +148,7 @@ class HybridModelBuilder {
 
   RuntimeParam &runtime_param_;
   VarManager *var_manager_ = nullptr;
+  std::vector<std::pair<std::string, uint64_t>> build_costs_;
 
   // map<known_node_item, map<output_idx, constant_node>>
   std::map<NodeItem *, std::map<uint32_t, NodePtr>> known_subgraph_constant_output_refs_;
@@ -277,6 +277,8 @@ Status NodeItem::Init() {
   }
   copy_mu_ = MakeShared<std::mutex>();
   GE_CHECK_NOTNULL(copy_mu_);
+  latency_stats.reset(new (std::nothrow) NodeLatencyStats());
+  GE_CHECK_NOTNULL(latency_stats);
 
   return SUCCESS;
 }
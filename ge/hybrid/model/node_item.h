@@ -25,6 +25,7 @@
 #include "graph/op_desc.h"
 #include "graph/utils/node_utils.h"
 #include "framework/common/types.h"
+#include "hybrid/common/node_latency_stats.h"
 #include "hybrid/common/tensor_value.h"
 
 namespace ge {
@@ -166,6 +167,8 @@ struct NodeItem {
   std::map<int, int> reuse_outputs;
   int num_static_input_shapes = 0;
   bool is_profiling_report = false;
+  bool is_stream_ordered = false;  // memory is only touched by tasks launched to the stream
+  std::unique_ptr<NodeLatencyStats> latency_stats;
 
  private:
   explicit NodeItem(NodePtr node);
@@ -103,17 +103,20 @@ Status AiCoreNodeExecutor::GenNodeKey(const NodePtr &node, std::string &node_key
   return SUCCESS;
 }
 
-bool AiCoreNodeTaskRegistry::AddTask(const std::string &node_key, const std::shared_ptr<AiCoreNodeTask> &task) {
-  GE_CHECK_NOTNULL(task);
-  std::lock_guard<std::mutex> lock(mutex_);
-  auto iter = reg_node_tasks_.find(node_key);
-  if (iter != reg_node_tasks_.end()) {
-    GELOGE(FAILED, "[Add][Task] failed, key:%s already exist.", node_key.c_str());
-    REPORT_INNER_ERROR("E19999", "AddTask failed, key:%s already exist.", node_key.c_str());
-    return false;
+std::shared_ptr<AiCoreNodeTask> AiCoreNodeTaskRegistry::AddTask(const std::string &node_key,
+                                                                const std::shared_ptr<AiCoreNodeTask> &task) {
+  if (task == nullptr) {
+    GELOGE(PARAM_INVALID, "[Check][Param] task of key:%s is null.", node_key.c_str());
+    REPORT_INNER_ERROR("E19999", "AddTask failed, task of key:%s is null.", node_key.c_str());
+    return nullptr;
   }
+  std::lock_guard<std::mutex> lock(mutex_);
+  // the same node may be compiled on another thread meanwhile, the task registered first wins
   auto ret = reg_node_tasks_.emplace(node_key, task);
-  return ret.second;
+  if (!ret.second) {
+    GELOGD("Task of key:%s already exists, use the registered one.", node_key.c_str());
+  }
+  return ret.first->second;
 }
 
 std::shared_ptr<AiCoreNodeTask> AiCoreNodeTaskRegistry::GetTask(const std::string &node_key) {
@@ -169,11 +172,13 @@ Status AiCoreNodeExecutor::CompileTask(const HybridModel &model,
   aicore_task = std::move(node_task);
   GELOGD("successfully created node task: %s", node->GetName().c_str());
 
-  if (!registry.AddTask(node_key, aicore_task)) {
+  aicore_task = registry.AddTask(node_key, aicore_task);
+  if (aicore_task == nullptr) {
     GELOGE(INTERNAL_ERROR, "[Add][NodeTask] failed, op name = %s.", node->GetName().c_str());
     REPORT_CALL_ERROR("E19999", "add task failed, op name = %s.", node->GetName().c_str());
     return INTERNAL_ERROR;
   }
+  op_desc->SetWorkspaceBytes(aicore_task->GetWorkspaceSizes());
 
   task = std::move(aicore_task);
   GELOGI("AiCoreNodeExecutor(%s) CompileTask End.", node->GetName().c_str());
@@ -43,7 +43,11 @@ class AiCoreNodeTaskRegistry {
   }
 
   std::shared_ptr<AiCoreNodeTask> GetTask(const std::string &node_key);
-  bool AddTask(const std::string &node_key, const std::shared_ptr<AiCoreNodeTask> &task);
+  ///
+  /// @brief add task unless a task of the key exists
+  /// @return the task registered with the key, null if task is null
+  ///
+  std::shared_ptr<AiCoreNodeTask> AddTask(const std::string &node_key, const std::shared_ptr<AiCoreNodeTask> &task);
  private:
   AiCoreNodeTaskRegistry() = default;
   std::map<std::string, std::shared_ptr<AiCoreNodeTask>> reg_node_tasks_;
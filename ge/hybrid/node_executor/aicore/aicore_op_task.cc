@@ -48,6 +48,7 @@ TbeHandleHolder::~TbeHandleHolder() {
 }
 
 bool TbeHandleRegistry::AddHandle(std::unique_ptr<TbeHandleHolder> &&holder) {
+  std::lock_guard<std::mutex> lock(mutex_);
   auto ret = registered_handles_.emplace(std::move(holder));
   return ret.second;
 }
@@ -83,6 +84,9 @@ Status AiCoreOpTask::Init(const OpDesc &op_desc, const domi::TaskDef &task_def)
 }
 
 Status AiCoreOpTask::RegisterTbeHandle(const OpDesc &op_desc) {
+  TBEHandleStore &kernel_store = TBEHandleStore::GetInstance();
+  // tasks are loaded on several threads, query and register the kernel as a whole
+  std::lock_guard<std::mutex> lock(kernel_store.GetRegisterMutex());
   rtError_t rt_ret = rtQueryFunctionRegistered(stub_name_.c_str());
   if (rt_ret != RT_ERROR_NONE) {
     auto op_desc_ptr = MakeShared<OpDesc>(op_desc);
@@ -92,7 +96,6 @@ Status AiCoreOpTask::RegisterTbeHandle(const OpDesc &op_desc) {
       GELOGE(INTERNAL_ERROR, "TBE: %s can't find tvm bin file!", op_desc_ptr->GetName().c_str());
       return INTERNAL_ERROR;
     }
-    TBEHandleStore &kernel_store = TBEHandleStore::GetInstance();
     void *bin_handle = nullptr;
     if (!kernel_store.FindTBEHandle(stub_name_.c_str(), bin_handle)) {
       GELOGI("TBE: can't find the binfile_key[%s] in HandleMap", stub_name_.c_str());
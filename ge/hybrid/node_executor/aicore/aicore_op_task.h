@@ -19,6 +19,8 @@
 #define GE_HYBRID_KERNEL_AICORE_OP_TASK_H_
 
 #include <memory>
+#include <mutex>
+#include <set>
 #include <vector>
 #include "framework/common/ge_inner_error_codes.h"
 #include "runtime/stream.h"
@@ -52,6 +54,7 @@ class TbeHandleRegistry {
   bool AddHandle(std::unique_ptr<TbeHandleHolder> &&holder);
 
  private:
+  std::mutex mutex_;
   std::set<std::unique_ptr<TbeHandleHolder>> registered_handles_;
 };
 
@@ -55,6 +55,53 @@ void TaskContext::ReleaseWorkspace() {
   workspaces_.clear();
 }
 
+bool TaskContext::IsStreamOrdered() const {
+  return execution_context_->stream_ordered_free && node_item_->is_stream_ordered;
+}
+
+void TaskContext::ReleaseStreamOrderedMemory() {
+  // the tasks are launched, memory freed in stream order is safe to reuse by later tasks of the stream.
+  // other memory, e.g. allocated by a node running on host, waits until the tasks complete
+  auto allocator = execution_context_->allocator;
+  for (auto it = workspaces_.begin(); it != workspaces_.end();) {
+    if (allocator->IsStreamOrdered(*it)) {
+      allocator->Deallocate(*it);
+      it = workspaces_.erase(it);
+    } else {
+      ++it;
+    }
+  }
+  for (int i = 0; i < NumInputs(); ++i) {
+    auto input_tensor = MutableInput(i);
+    if ((input_tensor != nullptr) && allocator->IsStreamOrdered(input_tensor->GetData())) {
+      ReleaseInput(i);
+    }
+  }
+}
+
+void TaskContext::RecordInputStreams() {
+  // inputs allocated on another stream are freed only after the tasks of this one launched so far
+  auto allocator = execution_context_->allocator;
+  for (int i = 0; i < NumInputs(); ++i) {
+    auto input_tensor = MutableInput(i);
+    if (input_tensor != nullptr) {
+      allocator->RecordStream(input_tensor->GetData(), GetStream());
+    }
+  }
+}
+
+AllocationAttr *TaskContext::GetStreamOrderedAttr(AllocationAttr *attr, AllocationAttr &stream_attr) const {
+  if (!IsStreamOrdered()) {
+    return attr;
+  }
+  // attr may be shared, e.g. NpuMemoryAllocator::AttrWithDefaultPadding
+  if (attr != nullptr) {
+    stream_attr = *attr;
+  }
+  stream_attr.SetStream(GetStream());
+  return &stream_attr;
+}
+
 std::unique_ptr<TaskContext> TaskContext::Create(NodeState *node_state, SubgraphContext *subgraph_context) {
   const NodeItem &node_item = *node_state->GetNodeItem();
   GELOGI("[%s] To create task context, input start = %d, num_inputs = %d, output start = %d, num_outputs = %d.",
@@ -171,8 +218,10 @@ const TensorValue *TaskContext::GetInput(int index) const {
 
 Status TaskContext::AllocateWorkspaces() {
   auto workspace_sizes = node_item_->node->GetOpDesc()->GetWorkspaceBytes();
+  AllocationAttr stream_attr;
+  AllocationAttr *attr = GetStreamOrderedAttr(nullptr, stream_attr);
   for (auto size : workspace_sizes) {
-    void *workspace = execution_context_->allocator->Allocate(size);
+    void *workspace = execution_context_->allocator->Allocate(size, attr);
     if (workspace == nullptr) {
       REPORT_CALL_ERROR("E19999", "node:%s(%s) Allocate workspace failed, size: %ld",
                         node_item_->NodeName().c_str(), node_item_->NodeType().c_str(), size);
@@ -228,7 +277,8 @@ Status TaskContext::AllocateTensor(const GeTensorDesc &tensor_desc, TensorValue
     GELOGW("size from tensor_desc == 0");
   }
 
-  auto buffer = TensorBuffer::Create(execution_context_->allocator, size, attr);
+  AllocationAttr stream_attr;
+  auto buffer = TensorBuffer::Create(execution_context_->allocator, size, GetStreamOrderedAttr(attr, stream_attr));
   GE_CHECK_NOTNULL(buffer);
   tensor = TensorValue(shared_ptr<TensorBuffer>(buffer.release()));
   return SUCCESS;
@@ -325,7 +375,8 @@ Status TaskContext::AllocateOutputs(AllocationAttr *attr) {
 }
 
 Status TaskContext::AllocateTensor(size_t size, TensorValue &tensor, AllocationAttr *attr) {
-  auto buffer = TensorBuffer::Create(execution_context_->allocator, size, attr);
+  AllocationAttr stream_attr;
+  auto buffer = TensorBuffer::Create(execution_context_->allocator, size, GetStreamOrderedAttr(attr, stream_attr));
   if (buffer == nullptr) {
     REPORT_CALL_ERROR("E19999", "%s(%s) Allocate buffer failed, size: %zu",
                       node_item_->NodeName().c_str(), node_item_->NodeType().c_str(), size);
@@ -406,11 +457,12 @@ bool TaskContext::IsOverFlow() {
 
 Status TaskContext::AllocateWorkspace(size_t size, void **buffer, void *ori_addr) {
   GE_CHECK_NOTNULL(buffer);
+  AllocationAttr stream_attr;
   if (ori_addr == nullptr) {
-    *buffer = execution_context_->allocator->Allocate(size, nullptr);
+    *buffer = execution_context_->allocator->Allocate(size, GetStreamOrderedAttr(nullptr, stream_attr));
   } else {
     AllocationAttr attr(ori_addr);
-    *buffer = execution_context_->allocator->Allocate(size, &attr);
+    *buffer = execution_context_->allocator->Allocate(size, GetStreamOrderedAttr(&attr, stream_attr));
   }
 
   if (*buffer == nullptr) {
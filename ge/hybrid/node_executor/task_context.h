@@ -59,6 +59,9 @@ class TaskContext {
   bool NeedCallback();
   void ReleaseInput(int index);
   void ReleaseWorkspace();
+  void ReleaseStreamOrderedMemory();
+  void RecordInputStreams();
+  bool IsStreamOrdered() const;
   const TensorValue *GetInput(int index) const;
   const TensorValue *GetOutput(int index) const;
   TensorValue *MutableOutput(int index);
@@ -129,6 +132,7 @@ class TaskContext {
               SubgraphContext *subgraph_context);
 
   static string TensorDesc2String(const GeTensorDesc &desc);
+  AllocationAttr *GetStreamOrderedAttr(AllocationAttr *attr, AllocationAttr &stream_attr) const;
   Status AllocateTensor(const GeTensorDesc &tensor_desc, TensorValue &tensor, AllocationAttr *attr);
 
   NodeState *node_state_ = nullptr;
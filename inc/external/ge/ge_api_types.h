@@ -71,6 +71,28 @@ const char_t *const OPTION_EXEC_DYNAMIC_INPUT = "ge.exec.dynamicInput";
 const char_t *const OPTION_EXEC_DYNAMIC_EXECUTE_MODE = "ge.exec.dynamicGraphExecuteMode";
 const char_t *const OPTION_EXEC_DATA_INPUTS_SHAPE_RANGE = "ge.exec.dataInputsShapeRange";
 const char_t *const OPTION_EXEC_ENABLE_COPY_OUTPUT_ADDR = "ge.exec.enableCopyOutputAddr";
+// Number of device slots used to stage inputs of queued requests while the model runs, 0 or 1 disables staging
+const char_t *const OPTION_EXEC_INPUT_STAGING_DEPTH = "ge.exec.inputStagingDepth";
+// Number of threads decoding the partitions and submodels of an offline model and loading the tasks of a dynamic
+// shape model, 0 or 1 does them in sequence
+const char_t *const OPTION_EXEC_MODEL_LOAD_THREAD_NUM = "ge.exec.modelLoadThreadNum";
+// Instances of a model loaded on one device share the weights of the same content if it is "1", "0"(default) uploads
+// them per instance
+const char_t *const OPTION_EXEC_SHARE_MODEL_WEIGHTS = "ge.exec.shareModelWeights";
+// Device memory sizes up to this many bytes are malloced from per thread slabs, at most 1048576. 0(default) disables
+// slabs
+const char_t *const OPTION_EXEC_SLAB_ALLOC_THRESHOLD = "ge.exec.slabAllocThreshold";
+// Dynamic shape execution frees device memory in stream order, so it is reused without waiting for tasks to complete.
+// ge.exec.streamOrderedFree=1 enables it
+const char_t *const OPTION_EXEC_STREAM_ORDERED_FREE = "ge.exec.streamOrderedFree";
+// Node hand-off queues of the dynamic shape executor listed here use a lock free ring buffer instead of a mutex,
+// any of "ready", "schedule" and "prepare" separated by ','. None by default
+const char_t *const OPTION_EXEC_LOCK_FREE_NODE_QUEUES = "ge.exec.lockFreeNodeQueues";
+// Latency stats of the dynamic shape execution stages of every node are written to
+// <ge.exec.latencyStatsPath>/hybrid_latency_stats_<model id>.json every this many seconds, 0 disables it.
+// The path defaults to the working directory
+const char_t *const OPTION_EXEC_LATENCY_STATS_INTERVAL = "ge.exec.latencyStatsInterval";
+const char_t *const OPTION_EXEC_LATENCY_STATS_PATH = "ge.exec.latencyStatsPath";
 
 // Option key: memory init
 const char_t *const GRAPH_MEMORY_MAX_SIZE = "ge.graphMemoryMaxSize";
@@ -354,6 +376,53 @@ const std::string OP_EXECUTE_TIMEOUT = "ge.exec.opExecuteTimeout";
 
 const char_t *const FILE_CONSTANT_PATH = "ge.exec.value_bins";
 
+// Configure number of threads computing the kernels of constant folding.
+// Kernels of the nodes whose inputs are all constants are computed in parallel, the graph is changed in sequence.
+// Its value should be 0(default) or 1 to compute them one by one, at most 32
+const char_t *const CONSTANT_FOLDING_THREAD_NUM = "ge.constantFoldingThreadNum";
+
+// Configure size in MB of the process wide cache of constant folding results, shared by graphs and sessions.
+// Nodes with the same type, attributes, tensor descs and input data are folded by the cached results.
+// Its value should be 0(default) to disable the cache, at most 4096. The size seen first in the process applies
+const char_t *const CONSTANT_FOLDING_CACHE_SIZE = "ge.constantFoldingCacheSize";
+
+// Time, nodes visited and changed, re-pass count and memory delta of every pass and graph optimizer of a graph are
+// written to <ge.passReportPath>/ge_pass_report_<graph id>.json after the graph is compiled.
+// Empty(default) disables the report
+const char_t *const PASS_REPORT_PATH = "ge.passReportPath";
+
+// Feature map memory is also planned by packing the life time of the memory blocks into offsets, the smallest plan of
+// it and the block size based ones is used. Its value should be 0(default) or 1 to enable it
+const char_t *const MEMORY_INTERVAL_PACKING = "ge.memoryIntervalPacking";
+
+// Feature map memory plan of a graph, the sizes of each memory type and the offset, size, life time, stream and tensors
+// of each memory block, is written to <ge.memoryPlanPath>/ge_memory_plan_<graph id>_<graph name>.json after memory
+// is assigned. Empty(default) disables it
+const char_t *const MEMORY_PLAN_PATH = "ge.memoryPlanPath";
+
+// Outputs of ops cheap to recompute, e.g. elementwise ones, alive at the feature map peak only for their later
+// consumers are recomputed right before these consumers instead of being kept. Set as a graph option to switch it per
+// graph. Its value should be 0(default) or 1 to enable it
+const char_t *const MEMORY_REMATERIALIZATION = "ge.memoryRematerialization";
+
+// Rematerialization stops once the estimated feature map peak is within this budget in MB. Its value should be
+// 0(default) to rematerialize as long as the peak is reduced
+const char_t *const MEMORY_REMATERIALIZATION_BUDGET = "ge.memoryRematerializationBudget";
+
+// Outputs idle for a long gap between two of their uses are copied to host memory after the early uses and back before
+// the late ones on the same stream, trading feature map memory for host transfers. Set as a graph option to switch it
+// per graph. Its value should be 0(default) or 1 to enable it
+const char_t *const MEMORY_ACTIVATION_OFFLOAD = "ge.memoryActivationOffload";
+
+// Outputs are only offloaded if the gap, in nodes between two adjacent uses in topological order, is at least this
+// long. An output is copied back a quarter of it ahead of its next use. Its value should be a positive integer, 32 by
+// default
+const char_t *const MEMORY_ACTIVATION_OFFLOAD_MIN_GAP = "ge.memoryActivationOffloadMinGap";
+
+// Outputs are only offloaded if they are at least this large in KB. Its value should be a positive integer, 1024 by
+// default
+const char_t *const MEMORY_ACTIVATION_OFFLOAD_MIN_SIZE = "ge.memoryActivationOffloadMinSize";
+
 // Graph run mode
 enum GraphRunMode { PREDICTION = 0, TRAIN };
 
@@ -18,8 +18,11 @@
 #ifndef INC_FRAMEWORK_COMMON_HELPER_MODEL_HELPER_H_
 #define INC_FRAMEWORK_COMMON_HELPER_MODEL_HELPER_H_
 
+#include <functional>
+#include <map>
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "framework/common/helper/om_file_helper.h"
 #include "common/model/ge_model.h"
@@ -55,18 +58,45 @@ class GE_FUNC_VISIBILITY ModelHelper {
   Status GetBaseNameFromFileName(const std::string &file_name, std::string &base_name) const;
   Status GetModelNameFromMergedGraphName(const std::string &graph_name, std::string &model_name) const;
 
+  ///
+  /// @brief Decode the partitions of the model, and the submodels of a root model, with thread_num threads.
+  /// 0 or 1 decodes them one after another on the calling thread.
+  ///
+  void SetLoadThreadNum(const uint32_t thread_num) {
+    load_thread_num_ = thread_num;
+  }
+
+  ///
+  /// @brief Time in us spent on each kind of partition by the last load, summed over all submodels,
+  /// keyed by model_def / weights / task / tbe_kernels / cust_aicpu_kernels, and the wall time as total.
+  ///
+  const std::map<std::string, uint64_t> &GetPartitionLoadCost() const {
+    return partition_load_cost_;
+  }
+
  private:
+  struct PartitionLoadTask {
+    const char *partition;
+    Status error_code;
+    std::function<Status()> load;
+  };
+
   bool is_assign_model_ = false;
   bool is_offline_ = true;
   bool is_unknown_shape_model_ = false;
   ModelFileHeader *file_header_ = nullptr;
   GeModelPtr model_;
   GeRootModelPtr root_model_;
+  uint32_t load_thread_num_ = 0U;
+  std::map<std::string, uint64_t> partition_load_cost_;
 
   ModelHelper(const ModelHelper &) = default;
   ModelHelper &operator=(const ModelHelper &) = default;
   Status GenerateGeModel(OmFileLoadHelper &om_load_helper);
   Status GenerateGeRootModel(OmFileLoadHelper &om_load_helper);
+  void AddPartitionLoadTasks(OmFileLoadHelper &om_load_helper, GeModelPtr &cur_model, const size_t mode_index,
+                             std::vector<PartitionLoadTask> &tasks);
+  Status RunPartitionLoadTasks(const std::vector<PartitionLoadTask> &tasks);
   Status LoadModelData(OmFileLoadHelper &om_load_helper);
   Status LoadModelData(OmFileLoadHelper &om_load_helper, GeModelPtr &cur_model, const size_t mode_index) const;
   Status LoadWeights(OmFileLoadHelper &om_load_helper) const;
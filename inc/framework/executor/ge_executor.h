@@ -216,6 +216,20 @@ class GE_FUNC_VISIBILITY GeExecutor {
   Status LoadModelFromData(uint32_t &model_id, const ModelData &model_data, void *const dev_ptr, const size_t mem_size,
                            void *const weight_ptr, const size_t weight_size);
 
+  ///
+  /// @ingroup ge
+  /// @brief Load model from offline model file, the file is mapped instead of read into host memory
+  /// @param [in] const std::string &path: Offline model file path
+  /// @param [in] void *dev_ptr: Input/Output memory address
+  /// @param [in] size_t mem_size: Input/Output memory length
+  /// @param [in] void *weight_ptr: Weight memory address
+  /// @param [in] size_t weight_size: Weight memory length
+  /// @param [out] uint32_t &model_id: Corresponding identification after model loading
+  /// @return SUCCESS handle successfully / others handle failed
+  ///
+  Status LoadModelFromFile(uint32_t &model_id, const std::string &path, void *const dev_ptr, const size_t mem_size,
+                           void *const weight_ptr, const size_t weight_size);
+
   ///
   /// @ingroup ge
   /// @brief Load task list from ModelData with queue.
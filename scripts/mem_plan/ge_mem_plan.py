@@ -0,0 +1,245 @@
+#!/usr/bin/python3
+# -*- coding: UTF-8 -*-
+#-------------------------------------------------------------------
+# Purpose: show, diff and check feature map memory plans written by option ge.memoryPlanPath
+# Copyright 2021, 2022 LuoJiaNET Research and Development Group, Wuhan University
+# Copyright 2021, 2022 Huawei Technologies Co., Ltd
+#-------------------------------------------------------------------
+
+"""
+    Memory plans are written to <ge.memoryPlanPath>/ge_memory_plan_<graph id>_<graph name>.json
+    when memory of a graph is assigned.
+
+    ge_mem_plan.py show PLAN [--buckets N] [--svg FILE]
+        sizes of each memory type, peak size of alive tensors and utilization over node order,
+        --svg draws blocks by offset and life time
+    ge_mem_plan.py diff BASE NEW [--top N]
+        size changes of each memory type and the tensors changed most
+    ge_mem_plan.py check BASE NEW [--threshold RATIO]
+        fails if the size of any memory type grows by more than RATIO(default 0.05),
+        BASE and NEW may be directories of plans, plans of the same file name are checked
+"""
+
+import argparse
+import json
+import os
+import sys
+
+PLAN_PREFIX = 'ge_memory_plan_'
+BAR_WIDTH = 50
+SVG_WIDTH = 1200
+SVG_HEIGHT = 800
+SVG_COLORS = ['#4e79a7', '#f28e2b', '#e15759', '#76b7b2', '#59a14f', '#edc948', '#b07aa1', '#ff9da7']
+
+
+def load_plan(path):
+    with open(path, 'r') as plan_file:
+        return json.load(plan_file)
+
+
+def memory_sizes(plan):
+    return {memory['memory_type']: memory for memory in plan.get('memory', [])}
+
+
+def tensor_key(tensor):
+    return '%s:%s:%d' % (tensor['node'], tensor['kind'], tensor['index'])
+
+
+def get_end_time(plan):
+    end_time = 0
+    for block in plan.get('blocks', []):
+        end_time = max(end_time, block['life_begin'], block['life_end'])
+        for tensor in block['tensors']:
+            end_time = max(end_time, tensor['life_begin'], tensor['life_end'])
+    return end_time + 1
+
+
+def get_alive_sizes(plan, memory_type, end_time):
+    """
+        sizes of the tensors alive at each node, tensors never released are alive till the end
+    """
+    changes = [0] * (end_time + 2)
+    for block in plan.get('blocks', []):
+        if block['memory_type'] != memory_type or block['zero_copy']:
+            continue
+        for tensor in block['tensors']:
+            life_end = end_time if tensor['life_end'] < 0 else tensor['life_end']
+            changes[tensor['life_begin']] += tensor['size']
+            changes[life_end + 1] -= tensor['size']
+    alive_sizes = []
+    alive_size = 0
+    for change in changes[:end_time + 1]:
+        alive_size += change
+        alive_sizes.append(alive_size)
+    return alive_sizes
+
+
+def show(args):
+    plan = load_plan(args.plan)
+    end_time = get_end_time(plan)
+    print('graph: %s(%s), assigner: %s, blocks: %d' % (plan.get('graph_name'), plan.get('graph_id'),
+                                                      plan.get('assigner', 'unknown'), len(plan.get('blocks', []))))
+    if 'rematerialization' in plan:
+        print('rematerialization: estimated peak %d -> %d' % (plan['rematerialization']['estimated_peak_before'],
+                                                              plan['rematerialization']['estimated_peak_after']))
+    for memory_type, memory in sorted(memory_sizes(plan).items()):
+        alive_sizes = get_alive_sizes(plan, memory_type, end_time)
+        peak = max(alive_sizes) if alive_sizes else 0
+        size = memory['size']
+        print('memory type %d: size %d, block size %d, peak of alive tensors %d, peak utilization %.1f%%' %
+              (memory_type, size, memory['block_size'], peak, 100.0 * peak / size if size > 0 else 0.0))
+        if size == 0 or not alive_sizes:
+            continue
+        buckets = max(1, min(args.buckets, len(alive_sizes)))
+        step = (len(alive_sizes) + buckets - 1) // buckets
+        for begin in range(0, len(alive_sizes), step):
+            alive = max(alive_sizes[begin:begin + step])
+            bar = '#' * int(round(BAR_WIDTH * alive / size))
+            print('  node %6d-%-6d %-*s %5.1f%%' % (begin, min(begin + step, len(alive_sizes)) - 1, BAR_WIDTH, bar,
+                                                   100.0 * alive / size))
+    if args.svg:
+        write_svg(plan, end_time, args.svg)
+    return 0
+
+
+def write_svg(plan, end_time, svg_path):
+    """
+        blocks of each memory type are drawn from top to bottom, x is node order and y is offset
+    """
+    memories = memory_sizes(plan)
+    total_size = sum(max(memory['size'], 1) for memory in memories.values()) or 1
+    rects = []
+    top = 0.0
+    for memory_type, memory in sorted(memories.items()):
+        height = SVG_HEIGHT * max(memory['size'], 1) / total_size
+        rects.append('<text x="2" y="%.1f" font-size="10">memory type %d</text>' % (top + 10, memory_type))
+        for block in plan.get('blocks', []):
+            if block['memory_type'] != memory_type or not block['tensors']:
+                continue
+            for tensor in block['tensors']:
+                life_end = end_time if tensor['life_end'] < 0 else tensor['life_end']
+                x = SVG_WIDTH * tensor['life_begin'] / end_time
+                width = max(SVG_WIDTH * (life_end + 1 - tensor['life_begin']) / end_time, 1.0)
+                y = top + height * block['offset'] / max(memory['size'], 1)
+                rect_height = max(height * tensor['size'] / max(memory['size'], 1), 1.0)
+                rects.append('<rect x="%.1f" y="%.1f" width="%.1f" height="%.1f" fill="%s" fill-opacity="0.7">'
+                             '<title>%s size:%d offset:%d life:%d-%d stream:%d</title></rect>' %
+                             (x, y, width, rect_height, SVG_COLORS[block['stream'] % len(SVG_COLORS)],
+                              tensor_key(tensor), tensor['size'], block['offset'], tensor['life_begin'],
+                              tensor['life_end'], block['stream']))
+        top += height
+    with open(svg_path, 'w') as svg_file:
+        svg_file.write('<svg xmlns="http://www.w3.org/2000/svg" width="%d" height="%d">\n' % (SVG_WIDTH, SVG_HEIGHT))
+        svg_file.write('\n'.join(rects))
+        svg_file.write('\n</svg>\n')
+    print('svg is written to %s' % svg_path)
+
+
+def get_tensors(plan):
+    tensors = {}
+    for block in plan.get('blocks', []):
+        for tensor in block['tensors']:
+            tensors[tensor_key(tensor)] = (tensor, block)
+    return tensors
+
+
+def diff(args):
+    base = load_plan(args.base)
+    new = load_plan(args.new)
+    print('assigner: %s -> %s' % (base.get('assigner', 'unknown'), new.get('assigner', 'unknown')))
+    print('blocks: %d -> %d' % (len(base.get('blocks', [])), len(new.get('blocks', []))))
+    base_memories = memory_sizes(base)
+    new_memories = memory_sizes(new)
+    for memory_type in sorted(set(base_memories) | set(new_memories)):
+        base_memory = base_memories.get(memory_type, {'size': 0, 'block_size': 0})
+        new_memory = new_memories.get(memory_type, {'size': 0, 'block_size': 0})
+        print('memory type %d: size %d -> %d (%+d), block size %d -> %d (%+d)' %
+              (memory_type, base_memory['size'], new_memory['size'], new_memory['size'] - base_memory['size'],
+               base_memory['block_size'], new_memory['block_size'],
+               new_memory['block_size'] - base_memory['block_size']))
+
+    base_tensors = get_tensors(base)
+    new_tensors = get_tensors(new)
+    changes = []
+    for key in set(base_tensors) | set(new_tensors):
+        base_tensor = base_tensors.get(key, (None, None))[0]
+        new_tensor = new_tensors.get(key, (None, None))[0]
+        if base_tensor is None:
+            changes.append((new_tensor['size'], key, 'added, size %d life %d-%d' %
+                            (new_tensor['size'], new_tensor['life_begin'], new_tensor['life_end'])))
+        elif new_tensor is None:
+            changes.append((base_tensor['size'], key, 'removed, size %d life %d-%d' %
+                            (base_tensor['size'], base_tensor['life_begin'], base_tensor['life_end'])))
+        elif (base_tensor['size'], base_tensor['life_begin'], base_tensor['life_end']) != \
+                (new_tensor['size'], new_tensor['life_begin'], new_tensor['life_end']):
+            changes.append((abs(new_tensor['size'] - base_tensor['size']), key,
+                            'size %d -> %d, life %d-%d -> %d-%d' %
+                            (base_tensor['size'], new_tensor['size'], base_tensor['life_begin'],
+                             base_tensor['life_end'], new_tensor['life_begin'], new_tensor['life_end'])))
+    changes.sort(key=lambda change: (-change[0], change[1]))
+    print('tensors changed: %d' % len(changes))
+    for _, key, desc in changes[:args.top]:
+        print('  %s: %s' % (key, desc))
+    return 0
+
+
+def check_plan(base_path, new_path, threshold):
+    base_memories = memory_sizes(load_plan(base_path))
+    new_memories = memory_sizes(load_plan(new_path))
+    passed = True
+    for memory_type, new_memory in sorted(new_memories.items()):
+        base_size = base_memories.get(memory_type, {'size': 0})['size']
+        limit = base_size * (1.0 + threshold)
+        if new_memory['size'] > limit:
+            print('FAIL %s memory type %d: size %d -> %d, more than %.1f%% growth' %
+                  (os.path.basename(new_path), memory_type, base_size, new_memory['size'], threshold * 100))
+            passed = False
+        else:
+            print('PASS %s memory type %d: size %d -> %d' %
+                  (os.path.basename(new_path), memory_type, base_size, new_memory['size']))
+    return passed
+
+
+def check(args):
+    pairs = []
+    if os.path.isdir(args.base) and os.path.isdir(args.new):
+        for name in sorted(os.listdir(args.base)):
+            if not (name.startswith(PLAN_PREFIX) and name.endswith('.json')):
+                continue
+            if not os.path.isfile(os.path.join(args.new, name)):
+                print('MISS %s' % name)
+                continue
+            pairs.append((os.path.join(args.base, name), os.path.join(args.new, name)))
+    else:
+        pairs.append((args.base, args.new))
+    passed = True
+    for base_path, new_path in pairs:
+        passed = check_plan(base_path, new_path, args.threshold) and passed
+    return 0 if passed else 1
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Show, diff and check memory plans of graphs.')
+    subparsers = parser.add_subparsers(dest='command')
+    show_parser = subparsers.add_parser('show', help='show sizes and utilization over node order of a plan')
+    show_parser.add_argument('plan')
+    show_parser.add_argument('--buckets', type=int, default=20, help='rows of utilization over node order')
+    show_parser.add_argument('--svg', help='draw blocks to svg file')
+    diff_parser = subparsers.add_parser('diff', help='diff two plans of a graph')
+    diff_parser.add_argument('base')
+    diff_parser.add_argument('new')
+    diff_parser.add_argument('--top', type=int, default=20, help='number of the tensors changed most to print')
+    check_parser = subparsers.add_parser('check', help='check size growth of plans')
+    check_parser.add_argument('base')
+    check_parser.add_argument('new')
+    check_parser.add_argument('--threshold', type=float, default=0.05, help='ratio of growth allowed')
+    args = parser.parse_args()
+    commands = {'show': show, 'diff': diff, 'check': check}
+    if args.command not in commands:
+        parser.print_help()
+        return 1
+    return commands[args.command](args)
+
+
+if __name__ == '__main__':
+    sys.exit(main())
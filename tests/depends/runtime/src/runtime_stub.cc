@@ -69,6 +69,7 @@ void rtStubTearDown() {
   DEL_STUB_RETURN_VALUE(rtEventReset, rtError_t);
   DEL_STUB_RETURN_VALUE(rtEventCreate, rtError_t);
   DEL_STUB_RETURN_VALUE(rtGetEventID, rtError_t);
+  DEL_STUB_RETURN_VALUE(rtEventQuery, rtError_t);
 }
 
 ADD_STUB_RETURN_VALUE(rtGetDevice, rtError_t);
@@ -133,6 +134,11 @@ rtError_t rtEventRecord(rtEvent_t event, rtStream_t stream) { return RT_ERROR_NO
 
 rtError_t rtEventSynchronize(rtEvent_t event) { return RT_ERROR_NONE; }
 
+ADD_STUB_RETURN_VALUE(rtEventQuery, rtError_t);
+rtError_t rtEventQuery(rtEvent_t event) {
+  return GET_STUB_RETURN_VALUE(rtEventQuery, rtError_t, RT_ERROR_NONE);
+}
+
 rtError_t rtEventDestroy(rtEvent_t event) {
   delete[](int *) event;
   return RT_ERROR_NONE;
@@ -65,6 +65,8 @@ RTS_STUB_OUTBOUND_EXTERN(rtEventCreate, rtEvent_t, event);
 RTS_STUB_RETURN_EXTERN(rtGetEventID, rtError_t);
 RTS_STUB_OUTBOUND_EXTERN(rtEventCreate, uint32_t, event_id);
 
+RTS_STUB_RETURN_EXTERN(rtEventQuery, rtError_t);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,139 @@
+/**
+* Copyright 2021, 2022 LuoJiaNET Research and Development Group, Wuhan University
+* Copyright 2021, 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+#include <vector>
+
+#define private public
+#include "common/bcast.h"
+#undef private
+
+using namespace std;
+
+namespace ge {
+namespace {
+ConstGeTensorPtr CreateTensor(const vector<int64_t> &dims, vector<int32_t> &data) {
+  int64_t num = 1;
+  for (auto dim : dims) {
+    num *= dim;
+  }
+  data.resize(num);
+  for (int64_t i = 0; i < num; ++i) {
+    data[i] = static_cast<int32_t>(i * 3 + dims.size());
+  }
+  GeTensorDesc tensor_desc(GeShape(dims), FORMAT_ND, DT_INT32);
+  return std::make_shared<GeTensor>(tensor_desc, reinterpret_cast<uint8_t *>(data.data()),
+                                    data.size() * sizeof(int32_t));
+}
+
+int64_t Combine(int32_t const &x, int32_t const &y) {
+  return static_cast<int64_t>(x) * 100000 + y;
+}
+
+void CheckWithIndexes(const vector<int64_t> &x_dims, const vector<int64_t> &y_dims, size_t loop_dim_num) {
+  vector<int32_t> x_data;
+  vector<int32_t> y_data;
+  vector<ConstGeTensorPtr> input = {CreateTensor(x_dims, x_data), CreateTensor(y_dims, y_data)};
+  BCast bcast;
+  vector<int64_t> output;
+  ASSERT_EQ(bcast.BCastCompute<int32_t>(input, output, Combine), SUCCESS);
+  EXPECT_EQ(bcast.bcast_dims_.size(), loop_dim_num);
+
+  BCast index_bcast;
+  ASSERT_EQ(index_bcast.GenerateBcastInfo(x_dims, y_dims), SUCCESS);
+  EXPECT_EQ(index_bcast.GetOutputShape(), bcast.GetOutputShape());
+  vector<int64_t> x_indexes;
+  vector<int64_t> y_indexes;
+  index_bcast.BCastIndexes(x_indexes, y_indexes);
+  ASSERT_EQ(output.size(), x_indexes.size());
+  for (size_t i = 0; i < output.size(); ++i) {
+    ASSERT_EQ(output[i], Combine(x_data[x_indexes[i]], y_data[y_indexes[i]]));
+  }
+}
+}  // namespace
+
+class UtestBCast : public testing::Test {
+ protected:
+  void SetUp() {}
+  void TearDown() {}
+};
+
+TEST_F(UtestBCast, compute_same_as_indexes) {
+  CheckWithIndexes({}, {}, 0);
+  CheckWithIndexes({}, {5}, 1);
+  CheckWithIndexes({2, 3, 4}, {2, 3, 4}, 1);
+  // dims broadcasting the same way are collapsed
+  CheckWithIndexes({2, 3, 4}, {1, 1, 4}, 2);
+  CheckWithIndexes({2, 3, 4}, {4}, 2);
+  CheckWithIndexes({2, 1, 4}, {1, 3, 1}, 3);
+  CheckWithIndexes({5, 1}, {1, 6}, 2);
+  CheckWithIndexes({2, 1, 3, 1, 4}, {1, 1, 3, 5, 1}, 4);
+  CheckWithIndexes({1, 1, 7}, {3, 2, 1}, 2);
+  CheckWithIndexes({1, 4}, {3, 1, 1}, 2);
+  // both inputs broadcast into the outer dims, the inner one is contiguous in both
+  CheckWithIndexes({4, 1, 8}, {1, 4, 8}, 3);
+}
+
+TEST_F(UtestBCast, compute_empty_and_invalid) {
+  vector<int32_t> x_data;
+  vector<int32_t> y_data;
+  vector<ConstGeTensorPtr> input = {CreateTensor({2, 3}, x_data), CreateTensor({0, 1, 3}, y_data)};
+  BCast bcast;
+  vector<int64_t> output;
+  EXPECT_EQ(bcast.BCastCompute<int32_t>(input, output, Combine), SUCCESS);
+  EXPECT_TRUE(output.empty());
+  EXPECT_EQ(bcast.GetOutputShape(), vector<int64_t>({0, 2, 3}));
+
+  // shapes not compatible
+  input = {CreateTensor({2, 3}, x_data), CreateTensor({2}, y_data)};
+  BCast not_compatible;
+  EXPECT_NE(not_compatible.BCastCompute<int32_t>(input, output, Combine), SUCCESS);
+
+  // data is less than the shape
+  GeTensorDesc tensor_desc(GeShape({4}), FORMAT_ND, DT_INT32);
+  input = {CreateTensor({2, 4}, x_data),
+           std::make_shared<GeTensor>(tensor_desc, reinterpret_cast<uint8_t *>(y_data.data()), sizeof(int32_t))};
+  BCast short_data;
+  EXPECT_EQ(short_data.BCastCompute<int32_t>(input, output, Combine), PARAM_INVALID);
+
+  input = {CreateTensor({2, 4}, x_data)};
+  BCast one_input;
+  EXPECT_EQ(one_input.BCastCompute<int32_t>(input, output, Combine), PARAM_INVALID);
+}
+
+TEST_F(UtestBCast, compute_check) {
+  vector<int32_t> x_data;
+  vector<int32_t> y_data;
+  vector<ConstGeTensorPtr> input = {CreateTensor({3, 1, 4}, x_data), CreateTensor({2, 1}, y_data)};
+  auto check_all = [](int32_t const &, int32_t const &) -> bool { return true; };
+  BCast bcast;
+  vector<int64_t> output;
+  ASSERT_EQ(bcast.BCastComputeCheck<int32_t>(input, output, Combine, check_all), SUCCESS);
+  EXPECT_EQ(output.size(), 24);
+
+  // the last pair fails, nothing is left in output
+  int32_t last_x = x_data.back();
+  int32_t last_y = y_data.back();
+  auto check_last = [last_x, last_y](int32_t const &x, int32_t const &y) -> bool {
+    return (x != last_x) || (y != last_y);
+  };
+  BCast check_bcast;
+  vector<int64_t> check_output;
+  EXPECT_EQ(check_bcast.BCastComputeCheck<int32_t>(input, check_output, Combine, check_last), PARAM_INVALID);
+  EXPECT_TRUE(check_output.empty());
+}
+}  // namespace ge
@@ -0,0 +1,111 @@
+/**
+* Copyright 2021, 2022 LuoJiaNET Research and Development Group, Wuhan University
+* Copyright 2021, 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "common/compile_executor.h"
+
+namespace ge {
+namespace {
+CompileExecutor::Task CreateTask(const std::string &name, size_t node_num, const std::function<Status()> &func) {
+  CompileExecutor::Task task;
+  task.name = name;
+  task.node_num = node_num;
+  task.func = func;
+  return task;
+}
+}  // namespace
+
+class UtestCompileExecutor : public testing::Test {
+ protected:
+  void SetUp() {
+    CompileExecutor::GetInstance().ClearCosts();
+  }
+  void TearDown() {
+    CompileExecutor::GetInstance().ClearCosts();
+  }
+};
+
+TEST_F(UtestCompileExecutor, run_largest_first) {
+  std::vector<std::string> order;
+  std::mutex mutex;
+  std::vector<CompileExecutor::Task> tasks;
+  for (size_t node_num : {10U, 30U, 20U}) {
+    const std::string name = "graph_" + std::to_string(node_num);
+    tasks.emplace_back(CreateTask(name, node_num, [name, &order, &mutex]() {
+      std::lock_guard<std::mutex> lock(mutex);
+      order.emplace_back(name);
+      return SUCCESS;
+    }));
+  }
+  auto &executor = CompileExecutor::GetInstance();
+  EXPECT_EQ(executor.Run("test", tasks, 1U), SUCCESS);
+  EXPECT_EQ(order, std::vector<std::string>({"graph_30", "graph_20", "graph_10"}));
+
+  // the recorded times are used from now on
+  executor.RecordCost("graph_10", 10U, 1000000U);
+  EXPECT_EQ(executor.EstimateCost("graph_10", 10U), 1000000U);
+  EXPECT_GT(executor.EstimateCost("unknown_graph", 20U), executor.EstimateCost("graph_20", 20U));
+  order.clear();
+  EXPECT_EQ(executor.Run("test", tasks, 1U), SUCCESS);
+  EXPECT_EQ(order.front(), "graph_10");
+}
+
+TEST_F(UtestCompileExecutor, stop_after_failure) {
+  std::atomic<int> run_num(0);
+  std::vector<CompileExecutor::Task> tasks;
+  tasks.emplace_back(CreateTask("", 3U, [&run_num]() {
+    ++run_num;
+    return FAILED;
+  }));
+  for (int i = 0; i < 8; ++i) {
+    tasks.emplace_back(CreateTask("", 1U, [&run_num]() {
+      ++run_num;
+      return SUCCESS;
+    }));
+  }
+  EXPECT_EQ(CompileExecutor::GetInstance().Run("test", tasks, 1U), FAILED);
+  EXPECT_EQ(run_num.load(), 1);
+
+  tasks.emplace_back(CompileExecutor::Task());
+  EXPECT_EQ(CompileExecutor::GetInstance().Run("test", tasks), PARAM_INVALID);
+}
+
+TEST_F(UtestCompileExecutor, run_nested_tasks) {
+  auto &executor = CompileExecutor::GetInstance();
+  std::atomic<int> run_num(0);
+  std::vector<CompileExecutor::Task> tasks;
+  for (int i = 0; i < 16; ++i) {
+    tasks.emplace_back(CreateTask("", 1U, [&executor, &run_num]() {
+      std::vector<CompileExecutor::Task> sub_tasks;
+      for (int j = 0; j < 16; ++j) {
+        sub_tasks.emplace_back(CreateTask("", 1U, [&run_num]() {
+          ++run_num;
+          return SUCCESS;
+        }));
+      }
+      return executor.Run("sub_test", sub_tasks);
+    }));
+  }
+  EXPECT_EQ(executor.Run("test", tasks), SUCCESS);
+  EXPECT_EQ(run_num.load(), 256);
+}
+}  // namespace ge
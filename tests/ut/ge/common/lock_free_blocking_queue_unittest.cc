@@ -0,0 +1,193 @@
+/**
+* Copyright 2021, 2022 LuoJiaNET Research and Development Group, Wuhan University
+* Copyright 2021, 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+#include <chrono>
+#include <future>
+#include <thread>
+#include <vector>
+
+#include "common/blocking_queue.h"
+#include "common/lock_free_blocking_queue.h"
+
+namespace ge {
+namespace {
+constexpr int kScheduleNodeNum = 2000;
+constexpr uint32_t kReadyQueueSize = 16;
+
+// Replays the hand-offs of SubgraphExecutor::ScheduleTasks: the prepare thread feeds schedule_queue_,
+// the schedule thread forwards into the bounded ready_queue_ and the caller drains it as the launch
+// thread does. nullptr marks the end. Returns the nodes in the order launched.
+template <template <typename> class Queue>
+std::vector<int> ReplaySchedule(const std::vector<int> &nodes) {
+  Queue<const int *> schedule_queue;
+  Queue<const int *> ready_queue(kReadyQueueSize);
+  auto prepare_future = std::async(std::launch::async, [&]() {
+    for (const auto &node : nodes) {
+      EXPECT_TRUE(schedule_queue.Push(&node));
+    }
+    schedule_queue.Push(nullptr);
+  });
+  auto schedule_future = std::async(std::launch::async, [&]() {
+    const int *node = nullptr;
+    while (schedule_queue.Pop(node) && node != nullptr) {
+      EXPECT_TRUE(ready_queue.Push(node));
+    }
+    ready_queue.Push(nullptr);
+  });
+  std::vector<int> launched;
+  const int *node = nullptr;
+  while (ready_queue.Pop(node) && node != nullptr) {
+    launched.emplace_back(*node);
+  }
+  prepare_future.wait();
+  schedule_future.wait();
+  return launched;
+}
+}  // namespace
+
+class UtestLockFreeBlockingQueue : public testing::Test {
+ protected:
+  void SetUp() {}
+  void TearDown() {}
+};
+
+TEST_F(UtestLockFreeBlockingQueue, push_pop_in_order) {
+  LockFreeBlockingQueue<int> queue(3);
+  EXPECT_EQ(queue.Capacity(), 4);
+  for (int i = 0; i < 4; ++i) {
+    EXPECT_TRUE(queue.Push(i));
+  }
+  EXPECT_TRUE(queue.IsFull());
+  EXPECT_FALSE(queue.Push(4, false));
+  EXPECT_EQ(queue.Size(), 4);
+  for (int i = 0; i < 4; ++i) {
+    int item = -1;
+    EXPECT_TRUE(queue.Pop(item));
+    EXPECT_EQ(item, i);
+  }
+  EXPECT_EQ(queue.Size(), 0);
+}
+
+TEST_F(UtestLockFreeBlockingQueue, stop_wakes_blocked_pop) {
+  LockFreeBlockingQueue<int> queue;
+  auto pop_future = std::async(std::launch::async, [&queue]() {
+    int item = 0;
+    return queue.Pop(item);
+  });
+  std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  queue.Stop();
+  EXPECT_FALSE(pop_future.get());
+  EXPECT_FALSE(queue.Push(1));
+  queue.Restart();
+  EXPECT_TRUE(queue.Push(1));
+  queue.Clear();
+  EXPECT_EQ(queue.Size(), 0);
+}
+
+TEST_F(UtestLockFreeBlockingQueue, blocked_push_resumes_after_pop) {
+  LockFreeBlockingQueue<int> queue(2);
+  EXPECT_TRUE(queue.Push(0));
+  EXPECT_TRUE(queue.Push(1));
+  auto push_future = std::async(std::launch::async, [&queue]() { return queue.Push(2); });
+  std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  int item = -1;
+  EXPECT_TRUE(queue.Pop(item));
+  EXPECT_TRUE(push_future.get());
+  EXPECT_EQ(queue.Size(), 2);
+}
+
+TEST_F(UtestLockFreeBlockingQueue, multi_producer_multi_consumer) {
+  const int kProducerNum = 4;
+  const int kItemNum = 10000;
+  LockFreeBlockingQueue<int> queue(64);
+  std::vector<std::future<void>> producers;
+  for (int p = 0; p < kProducerNum; ++p) {
+    producers.emplace_back(std::async(std::launch::async, [&queue, p]() {
+      for (int i = 1; i <= kItemNum; ++i) {
+        EXPECT_TRUE(queue.Push(p * kItemNum + i));
+      }
+    }));
+  }
+  // items of each producer are popped in the order pushed, even spread over the consumers
+  std::vector<std::future<std::vector<int>>> consumers;
+  for (int c = 0; c < kProducerNum; ++c) {
+    consumers.emplace_back(std::async(std::launch::async, [&queue]() {
+      std::vector<int> items;
+      int item = 0;
+      while (queue.Pop(item) && item != 0) {
+        items.emplace_back(item);
+      }
+      return items;
+    }));
+  }
+  for (auto &producer : producers) {
+    producer.wait();
+  }
+  for (int c = 0; c < kProducerNum; ++c) {
+    EXPECT_TRUE(queue.Push(0));
+  }
+  std::vector<int> pop_count(kProducerNum * kItemNum + 1, 0);
+  for (auto &consumer : consumers) {
+    std::vector<int> last_items(kProducerNum, 0);
+    for (auto item : consumer.get()) {
+      ASSERT_GT(item, 0);
+      ASSERT_LE(item, kProducerNum * kItemNum);
+      const int producer = (item - 1) / kItemNum;
+      EXPECT_GT(item, last_items[producer]);
+      last_items[producer] = item;
+      pop_count[item]++;
+    }
+  }
+  // every item is popped exactly once
+  for (int item = 1; item <= kProducerNum * kItemNum; ++item) {
+    ASSERT_EQ(pop_count[item], 1) << "item " << item;
+  }
+  EXPECT_EQ(queue.Size(), 0);
+}
+
+TEST_F(UtestLockFreeBlockingQueue, schedule_replay_keeps_order) {
+  std::vector<int> nodes(kScheduleNodeNum);
+  for (int i = 0; i < kScheduleNodeNum; ++i) {
+    nodes[i] = i;
+  }
+  EXPECT_EQ(ReplaySchedule<LockFreeBlockingQueue>(nodes), nodes);
+  EXPECT_EQ(ReplaySchedule<BlockingQueue>(nodes), nodes);
+}
+
+TEST_F(UtestLockFreeBlockingQueue, selectable_queue_uses_chosen_type) {
+  for (bool lock_free : {false, true}) {
+    SelectableBlockingQueue<int> queue(lock_free, 4);
+    EXPECT_EQ(queue.IsLockFree(), lock_free);
+    for (int i = 0; i < 4; ++i) {
+      EXPECT_TRUE(queue.Push(i));
+    }
+    EXPECT_TRUE(queue.IsFull());
+    EXPECT_FALSE(queue.Push(4, false));
+    EXPECT_EQ(queue.Size(), 4);
+    int item = -1;
+    EXPECT_TRUE(queue.Pop(item));
+    EXPECT_EQ(item, 0);
+    queue.Clear();
+    EXPECT_EQ(queue.Size(), 0);
+    queue.Stop();
+    EXPECT_FALSE(queue.Pop(item));
+    queue.Restart();
+    EXPECT_TRUE(queue.Push(5));
+  }
+}
+}  // namespace ge
@@ -0,0 +1,133 @@
+/**
+* Copyright 2021, 2022 LuoJiaNET Research and Development Group, Wuhan University
+* Copyright 2021, 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <vector>
+
+#include "common/model_parser/mapped_model_file.h"
+#include "common/model_parser/model_parser.h"
+#include "framework/common/helper/om_file_helper.h"
+#include "framework/common/types.h"
+
+namespace ge {
+namespace {
+const char *const kModelFile = "./ut_mapped_model_file.om";
+constexpr uint32_t kModelDefSize = 1024;
+constexpr uint32_t kTaskInfoSize = 4096;
+
+uint8_t WeightByte(size_t index) {
+  return static_cast<uint8_t>(index * 7 + 1);
+}
+
+// header, a table of model def / weights / task info partitions and their contents
+void WriteOmFile(const std::string &path, uint32_t weight_size) {
+  const uint32_t partition_num = 3;
+  const ModelPartitionMemInfo partitions[partition_num] = {{MODEL_DEF, 0, kModelDefSize},
+                                                           {WEIGHTS_DATA, kModelDefSize, weight_size},
+                                                           {TASK_INFO, kModelDefSize + weight_size, kTaskInfoSize}};
+  ModelFileHeader header;
+  header.length = sizeof(uint32_t) + sizeof(partitions) + kModelDefSize + weight_size + kTaskInfoSize;
+  std::ofstream file(path, std::ios::binary | std::ios::trunc);
+  file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+  file.write(reinterpret_cast<const char *>(&partition_num), sizeof(partition_num));
+  file.write(reinterpret_cast<const char *>(partitions), sizeof(partitions));
+  file << std::string(kModelDefSize, 'm');
+  std::vector<uint8_t> weights(weight_size);
+  for (size_t i = 0; i < weights.size(); ++i) {
+    weights[i] = WeightByte(i);
+  }
+  file.write(reinterpret_cast<const char *>(weights.data()), weights.size());
+  file << std::string(kTaskInfoSize, 't');
+}
+
+Status GetPartition(const ModelData &model_data, ModelPartitionType type, ModelPartition &partition) {
+  uint8_t *model_addr = nullptr;
+  uint32_t model_len = 0;
+  GE_CHK_STATUS_RET_NOLOG(ModelParserBase::ParseModelContent(model_data, model_addr, model_len));
+  OmFileLoadHelper om_load_helper;
+  GE_CHK_STATUS_RET_NOLOG(om_load_helper.Init(model_addr, model_len));
+  return om_load_helper.GetModelPartition(type, partition);
+}
+}  // namespace
+
+class UtestMappedModelFile : public testing::Test {
+ protected:
+  void SetUp() {}
+  void TearDown() { (void)std::remove(kModelFile); }
+};
+
+TEST_F(UtestMappedModelFile, map_and_parse_partitions) {
+  WriteOmFile(kModelFile, 4096);
+  MappedModelFile model_file;
+  EXPECT_FALSE(model_file.IsMapped());
+  EXPECT_EQ(model_file.Map(kModelFile, 2), SUCCESS);
+  EXPECT_TRUE(model_file.IsMapped());
+  const ModelData &model_data = model_file.GetModelData();
+  EXPECT_EQ(model_data.priority, 2);
+  EXPECT_FALSE(model_data.om_name.empty());
+
+  ModelPartition partition;
+  EXPECT_EQ(GetPartition(model_data, WEIGHTS_DATA, partition), SUCCESS);
+  ASSERT_EQ(partition.size, 4096);
+  EXPECT_EQ(partition.data[0], WeightByte(0));
+  EXPECT_EQ(partition.data[4095], WeightByte(4095));
+  EXPECT_EQ(GetPartition(model_data, TASK_INFO, partition), SUCCESS);
+  EXPECT_EQ(partition.size, kTaskInfoSize);
+  EXPECT_EQ(partition.data[0], 't');
+
+  model_file.Unmap();
+  EXPECT_FALSE(model_file.IsMapped());
+  EXPECT_EQ(model_file.GetModelData().model_data, nullptr);
+  EXPECT_EQ(model_file.GetModelData().model_len, 0);
+}
+
+TEST_F(UtestMappedModelFile, map_invalid_file) {
+  MappedModelFile model_file;
+  EXPECT_EQ(model_file.Map("./not_exist.om", 0), ACL_ERROR_GE_EXEC_MODEL_PATH_INVALID);
+  EXPECT_FALSE(model_file.IsMapped());
+
+  { std::ofstream empty(kModelFile, std::ios::trunc); }
+  EXPECT_EQ(model_file.Map(kModelFile, 0), ACL_ERROR_GE_EXEC_MODEL_PATH_INVALID);
+  EXPECT_FALSE(model_file.IsMapped());
+}
+
+TEST_F(UtestMappedModelFile, same_partitions_as_load_from_file) {
+  const uint32_t weight_size = 3 * 4096 + 5;
+  WriteOmFile(kModelFile, weight_size);
+  MappedModelFile model_file;
+  ASSERT_EQ(model_file.Map(kModelFile, 0), SUCCESS);
+  ModelData heap_data;
+  ASSERT_EQ(ModelParserBase::LoadFromFile(kModelFile, 0, heap_data), SUCCESS);
+  EXPECT_EQ(model_file.GetModelData().model_len, heap_data.model_len);
+
+  for (auto type : {MODEL_DEF, WEIGHTS_DATA, TASK_INFO}) {
+    ModelPartition mapped_partition;
+    ModelPartition heap_partition;
+    ASSERT_EQ(GetPartition(model_file.GetModelData(), type, mapped_partition), SUCCESS);
+    ASSERT_EQ(GetPartition(heap_data, type, heap_partition), SUCCESS);
+    ASSERT_EQ(mapped_partition.size, heap_partition.size);
+    EXPECT_EQ(memcmp(mapped_partition.data, heap_partition.data, heap_partition.size), 0);
+  }
+  // the mapping is read only and the file is not changed by parsing it
+  std::ifstream file(kModelFile, std::ios::binary | std::ios::ate);
+  EXPECT_EQ(static_cast<uint32_t>(file.tellg()), heap_data.model_len);
+  delete[] static_cast<char *>(heap_data.model_data);
+}
+}  // namespace ge
@@ -0,0 +1,148 @@
+/**
+* Copyright 2021, 2022 LuoJiaNET Research and Development Group, Wuhan University
+* Copyright 2021, 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+#include <array>
+#include <future>
+#include <vector>
+
+#include "common/thread_pool.h"
+#include "common/work_stealing_thread_pool.h"
+
+namespace ge {
+namespace {
+constexpr uint32_t kThreadNum = 8;
+constexpr int kTaskNum = 1000;
+
+template <typename Pool>
+std::vector<int> RunCommits(Pool &pool) {
+  std::vector<std::future<int>> futures;
+  for (int i = 0; i < kTaskNum; ++i) {
+    futures.emplace_back(pool.commit([](int value) -> int { return value * 2 + 1; }, i));
+  }
+  std::vector<int> results;
+  for (auto &future : futures) {
+    results.emplace_back(future.get());
+  }
+  return results;
+}
+}  // namespace
+
+class UtestWorkStealingThreadPool : public testing::Test {
+ protected:
+  void SetUp() {}
+  void TearDown() {}
+};
+
+TEST_F(UtestWorkStealingThreadPool, small_task_inline_and_heap) {
+  int called = 0;
+  SmallTask inline_task([&called]() { ++called; });
+  SmallTask moved_task(std::move(inline_task));
+  EXPECT_FALSE(static_cast<bool>(inline_task));
+  moved_task();
+  EXPECT_EQ(called, 1);
+
+  std::array<char, SmallTask::kInlineSize * 2> big_capture{};
+  big_capture[0] = 1;
+  SmallTask heap_task([&called, big_capture]() { called += big_capture[0]; });
+  SmallTask assigned_task;
+  assigned_task = std::move(heap_task);
+  assigned_task();
+  EXPECT_EQ(called, 2);
+}
+
+TEST_F(UtestWorkStealingThreadPool, commit_success) {
+  WorkStealingThreadPool pool(kThreadNum);
+  EXPECT_EQ(pool.GetThreadNum(), kThreadNum);
+  auto future = pool.commit([](int a, int b) -> Status { return a == b ? SUCCESS : FAILED; }, 1, 1);
+  ASSERT_TRUE(future.valid());
+  EXPECT_EQ(future.get(), SUCCESS);
+}
+
+TEST_F(UtestWorkStealingThreadPool, nested_commit_from_worker) {
+  WorkStealingThreadPool pool(2);
+  auto outer = pool.commit([&pool]() -> int {
+    std::vector<std::future<int>> inner;
+    for (int i = 0; i < 16; ++i) {
+      inner.emplace_back(pool.commit([i]() { return i; }));
+    }
+    int sum = 0;
+    for (auto &future : inner) {
+      sum += future.get();
+    }
+    return sum;
+  });
+  EXPECT_EQ(outer.get(), 120);
+}
+
+TEST_F(UtestWorkStealingThreadPool, parallel_for) {
+  WorkStealingThreadPool pool(kThreadNum);
+  std::vector<int> values(10000, 1);
+  std::atomic<int64_t> sum(0);
+  EXPECT_EQ(pool.ParallelFor(values.size(), 64, [&values, &sum](size_t begin, size_t end) -> Status {
+    for (size_t i = begin; i < end; ++i) {
+      sum += values[i];
+    }
+    return SUCCESS;
+  }), SUCCESS);
+  EXPECT_EQ(sum.load(), 10000);
+
+  EXPECT_EQ(pool.ParallelFor(100, 1, [](size_t begin, size_t) -> Status {
+    return begin == 50 ? PARAM_INVALID : SUCCESS;
+  }), PARAM_INVALID);
+  EXPECT_EQ(pool.ParallelFor(0, 1, [](size_t, size_t) -> Status { return FAILED; }), SUCCESS);
+}
+
+TEST_F(UtestWorkStealingThreadPool, nested_parallel_for_no_deadlock) {
+  WorkStealingThreadPool pool(2);
+  std::atomic<int> count(0);
+  EXPECT_EQ(pool.ParallelFor(8, 1, [&pool, &count](size_t, size_t) -> Status {
+    return pool.ParallelFor(8, 1, [&count](size_t, size_t) -> Status {
+      ++count;
+      return SUCCESS;
+    });
+  }), SUCCESS);
+  EXPECT_EQ(count.load(), 64);
+}
+
+TEST_F(UtestWorkStealingThreadPool, pending_tasks_run_before_destroy) {
+  std::atomic<int> count(0);
+  {
+    WorkStealingThreadPool pool(1);
+    for (int i = 0; i < 100; ++i) {
+      (void)pool.commit([&count]() { ++count; });
+    }
+  }
+  EXPECT_EQ(count.load(), 100);
+}
+
+TEST_F(UtestWorkStealingThreadPool, commit_same_results_as_thread_pool) {
+  std::vector<int> ws_results;
+  std::vector<int> tp_results;
+  {
+    WorkStealingThreadPool pool(kThreadNum);
+    ws_results = RunCommits(pool);
+  }
+  {
+    ThreadPool pool(kThreadNum);
+    tp_results = RunCommits(pool);
+  }
+  ASSERT_EQ(ws_results.size(), kTaskNum);
+  EXPECT_EQ(ws_results, tp_results);
+  EXPECT_EQ(ws_results[kTaskNum - 1], kTaskNum * 2 - 1);
+}
+}  // namespace ge
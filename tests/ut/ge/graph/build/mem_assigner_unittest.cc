@@ -16,11 +16,17 @@
  */
 
 #include <gtest/gtest.h>
+#include <cstdio>
+#include <fstream>
+#include <functional>
 #include <memory>
+#include <nlohmann/json.hpp>
 
+#include "external/ge/ge_api_types.h"
 #include "graph/anchor.h"
 #include "graph/attr_value.h"
 #include "graph/debug/ge_attr_define.h"
+#include "graph/ge_local_context.h"
 #include "graph/utils/graph_utils.h"
 #include "graph/utils/node_utils.h"
 #include "graph/utils/op_desc_utils.h"
@@ -33,6 +39,7 @@
 #include "graph/build/memory/binary_block_mem_assigner.h"
 #include "graph/build/memory/graph_mem_assigner.h"
 #include "graph/build/memory/hybrid_mem_assigner.h"
+#include "graph/build/memory/interval_mem_assigner.h"
 #include "graph/build/memory/max_block_mem_assigner.h"
 #include "graph/manager/graph_var_manager.h"
 #undef protected
@@ -715,3 +722,162 @@ TEST_F(UtestMemoryAssignerTest, multi_batch_reuse) {
   EXPECT_EQ(session_scope_offset, 1536);
   EXPECT_EQ(ret, SUCCESS);
 }
+
+TEST_F(UtestMemoryAssignerTest, interval_packing_reuse_by_life_time) {
+  ge::ComputeGraphPtr graph = make_shared<ge::ComputeGraph>("");
+  MakeFftsReuseGraph(graph, kInvalidThreadScopeId, kInvalidThreadScopeId);
+  GetThreadLocalContext().SetGlobalOption({{MEMORY_INTERVAL_PACKING, "1"}});
+  HybridMemAssigner hybridMemAssigner(graph);
+  ge::Status ret = hybridMemAssigner.Assign();
+  GetThreadLocalContext().SetGlobalOption({});
+  EXPECT_EQ(ret, SUCCESS);
+  size_t offset = 0;
+  auto it = hybridMemAssigner.GetMemOffsets().find(RT_MEMORY_HBM);
+  if (it != hybridMemAssigner.GetMemOffsets().end()) {
+    offset = it->second;
+  }
+  // 5120 by the block size based assigners
+  EXPECT_LT(offset, 5120);
+
+  auto interval_assigner = dynamic_cast<IntervalMemAssigner *>(hybridMemAssigner.GetPriorityAssinger().get());
+  ASSERT_NE(interval_assigner, nullptr);
+  auto peak = interval_assigner->GetPeakMemSizes().find(RT_MEMORY_HBM);
+  ASSERT_NE(peak, interval_assigner->GetPeakMemSizes().end());
+  EXPECT_LE(peak->second, offset);
+}
+
+TEST_F(UtestMemoryAssignerTest, interval_packing_small_graph_reach_peak) {
+  ge::ComputeGraphPtr graph = make_shared<ge::ComputeGraph>("");
+  ge::NodePtr node_a = graph->AddNode(CreateOpWithWsSize("A", 0));
+  ge::NodePtr node_b = graph->AddNode(CreateOpWithWsSize("B", 0, "some", 2048));
+  ge::NodePtr node_c = graph->AddNode(CreateOpWithWsSize("C", 0));
+  ge::NodePtr node_d = graph->AddNode(CreateOpWithWsSize("D", 0, "some", 2048));
+  ge::GraphUtils::AddEdge(node_a->GetOutDataAnchor(0), node_b->GetInDataAnchor(0));
+  ge::GraphUtils::AddEdge(node_b->GetOutDataAnchor(0), node_c->GetInDataAnchor(0));
+  ge::GraphUtils::AddEdge(node_c->GetOutDataAnchor(0), node_d->GetInDataAnchor(0));
+  graph->TopologicalSorting();
+
+  std::map<std::string, std::string> anchor_to_symbol;
+  std::map<std::string, std::list<NodeIndexIO>> symbol_to_anchors;
+  EXPECT_EQ(GraphUtils::GetRefMapping(graph, symbol_to_anchors, anchor_to_symbol), GRAPH_SUCCESS);
+  IntervalMemAssigner interval_assigner(graph, anchor_to_symbol, symbol_to_anchors);
+  EXPECT_EQ(interval_assigner.Assign(), SUCCESS);
+
+  // output of A and C share memory, the last output is never released
+  auto offset = interval_assigner.GetMemOffsets().find(RT_MEMORY_HBM);
+  auto peak = interval_assigner.GetPeakMemSizes().find(RT_MEMORY_HBM);
+  ASSERT_NE(offset, interval_assigner.GetMemOffsets().end());
+  ASSERT_NE(peak, interval_assigner.GetPeakMemSizes().end());
+  EXPECT_EQ(offset->second, peak->second);
+  EXPECT_EQ(node_a->GetOpDesc()->GetOutputOffset()[0], node_c->GetOpDesc()->GetOutputOffset()[0]);
+}
+
+TEST_F(UtestMemoryAssignerTest, interval_packing_life_overlapped) {
+  IntervalMemAssigner::PackItem left;
+  left.life_begin = 2;
+  left.life_end = 5;
+  IntervalMemAssigner::PackItem right;
+  right.life_begin = 5;
+  right.life_end = 8;
+  EXPECT_TRUE(IntervalMemAssigner::LifeOverlapped(left, right));
+  EXPECT_TRUE(IntervalMemAssigner::LifeOverlapped(right, left));
+  right.life_begin = 6;
+  EXPECT_FALSE(IntervalMemAssigner::LifeOverlapped(left, right));
+  EXPECT_FALSE(IntervalMemAssigner::LifeOverlapped(right, left));
+}
+
+TEST_F(UtestMemoryAssignerTest, graph_memory_get_memory_plan) {
+  ge::ComputeGraphPtr graph = make_shared<ge::ComputeGraph>("plan");
+  MakeFftsReuseGraph(graph, kInvalidThreadScopeId, kInvalidThreadScopeId);
+  GraphMemoryAssigner memory_assigner(graph);
+  EXPECT_EQ(memory_assigner.AssignMemory(), SUCCESS);
+  std::string plan;
+  ASSERT_EQ(memory_assigner.GetMemoryPlan(plan), SUCCESS);
+
+  auto plan_json = nlohmann::json::parse(plan);
+  EXPECT_EQ(plan_json["graph_name"], "plan");
+  EXPECT_EQ(plan_json["assigner"], memory_assigner.mem_assigner_->GetPriorityAssignerName());
+  bool hbm_found = false;
+  for (const auto &memory_json : plan_json["memory"]) {
+    if (memory_json["memory_type"] == RT_MEMORY_HBM) {
+      hbm_found = true;
+      EXPECT_EQ(memory_json["size"], memory_assigner.memory_offset_[RT_MEMORY_HBM].mem_offset_);
+      EXPECT_EQ(memory_json["block_size"], 5120);
+    }
+  }
+  EXPECT_TRUE(hbm_found);
+
+  // every tensor of the graph lies in one block, blocks are inside the memory of their type
+  ASSERT_FALSE(plan_json["blocks"].empty());
+  size_t tensor_num = 0;
+  for (const auto &block_json : plan_json["blocks"]) {
+    if (block_json["memory_type"] == RT_MEMORY_HBM) {
+      EXPECT_LE(block_json["offset"].get<size_t>() + block_json["size"].get<size_t>(), 5120);
+    }
+    for (const auto &tensor_json : block_json["tensors"]) {
+      EXPECT_NE(graph->FindNode(tensor_json["node"].get<std::string>()), nullptr);
+      EXPECT_LE(tensor_json["size"].get<size_t>(), block_json["size"].get<size_t>());
+      tensor_num++;
+    }
+  }
+  EXPECT_GT(tensor_num, 0U);
+}
+
+TEST_F(UtestMemoryAssignerTest, graph_memory_dump_memory_plan) {
+  ge::ComputeGraphPtr graph = make_shared<ge::ComputeGraph>("plan/dump");
+  MakeFftsReuseGraph(graph, kInvalidThreadScopeId, kInvalidThreadScopeId);
+  GraphMemoryAssigner memory_assigner(graph);
+  EXPECT_EQ(memory_assigner.AssignMemory(), SUCCESS);
+  const std::string plan_file = "./ge_memory_plan_" + std::to_string(graph->GetGraphID()) + "_plan_dump.json";
+  (void)remove(plan_file.c_str());
+
+  memory_assigner.DumpMemoryPlan();
+  std::ifstream not_dumped(plan_file);
+  EXPECT_FALSE(not_dumped.is_open());
+
+  GetThreadLocalContext().SetGlobalOption({{MEMORY_PLAN_PATH, "."}});
+  memory_assigner.DumpMemoryPlan();
+  GetThreadLocalContext().SetGlobalOption({});
+  std::ifstream dumped(plan_file);
+  ASSERT_TRUE(dumped.is_open());
+  nlohmann::json plan_json;
+  dumped >> plan_json;
+  EXPECT_EQ(plan_json["graph_name"], "plan/dump");
+  (void)remove(plan_file.c_str());
+}
+
+// sizes of reference graphs, a change of the assigners growing any of them by more than 5% fails
+TEST_F(UtestMemoryAssignerTest, graph_memory_plan_size_regression) {
+  const double threshold = 0.05;
+  struct ReferenceGraph {
+    std::string name;
+    std::function<void(ge::ComputeGraphPtr)> make_graph;
+    size_t baseline;
+  };
+  std::vector<ReferenceGraph> reference_graphs = {
+    {"ffts_reuse", [this](ge::ComputeGraphPtr graph) { MakeFftsReuseGraph(graph); }, 5120},
+    {"ffts_reuse_two_scopes", [this](ge::ComputeGraphPtr graph) { MakeFftsReuseGraph(graph, 0, 1); }, 6656},
+    {"ffts_reuse_one_scope",
+     [this](ge::ComputeGraphPtr graph) { MakeFftsReuseGraph(graph, 0, kInvalidThreadScopeId); }, 5632},
+    {"session_scope_reuse", [this](ge::ComputeGraphPtr graph) { MakeSessionScopeReuseGraph(graph); }, 5120},
+    {"multi_batch_reuse", [this](ge::ComputeGraphPtr graph) { MakeMultiBatchReuseGraph(graph); }, 6656},
+    {"nopading_continuous_reuse", [this](ge::ComputeGraphPtr graph) { MakeContinuousReuseGraph(graph, true); }, 8192},
+  };
+  for (const auto &reference_graph : reference_graphs) {
+    ge::ComputeGraphPtr graph = make_shared<ge::ComputeGraph>(reference_graph.name);
+    reference_graph.make_graph(graph);
+    GraphMemoryAssigner memory_assigner(graph);
+    EXPECT_EQ(memory_assigner.AssignMemory(), SUCCESS) << reference_graph.name;
+    std::string plan;
+    ASSERT_EQ(memory_assigner.GetMemoryPlan(plan), SUCCESS);
+    auto plan_json = nlohmann::json::parse(plan);
+    size_t size = 0;
+    for (const auto &memory_json : plan_json["memory"]) {
+      if (memory_json["memory_type"] == RT_MEMORY_HBM) {
+        size = memory_json["block_size"].get<size_t>();
+      }
+    }
+    EXPECT_LE(size, reference_graph.baseline * (1 + threshold))
+        << reference_graph.name << " grows from " << reference_graph.baseline << " to " << size;
+  }
+}
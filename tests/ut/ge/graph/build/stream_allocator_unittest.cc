@@ -15,6 +15,9 @@
  * limitations under the License.
  */
 
+#include <map>
+#include <queue>
+#include <set>
 #include <string>
 #include <vector>
 #include <gtest/gtest.h>
@@ -106,6 +109,94 @@ class UtestStreamAllocator : public testing::Test {
     GraphUtils::AddEdge(node_list[399]->GetOutDataAnchor(0), e_node->GetInDataAnchor(0));
     GraphUtils::AddEdge(e_node->GetOutDataAnchor(0), f_node->GetInDataAnchor(1));
   }
+
+  NodePtr add_node(const ComputeGraphPtr &graph, const std::string &name, int64_t stream_id, size_t input_num = 1) {
+    const auto &op_desc = std::make_shared<OpDesc>(name, "testa");
+    for (size_t i = 0; i < input_num; ++i) {
+      op_desc->AddInputDesc(GeTensorDesc());
+    }
+    op_desc->AddOutputDesc(GeTensorDesc());
+    op_desc->SetStreamId(stream_id);
+    return graph->AddNode(op_desc);
+  }
+
+  ///
+  /// Nodes in layers, node i of a layer is on stream i and reads nodes i, i + 1 and i + 7 of the layer before.
+  ///
+  void make_graph_layers(const ComputeGraphPtr &graph, int64_t stream_num, int64_t layer_num) {
+    std::vector<NodePtr> last_layer;
+    for (int64_t layer = 0; layer < layer_num; ++layer) {
+      std::vector<NodePtr> cur_layer;
+      for (int64_t stream = 0; stream < stream_num; ++stream) {
+        const std::string name = "n_" + std::to_string(layer) + "_" + std::to_string(stream);
+        const auto &node = add_node(graph, name, stream, 3);
+        if (!last_layer.empty()) {
+          GraphUtils::AddEdge(last_layer[stream]->GetOutDataAnchor(0), node->GetInDataAnchor(0));
+          GraphUtils::AddEdge(last_layer[(stream + 1) % stream_num]->GetOutDataAnchor(0), node->GetInDataAnchor(1));
+          GraphUtils::AddEdge(last_layer[(stream + 7) % stream_num]->GetOutDataAnchor(0), node->GetInDataAnchor(2));
+        }
+        cur_layer.emplace_back(node);
+      }
+      last_layer.swap(cur_layer);
+    }
+  }
+
+  size_t get_event_num(const StreamAllocator &allocator) {
+    size_t send_num = 0;
+    for (const auto &node_events : allocator.node_to_send_events_) {
+      send_num += node_events.second.size();
+    }
+    size_t recv_num = 0;
+    for (const auto &node_events : allocator.node_to_recv_events_) {
+      recv_num += node_events.second.size();
+    }
+    EXPECT_EQ(send_num, recv_num);
+    return send_num;
+  }
+
+  ///
+  /// Check every data edge is still ordered by the order on the streams and the events left.
+  ///
+  void check_data_edges_ordered(const ComputeGraphPtr &graph, const StreamAllocator &allocator) {
+    std::map<uint32_t, NodePtr> send_nodes;
+    for (const auto &node_events : allocator.node_to_send_events_) {
+      for (const auto &event_id : node_events.second) {
+        send_nodes[event_id] = node_events.first;
+      }
+    }
+    std::map<NodePtr, std::vector<NodePtr>> pre_nodes;
+    std::map<int64_t, NodePtr> last_nodes;
+    for (const auto &node : graph->GetDirectNode()) {
+      auto &last_node = last_nodes[node->GetOpDesc()->GetStreamId()];
+      if (last_node != nullptr) {
+        pre_nodes[node].emplace_back(last_node);
+      }
+      last_node = node;
+      auto iter = allocator.node_to_recv_events_.find(node);
+      if (iter != allocator.node_to_recv_events_.end()) {
+        for (const auto &event_id : iter->second) {
+          ASSERT_EQ(send_nodes.count(event_id), 1);
+          pre_nodes[node].emplace_back(send_nodes[event_id]);
+        }
+      }
+    }
+    for (const auto &node : graph->GetDirectNode()) {
+      for (const auto &in_node : node->GetInDataNodes()) {
+        std::set<NodePtr> visited{node};
+        std::queue<NodePtr> to_visit;
+        to_visit.push(node);
+        while (!to_visit.empty() && (visited.count(in_node) == 0)) {
+          for (const auto &pre_node : pre_nodes[to_visit.front()]) {
+            if (visited.insert(pre_node).second) {
+              to_visit.push(pre_node);
+            }
+          }
+          to_visit.pop();
+        }
+        EXPECT_EQ(visited.count(in_node), 1) << in_node->GetName() << " -> " << node->GetName();
+      }
+    }
+  }
 };
 
 TEST_F(UtestStreamAllocator, test_split_streams_active) {
@@ -188,4 +279,102 @@ TEST_F(UtestStreamAllocator, test_update_active_streams_for_subgraph) {
   EXPECT_EQ(allocator.specific_activated_streams_.size(), 1);
   EXPECT_EQ(allocator.specific_activated_streams_.count(3), 1);
 }
+
+///
+/// Stream0    Stream1
+///   a ------> b
+///    \        |
+///     ------> c
+///
+TEST_F(UtestStreamAllocator, optimize_events_by_send_events) {
+  const auto &graph = std::make_shared<ComputeGraph>("optimize_events_by_send_events_graph");
+  const auto &a = add_node(graph, "a", 0);
+  const auto &b = add_node(graph, "b", 1);
+  const auto &c = add_node(graph, "c", 1, 2);
+  GraphUtils::AddEdge(a->GetOutDataAnchor(0), b->GetInDataAnchor(0));
+  GraphUtils::AddEdge(b->GetOutDataAnchor(0), c->GetInDataAnchor(0));
+  GraphUtils::AddEdge(a->GetOutDataAnchor(0), c->GetInDataAnchor(1));
+
+  StreamAllocator allocator(graph, Graph2SubGraphInfoList());
+  EXPECT_EQ(allocator.InsertSyncEvents(), SUCCESS);
+  EXPECT_EQ(get_event_num(allocator), 2);
+  EXPECT_EQ(allocator.OptimizeSyncEvents(), SUCCESS);
+  EXPECT_EQ(get_event_num(allocator), 1);
+  EXPECT_EQ(allocator.node_to_recv_events_[b].size(), 1);
+  EXPECT_TRUE(allocator.node_to_recv_events_[c].empty());
+}
+
+///
+/// Stream0    Stream1
+///   a ------
+///   |       \
+///   b ------> c
+///
+TEST_F(UtestStreamAllocator, optimize_events_by_recv_events) {
+  const auto &graph = std::make_shared<ComputeGraph>("optimize_events_by_recv_events_graph");
+  const auto &a = add_node(graph, "a", 0);
+  const auto &b = add_node(graph, "b", 0);
+  const auto &c = add_node(graph, "c", 1, 2);
+  GraphUtils::AddEdge(a->GetOutDataAnchor(0), b->GetInDataAnchor(0));
+  GraphUtils::AddEdge(a->GetOutDataAnchor(0), c->GetInDataAnchor(0));
+  GraphUtils::AddEdge(b->GetOutDataAnchor(0), c->GetInDataAnchor(1));
+
+  StreamAllocator allocator(graph, Graph2SubGraphInfoList());
+  EXPECT_EQ(allocator.InsertSyncEvents(), SUCCESS);
+  EXPECT_EQ(get_event_num(allocator), 2);
+  EXPECT_EQ(allocator.OptimizeSyncEvents(), SUCCESS);
+  EXPECT_EQ(get_event_num(allocator), 1);
+  EXPECT_TRUE(allocator.node_to_send_events_[a].empty());
+  EXPECT_EQ(allocator.node_to_send_events_[b].size(), 1);
+}
+
+///
+/// Stream0    Stream1    Stream2
+///   a ------> b ------> c
+///    \_________________/
+///
+TEST_F(UtestStreamAllocator, optimize_events_through_other_stream) {
+  const auto &graph = std::make_shared<ComputeGraph>("optimize_events_through_other_stream_graph");
+  const auto &a = add_node(graph, "a", 0);
+  const auto &b = add_node(graph, "b", 1);
+  const auto &c = add_node(graph, "c", 2, 2);
+  GraphUtils::AddEdge(a->GetOutDataAnchor(0), b->GetInDataAnchor(0));
+  GraphUtils::AddEdge(b->GetOutDataAnchor(0), c->GetInDataAnchor(0));
+  GraphUtils::AddEdge(a->GetOutDataAnchor(0), c->GetInDataAnchor(1));
+
+  StreamAllocator allocator(graph, Graph2SubGraphInfoList());
+  EXPECT_EQ(allocator.InsertSyncEvents(), SUCCESS);
+  EXPECT_EQ(get_event_num(allocator), 3);
+  EXPECT_EQ(allocator.OptimizeSyncEvents(), SUCCESS);
+  EXPECT_EQ(get_event_num(allocator), 2);
+  EXPECT_EQ(allocator.node_to_send_events_[a].size(), 1);
+  EXPECT_EQ(allocator.node_to_recv_events_[c].size(), 1);
+  check_data_edges_ordered(graph, allocator);
+
+  // stream 1 may run again after being activated, what it knows of stream 0 is not passed on
+  const auto &graph2 = std::make_shared<ComputeGraph>("optimize_events_through_activated_stream_graph");
+  const auto &a2 = add_node(graph2, "a", 0);
+  const auto &b2 = add_node(graph2, "b", 1);
+  const auto &c2 = add_node(graph2, "c", 2, 2);
+  GraphUtils::AddEdge(a2->GetOutDataAnchor(0), b2->GetInDataAnchor(0));
+  GraphUtils::AddEdge(b2->GetOutDataAnchor(0), c2->GetInDataAnchor(0));
+  GraphUtils::AddEdge(a2->GetOutDataAnchor(0), c2->GetInDataAnchor(1));
+
+  StreamAllocator allocator2(graph2, Graph2SubGraphInfoList());
+  allocator2.specific_activated_streams_.emplace(1);
+  EXPECT_EQ(allocator2.InsertSyncEvents(), SUCCESS);
+  EXPECT_EQ(allocator2.OptimizeSyncEvents(), SUCCESS);
+  EXPECT_EQ(get_event_num(allocator2), 3);
+}
+
+TEST_F(UtestStreamAllocator, optimize_events_keep_order) {
+  const auto &graph = std::make_shared<ComputeGraph>("optimize_events_keep_order_graph");
+  make_graph_layers(graph, 16, 12);
+  StreamAllocator allocator(graph, Graph2SubGraphInfoList());
+  EXPECT_EQ(allocator.InsertSyncEvents(), SUCCESS);
+  const size_t event_num = get_event_num(allocator);
+  EXPECT_EQ(allocator.OptimizeSyncEvents(), SUCCESS);
+  EXPECT_LT(get_event_num(allocator), event_num);
+  check_data_edges_ordered(graph, allocator);
+}
 }
@@ -24,6 +24,7 @@
 #include "common/profiling/profiling_manager.h"
 #include "graph/load/model_manager/davinci_model.h"
 #include "graph/manager/graph_var_manager.h"
+#include "graph/ge_local_context.h"
 
 using namespace std;
 
@@ -40,6 +41,15 @@ class DModelListener : public ModelListener {
 
 shared_ptr<ModelListener> g_local_call_back(new DModelListener());
 
+class StagingListener : public ModelListener {
+ public:
+  uint32_t OnComputeDone(uint32_t model_id, uint32_t data_index, uint32_t result, vector<ge::Tensor> &outputs) {
+    results[data_index] = result;
+    return 0;
+  }
+  map<uint32_t, uint32_t> results;
+};
+
 class UtestDavinciModel : public testing::Test {
  protected:
   void SetUp() {}
@@ -1203,4 +1213,103 @@ TEST_F(UtestDavinciModel, init_kernel_name) {
   AttrUtils::SetStr(op_desc, attr_kernel_name, kernel_name);
   EXPECT_EQ(model.InitKernelName(op_desc, is_ffts, 0, kernel_name), SUCCESS);
 }
+
+TEST_F(UtestDavinciModel, input_staging_overlap_next_request) {
+  DavinciModel model(0, nullptr);
+  ZeroCopyOffset zero_copy_offset;
+  zero_copy_offset.data_size_ = 64;
+  model.input_data_info_[0] = zero_copy_offset;
+
+  // staging is off by default
+  EXPECT_EQ(model.InitInputStaging(), SUCCESS);
+  EXPECT_EQ(model.input_staging_depth_, 0);
+
+  GetThreadLocalContext().SetGlobalOption({{OPTION_EXEC_INPUT_STAGING_DEPTH, "2"}});
+  EXPECT_EQ(model.InitInputStaging(), SUCCESS);
+  GetThreadLocalContext().SetGlobalOption({});
+  EXPECT_EQ(model.input_staging_depth_, 2);
+  EXPECT_EQ(model.input_staging_slots_.size(), 2);
+
+  model.data_inputer_ = new (std::nothrow) DataInputer();
+  vector<uint8_t> host_data(64);
+  OutputData output_data;
+  for (uint32_t i = 0; i < 2; ++i) {
+    InputData input_data;
+    input_data.index = i;
+    input_data.blobs.push_back(DataBuffer(host_data.data(), host_data.size(), false));
+    auto data_wrapper = make_shared<InputDataWrapper>();
+    EXPECT_EQ(data_wrapper->Init(input_data, output_data), SUCCESS);
+    EXPECT_EQ(model.data_inputer_->Push(data_wrapper), SUCCESS);
+  }
+
+  shared_ptr<InputDataWrapper> data_wrapper;
+  Status staged_ret = FAILED;
+  EXPECT_EQ(model.PopInputData(data_wrapper, staged_ret), SUCCESS);
+  EXPECT_EQ(staged_ret, SUCCESS);
+  EXPECT_EQ(data_wrapper->GetInput().index, 0);
+  EXPECT_EQ(model.cur_staging_slot_, 0);
+  EXPECT_EQ(model.CopyStagedInputData(data_wrapper->GetInput()), SUCCESS);
+
+  // the second request is staged into the spare slot while the first one runs
+  model.StageNextInputData();
+  EXPECT_EQ(model.staged_inputs_.size(), 1);
+  EXPECT_EQ(model.data_inputer_->TryPop(data_wrapper), false);
+  EXPECT_EQ(model.PopInputData(data_wrapper, staged_ret), SUCCESS);
+  EXPECT_EQ(data_wrapper->GetInput().index, 1);
+  EXPECT_EQ(model.cur_staging_slot_, 1);
+
+  // a request staged but not run gets an error when the model stops
+  InputData input_data;
+  input_data.index = 2;
+  input_data.blobs.push_back(DataBuffer(host_data.data(), host_data.size(), false));
+  auto staged_wrapper = make_shared<InputDataWrapper>();
+  EXPECT_EQ(staged_wrapper->Init(input_data, output_data), SUCCESS);
+  EXPECT_EQ(model.data_inputer_->Push(staged_wrapper), SUCCESS);
+  model.StageNextInputData();
+  EXPECT_EQ(model.staged_inputs_.size(), 1);
+  auto listener = make_shared<StagingListener>();
+  model.listener_ = listener;
+
+  model.FreeInputStaging();
+  EXPECT_EQ(model.input_staging_depth_, 0);
+  EXPECT_TRUE(model.input_staging_slots_.empty());
+  EXPECT_TRUE(model.staged_inputs_.empty());
+  ASSERT_EQ(listener->results.size(), 1);
+  EXPECT_EQ(listener->results[2], INTERNAL_ERROR);
+}
+
+TEST_F(UtestDavinciModel, update_io_task_args_by_patch_table) {
+  DavinciModel model(0, nullptr);
+  void *virtual_addr = reinterpret_cast<void *>(0x1000);
+  ZeroCopyOffset zero_copy_offset;
+  zero_copy_offset.data_count_ = 1;
+  zero_copy_offset.data_info_ = {{64, virtual_addr}};
+  zero_copy_offset.relative_offset_ = {0};
+  zero_copy_offset.data_size_ = 64;
+  model.input_data_info_[0] = zero_copy_offset;
+
+  vector<uint8_t> args(16);
+  const vector<string> batch_labels = {"Batch_default", "Batch_0", "Batch_1"};
+  for (const auto &batch_label : batch_labels) {
+    ZeroCopyTask task("add_" + batch_label, args.data(), args.size());
+    EXPECT_EQ(task.SetTaskArgsOffset(reinterpret_cast<uintptr_t>(virtual_addr), 8), SUCCESS);
+    task.SetOriginalArgs(args.data(), args.size());
+    task.SetBatchLabel(batch_label);
+    model.zero_copy_tasks_.emplace_back(task);
+  }
+
+  vector<uint8_t> user_data(64);
+  vector<DataBuffer> blobs = {DataBuffer(user_data.data(), user_data.size(), false)};
+  EXPECT_EQ(model.UpdateIoTaskArgs(model.input_data_info_, true, blobs, false, "Batch_1"), SUCCESS);
+  EXPECT_TRUE(model.zero_copy_patch_table_ready_);
+  EXPECT_EQ(model.input_patch_table_[0].size(), 3);
+
+  auto patched_addr = [&model](size_t task_index) {
+    return *reinterpret_cast<uintptr_t *>(model.zero_copy_tasks_[task_index].args_info_.data() + 8);
+  };
+  EXPECT_EQ(patched_addr(0), reinterpret_cast<uintptr_t>(user_data.data()));
+  EXPECT_EQ(patched_addr(1), 0);
+  EXPECT_EQ(patched_addr(2), reinterpret_cast<uintptr_t>(user_data.data()));
+  EXPECT_FALSE(model.zero_copy_tasks_[1].is_updated_);
+}
 }  // namespace ge
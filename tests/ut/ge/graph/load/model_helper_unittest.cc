@@ -25,11 +25,27 @@
 #undef private
 #undef protected
 
+#include "graph/utils/graph_utils.h"
 #include "proto/task.pb.h"
 
 using namespace std;
 
 namespace ge {
+namespace {
+GeModelPtr BuildGeModel(const string &name, size_t weight_size) {
+  auto compute_graph = MakeShared<ComputeGraph>(name);
+  auto data_desc = MakeShared<OpDesc>(name + "_data", DATA);
+  data_desc->AddOutputDesc(GeTensorDesc(GeShape({1, 16}), FORMAT_ND, DT_FLOAT));
+  (void)compute_graph->AddNode(data_desc);
+  GeModelPtr ge_model = MakeShared<GeModel>();
+  ge_model->SetGraph(GraphUtils::CreateGraphFromComputeGraph(compute_graph));
+  ge_model->SetName(name);
+  ge_model->SetWeight(Buffer(weight_size, static_cast<uint8_t>(weight_size)));
+  ge_model->SetModelTaskDef(MakeShared<domi::ModelTaskDef>());
+  return ge_model;
+}
+}  // namespace
+
 class UtestModelHelper : public testing::Test {
  protected:
   void SetUp() override {}
@@ -62,4 +78,47 @@ TEST_F(UtestModelHelper, atc_test)
   ModelTool::GetModelInfoFromPbtxt(file_path.c_str(), model_def);
   ModelTool::GetModelInfoFromPbtxt("123.pbtxt", model_def);
 }
+
+TEST_F(UtestModelHelper, load_root_model_in_parallel) {
+  const vector<string> model_names = {"root", "sub_1", "sub_2", "sub_3"};
+  GeRootModelPtr ge_root_model = MakeShared<GeRootModel>();
+  for (size_t i = 0; i < model_names.size(); ++i) {
+    GeModelPtr ge_model = BuildGeModel(model_names[i], (i + 1) * 64);
+    if (i == 0) {
+      ge_root_model->SetRootGraph(GraphUtils::GetComputeGraph(ge_model->GetGraph()));
+    }
+    ge_root_model->SetSubgraphInstanceNameToModel(model_names[i], ge_model);
+  }
+  ModelHelper save_helper;
+  save_helper.SetSaveMode(false);
+  ModelBufferData model_buffer;
+  ASSERT_EQ(save_helper.SaveToOmRootModel(ge_root_model, SaveParam(), "root.om", model_buffer, true), SUCCESS);
+  ModelData model_data;
+  model_data.model_data = model_buffer.data.get();
+  model_data.model_len = model_buffer.length;
+
+  ModelHelper serial_helper;
+  ASSERT_EQ(serial_helper.LoadRootModel(model_data), SUCCESS);
+  ModelHelper parallel_helper;
+  parallel_helper.SetLoadThreadNum(4);
+  ASSERT_EQ(parallel_helper.LoadRootModel(model_data), SUCCESS);
+
+  auto serial_models = serial_helper.GetGeRootModel()->GetSubgraphInstanceNameToModel();
+  auto parallel_models = parallel_helper.GetGeRootModel()->GetSubgraphInstanceNameToModel();
+  EXPECT_EQ(parallel_helper.GetGeRootModel()->GetRootGraph()->GetName(), "root");
+  ASSERT_EQ(parallel_models.size(), model_names.size() - 1);
+  ASSERT_EQ(parallel_models.size(), serial_models.size());
+  for (size_t i = 1; i < model_names.size(); ++i) {
+    ASSERT_EQ(parallel_models.count(model_names[i]), 1);
+    EXPECT_EQ(parallel_models[model_names[i]]->GetWeight().GetSize(), (i + 1) * 64);
+    EXPECT_EQ(parallel_models[model_names[i]]->GetWeight().GetSize(),
+              serial_models[model_names[i]]->GetWeight().GetSize());
+    EXPECT_NE(parallel_models[model_names[i]]->GetModelTaskDefPtr(), nullptr);
+  }
+
+  const auto &load_cost = parallel_helper.GetPartitionLoadCost();
+  for (const auto &partition : {"model_def", "weights", "task", "tbe_kernels", "cust_aicpu_kernels", "total"}) {
+    EXPECT_EQ(load_cost.count(partition), 1);
+  }
+}
 }  // namespace ge
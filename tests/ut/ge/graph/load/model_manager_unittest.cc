@@ -28,6 +28,7 @@
 #include "graph/load/model_manager/davinci_model.h"
 #include "graph/ops_stub.h"
 #include "common/profiling/profiling_manager.h"
+#include "graph/manager/graph_mem_manager.h"
 
 using namespace std;
 using namespace testing;
@@ -455,4 +456,57 @@ TEST_F(UtestModelManagerModelManager, command_profiling) {
   Status ret = manager.HandleProfModelUnsubscribeCommand(cmd);
   profiling_manager.CleanSubscribeInfo();
 }
+TEST_F(UtestModelManagerModelManager, share_weights_of_same_content) {
+  ModelManager mm;
+  std::vector<rtMemType_t> mem_type{RT_MEMORY_HBM};
+  EXPECT_EQ(MemManager::Instance().Initialize(mem_type), SUCCESS);
+  std::vector<uint8_t> data(1027U, 1U);
+  Buffer weights(data.size());
+  (void)memcpy(weights.GetData(), data.data(), data.size());
+  Buffer same_weights(data.size());
+  (void)memcpy(same_weights.GetData(), data.data(), data.size());
+  data[1026U] = 2U;
+  Buffer other_weights(data.size());
+  (void)memcpy(other_weights.GetData(), data.data(), data.size());
+
+  std::string key;
+  uint8_t *addr = nullptr;
+  ASSERT_EQ(mm.AcquireSharedWeights(0U, weights, key, addr), SUCCESS);
+  ASSERT_NE(addr, nullptr);
+  std::string same_key;
+  uint8_t *same_addr = nullptr;
+  ASSERT_EQ(mm.AcquireSharedWeights(0U, same_weights, same_key, same_addr), SUCCESS);
+  EXPECT_EQ(same_key, key);
+  EXPECT_EQ(same_addr, addr);
+  EXPECT_EQ(mm.shared_weights_[key].ref_count, 2U);
+
+  // different content or device is not shared
+  std::string other_key;
+  uint8_t *other_addr = nullptr;
+  ASSERT_EQ(mm.AcquireSharedWeights(0U, other_weights, other_key, other_addr), SUCCESS);
+  EXPECT_NE(other_key, key);
+  std::string device_key;
+  uint8_t *device_addr = nullptr;
+  ASSERT_EQ(mm.AcquireSharedWeights(1U, weights, device_key, device_addr), SUCCESS);
+  EXPECT_NE(device_key, key);
+  EXPECT_EQ(mm.shared_weights_.size(), 3U);
+
+  // weights of the same hash but another content are not shared
+  mm.shared_weights_[key].addr[0U] = 3U;
+  std::string collided_key;
+  uint8_t *collided_addr = nullptr;
+  ASSERT_EQ(mm.AcquireSharedWeights(0U, same_weights, collided_key, collided_addr), SUCCESS);
+  EXPECT_TRUE(collided_key.empty());
+  EXPECT_EQ(collided_addr, nullptr);
+  EXPECT_EQ(mm.shared_weights_[key].ref_count, 2U);
+
+  mm.ReleaseSharedWeights(key);
+  EXPECT_EQ(mm.shared_weights_[key].ref_count, 1U);
+  mm.ReleaseSharedWeights(same_key);
+  EXPECT_EQ(mm.shared_weights_.count(key), 0U);
+  mm.ReleaseSharedWeights(other_key);
+  mm.ReleaseSharedWeights(device_key);
+  EXPECT_TRUE(mm.shared_weights_.empty());
+  MemManager::Instance().Finalize();
+}
 }  // namespace ge
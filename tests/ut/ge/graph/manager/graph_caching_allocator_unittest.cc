@@ -20,7 +20,9 @@
 
 #include "graph/anchor.h"
 #include "graph/attr_value.h"
+#include "external/ge/ge_api_types.h"
 #include "graph/debug/ge_attr_define.h"
+#include "graph/ge_local_context.h"
 #include "graph/utils/graph_utils.h"
 #include "graph/utils/node_utils.h"
 #include "graph/utils/op_desc_utils.h"
@@ -103,3 +105,52 @@ TEST_F(UtestGraphCachingAllocatorTest, malloc_statics) {
   MemManager::Instance().CachingInstance(RT_MEMORY_HBM).FreeCachedBlocks();
   MemManager::Instance().Finalize();
 }
+
+TEST_F(UtestGraphCachingAllocatorTest, slabs_disabled_by_default) {
+  std::vector<rtMemType_t> mem_type;
+  mem_type.push_back(RT_MEMORY_HBM);
+  EXPECT_EQ(MemManager::Instance().Initialize(mem_type), SUCCESS);
+  CachingAllocator &allocator = MemManager::Instance().CachingInstance(RT_MEMORY_HBM);
+  EXPECT_EQ(allocator.slab_allocator_, nullptr);
+  uint8_t *ptr = allocator.Malloc(kKByteSize);
+  EXPECT_NE(nullptr, ptr);
+  EXPECT_EQ(allocator.allocated_blocks_.count(ptr), 1);
+  EXPECT_EQ(allocator.Free(ptr), SUCCESS);
+  MemManager::Instance().Finalize();
+}
+
+TEST_F(UtestGraphCachingAllocatorTest, malloc_small_from_slabs) {
+  ge::GetThreadLocalContext().SetGraphOption({{OPTION_EXEC_SLAB_ALLOC_THRESHOLD, "65536"}});
+  std::vector<rtMemType_t> mem_type;
+  mem_type.push_back(RT_MEMORY_HBM);
+  EXPECT_EQ(MemManager::Instance().Initialize(mem_type), SUCCESS);
+  ge::GetThreadLocalContext().SetGraphOption({});
+  CachingAllocator &allocator = MemManager::Instance().CachingInstance(RT_MEMORY_HBM);
+  ASSERT_NE(allocator.slab_allocator_, nullptr);
+  uint8_t *ptr = allocator.Malloc(kKByteSize);
+  EXPECT_NE(nullptr, ptr);
+  uint8_t *ptr1 = allocator.Malloc(kKByteSize);
+  EXPECT_NE(nullptr, ptr1);
+  // both come from one slab, which is a single allocated block
+  EXPECT_EQ(allocator.allocated_blocks_.size(), 1);
+  EXPECT_EQ(allocator.allocated_blocks_.count(ptr), 0);
+  EXPECT_EQ(allocator.slab_allocator_->GetHitCount(), 1);
+  uint8_t *ptr2 = allocator.Malloc(kMByteSize);
+  EXPECT_NE(nullptr, ptr2);
+  EXPECT_EQ(allocator.allocated_blocks_.count(ptr2), 1);
+  // a reuse address is tried in the block bins
+  uint8_t *ptr3 = allocator.Malloc(kKByteSize, ptr2);
+  EXPECT_NE(nullptr, ptr3);
+  EXPECT_EQ(allocator.allocated_blocks_.count(ptr3), 1);
+  EXPECT_EQ(allocator.Free(ptr3), SUCCESS);
+
+  EXPECT_EQ(allocator.Free(ptr), SUCCESS);
+  allocator.TryFreeBlocks();
+  EXPECT_EQ(allocator.allocated_blocks_.size(), 2);
+  EXPECT_EQ(allocator.Free(ptr1), SUCCESS);
+  EXPECT_EQ(allocator.Free(ptr2), SUCCESS);
+  allocator.TryFreeBlocks();
+  EXPECT_TRUE(allocator.allocated_blocks_.empty());
+  EXPECT_EQ(allocator.Free(ptr1), PARAM_INVALID);
+  MemManager::Instance().Finalize();
+}
@@ -0,0 +1,150 @@
+/**
+* Copyright 2021, 2022 LuoJiaNET Research and Development Group, Wuhan University
+* Copyright 2021, 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+#include <fstream>
+#include <memory>
+
+#include "framework/common/types.h"
+#include "graph/utils/graph_utils.h"
+#include "mmpa/mmpa_api.h"
+
+#define protected public
+#define private public
+#include "graph/manager/graph_compile_cache.h"
+#undef protected
+#undef private
+
+using namespace std;
+
+namespace ge {
+namespace {
+const char *const kCachePath = "./ut_graph_compile_cache";
+
+ComputeGraphPtr BuildGraph(const string &data_type) {
+  auto graph = make_shared<ComputeGraph>("compile_cache_graph");
+  GeTensorDesc tensor_desc(GeShape({1, 3, 16, 16}), FORMAT_NCHW, DT_FLOAT);
+  auto data_desc = make_shared<OpDesc>("data", data_type);
+  data_desc->AddOutputDesc(tensor_desc);
+  auto relu_desc = make_shared<OpDesc>("relu", RELU);
+  relu_desc->AddInputDesc(tensor_desc);
+  relu_desc->AddOutputDesc(tensor_desc);
+  auto data_node = graph->AddNode(data_desc);
+  auto relu_node = graph->AddNode(relu_desc);
+  (void)GraphUtils::AddEdge(data_node->GetOutDataAnchor(0), relu_node->GetInDataAnchor(0));
+  return graph;
+}
+}  // namespace
+
+class UtestGraphCompileCache : public testing::Test {
+ protected:
+  void SetUp() {}
+  void TearDown() {}
+};
+
+TEST_F(UtestGraphCompileCache, disabled_by_default) {
+  GraphCompileCache cache;
+  EXPECT_EQ(cache.Initialize({}), SUCCESS);
+  EXPECT_FALSE(cache.IsEnabled());
+  EXPECT_FALSE(cache.IsGraphCacheable(BuildGraph(DATA)));
+}
+
+TEST_F(UtestGraphCompileCache, key_depends_on_graph_inputs_and_options) {
+  GraphCompileCache cache;
+  map<string, string> cache_options = {{OPTION_EXEC_ENABLE_INCRE_BUILD, "1"},
+                                       {OPTION_EXEC_INCRE_BUILD_CACHE_PATH, kCachePath}};
+  EXPECT_EQ(cache.Initialize(cache_options), SUCCESS);
+  EXPECT_TRUE(cache.IsEnabled());
+  EXPECT_TRUE(cache.IsGraphCacheable(BuildGraph(DATA)));
+  EXPECT_FALSE(cache.IsGraphCacheable(BuildGraph(VARIABLE)));
+
+  vector<GeTensor> inputs = {GeTensor(GeTensorDesc(GeShape({1, 3, 16, 16}), FORMAT_NCHW, DT_FLOAT))};
+  map<string, string> options = {{OPTION_EXEC_SESSION_ID, "1"}, {"ge.exec.precision_mode", "force_fp16"}};
+  const string key = cache.GenerateKey(BuildGraph(DATA), inputs, options);
+  EXPECT_EQ(cache.GenerateKey(BuildGraph(DATA), inputs, options), key);
+
+  // session id differs from process to process and does not change the model
+  options[OPTION_EXEC_SESSION_ID] = "2";
+  EXPECT_EQ(cache.GenerateKey(BuildGraph(DATA), inputs, options), key);
+
+  options["ge.exec.precision_mode"] = "allow_fp32_to_fp16";
+  EXPECT_NE(cache.GenerateKey(BuildGraph(DATA), inputs, options), key);
+  options["ge.exec.precision_mode"] = "force_fp16";
+
+  vector<GeTensor> other_inputs = {GeTensor(GeTensorDesc(GeShape({2, 3, 16, 16}), FORMAT_NCHW, DT_FLOAT))};
+  EXPECT_NE(cache.GenerateKey(BuildGraph(DATA), other_inputs, options), key);
+
+  auto graph = BuildGraph(DATA);
+  (void)AttrUtils::SetInt(graph->FindNode("relu")->GetOpDesc(), "alpha", 1);
+  EXPECT_NE(cache.GenerateKey(graph, inputs, options), key);
+}
+
+TEST_F(UtestGraphCompileCache, load_miss_and_invalidate) {
+  GraphCompileCache cache;
+  map<string, string> cache_options = {{OPTION_EXEC_ENABLE_INCRE_BUILD, "true"},
+                                       {OPTION_EXEC_INCRE_BUILD_CACHE_PATH, kCachePath}};
+  EXPECT_EQ(cache.Initialize(cache_options), SUCCESS);
+  const string key = cache.GenerateKey(BuildGraph(DATA), {}, {});
+
+  GeRootModelPtr ge_root_model;
+  EXPECT_EQ(cache.Load(key, 0, ge_root_model), SUCCESS);
+  EXPECT_EQ(ge_root_model, nullptr);
+  EXPECT_EQ(cache.GetMissCount(), 1);
+
+  // a broken file is removed and rebuilt instead of failing the run
+  const string cache_file = cache.GetCacheFile(key);
+  const string key_file = cache.GetKeyFile(key);
+  {
+    ofstream broken(cache_file, ios::binary);
+    broken << "not an om file";
+    ofstream key_stream(key_file, ios::binary);
+    key_stream << key;
+  }
+  EXPECT_EQ(cache.Load(key, 0, ge_root_model), SUCCESS);
+  EXPECT_EQ(ge_root_model, nullptr);
+  EXPECT_EQ(cache.GetInvalidCount(), 1);
+  EXPECT_EQ(cache.GetMissCount(), 2);
+  EXPECT_EQ(cache.GetHitCount(), 0);
+  EXPECT_NE(mmAccess2(cache_file.c_str(), M_F_OK), EN_OK);
+  EXPECT_NE(mmAccess2(key_file.c_str(), M_F_OK), EN_OK);
+}
+
+TEST_F(UtestGraphCompileCache, load_with_other_key) {
+  GraphCompileCache cache;
+  map<string, string> cache_options = {{OPTION_EXEC_ENABLE_INCRE_BUILD, "1"},
+                                       {OPTION_EXEC_INCRE_BUILD_CACHE_PATH, kCachePath}};
+  EXPECT_EQ(cache.Initialize(cache_options), SUCCESS);
+  const string key = cache.GenerateKey(BuildGraph(DATA), {}, {});
+  EXPECT_NE(key.find("packages:"), string::npos);
+
+  // same file name, different full key, as with a hash collision or another GE version
+  const string cache_file = cache.GetCacheFile(key);
+  const string key_file = cache.GetKeyFile(key);
+  {
+    ofstream model_stream(cache_file, ios::binary);
+    model_stream << "om of another graph";
+    ofstream key_stream(key_file, ios::binary);
+    key_stream << key << "other";
+  }
+  GeRootModelPtr ge_root_model;
+  EXPECT_EQ(cache.Load(key, 0, ge_root_model), SUCCESS);
+  EXPECT_EQ(ge_root_model, nullptr);
+  EXPECT_EQ(cache.GetInvalidCount(), 1);
+  EXPECT_EQ(cache.GetMissCount(), 1);
+  EXPECT_NE(mmAccess2(cache_file.c_str(), M_F_OK), EN_OK);
+}
+}  // namespace ge
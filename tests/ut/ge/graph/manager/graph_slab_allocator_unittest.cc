@@ -0,0 +1,195 @@
+/**
+* Copyright 2021, 2022 LuoJiaNET Research and Development Group, Wuhan University
+* Copyright 2021, 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+#include <atomic>
+#include <cstdlib>
+#include <memory>
+#include <set>
+#include <thread>
+#include <vector>
+
+#include "graph/manager/graph_slab_allocator.h"
+
+using namespace std;
+
+namespace ge {
+namespace {
+const size_t kThreshold = 65536;
+
+unique_ptr<SlabAllocator> CreateAllocator(size_t threshold, atomic<int64_t> &chunk_count) {
+  auto chunk_malloc = [&chunk_count](size_t size) {
+    chunk_count++;
+    return static_cast<uint8_t *>(malloc(size));
+  };
+  auto chunk_free = [&chunk_count](uint8_t *ptr) {
+    chunk_count--;
+    free(ptr);
+  };
+  return unique_ptr<SlabAllocator>(new SlabAllocator(threshold, chunk_malloc, chunk_free));
+}
+}  // namespace
+
+class UtestGraphSlabAllocator : public testing::Test {
+ protected:
+  void SetUp() {}
+  void TearDown() {}
+};
+
+TEST_F(UtestGraphSlabAllocator, malloc_and_reuse) {
+  atomic<int64_t> chunk_count(0);
+  auto allocator = CreateAllocator(kThreshold, chunk_count);
+  EXPECT_FALSE(allocator->IsSlabSize(0));
+  EXPECT_TRUE(allocator->IsSlabSize(kThreshold));
+  EXPECT_FALSE(allocator->IsSlabSize(kThreshold + 1));
+  EXPECT_EQ(allocator->Malloc(kThreshold + 1), nullptr);
+
+  uint8_t *ptr = allocator->Malloc(100);
+  ASSERT_NE(ptr, nullptr);
+  EXPECT_EQ(allocator->GetMissCount(), 1);
+  EXPECT_EQ(allocator->GetUsingBytes(), 512);
+  EXPECT_EQ(chunk_count, 1);
+  uint8_t *ptr1 = allocator->Malloc(512);
+  ASSERT_NE(ptr1, nullptr);
+  EXPECT_NE(ptr1, ptr);
+  EXPECT_EQ(allocator->GetHitCount(), 1);
+
+  EXPECT_TRUE(allocator->Free(ptr));
+  EXPECT_EQ(allocator->Malloc(300), ptr);
+  EXPECT_EQ(allocator->GetHitCount(), 2);
+  EXPECT_EQ(chunk_count, 1);
+
+  // inside of a slab but not an object, or not from a slab at all
+  EXPECT_FALSE(allocator->Free(ptr + 1));
+  uint8_t other = 0;
+  EXPECT_FALSE(allocator->Free(&other));
+  EXPECT_FALSE(allocator->Free(nullptr));
+
+  EXPECT_TRUE(allocator->Free(ptr));
+  EXPECT_TRUE(allocator->Free(ptr1));
+  EXPECT_EQ(allocator->GetUsingBytes(), 0);
+  allocator->PrintStatics();
+}
+
+TEST_F(UtestGraphSlabAllocator, size_classes) {
+  atomic<int64_t> chunk_count(0);
+  auto allocator = CreateAllocator(kThreshold, chunk_count);
+  // 1536 and 3072 are classes, a 1025 byte object takes 1536
+  uint8_t *ptr = allocator->Malloc(1025);
+  ASSERT_NE(ptr, nullptr);
+  EXPECT_EQ(allocator->GetUsingBytes(), 1536);
+  uint8_t *ptr1 = allocator->Malloc(1025);
+  EXPECT_EQ(ptr1, ptr + 1536);
+  uint8_t *ptr2 = allocator->Malloc(2049);
+  ASSERT_NE(ptr2, nullptr);
+  EXPECT_EQ(allocator->GetUsingBytes(), 1536 * 2 + 3072);
+  EXPECT_EQ(chunk_count, 2);
+  EXPECT_TRUE(allocator->Free(ptr));
+  EXPECT_TRUE(allocator->Free(ptr1));
+  EXPECT_TRUE(allocator->Free(ptr2));
+
+  // the threshold is capped
+  auto big_allocator = CreateAllocator(kMaxSlabThreshold * 2, chunk_count);
+  EXPECT_TRUE(big_allocator->IsSlabSize(kMaxSlabThreshold));
+  EXPECT_FALSE(big_allocator->IsSlabSize(kMaxSlabThreshold + 1));
+}
+
+TEST_F(UtestGraphSlabAllocator, release_when_not_in_use) {
+  atomic<int64_t> chunk_count(0);
+  auto allocator = CreateAllocator(kThreshold, chunk_count);
+  EXPECT_FALSE(allocator->TryRelease());
+  uint8_t *ptr = allocator->Malloc(4096);
+  uint8_t *ptr1 = allocator->Malloc(kThreshold);
+  ASSERT_NE(ptr, nullptr);
+  ASSERT_NE(ptr1, nullptr);
+  EXPECT_EQ(chunk_count, 2);
+  EXPECT_FALSE(allocator->TryRelease());
+  EXPECT_TRUE(allocator->Free(ptr));
+  EXPECT_FALSE(allocator->TryRelease());
+  EXPECT_TRUE(allocator->Free(ptr1));
+  EXPECT_TRUE(allocator->TryRelease());
+  EXPECT_EQ(chunk_count, 0);
+  EXPECT_EQ(allocator->GetSlabBytes(), 0);
+
+  // objects cached by the thread belonged to the released slabs
+  EXPECT_FALSE(allocator->Free(ptr));
+  ptr = allocator->Malloc(4096);
+  ASSERT_NE(ptr, nullptr);
+  EXPECT_EQ(chunk_count, 1);
+  allocator.reset();
+  EXPECT_EQ(chunk_count, 0);
+}
+
+TEST_F(UtestGraphSlabAllocator, malloc_and_free_in_threads) {
+  atomic<int64_t> chunk_count(0);
+  auto allocator = CreateAllocator(kThreshold, chunk_count);
+  const size_t thread_num = 4;
+  const size_t object_num = 2000;
+  vector<vector<uint8_t *>> objects(thread_num);
+  vector<thread> threads;
+  for (size_t i = 0; i < thread_num; ++i) {
+    threads.emplace_back([&allocator, &objects, i]() {
+      for (size_t j = 0; j < object_num; ++j) {
+        size_t size = (j * 97 + i) % kThreshold + 1;
+        uint8_t *ptr = allocator->Malloc(size);
+        if (ptr != nullptr) {
+          ptr[0] = static_cast<uint8_t>(i);
+          ptr[size - 1] = static_cast<uint8_t>(j);
+        }
+        objects[i].emplace_back(ptr);
+      }
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  set<uint8_t *> addrs;
+  for (const auto &thread_objects : objects) {
+    for (auto ptr : thread_objects) {
+      ASSERT_NE(ptr, nullptr);
+      addrs.insert(ptr);
+    }
+  }
+  EXPECT_EQ(addrs.size(), thread_num * object_num);
+
+  // free by other threads than the ones malloced, objects cached by exited threads go back to the classes
+  threads.clear();
+  for (size_t i = 0; i < thread_num; ++i) {
+    threads.emplace_back([&allocator, &objects, i]() {
+      for (auto ptr : objects[(i + 1) % thread_num]) {
+        EXPECT_TRUE(allocator->Free(ptr));
+      }
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  EXPECT_EQ(allocator->GetUsingBytes(), 0);
+  EXPECT_EQ(allocator->GetHitCount() + allocator->GetMissCount(), thread_num * object_num);
+  allocator->PrintStatics();
+
+  const int64_t slab_num = chunk_count;
+  for (size_t i = 0; i < object_num; ++i) {
+    uint8_t *ptr = allocator->Malloc(i % kThreshold + 1);
+    ASSERT_NE(ptr, nullptr);
+    EXPECT_TRUE(allocator->Free(ptr));
+  }
+  EXPECT_EQ(chunk_count, slab_num);
+  EXPECT_TRUE(allocator->TryRelease());
+  EXPECT_EQ(chunk_count, 0);
+}
+}  // namespace ge
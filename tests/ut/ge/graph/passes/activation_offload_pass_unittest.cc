@@ -0,0 +1,197 @@
+/**
+* Copyright 2021, 2022 LuoJiaNET Research and Development Group, Wuhan University
+* Copyright 2021, 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+
+#include "external/ge/ge_api_types.h"
+#include "framework/common/types.h"
+#include "graph/build/memory/block_mem_assigner.h"
+#include "graph/build/memory/hybrid_mem_assigner.h"
+#include "graph/debug/ge_attr_define.h"
+#include "graph/ge_local_context.h"
+#include "graph/passes/activation_offload_pass.h"
+#include "graph/utils/attr_utils.h"
+#include "graph/utils/tensor_utils.h"
+#include "graph_builder_utils.h"
+
+namespace ge {
+namespace {
+const char *const kHeavy = "Heavy";
+const std::vector<int64_t> kSmallShape = {1, 1, 32, 32};
+const std::vector<int64_t> kLargeShape = {1, 1, 64, 64};
+const size_t kChainLength = 9U;
+
+///                                                  netoutput
+///                                                      |
+/// data -> act -> n1 -> ... -> n5 -> ... -> n9 ------> q
+///           \_____________________________________/
+/// output of act is large and used by n1 and q, output of n5 is large too
+ComputeGraphPtr BuildGraph() {
+  auto builder = ut::GraphBuilder("test");
+  auto data = builder.AddNode("data", DATA, 0, 1, FORMAT_NCHW, DT_FLOAT, kLargeShape);
+  auto act = builder.AddNode("act", kHeavy, 1, 1, FORMAT_NCHW, DT_FLOAT, kLargeShape);
+  builder.AddDataEdge(data, 0, act, 0);
+  auto prev = act;
+  for (size_t i = 1; i <= kChainLength; ++i) {
+    auto shape = (i == kChainLength / 2 + 1) ? kLargeShape : kSmallShape;
+    auto node = builder.AddNode("n" + std::to_string(i), kHeavy, 1, 1, FORMAT_NCHW, DT_FLOAT, shape);
+    builder.AddDataEdge(prev, 0, node, 0);
+    prev = node;
+  }
+  auto q = builder.AddNode("q", kHeavy, 2, 1, FORMAT_NCHW, DT_FLOAT, kSmallShape);
+  auto netoutput = builder.AddNode("netoutput", NETOUTPUT, 1, 0, FORMAT_NCHW, DT_FLOAT, kSmallShape);
+  builder.AddDataEdge(prev, 0, q, 0);
+  builder.AddDataEdge(act, 0, q, 1);
+  builder.AddDataEdge(q, 0, netoutput, 0);
+  return builder.GetGraph();
+}
+
+// sizes and ids are set by the builder before memory is assigned
+void PrepareForMemAssign(const ComputeGraphPtr &graph) {
+  int64_t id = 0;
+  for (const auto &node : graph->GetAllNodes()) {
+    const auto &op_desc = node->GetOpDesc();
+    op_desc->SetId(id++);
+    for (size_t i = 0; i < op_desc->GetInputsSize(); ++i) {
+      auto desc = op_desc->MutableInputDesc(static_cast<uint32_t>(i));
+      TensorUtils::SetSize(*desc, desc->GetShape().GetShapeSize() * static_cast<int64_t>(sizeof(float)));
+    }
+    for (size_t i = 0; i < op_desc->GetOutputsSize(); ++i) {
+      auto desc = op_desc->MutableOutputDesc(static_cast<uint32_t>(i));
+      TensorUtils::SetSize(*desc, desc->GetShape().GetShapeSize() * static_cast<int64_t>(sizeof(float)));
+    }
+  }
+}
+
+size_t AssignHbmSize(const ComputeGraphPtr &graph) {
+  HybridMemAssigner assigner(graph);
+  EXPECT_EQ(assigner.Assign(), SUCCESS);
+  auto iter = assigner.GetMemOffsets().find(RT_MEMORY_HBM);
+  return (iter == assigner.GetMemOffsets().end()) ? 0U : iter->second;
+}
+}  // namespace
+
+class UtestActivationOffloadPass : public testing::Test {
+ protected:
+  void SetUp() {}
+  void TearDown() {
+    GetThreadLocalContext().SetGraphOption({});
+  }
+};
+
+TEST_F(UtestActivationOffloadPass, swap_out_long_idle_output) {
+  auto graph = BuildGraph();
+  GetThreadLocalContext().SetGraphOption({{MEMORY_ACTIVATION_OFFLOAD, "1"},
+                                          {MEMORY_ACTIVATION_OFFLOAD_MIN_GAP, "8"},
+                                          {MEMORY_ACTIVATION_OFFLOAD_MIN_SIZE, "0"}});
+  ActivationOffloadPass pass;
+  EXPECT_EQ(pass.Run(graph), SUCCESS);
+  EXPECT_EQ(pass.GetOffloadNum(), 1U);
+  EXPECT_LT(pass.GetPeakAfter(), pass.GetPeakBefore());
+  EXPECT_EQ(pass.GetCopySize(), 2 * 64 * 64 * static_cast<int64_t>(sizeof(float)));
+
+  auto act = graph->FindNode("act");
+  auto q = graph->FindNode("q");
+  ASSERT_NE(act, nullptr);
+  ASSERT_NE(q, nullptr);
+  auto swap_in = q->GetInDataAnchor(1)->GetPeerOutAnchor()->GetOwnerNode();
+  EXPECT_EQ(swap_in->GetType(), MEMCPYASYNC);
+  auto swap_out = swap_in->GetInDataAnchor(0)->GetPeerOutAnchor()->GetOwnerNode();
+  EXPECT_EQ(swap_out->GetType(), MEMCPYASYNC);
+  EXPECT_EQ(swap_out->GetInDataAnchor(0)->GetPeerOutAnchor()->GetOwnerNode(), act);
+  ASSERT_EQ(act->GetOutDataNodes().size(), 2U);
+
+  // copied out after the early use, copied back a quarter of the minimum gap, 2 nodes, ahead of the late use
+  ASSERT_EQ(swap_out->GetInControlNodes().size(), 1U);
+  EXPECT_EQ(swap_out->GetInControlNodes().at(0)->GetName(), "n1");
+  ASSERT_EQ(swap_in->GetInControlNodes().size(), 1U);
+  EXPECT_EQ(swap_in->GetInControlNodes().at(0)->GetName(), "n7");
+
+  std::vector<int64_t> mem_types;
+  EXPECT_TRUE(AttrUtils::GetListInt(swap_out->GetOpDesc(), ATTR_NAME_OUTPUT_MEM_TYPE_LIST, mem_types));
+  EXPECT_EQ(mem_types, std::vector<int64_t>({static_cast<int64_t>(kHostSwapMemory | RT_MEMORY_HBM)}));
+  EXPECT_TRUE(AttrUtils::GetListInt(swap_in->GetOpDesc(), ATTR_NAME_INPUT_MEM_TYPE_LIST, mem_types));
+  EXPECT_EQ(mem_types, std::vector<int64_t>({static_cast<int64_t>(kHostSwapMemory | RT_MEMORY_HBM)}));
+  // the copies stay on the stream of act and q
+  EXPECT_FALSE(swap_out->GetOpDesc()->HasAttr(ATTR_NAME_PARALLEL_GROUP));
+  EXPECT_FALSE(swap_in->GetOpDesc()->HasAttr(ATTR_NAME_PARALLEL_GROUP));
+  std::string from;
+  EXPECT_TRUE(AttrUtils::GetStr(swap_in->GetOpDesc(), kAttrNameActivationOffloadFrom, from));
+  EXPECT_EQ(from, "act");
+
+  int64_t value = 0;
+  EXPECT_TRUE(AttrUtils::GetInt(graph, kAttrNameActivationOffloadPeakAfter, value));
+  EXPECT_EQ(value, pass.GetPeakAfter());
+  EXPECT_TRUE(AttrUtils::GetInt(graph, kAttrNameActivationOffloadCopySize, value));
+  EXPECT_EQ(value, pass.GetCopySize());
+  EXPECT_GT(pass.GetCopyTimeUs(), 0);
+  EXPECT_TRUE(AttrUtils::GetInt(graph, kAttrNameActivationOffloadCopyTime, value));
+  EXPECT_EQ(value, pass.GetCopyTimeUs());
+}
+
+TEST_F(UtestActivationOffloadPass, lower_assigned_hbm_size) {
+  auto origin_graph = BuildGraph();
+  PrepareForMemAssign(origin_graph);
+  size_t origin_size = AssignHbmSize(origin_graph);
+
+  auto graph = BuildGraph();
+  PrepareForMemAssign(graph);
+  ActivationOffloadPass pass;
+  pass.SetEnabled(true);
+  pass.SetMinSize(0);
+  pass.SetMinGap(8);
+  EXPECT_EQ(pass.Run(graph), SUCCESS);
+  ASSERT_EQ(pass.GetOffloadNum(), 1U);
+  PrepareForMemAssign(graph);
+  size_t offload_size = AssignHbmSize(graph);
+  EXPECT_GT(origin_size, 0U);
+  EXPECT_LT(offload_size, origin_size);
+}
+
+TEST_F(UtestActivationOffloadPass, keep_output_of_short_gap) {
+  auto graph = BuildGraph();
+  ActivationOffloadPass pass;
+  pass.SetEnabled(true);
+  pass.SetMinSize(0);
+  pass.SetMinGap(kChainLength + 1);
+  EXPECT_EQ(pass.Run(graph), SUCCESS);
+  EXPECT_EQ(pass.GetOffloadNum(), 0U);
+  EXPECT_EQ(pass.GetCopySize(), 0);
+  EXPECT_EQ(graph->GetDirectNodesSize(), kChainLength + 4);
+  EXPECT_FALSE(graph->HasAttr(kAttrNameActivationOffloadPeakBefore));
+}
+
+TEST_F(UtestActivationOffloadPass, keep_small_output) {
+  auto graph = BuildGraph();
+  ActivationOffloadPass pass;
+  pass.SetEnabled(true);
+  pass.SetMinGap(1);
+  EXPECT_EQ(pass.Run(graph), SUCCESS);
+  EXPECT_EQ(pass.GetOffloadNum(), 0U);
+  EXPECT_EQ(graph->GetDirectNodesSize(), kChainLength + 4);
+}
+
+TEST_F(UtestActivationOffloadPass, disabled_by_default) {
+  auto graph = BuildGraph();
+  ActivationOffloadPass pass;
+  EXPECT_EQ(pass.Run(graph), SUCCESS);
+  EXPECT_EQ(pass.GetOffloadNum(), 0U);
+  EXPECT_EQ(graph->GetDirectNodesSize(), kChainLength + 4);
+}
+}  // namespace ge
@@ -901,4 +901,77 @@ TEST_F(UTESTGraphPassesBasePass, suspend_pre_node) {
   layers.push_back({"reshape1", "sum1"});
   CheckIterOrder(&test_pass, layers);
 }*/
+
+TEST_F(UTESTGraphPassesBasePass, run_passes_on_interested_types_only) {
+  auto builder = ut::GraphBuilder("g1");
+  auto data = builder.AddNode("data1", DATA, 0, 1);
+  auto cast = builder.AddNode("cast1", CAST, 1, 1);
+  auto netoutput = builder.AddNode("netoutput1", NETOUTPUT, 1, 0);
+  builder.AddDataEdge(data, 0, cast, 0);
+  builder.AddDataEdge(cast, 0, netoutput, 0);
+  auto graph = builder.GetGraph();
+
+  UtestTestPass all_pass;
+  UtestTestPass cast_pass;
+  cast_pass.SetInterestedTypes({CAST});
+  NamesToPass names_to_pass = {{"all", &all_pass}, {"cast", &cast_pass}};
+  auto ge_pass = GEPass(graph);
+  EXPECT_EQ(ge_pass.Run(names_to_pass), SUCCESS);
+
+  EXPECT_EQ(all_pass.GetIterNodes().size(), 3);
+  ASSERT_EQ(cast_pass.GetIterNodes().size(), 1);
+  EXPECT_EQ(cast_pass.GetIterNodes()[0]->GetName(), "cast1");
+
+  const auto &statistics = ge_pass.GetPassStatistics();
+  ASSERT_EQ(statistics.size(), 2);
+  EXPECT_EQ(statistics.at("all").visit_count, 3);
+  EXPECT_EQ(statistics.at("all").skip_count, 0);
+  EXPECT_EQ(statistics.at("cast").visit_count, 1);
+  EXPECT_EQ(statistics.at("cast").skip_count, 2);
+}
+
+///   data_i --> call_i (sub graph i + 1)
+/// nesting deeper than the stack of the recursive walk allowed
+TEST_F(UTESTGraphPassesBasePass, run_passes_on_deep_nested_sub_graphs) {
+  const int depth = 64;
+  std::vector<ComputeGraphPtr> graphs;
+  std::vector<NodePtr> calls;
+  for (int i = 0; i < depth; ++i) {
+    auto builder = ut::GraphBuilder("g" + std::to_string(i));
+    auto data = builder.AddNode("data" + std::to_string(i), DATA, 0, 1);
+    auto call = builder.AddNode("call" + std::to_string(i), PARTITIONEDCALL, 1, 1);
+    builder.AddDataEdge(data, 0, call, 0);
+    graphs.emplace_back(builder.GetGraph());
+    calls.emplace_back(call);
+  }
+  auto root_graph = graphs[0];
+  for (int i = 1; i < depth; ++i) {
+    calls[i - 1]->GetOpDesc()->AddSubgraphName("f");
+    calls[i - 1]->GetOpDesc()->SetSubgraphInstanceName(0, graphs[i]->GetName());
+    graphs[i]->SetParentGraph(graphs[i - 1]);
+    graphs[i]->SetParentNode(calls[i - 1]);
+    root_graph->AddSubgraph(graphs[i]);
+  }
+
+  UtestTestPass test_pass;
+  NamesToPass names_to_pass = {{"test", &test_pass}};
+  auto ge_pass = GEPass(root_graph);
+  EXPECT_EQ(ge_pass.Run(names_to_pass), SUCCESS);
+
+  // the nodes with sub graphs are passed before and after their sub graphs
+  std::vector<std::string> expect_names;
+  for (int i = 0; i < depth; ++i) {
+    expect_names.emplace_back("data" + std::to_string(i));
+    expect_names.emplace_back("call" + std::to_string(i));
+  }
+  for (int i = depth - 2; i >= 0; --i) {
+    expect_names.emplace_back("call" + std::to_string(i));
+  }
+  auto iter_nodes = test_pass.GetIterNodes();
+  ASSERT_EQ(iter_nodes.size(), expect_names.size());
+  for (size_t i = 0; i < iter_nodes.size(); ++i) {
+    EXPECT_EQ(iter_nodes[i]->GetName(), expect_names[i]);
+  }
+  EXPECT_EQ(ge_pass.GetPassStatistics().at("test").visit_count, expect_names.size());
+}
 }  // namespace ge
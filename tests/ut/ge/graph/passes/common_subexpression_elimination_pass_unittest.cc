@@ -0,0 +1,159 @@
+/**
+* Copyright 2021, 2022 LuoJiaNET Research and Development Group, Wuhan University
+* Copyright 2021, 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "graph/passes/common_subexpression_elimination_pass.h"
+
+#include <set>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "common/types.h"
+#include "graph/utils/attr_utils.h"
+#include "graph_builder_utils.h"
+#include "inc/kernel.h"
+#include "inc/kernel_factory.h"
+
+namespace ge {
+const char *CseYes = "CseYes";
+
+// nodes with folding kernels are processed by cse
+class TestCseKernel : public Kernel {
+ public:
+  Status Compute(const ge::OpDescPtr op_desc_ptr, const std::vector<ge::ConstGeTensorPtr> &input,
+                 std::vector<ge::GeTensorPtr> &v_output) override {
+    return NOT_CHANGED;
+  }
+};
+REGISTER_KERNEL(CseYes, TestCseKernel);
+
+namespace {
+///     netoutput
+///    /   |    \.
+/// cse1  cse2  cse3(axis 1)   cse4 <-ctrl- const2
+///    \   |    /              /
+///      const1 --------------
+ComputeGraphPtr BuildGraph1() {
+  auto builder = ut::GraphBuilder("test");
+  auto const1 = builder.AddNode("const1", CONSTANT, 0, 1);
+  auto const2 = builder.AddNode("const2", CONSTANT, 0, 1);
+  auto cse1 = builder.AddNode("cse1", CseYes, 1, 1);
+  auto cse2 = builder.AddNode("cse2", CseYes, 1, 1);
+  auto cse3 = builder.AddNode("cse3", CseYes, 1, 1);
+  auto cse4 = builder.AddNode("cse4", CseYes, 1, 1);
+  auto netoutput = builder.AddNode("netoutput", NETOUTPUT, 4, 0);
+  (void)AttrUtils::SetInt(const2->GetOpDesc(), "index", 2);
+  (void)AttrUtils::SetInt(cse3->GetOpDesc(), "axis", 1);
+
+  builder.AddDataEdge(const1, 0, cse1, 0);
+  builder.AddDataEdge(const1, 0, cse2, 0);
+  builder.AddDataEdge(const1, 0, cse3, 0);
+  builder.AddDataEdge(const1, 0, cse4, 0);
+  builder.AddControlEdge(const2, cse4);
+  builder.AddDataEdge(cse1, 0, netoutput, 0);
+  builder.AddDataEdge(cse2, 0, netoutput, 1);
+  builder.AddDataEdge(cse3, 0, netoutput, 2);
+  builder.AddDataEdge(cse4, 0, netoutput, 3);
+  return builder.GetGraph();
+}
+
+/// every layer has two same nodes consuming the first node of the layer below
+ComputeGraphPtr BuildLayerGraph(int layer_num) {
+  auto builder = ut::GraphBuilder("test");
+  auto input = builder.AddNode("const", CONSTANT, 0, 1);
+  for (int i = 0; i < layer_num; ++i) {
+    auto first = builder.AddNode("cse_a" + std::to_string(i), CseYes, 1, 1);
+    auto second = builder.AddNode("cse_b" + std::to_string(i), CseYes, 1, 1);
+    builder.AddDataEdge(input, 0, first, 0);
+    builder.AddDataEdge(input, 0, second, 0);
+    input = first;
+  }
+  return builder.GetGraph();
+}
+
+// keys serialized as strings, as the pass did before hashing them
+std::string GetStringCseKey(const NodePtr &node) {
+  std::stringstream ss;
+  ss << node->GetType() << "-data-inputs-";
+  for (auto &in_anchor : node->GetAllInDataAnchors()) {
+    auto src_anchor = in_anchor->GetPeerOutAnchor();
+    if (src_anchor == nullptr) {
+      ss << in_anchor->GetIdx() << "-null-";
+    } else {
+      ss << in_anchor->GetIdx() << "-" << src_anchor->GetOwnerNode()->GetName() << "-" << src_anchor->GetIdx()
+         << "-";
+    }
+  }
+  ss << "control-inputs-";
+  std::set<std::string> control_in_node_names;
+  for (auto &src_node : node->GetInControlNodes()) {
+    control_in_node_names.insert(src_node->GetName());
+  }
+  for (auto &name : control_in_node_names) {
+    ss << name << "-";
+  }
+  ss << "attrs-" << AttrUtils::GetAllAttrsStr(node->GetOpDesc());
+  return ss.str();
+}
+}  // namespace
+
+class UtestCommonSubexpressionEliminationPass : public testing::Test {
+ protected:
+  void SetUp() {}
+  void TearDown() {}
+};
+
+TEST_F(UtestCommonSubexpressionEliminationPass, remove_same_nodes) {
+  auto graph = BuildGraph1();
+  CommonSubexpressionEliminationPass pass;
+  EXPECT_EQ(pass.Run(graph), SUCCESS);
+  EXPECT_NE(graph->FindNode("cse1"), nullptr);
+  EXPECT_EQ(graph->FindNode("cse2"), nullptr);
+  // different attributes or control inputs
+  EXPECT_NE(graph->FindNode("cse3"), nullptr);
+  EXPECT_NE(graph->FindNode("cse4"), nullptr);
+
+  auto netoutput = graph->FindNode("netoutput");
+  ASSERT_NE(netoutput, nullptr);
+  EXPECT_EQ(netoutput->GetInDataAnchor(0)->GetPeerOutAnchor()->GetOwnerNode()->GetName(), "cse1");
+  EXPECT_EQ(netoutput->GetInDataAnchor(1)->GetPeerOutAnchor()->GetOwnerNode()->GetName(), "cse1");
+  EXPECT_EQ(netoutput->GetInDataAnchor(2)->GetPeerOutAnchor()->GetOwnerNode()->GetName(), "cse3");
+}
+
+TEST_F(UtestCommonSubexpressionEliminationPass, remove_same_nodes_of_layers) {
+  const int layer_num = 16;
+  auto graph = BuildLayerGraph(layer_num);
+  ASSERT_EQ(graph->GetDirectNodesSize(), layer_num * 2 + 1);
+  std::set<std::string> string_keys;
+  for (const auto &node : graph->GetDirectNode()) {
+    if (node->GetType() == CseYes) {
+      (void)string_keys.insert(GetStringCseKey(node));
+    }
+  }
+  // second nodes of the layers have the same keys as the first ones
+  EXPECT_EQ(string_keys.size(), layer_num);
+
+  CommonSubexpressionEliminationPass pass;
+  EXPECT_EQ(pass.Run(graph), SUCCESS);
+  EXPECT_EQ(graph->GetDirectNodesSize(), layer_num + 1);
+  for (int i = 0; i < layer_num; ++i) {
+    EXPECT_NE(graph->FindNode("cse_a" + std::to_string(i)), nullptr);
+    EXPECT_EQ(graph->FindNode("cse_b" + std::to_string(i)), nullptr);
+  }
+}
+}  // namespace ge
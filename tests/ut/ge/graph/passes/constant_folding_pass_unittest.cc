@@ -17,14 +17,18 @@
 
 #include "graph/passes/constant_folding_pass.h"
 
+#include <atomic>
+#include <map>
 #include <string>
 #include <vector>
 #include <gtest/gtest.h>
 
 #include "common/types.h"
 #include "ge/common/ge/ge_util.h"
+#include "graph/ge_local_context.h"
 #include "graph/passes/base_pass.h"
 #include "graph/passes/dimension_compute_pass.h"
+#include "graph/passes/folding_cache.h"
 #include "graph_builder_utils.h"
 #include "inc/kernel.h"
 #include "inc/kernel_factory.h"
@@ -41,6 +45,7 @@ const char *WrongYes = "WrongYes";
 const char *WrongYes1 = "WrongYes1";
 const char *WrongYes2 = "WrongYes2";
 const char *WrongYes3 = "WrongYes3";
+const char *CountYes = "CountYes";
 
 class TestAddNKernel : public Kernel {
  public:
@@ -162,6 +167,30 @@ class TestWrongKernel3 : public Kernel {
 };
 REGISTER_KERNEL(WrongYes3, TestWrongKernel3);
 
+std::atomic<int64_t> count_kernel_calls(0);
+// output is the first input with every byte plus one
+class TestCountKernel : public Kernel {
+ public:
+  Status Compute(const ge::OpDescPtr op_desc_ptr, const std::vector<ge::ConstGeTensorPtr> &input,
+                 std::vector<ge::GeTensorPtr> &v_output) override {
+    count_kernel_calls++;
+    if (input.empty() || input[0] == nullptr) {
+      return NOT_CHANGED;
+    }
+    std::vector<uint8_t> data(input[0]->GetData().data(), input[0]->GetData().data() + input[0]->GetData().size());
+    for (auto &value : data) {
+      value++;
+    }
+    auto output = std::make_shared<GeTensor>();
+    output->MutableTensorDesc().SetShape(GeShape(std::vector<int64_t>{static_cast<int64_t>(data.size())}));
+    output->SetData(data);
+    output->MutableTensorDesc().SetDataType(DT_UINT8);
+    v_output.push_back(output);
+    return SUCCESS;
+  }
+};
+REGISTER_KERNEL(CountYes, TestCountKernel);
+
 class UtestGraphPassesConstantFoldingPass : public testing::Test {
  protected:
   UtestGraphPassesConstantFoldingPass() = default;
@@ -528,6 +557,65 @@ ComputeGraphPtr BuildWrongGraph6() {
   builder.AddDataEdge(op, 0, conv, 0);
   return builder.GetGraph();
 }
+
+///      shapeNo_i
+///         |
+///    countYes2_i
+///     /       \.
+/// countYes1_i  |
+///     \       /
+///      const_i
+/// for i in [0, chain_num)
+ComputeGraphPtr BuildWideGraph(int chain_num) {
+  auto builder = ut::GraphBuilder("test");
+  for (int i = 0; i < chain_num; ++i) {
+    auto index = std::to_string(i);
+    auto const_op = builder.AddNode("const" + index, CONSTANT, 0, 1);
+    GeTensorPtr weight = std::make_shared<GeTensor>(GeTensorDesc(GeShape({2}), FORMAT_ND, DT_UINT8));
+    weight->SetData(std::vector<uint8_t>{static_cast<uint8_t>(i), static_cast<uint8_t>(i * 2)});
+    OpDescUtils::SetWeights(const_op->GetOpDesc(), weight);
+    auto count1 = builder.AddNode("count1_" + index, CountYes, 1, 1);
+    auto count2 = builder.AddNode("count2_" + index, CountYes, 2, 1);
+    auto shape = builder.AddNode("shape" + index, ShapeNo, 1, 1);
+    builder.AddDataEdge(const_op, 0, count1, 0);
+    builder.AddDataEdge(count1, 0, count2, 0);
+    builder.AddDataEdge(const_op, 0, count2, 1);
+    builder.AddDataEdge(count2, 0, shape, 0);
+  }
+  return builder.GetGraph();
+}
+
+std::map<std::string, std::vector<uint8_t>> FoldWideGraph(int chain_num, ConstantFoldingPass &folding_pass) {
+  auto graph = BuildWideGraph(chain_num);
+  NamesToPass names_to_pass;
+  names_to_pass.push_back({"Test", &folding_pass});
+  GEPass pass(graph);
+  EXPECT_EQ(pass.Run(names_to_pass), SUCCESS);
+  // consts of the chains are folded to one
+  EXPECT_EQ(graph->GetDirectNodesSize(), chain_num * 2);
+
+  std::map<std::string, std::vector<uint8_t>> folded;
+  for (int i = 0; i < chain_num; ++i) {
+    auto name = "shape" + std::to_string(i);
+    auto shape = graph->FindNode(name);
+    EXPECT_NE(shape, nullptr);
+    if (shape == nullptr) {
+      continue;
+    }
+    auto in_nodes = shape->GetInDataNodes();
+    EXPECT_EQ(in_nodes.size(), 1);
+    if (in_nodes.size() != 1) {
+      continue;
+    }
+    auto weights = OpDescUtils::MutableWeights(in_nodes.at(0));
+    EXPECT_EQ(weights.size(), 1);
+    if (weights.size() == 1) {
+      const auto &data = weights[0]->GetData();
+      folded[name] = std::vector<uint8_t>(data.data(), data.data() + data.size());
+    }
+  }
+  return folded;
+}
 }  // namespace
 
 TEST_F(UtestGraphPassesConstantFoldingPass, folding_addn) {
@@ -775,4 +863,89 @@ TEST_F(UtestGraphPassesConstantFoldingPass, unlikely6) {
     delete name_to_pass.second;
   }
 }
+TEST_F(UtestGraphPassesConstantFoldingPass, parallel_folding_same_as_serial) {
+  const int chain_num = 64;
+  count_kernel_calls = 0;
+  ConstantFoldingPass serial_pass;
+  auto serial_folded = FoldWideGraph(chain_num, serial_pass);
+  EXPECT_EQ(count_kernel_calls, chain_num * 2);
+  ASSERT_EQ(serial_folded.size(), chain_num);
+  EXPECT_EQ(serial_folded["shape0"], std::vector<uint8_t>({2, 2}));
+  EXPECT_EQ(serial_folded["shape5"], std::vector<uint8_t>({7, 12}));
+
+  // kernels are computed in waves by option, every node is computed once still
+  count_kernel_calls = 0;
+  GetThreadLocalContext().SetGlobalOption({{CONSTANT_FOLDING_THREAD_NUM, "4"}});
+  ConstantFoldingPass parallel_pass;
+  GetThreadLocalContext().SetGlobalOption({});
+  auto parallel_folded = FoldWideGraph(chain_num, parallel_pass);
+  EXPECT_EQ(count_kernel_calls, chain_num * 2);
+  EXPECT_EQ(parallel_folded, serial_folded);
+
+  std::uint64_t calls = 0;
+  for (const auto &statistic : parallel_pass.GetGeConstantFoldingPerfStatistic()) {
+    calls += statistic.second.first;
+  }
+  EXPECT_EQ(calls, chain_num * 2);
+
+  // changes of threads between graphs
+  count_kernel_calls = 0;
+  parallel_pass.SetThreadNum(1);
+  EXPECT_EQ(FoldWideGraph(chain_num, parallel_pass), serial_folded);
+  EXPECT_EQ(count_kernel_calls, chain_num * 2);
+}
+
+TEST_F(UtestGraphPassesConstantFoldingPass, parallel_folding_recompute_changed_node) {
+  auto graph = BuildWideGraph(2);
+  ConstantFoldingPass folding_pass;
+  folding_pass.SetThreadNum(4);
+  count_kernel_calls = 0;
+  auto count1_0 = graph->FindNode("count1_0");
+  auto count1_1 = graph->FindNode("count1_1");
+  ASSERT_NE(count1_0, nullptr);
+  ASSERT_NE(count1_1, nullptr);
+  // the wave computes both nodes of constant inputs
+  EXPECT_EQ(folding_pass.Run(count1_0), SUCCESS);
+  EXPECT_EQ(count_kernel_calls, 2);
+
+  // the output desc is inferred again after the wave, the result is stale
+  count1_1->GetOpDesc()->MutableOutputDesc(0)->SetShape(GeShape({2}));
+  EXPECT_EQ(folding_pass.Run(count1_1), SUCCESS);
+  EXPECT_EQ(count_kernel_calls, 3);
+}
+
+TEST_F(UtestGraphPassesConstantFoldingPass, folding_by_cache_between_graphs) {
+  const int chain_num = 8;
+  FoldingCache::GetInstance().Clear();
+  GetThreadLocalContext().SetGlobalOption({{CONSTANT_FOLDING_CACHE_SIZE, "1"}});
+  ConstantFoldingPass first_pass;
+  ConstantFoldingPass second_pass;
+  GetThreadLocalContext().SetGlobalOption({});
+  EXPECT_EQ(FoldingCache::GetInstance().GetCapacity(), 1024U * 1024U);
+
+  count_kernel_calls = 0;
+  auto first_folded = FoldWideGraph(chain_num, first_pass);
+  EXPECT_EQ(count_kernel_calls, chain_num * 2);
+  EXPECT_EQ(FoldingCache::GetInstance().GetEntryNum(), chain_num * 2);
+
+  // the same nodes of another graph are folded by the cache
+  count_kernel_calls = 0;
+  EXPECT_EQ(FoldWideGraph(chain_num, second_pass), first_folded);
+  EXPECT_EQ(count_kernel_calls, 0);
+  const auto &statistic = second_pass.GetGeConstantFoldingPerfStatistic();
+  ASSERT_EQ(statistic.count("CountYes:cache_hit"), 1);
+  EXPECT_EQ(statistic.at("CountYes:cache_hit").first, chain_num * 2);
+  EXPECT_EQ(statistic.count("CountYes"), 0);
+
+  // a session disabling the cache keeps the shared capacity but folds by the kernels
+  GetThreadLocalContext().SetGlobalOption({{CONSTANT_FOLDING_CACHE_SIZE, "0"}});
+  ConstantFoldingPass uncached_pass;
+  GetThreadLocalContext().SetGlobalOption({});
+  EXPECT_EQ(FoldingCache::GetInstance().GetCapacity(), 1024U * 1024U);
+  count_kernel_calls = 0;
+  EXPECT_EQ(FoldWideGraph(chain_num, uncached_pass), first_folded);
+  EXPECT_EQ(count_kernel_calls, chain_num * 2);
+
+  FoldingCache::GetInstance().SetCapacity(0U);
+}
 }  // namespace ge
@@ -0,0 +1,153 @@
+/**
+* Copyright 2021, 2022 LuoJiaNET Research and Development Group, Wuhan University
+* Copyright 2021, 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+
+#include "graph/passes/folding_cache.h"
+#include "graph/utils/attr_utils.h"
+
+namespace ge {
+namespace {
+ConstGeTensorPtr CreateTensor(const std::vector<int32_t> &data) {
+  GeTensorDesc tensor_desc(GeShape({static_cast<int64_t>(data.size())}), FORMAT_ND, DT_INT32);
+  return std::make_shared<GeTensor>(tensor_desc, reinterpret_cast<const uint8_t *>(data.data()),
+                                    data.size() * sizeof(int32_t));
+}
+
+OpDescPtr CreateOpDesc(const std::string &name) {
+  auto op_desc = std::make_shared<OpDesc>(name, "Pack");
+  op_desc->AddInputDesc(GeTensorDesc(GeShape({2}), FORMAT_ND, DT_INT32));
+  op_desc->AddOutputDesc(GeTensorDesc(GeShape({1, 2}), FORMAT_ND, DT_INT32));
+  (void)AttrUtils::SetInt(op_desc, "axis", 0);
+  return op_desc;
+}
+}  // namespace
+
+class UtestFoldingCache : public testing::Test {
+ protected:
+  void SetUp() {
+    FoldingCache::GetInstance().Clear();
+    FoldingCache::GetInstance().SetCapacity(1024U * 1024U);
+  }
+  void TearDown() {
+    FoldingCache::GetInstance().SetCapacity(0U);
+  }
+};
+
+TEST_F(UtestFoldingCache, key_by_content) {
+  std::string key;
+  std::string same_key;
+  std::string other_key;
+  // names of the nodes do not matter
+  ASSERT_TRUE(FoldingCache::GenerateKey(CreateOpDesc("pack1"), {CreateTensor({1, 2})}, key));
+  ASSERT_TRUE(FoldingCache::GenerateKey(CreateOpDesc("pack2"), {CreateTensor({1, 2})}, same_key));
+  EXPECT_EQ(key, same_key);
+
+  ASSERT_TRUE(FoldingCache::GenerateKey(CreateOpDesc("pack1"), {CreateTensor({1, 3})}, other_key));
+  EXPECT_NE(key, other_key);
+  auto op_desc = CreateOpDesc("pack1");
+  (void)AttrUtils::SetInt(op_desc, "axis", 1);
+  ASSERT_TRUE(FoldingCache::GenerateKey(op_desc, {CreateTensor({1, 2})}, other_key));
+  EXPECT_NE(key, other_key);
+  // attrs are kept in full, not by a hash
+  EXPECT_NE(other_key.find(AttrUtils::GetAllAttrsStr(op_desc)), std::string::npos);
+  op_desc = CreateOpDesc("pack1");
+  op_desc->MutableOutputDesc(0)->SetDataType(DT_INT64);
+  ASSERT_TRUE(FoldingCache::GenerateKey(op_desc, {CreateTensor({1, 2})}, other_key));
+  EXPECT_NE(key, other_key);
+
+  EXPECT_FALSE(FoldingCache::GenerateKey(nullptr, {CreateTensor({1, 2})}, other_key));
+  EXPECT_FALSE(FoldingCache::GenerateKey(CreateOpDesc("pack1"), {nullptr}, other_key));
+  std::vector<int32_t> large(1024U * 1024U, 1);
+  EXPECT_FALSE(FoldingCache::GenerateKey(CreateOpDesc("pack1"), {CreateTensor(large)}, other_key));
+}
+
+TEST_F(UtestFoldingCache, find_copies_of_outputs) {
+  auto &cache = FoldingCache::GetInstance();
+  std::vector<ConstGeTensorPtr> inputs = {CreateTensor({1, 2})};
+  std::string key;
+  ASSERT_TRUE(FoldingCache::GenerateKey(CreateOpDesc("pack1"), inputs, key));
+  std::vector<GeTensorPtr> outputs;
+  EXPECT_FALSE(cache.Find(key, inputs, outputs));
+
+  auto output = std::make_shared<GeTensor>(*CreateTensor({1, 2}));
+  cache.Insert(key, inputs, {output});
+  EXPECT_EQ(cache.GetEntryNum(), 1U);
+  ASSERT_TRUE(cache.Find(key, inputs, outputs));
+  ASSERT_EQ(outputs.size(), 1U);
+  EXPECT_NE(outputs[0], output);
+  EXPECT_EQ(outputs[0]->GetData().size(), output->GetData().size());
+  // changing the returned outputs does not change the cached ones
+  outputs[0]->SetData(std::vector<uint8_t>{0});
+  std::vector<GeTensorPtr> outputs_again;
+  ASSERT_TRUE(cache.Find(key, inputs, outputs_again));
+  EXPECT_EQ(outputs_again[0]->GetData().size(), 2U * sizeof(int32_t));
+
+  // a key colliding with different inputs misses
+  std::vector<GeTensorPtr> collided;
+  EXPECT_FALSE(cache.Find(key, {CreateTensor({1, 3})}, collided));
+  EXPECT_TRUE(collided.empty());
+  EXPECT_EQ(cache.GetHitCount(), 2U);
+  EXPECT_EQ(cache.GetMissCount(), 2U);
+}
+
+TEST_F(UtestFoldingCache, capacity_inited_once) {
+  auto &cache = FoldingCache::GetInstance();
+  cache.Clear();
+  cache.InitCapacity(2048U);
+  EXPECT_EQ(cache.GetCapacity(), 2048U);
+  // passes of later graphs or sessions do not change it
+  cache.InitCapacity(0U);
+  EXPECT_EQ(cache.GetCapacity(), 2048U);
+  cache.Clear();
+  cache.InitCapacity(4096U);
+  EXPECT_EQ(cache.GetCapacity(), 4096U);
+  cache.Clear();
+}
+
+TEST_F(UtestFoldingCache, evict_least_recently_used) {
+  auto &cache = FoldingCache::GetInstance();
+  std::vector<std::string> keys;
+  std::vector<std::vector<ConstGeTensorPtr>> inputs;
+  for (int32_t i = 0; i < 3; ++i) {
+    inputs.push_back({CreateTensor({i, i})});
+    std::string key;
+    ASSERT_TRUE(FoldingCache::GenerateKey(CreateOpDesc("pack"), inputs.back(), key));
+    keys.emplace_back(key);
+    cache.Insert(key, inputs.back(), {std::make_shared<GeTensor>(*CreateTensor({i}))});
+  }
+  ASSERT_EQ(cache.GetEntryNum(), 3U);
+
+  // key 0 is used, key 1 is the least recently used one
+  std::vector<GeTensorPtr> outputs;
+  ASSERT_TRUE(cache.Find(keys[0], inputs[0], outputs));
+  cache.SetCapacity(cache.GetSize() - 1U);
+  EXPECT_EQ(cache.GetEntryNum(), 2U);
+  EXPECT_TRUE(cache.Find(keys[0], inputs[0], outputs));
+  EXPECT_FALSE(cache.Find(keys[1], inputs[1], outputs));
+  EXPECT_TRUE(cache.Find(keys[2], inputs[2], outputs));
+
+  // disabled
+  cache.SetCapacity(0U);
+  EXPECT_EQ(cache.GetEntryNum(), 0U);
+  EXPECT_EQ(cache.GetSize(), 0U);
+  cache.Insert(keys[1], inputs[1], {std::make_shared<GeTensor>(*CreateTensor({1}))});
+  EXPECT_FALSE(cache.Find(keys[1], inputs[1], outputs));
+}
+}  // namespace ge
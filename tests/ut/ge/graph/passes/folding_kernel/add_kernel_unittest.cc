@@ -135,6 +135,80 @@ TEST_F(UtestFoldingKernelAddKernel, AddOptimizerFloatSuccess) {
   EXPECT_EQ(NOT_CHANGED, status);
 }
 
+TEST_F(UtestFoldingKernelAddKernel, AddOptimizerInt32Overflow) {
+  OpDescPtr op_desc_ptr = std::make_shared<OpDesc>("Add", ADD);
+  op_desc_ptr->AddOutputDesc(GeTensorDesc());
+
+  vector<int64_t> dims_vec_0 = {2, 2};
+  vector<int32_t> data_vec_0 = {1, 2, 3, INT32_MAX};
+  GeTensorDesc tensor_desc_0(GeShape(dims_vec_0), FORMAT_NCHW, DT_INT32);
+  ConstGeTensorPtr tensor_0 =
+      std::make_shared<GeTensor>(tensor_desc_0, (uint8_t *)data_vec_0.data(), data_vec_0.size() * sizeof(int32_t));
+
+  vector<int64_t> dims_vec_1 = {2};
+  vector<int32_t> data_vec_1 = {0, 1};
+  GeTensorDesc tensor_desc_1(GeShape(dims_vec_1), FORMAT_NCHW, DT_INT32);
+  ConstGeTensorPtr tensor_1 =
+      std::make_shared<GeTensor>(tensor_desc_1, (uint8_t *)data_vec_1.data(), data_vec_1.size() * sizeof(int32_t));
+
+  vector<ConstGeTensorPtr> input = {tensor_0, tensor_1};
+  vector<GeTensorPtr> v_output;
+
+  shared_ptr<Kernel> kernel = KernelFactory::Instance().Create(ADD);
+  EXPECT_EQ(kernel->Compute(op_desc_ptr, input, v_output), NOT_CHANGED);
+  EXPECT_TRUE(v_output.empty());
+
+  data_vec_1 = {0, 0};
+  tensor_1 =
+      std::make_shared<GeTensor>(tensor_desc_1, (uint8_t *)data_vec_1.data(), data_vec_1.size() * sizeof(int32_t));
+  input = {tensor_0, tensor_1};
+  EXPECT_EQ(kernel->Compute(op_desc_ptr, input, v_output), SUCCESS);
+  ASSERT_EQ(v_output.size(), 1);
+  EXPECT_EQ(v_output[0]->GetData().size(), data_vec_0.size() * sizeof(int32_t));
+  EXPECT_EQ(((const int32_t *)v_output[0]->GetData().data())[3], INT32_MAX);
+}
+
+TEST_F(UtestFoldingKernelAddKernel, AddOptimizerBroadcastBothInputs) {
+  OpDescPtr op_desc_ptr = std::make_shared<OpDesc>("Add", ADD);
+  op_desc_ptr->AddOutputDesc(GeTensorDesc());
+
+  vector<int64_t> dims_vec_0 = {3, 1, 4};
+  vector<float> data_vec_0(3 * 4);
+  for (size_t i = 0; i < data_vec_0.size(); ++i) {
+    data_vec_0[i] = static_cast<float>(i / 4 * 10);
+  }
+  GeTensorDesc tensor_desc_0(GeShape(dims_vec_0), FORMAT_NCHW, DT_FLOAT);
+  ConstGeTensorPtr tensor_0 =
+      std::make_shared<GeTensor>(tensor_desc_0, (uint8_t *)data_vec_0.data(), data_vec_0.size() * sizeof(float));
+
+  vector<int64_t> dims_vec_1 = {1, 2, 4};
+  vector<float> data_vec_1(2 * 4);
+  for (size_t i = 0; i < data_vec_1.size(); ++i) {
+    data_vec_1[i] = static_cast<float>(i % 4);
+  }
+  GeTensorDesc tensor_desc_1(GeShape(dims_vec_1), FORMAT_NCHW, DT_FLOAT);
+  ConstGeTensorPtr tensor_1 =
+      std::make_shared<GeTensor>(tensor_desc_1, (uint8_t *)data_vec_1.data(), data_vec_1.size() * sizeof(float));
+
+  vector<ConstGeTensorPtr> input = {tensor_0, tensor_1};
+  vector<GeTensorPtr> v_output;
+
+  shared_ptr<Kernel> kernel = KernelFactory::Instance().Create(ADD);
+  EXPECT_EQ(kernel->Compute(op_desc_ptr, input, v_output), SUCCESS);
+  ASSERT_EQ(v_output.size(), 1);
+  EXPECT_EQ(v_output[0]->GetTensorDesc().GetShape().GetDims(), vector<int64_t>({3, 2, 4}));
+  ASSERT_EQ(v_output[0]->GetData().size(), 3 * 2 * 4 * sizeof(float));
+  const float *output = (const float *)v_output[0]->GetData().data();
+  // output[i][j][k] = i * 10 + k
+  for (size_t i = 0; i < 3; ++i) {
+    for (size_t j = 0; j < 2; ++j) {
+      for (size_t k = 0; k < 4; ++k) {
+        EXPECT_EQ(output[(i * 2 + j) * 4 + k], static_cast<float>(i * 10 + k));
+      }
+    }
+  }
+}
+
 // optimize op of slice success
 TEST_F(UtestFoldingKernelAddKernel, OptimizeOpOfSliceSuccess) {
   OpDescPtr op_desc_ptr = std::make_shared<OpDesc>("Add", ADD);
@@ -260,4 +260,139 @@ TEST_F(UtestGraphInfershapePass, update_output_from_subgraphs_for_multiDims_succ
   EXPECT_EQ(ret, SUCCESS);
   EXPECT_EQ(dst_ge_tensor_desc_ptr->GetShape().GetDims(), std::vector<int64_t>({2,2,3,4}));
 }
+
+TEST_F(UtestGraphInfershapePass, skip_infer_of_unchanged_nodes) {
+  auto graph = std::make_shared<ComputeGraph>("test_incremental_infer");
+  auto data1 = CreateNode(*graph, "data", DATA, 1, 1);
+  auto relu1 = CreateNode(*graph, "relu", RELU, 1, 1);
+  GraphUtils::AddEdge(data1->GetOutDataAnchor(0), relu1->GetInDataAnchor(0));
+  int infer_times = 0;
+  relu1->GetOpDesc()->AddInferFunc([&infer_times](Operator &op) {
+    infer_times++;
+    op.UpdateOutputDesc("__output0", op.GetInputDesc(0));
+    return GRAPH_SUCCESS;
+  });
+  relu1->GetOpDesc()->MutableInputDesc(0)->SetShape(GeShape({1, 2}));
+
+  InferShapePass infer_shape_pass;
+  EXPECT_EQ(infer_shape_pass.Run(relu1), SUCCESS);
+  EXPECT_EQ(infer_times, 1);
+  EXPECT_EQ(relu1->GetOpDesc()->GetOutputDesc(0).GetShape().GetDims(), std::vector<int64_t>({1, 2}));
+  EXPECT_EQ(infer_shape_pass.Run(relu1), SUCCESS);
+  EXPECT_EQ(infer_times, 1);
+  EXPECT_EQ(infer_shape_pass.GetSkippedInferCount(), 1U);
+
+  // the input desc changes
+  relu1->GetOpDesc()->MutableInputDesc(0)->SetShape(GeShape({3, 2}));
+  EXPECT_EQ(infer_shape_pass.Run(relu1), SUCCESS);
+  EXPECT_EQ(infer_times, 2);
+  EXPECT_EQ(relu1->GetOpDesc()->GetOutputDesc(0).GetShape().GetDims(), std::vector<int64_t>({3, 2}));
+  // the attributes change
+  (void)AttrUtils::SetInt(relu1->GetOpDesc(), "axis", 1);
+  EXPECT_EQ(infer_shape_pass.Run(relu1), SUCCESS);
+  EXPECT_EQ(infer_times, 3);
+  // the attributes of the input desc change
+  std::vector<std::pair<int64_t, int64_t>> value_range = {{1, 3}, {2, 2}};
+  relu1->GetOpDesc()->MutableInputDesc(0)->SetValueRange(value_range);
+  EXPECT_EQ(infer_shape_pass.Run(relu1), SUCCESS);
+  EXPECT_EQ(infer_times, 4);
+  EXPECT_EQ(infer_shape_pass.GetInferCount(), 4U);
+  EXPECT_EQ(infer_shape_pass.GetSkippedInferCount(), 1U);
+}
+
+TEST_F(UtestGraphInfershapePass, reuse_infer_result_of_same_nodes) {
+  auto graph = std::make_shared<ComputeGraph>("test_incremental_infer");
+  int infer_times = 0;
+  const auto infer_func = [&infer_times](Operator &op) {
+    infer_times++;
+    auto output_desc = op.GetInputDesc(0);
+    output_desc.SetDataType(DT_INT32);
+    op.UpdateOutputDesc("__output0", output_desc);
+    return GRAPH_SUCCESS;
+  };
+  std::vector<NodePtr> nodes;
+  for (int i = 0; i < 3; ++i) {
+    auto data = CreateNode(*graph, "data" + std::to_string(i), DATA, 1, 1);
+    auto cast = CreateNode(*graph, "cast" + std::to_string(i), CAST, 1, 1);
+    GraphUtils::AddEdge(data->GetOutDataAnchor(0), cast->GetInDataAnchor(0));
+    cast->GetOpDesc()->AddInferFunc(infer_func);
+    cast->GetOpDesc()->MutableInputDesc(0)->SetShape(GeShape({4, 5}));
+    nodes.emplace_back(cast);
+  }
+  (void)AttrUtils::SetInt(nodes[2]->GetOpDesc(), "dst_type", 3);
+
+  InferShapePass infer_shape_pass;
+  for (auto &node : nodes) {
+    EXPECT_EQ(infer_shape_pass.Run(node), SUCCESS);
+    EXPECT_EQ(node->GetOpDesc()->GetOutputDesc(0).GetShape().GetDims(), std::vector<int64_t>({4, 5}));
+    EXPECT_EQ(node->GetOpDesc()->GetOutputDesc(0).GetDataType(), DT_INT32);
+  }
+  // the second node reuses the result of the first one, the third one has different attributes
+  EXPECT_EQ(infer_times, 2);
+  EXPECT_EQ(infer_shape_pass.GetMemoizedInferCount(), 1U);
+}
+
+TEST_F(UtestGraphInfershapePass, infer_again_when_const_input_changes) {
+  auto graph = std::make_shared<ComputeGraph>("test_incremental_infer");
+  auto const1 = CreateNode(*graph, "const", CONSTANT, 0, 1);
+  auto reshape1 = CreateNode(*graph, "reshape", RESHAPE, 1, 1);
+  GraphUtils::AddEdge(const1->GetOutDataAnchor(0), reshape1->GetInDataAnchor(0));
+  int infer_times = 0;
+  reshape1->GetOpDesc()->AddInferFunc([&infer_times](Operator &op) {
+    infer_times++;
+    return GRAPH_SUCCESS;
+  });
+  std::vector<int32_t> data = {1, 2};
+  auto weight = std::make_shared<GeTensor>(const1->GetOpDesc()->GetOutputDesc(0),
+                                           reinterpret_cast<uint8_t *>(data.data()), data.size() * sizeof(int32_t));
+  OpDescUtils::SetWeights(const1, {weight});
+
+  InferShapePass infer_shape_pass;
+  EXPECT_EQ(infer_shape_pass.Run(reshape1), SUCCESS);
+  EXPECT_EQ(infer_shape_pass.Run(reshape1), SUCCESS);
+  EXPECT_EQ(infer_times, 1);
+
+  data[1] = 3;
+  weight = std::make_shared<GeTensor>(const1->GetOpDesc()->GetOutputDesc(0),
+                                      reinterpret_cast<uint8_t *>(data.data()), data.size() * sizeof(int32_t));
+  OpDescUtils::SetWeights(const1, {weight});
+  EXPECT_EQ(infer_shape_pass.Run(reshape1), SUCCESS);
+  EXPECT_EQ(infer_times, 2);
+}
+
+TEST_F(UtestGraphInfershapePass, confirm_const_data_when_reusing_result) {
+  auto graph = std::make_shared<ComputeGraph>("test_incremental_infer");
+  int infer_times = 0;
+  const auto infer_func = [&infer_times](Operator &op) {
+    infer_times++;
+    return GRAPH_SUCCESS;
+  };
+  std::vector<int32_t> data = {1, 2};
+  std::vector<NodePtr> nodes;
+  for (int i = 0; i < 3; ++i) {
+    auto const_node = CreateNode(*graph, "const" + std::to_string(i), CONSTANT, 0, 1);
+    auto reshape = CreateNode(*graph, "reshape" + std::to_string(i), RESHAPE, 1, 1);
+    GraphUtils::AddEdge(const_node->GetOutDataAnchor(0), reshape->GetInDataAnchor(0));
+    reshape->GetOpDesc()->AddInferFunc(infer_func);
+    auto weight = std::make_shared<GeTensor>(const_node->GetOpDesc()->GetOutputDesc(0),
+                                             reinterpret_cast<uint8_t *>(data.data()), data.size() * sizeof(int32_t));
+    OpDescUtils::SetWeights(const_node, {weight});
+    nodes.emplace_back(reshape);
+  }
+
+  InferShapePass infer_shape_pass;
+  EXPECT_EQ(infer_shape_pass.Run(nodes[0]), SUCCESS);
+  EXPECT_EQ(infer_shape_pass.Run(nodes[1]), SUCCESS);
+  EXPECT_EQ(infer_times, 1);
+  EXPECT_EQ(infer_shape_pass.GetMemoizedInferCount(), 1U);
+
+  // same hash but other data, as if the hashes collided, the result is not reused
+  ASSERT_EQ(infer_shape_pass.keys_2_infer_results_.size(), 1U);
+  auto &const_data = infer_shape_pass.keys_2_infer_results_.begin()->second.const_data;
+  ASSERT_EQ(const_data.size(), 1U);
+  const_data[0][0]++;
+  EXPECT_EQ(infer_shape_pass.Run(nodes[2]), SUCCESS);
+  EXPECT_EQ(infer_times, 2);
+  EXPECT_EQ(infer_shape_pass.GetMemoizedInferCount(), 1U);
+}
 }  // namespace ge
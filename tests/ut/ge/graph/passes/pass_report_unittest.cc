@@ -0,0 +1,164 @@
+/**
+* Copyright 2021, 2022 LuoJiaNET Research and Development Group, Wuhan University
+* Copyright 2021, 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+#include <fstream>
+#include <nlohmann/json.hpp>
+#include <string>
+
+#include "graph/passes/pass_report.h"
+#include "external/ge/ge_api_types.h"
+#include "framework/common/types.h"
+#include "graph/ge_local_context.h"
+#include "graph/passes/base_pass.h"
+#include "graph_builder_utils.h"
+#include "inc/pass_manager.h"
+
+namespace ge {
+namespace {
+class ChangedGraphPass : public GraphPass {
+ public:
+  Status Run(ComputeGraphPtr graph) override { return SUCCESS; }
+};
+
+class NotChangedGraphPass : public GraphPass {
+ public:
+  Status Run(ComputeGraphPtr graph) override { return NOT_CHANGED; }
+};
+
+// deletes cast nodes, asks their inputs and outputs to re-pass
+class DeleteCastPass : public BaseNodePass {
+ public:
+  Status Run(NodePtr &node) override {
+    if (node->GetType() != CAST) {
+      return SUCCESS;
+    }
+    return IsolateAndDeleteNode(node, {0});
+  }
+};
+
+///   data1 -> cast1 -> cast2 -> netoutput1
+ComputeGraphPtr BuildGraph() {
+  auto builder = ut::GraphBuilder("g1");
+  auto data = builder.AddNode("data1", DATA, 0, 1);
+  auto cast1 = builder.AddNode("cast1", CAST, 1, 1);
+  auto cast2 = builder.AddNode("cast2", CAST, 1, 1);
+  auto netoutput = builder.AddNode("netoutput1", NETOUTPUT, 1, 0);
+  builder.AddDataEdge(data, 0, cast1, 0);
+  builder.AddDataEdge(cast1, 0, cast2, 0);
+  builder.AddDataEdge(cast2, 0, netoutput, 0);
+  return builder.GetGraph();
+}
+
+const nlohmann::json *FindPass(const nlohmann::json &report, const std::string &stage, const std::string &name) {
+  for (const auto &pass : report["passes"]) {
+    if ((pass["stage"] == stage) && (pass["name"] == name)) {
+      return &pass;
+    }
+  }
+  return nullptr;
+}
+}  // namespace
+
+class UtestPassReport : public testing::Test {
+ protected:
+  void SetUp() {
+    PassReport::GetInstance().Clear(kGraphId);
+  }
+  void TearDown() {
+    GetThreadLocalContext().SetGlobalOption({});
+    PassReport::GetInstance().Clear(kGraphId);
+  }
+  const uint32_t kGraphId = 7;
+};
+
+TEST_F(UtestPassReport, inactive_without_path) {
+  PassReportScope scope(kGraphId, "OptimizeStage1_1");
+  EXPECT_FALSE(PassReport::IsActive());
+  EXPECT_EQ(PassReportScope::GetCurrent(), nullptr);
+
+  auto graph = BuildGraph();
+  PassManager pass_manager;
+  EXPECT_EQ(pass_manager.AddPass("ChangedGraphPass", new ChangedGraphPass), SUCCESS);
+  EXPECT_EQ(pass_manager.Run(graph), SUCCESS);
+
+  std::string json;
+  ASSERT_EQ(PassReport::GetInstance().ToJson(kGraphId, json), SUCCESS);
+  EXPECT_TRUE(nlohmann::json::parse(json)["passes"].empty());
+}
+
+TEST_F(UtestPassReport, report_passes_by_stages) {
+  GetThreadLocalContext().SetGlobalOption({{PASS_REPORT_PATH, "."}});
+  auto graph = BuildGraph();
+  {
+    PassReportScope outer_scope(kGraphId, "PreRun");
+    {
+      PassReportScope scope(kGraphId, "OptimizeStage1_1");
+      EXPECT_EQ(PassReportScope::GetCurrent(), &scope);
+      PassManager pass_manager;
+      EXPECT_EQ(pass_manager.AddPass("ChangedGraphPass", new ChangedGraphPass), SUCCESS);
+      EXPECT_EQ(pass_manager.AddPass("NotChangedGraphPass", new NotChangedGraphPass), SUCCESS);
+      EXPECT_EQ(pass_manager.Run(graph), SUCCESS);
+      EXPECT_EQ(pass_manager.Run(graph), SUCCESS);
+    }
+    EXPECT_EQ(PassReportScope::GetCurrent(), &outer_scope);
+    DeleteCastPass delete_cast_pass;
+    NamesToPass names_to_pass = {{"DeleteCastPass", &delete_cast_pass}};
+    EXPECT_EQ(GEPass(graph).Run(names_to_pass), SUCCESS);
+  }
+  EXPECT_EQ(PassReportScope::GetCurrent(), nullptr);
+  EXPECT_EQ(graph->GetDirectNodesSize(), 2);
+
+  std::string json;
+  ASSERT_EQ(PassReport::GetInstance().ToJson(kGraphId, json), SUCCESS);
+  auto report = nlohmann::json::parse(json);
+  EXPECT_EQ(report["graph_id"], kGraphId);
+  ASSERT_EQ(report["passes"].size(), 4);
+
+  auto changed = FindPass(report, "OptimizeStage1_1", "ChangedGraphPass");
+  ASSERT_NE(changed, nullptr);
+  EXPECT_EQ((*changed)["kind"], "graph_pass");
+  EXPECT_EQ((*changed)["calls"], 2);
+  EXPECT_EQ((*changed)["nodes_visited"], 8);
+  EXPECT_EQ((*changed)["graphs_changed"], 2);
+  auto not_changed = FindPass(report, "OptimizeStage1_1", "NotChangedGraphPass");
+  ASSERT_NE(not_changed, nullptr);
+  EXPECT_EQ((*not_changed)["graphs_changed"], 0);
+
+  auto delete_cast = FindPass(report, "PreRun", "DeleteCastPass");
+  ASSERT_NE(delete_cast, nullptr);
+  EXPECT_EQ((*delete_cast)["kind"], "node_pass");
+  EXPECT_EQ((*delete_cast)["nodes_changed"], 2);
+  EXPECT_GT((*delete_cast)["re_pass_count"], 0);
+  auto ge_pass = FindPass(report, "PreRun", "GEPass");
+  ASSERT_NE(ge_pass, nullptr);
+  EXPECT_EQ((*ge_pass)["kind"], "ge_pass");
+  EXPECT_GE((*ge_pass)["nodes_visited"], (*delete_cast)["nodes_visited"]);
+
+  ASSERT_EQ(PassReport::GetInstance().Dump(kGraphId, "."), SUCCESS);
+  std::ifstream ifs("./ge_pass_report_7.json");
+  ASSERT_TRUE(ifs.is_open());
+  auto dumped = nlohmann::json::parse(ifs);
+  EXPECT_EQ(dumped["passes"].size(), 4);
+  ifs.close();
+  (void)std::remove("./ge_pass_report_7.json");
+
+  // dumping clears the report
+  ASSERT_EQ(PassReport::GetInstance().ToJson(kGraphId, json), SUCCESS);
+  EXPECT_TRUE(nlohmann::json::parse(json)["passes"].empty());
+}
+}  // namespace ge
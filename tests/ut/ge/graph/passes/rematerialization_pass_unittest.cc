@@ -0,0 +1,149 @@
+/**
+* Copyright 2021, 2022 LuoJiaNET Research and Development Group, Wuhan University
+* Copyright 2021, 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+
+#include "external/ge/ge_api_types.h"
+#include "framework/common/types.h"
+#include "graph/ge_local_context.h"
+#include "graph/passes/rematerialization_pass.h"
+#include "graph/utils/attr_utils.h"
+#include "graph_builder_utils.h"
+
+namespace ge {
+namespace {
+const char *const kHeavy = "Heavy";
+const std::vector<int64_t> kSmallShape = {1, 1, 32, 32};
+const std::vector<int64_t> kMiddleShape = {1, 1, 32, 64};
+const std::vector<int64_t> kLargeShape = {1, 1, 64, 64};
+
+///                           netoutput
+///                               |
+/// data -> act -> a -> b -> c -> d
+///           \_______________/
+/// output of act is large and used by a and d, b is in the middle
+ComputeGraphPtr BuildGraph(const std::string &act_type, const std::vector<int64_t> &d_shape = kSmallShape) {
+  auto builder = ut::GraphBuilder("test");
+  auto data = builder.AddNode("data", DATA, 0, 1, FORMAT_NCHW, DT_FLOAT, kLargeShape);
+  auto act = builder.AddNode("act", act_type, 1, 1, FORMAT_NCHW, DT_FLOAT, kLargeShape);
+  auto a = builder.AddNode("a", kHeavy, 1, 1, FORMAT_NCHW, DT_FLOAT, kSmallShape);
+  auto b = builder.AddNode("b", kHeavy, 1, 1, FORMAT_NCHW, DT_FLOAT, kMiddleShape);
+  auto c = builder.AddNode("c", kHeavy, 1, 1, FORMAT_NCHW, DT_FLOAT, kSmallShape);
+  auto d = builder.AddNode("d", kHeavy, 2, 1, FORMAT_NCHW, DT_FLOAT, d_shape);
+  auto netoutput = builder.AddNode("netoutput", NETOUTPUT, 1, 0, FORMAT_NCHW, DT_FLOAT, kSmallShape);
+  builder.AddDataEdge(data, 0, act, 0);
+  builder.AddDataEdge(act, 0, a, 0);
+  builder.AddDataEdge(a, 0, b, 0);
+  builder.AddDataEdge(b, 0, c, 0);
+  builder.AddDataEdge(c, 0, d, 0);
+  builder.AddDataEdge(act, 0, d, 1);
+  builder.AddDataEdge(d, 0, netoutput, 0);
+  return builder.GetGraph();
+}
+}  // namespace
+
+class UtestRematerializationPass : public testing::Test {
+ protected:
+  void SetUp() {}
+  void TearDown() {
+    GetThreadLocalContext().SetGraphOption({});
+  }
+};
+
+TEST_F(UtestRematerializationPass, recompute_cheap_output_before_late_consumer) {
+  auto graph = BuildGraph(RELU);
+  GetThreadLocalContext().SetGraphOption({{MEMORY_REMATERIALIZATION, "1"}});
+  RematerializationPass pass;
+  EXPECT_EQ(pass.Run(graph), SUCCESS);
+  EXPECT_EQ(pass.GetRematerializedNum(), 1U);
+  EXPECT_GT(pass.GetPeakBefore(), 0);
+  EXPECT_LT(pass.GetPeakAfter(), pass.GetPeakBefore());
+
+  auto act = graph->FindNode("act");
+  auto d = graph->FindNode("d");
+  ASSERT_NE(act, nullptr);
+  ASSERT_NE(d, nullptr);
+  ASSERT_EQ(act->GetOutDataNodes().size(), 1U);
+  EXPECT_EQ(act->GetOutDataNodes().at(0)->GetName(), "a");
+  auto copy = d->GetInDataAnchor(1)->GetPeerOutAnchor()->GetOwnerNode();
+  EXPECT_EQ(copy->GetType(), RELU);
+  EXPECT_EQ(copy->GetInDataNodes().at(0)->GetName(), "data");
+  std::string from;
+  EXPECT_TRUE(AttrUtils::GetStr(copy->GetOpDesc(), kAttrNameRematerializedFrom, from));
+  EXPECT_EQ(from, "act");
+  // computed after c, right before d
+  ASSERT_EQ(copy->GetInControlNodes().size(), 1U);
+  EXPECT_EQ(copy->GetInControlNodes().at(0)->GetName(), "c");
+
+  int64_t peak = 0;
+  EXPECT_TRUE(AttrUtils::GetInt(graph, kAttrNameRematerializationPeakBefore, peak));
+  EXPECT_EQ(peak, pass.GetPeakBefore());
+  EXPECT_TRUE(AttrUtils::GetInt(graph, kAttrNameRematerializationPeakAfter, peak));
+  EXPECT_EQ(peak, pass.GetPeakAfter());
+}
+
+TEST_F(UtestRematerializationPass, rollback_when_peak_not_lowered) {
+  // act, c and the middle sized d are alive at d, as large as the peak at b
+  auto graph = BuildGraph(RELU, kMiddleShape);
+  RematerializationPass pass;
+  pass.SetEnabled(true);
+  EXPECT_EQ(pass.Run(graph), SUCCESS);
+  EXPECT_EQ(pass.GetRematerializedNum(), 0U);
+  EXPECT_EQ(pass.GetPeakAfter(), pass.GetPeakBefore());
+  EXPECT_EQ(graph->GetDirectNodesSize(), 7U);
+  EXPECT_FALSE(graph->HasAttr(kAttrNameRematerializationPeakBefore));
+
+  auto act = graph->FindNode("act");
+  auto d = graph->FindNode("d");
+  ASSERT_NE(act, nullptr);
+  ASSERT_NE(d, nullptr);
+  EXPECT_EQ(act->GetOutDataNodes().size(), 2U);
+  EXPECT_EQ(d->GetInDataAnchor(1)->GetPeerOutAnchor()->GetOwnerNode(), act);
+  EXPECT_TRUE(act->GetInControlNodes().empty());
+}
+
+TEST_F(UtestRematerializationPass, keep_expensive_output) {
+  auto graph = BuildGraph(kHeavy);
+  RematerializationPass pass;
+  pass.SetEnabled(true);
+  EXPECT_EQ(pass.Run(graph), SUCCESS);
+  EXPECT_EQ(pass.GetRematerializedNum(), 0U);
+  EXPECT_EQ(pass.GetPeakAfter(), pass.GetPeakBefore());
+  EXPECT_EQ(graph->GetDirectNodesSize(), 7U);
+  EXPECT_FALSE(graph->HasAttr(kAttrNameRematerializationPeakBefore));
+}
+
+TEST_F(UtestRematerializationPass, stop_within_budget) {
+  auto graph = BuildGraph(RELU);
+  RematerializationPass pass;
+  pass.SetEnabled(true);
+  pass.SetBudget(1024 * 1024);
+  EXPECT_EQ(pass.Run(graph), SUCCESS);
+  EXPECT_EQ(pass.GetRematerializedNum(), 0U);
+  EXPECT_EQ(graph->GetDirectNodesSize(), 7U);
+}
+
+TEST_F(UtestRematerializationPass, disabled_by_default) {
+  auto graph = BuildGraph(RELU);
+  RematerializationPass pass;
+  EXPECT_EQ(pass.Run(graph), SUCCESS);
+  EXPECT_EQ(pass.GetRematerializedNum(), 0U);
+  EXPECT_EQ(graph->GetDirectNodesSize(), 7U);
+}
+}  // namespace ge
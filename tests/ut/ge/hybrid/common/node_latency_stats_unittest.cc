@@ -0,0 +1,180 @@
+/**
+* Copyright 2021, 2022 LuoJiaNET Research and Development Group, Wuhan University
+* Copyright 2021, 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+#define private public
+#define protected public
+#include "hybrid/common/node_latency_stats.h"
+#include "hybrid/executor/hybrid_profiler.h"
+#include "hybrid/model/hybrid_model.h"
+#include "graph/ge_local_context.h"
+#include "graph/utils/graph_utils.h"
+
+using namespace std;
+
+namespace ge {
+using namespace hybrid;
+
+class UtestNodeLatencyStats : public testing::Test {
+ protected:
+  void SetUp() {}
+  void TearDown() {}
+};
+
+TEST_F(UtestNodeLatencyStats, bucket_bounds) {
+  uint64_t prev_upper = 0;
+  for (size_t i = 1; i < LatencyHistogram::kBucketNum; ++i) {
+    uint64_t upper = LatencyHistogram::GetBucketUpperBound(i);
+    ASSERT_GT(upper, prev_upper);
+    // every value falls in the bucket whose bounds hold it
+    EXPECT_EQ(LatencyHistogram::GetBucketIndex(prev_upper + 1), i);
+    EXPECT_EQ(LatencyHistogram::GetBucketIndex(upper), i);
+    // buckets are at most 1/8 of their values wide
+    EXPECT_LE(upper - prev_upper, (prev_upper + 1) / 8 + 1);
+    prev_upper = upper;
+  }
+  EXPECT_EQ(LatencyHistogram::GetBucketIndex(UINT64_MAX), LatencyHistogram::kBucketNum - 1);
+}
+
+TEST_F(UtestNodeLatencyStats, histogram_percentiles) {
+  LatencyHistogram histogram;
+  EXPECT_EQ(histogram.GetPercentile(50), 0);
+  for (uint64_t i = 1; i <= 1000; ++i) {
+    histogram.Record(i * 1000);
+  }
+  EXPECT_EQ(histogram.GetCount(), 1000);
+  EXPECT_EQ(histogram.GetSum(), 500500000);
+  EXPECT_EQ(histogram.GetMax(), 1000000);
+  uint64_t p50 = histogram.GetPercentile(50);
+  uint64_t p99 = histogram.GetPercentile(99);
+  EXPECT_GE(p50, 500000);
+  EXPECT_LE(p50, 500000 * 9 / 8);
+  EXPECT_GE(p99, 990000);
+  EXPECT_LE(p99, 1000000);
+  EXPECT_EQ(histogram.GetPercentile(100), 1000000);
+  EXPECT_LE(histogram.GetPercentile(0), 1000 * 9 / 8);
+
+  histogram.Reset();
+  EXPECT_EQ(histogram.GetCount(), 0);
+  EXPECT_EQ(histogram.GetPercentile(99), 0);
+}
+
+TEST_F(UtestNodeLatencyStats, record_in_threads) {
+  NodeLatencyStats stats;
+  EXPECT_EQ(stats.GetHistogram(profiling::kLaunchTask), nullptr);
+  const int thread_num = 4;
+  const int record_num = 10000;
+  vector<thread> threads;
+  for (int i = 0; i < thread_num; ++i) {
+    threads.emplace_back([&stats]() {
+      for (int j = 0; j < record_num; ++j) {
+        stats.Record(profiling::kLaunchTask, 100 + j);
+      }
+    });
+  }
+  for (auto &t : threads) {
+    t.join();
+  }
+  const LatencyHistogram *histogram = stats.GetHistogram(profiling::kLaunchTask);
+  ASSERT_NE(histogram, nullptr);
+  EXPECT_EQ(histogram->GetCount(), thread_num * record_num);
+  EXPECT_EQ(histogram->GetMax(), 100 + record_num - 1);
+  // only the recorded stage is created, others are not stages
+  EXPECT_EQ(stats.GetHistogram(profiling::kInferShape), nullptr);
+  stats.Record(profiling::kModelExecute, 100);
+  EXPECT_EQ(stats.GetHistogram(profiling::kModelExecute), nullptr);
+
+  {
+    ScopeLatency latency(&stats, profiling::kOnNodeDoneCallback);
+  }
+  ASSERT_NE(stats.GetHistogram(profiling::kOnNodeDoneCallback), nullptr);
+  EXPECT_EQ(stats.GetHistogram(profiling::kOnNodeDoneCallback)->GetCount(), 1);
+  {
+    ScopeLatency latency(nullptr, profiling::kOnNodeDoneCallback);
+  }
+
+  nlohmann::json stats_json;
+  stats.ToJson(stats_json);
+  ASSERT_TRUE(stats_json.contains("launch"));
+  ASSERT_TRUE(stats_json.contains("callback"));
+  EXPECT_FALSE(stats_json.contains("infer_shape"));
+  EXPECT_EQ(stats_json["launch"]["count"].get<uint64_t>(), thread_num * record_num);
+  EXPECT_GT(stats_json["launch"]["p99_us"].get<double>(), stats_json["launch"]["p50_us"].get<double>());
+
+  stats.Reset();
+  stats_json.clear();
+  stats.ToJson(stats_json);
+  EXPECT_TRUE(stats_json.empty());
+}
+
+TEST_F(UtestNodeLatencyStats, model_stats_and_reporter) {
+  ComputeGraphPtr graph = std::make_shared<ComputeGraph>("test");
+  OpDescPtr op_desc = std::make_shared<OpDesc>("add", "Add");
+  NodePtr node = graph->AddNode(op_desc);
+  GeRootModelPtr ge_root_model = make_shared<GeRootModel>(graph);
+  HybridModel hybrid_model(ge_root_model);
+  hybrid_model.model_name_ = "test_model";
+  hybrid_model.SetModelId(9);
+  std::unique_ptr<NodeItem> node_item;
+  ASSERT_EQ(NodeItem::Create(node, node_item), SUCCESS);
+  ASSERT_NE(node_item->latency_stats, nullptr);
+  // dropped when the reporter starts
+  node_item->latency_stats->Record(profiling::kPrepareTask, 2000);
+  hybrid_model.node_items_[node] = std::move(node_item);
+
+  string stats;
+  ASSERT_EQ(hybrid_model.GetNodeLatencyStats(stats), SUCCESS);
+  auto stats_json = nlohmann::json::parse(stats);
+  EXPECT_EQ(stats_json["model_name"].get<string>(), "test_model");
+  EXPECT_EQ(stats_json["nodes"]["add"]["type"].get<string>(), "Add");
+  EXPECT_EQ(stats_json["nodes"]["add"]["prepare"]["count"].get<uint64_t>(), 1);
+
+  // nothing is reported without the interval option
+  LatencyStatsReporter no_reporter(&hybrid_model);
+  EXPECT_EQ(no_reporter.Start(), SUCCESS);
+  EXPECT_TRUE(no_reporter.GetReportFile().empty());
+
+  GetThreadLocalContext().SetGlobalOption({{OPTION_EXEC_LATENCY_STATS_INTERVAL, "3600"},
+                                           {OPTION_EXEC_LATENCY_STATS_PATH, "."}});
+  {
+    LatencyStatsReporter reporter(&hybrid_model);
+    EXPECT_EQ(reporter.Start(), SUCCESS);
+    EXPECT_EQ(reporter.GetReportFile(), "./hybrid_latency_stats_9.json");
+    // only this one is in the report, the 2000 recorded before starting is dropped
+    hybrid_model.node_items_[node]->latency_stats->Record(profiling::kPrepareTask, 3000);
+    // the last stats are written when stopped
+    reporter.Stop();
+  }
+  GetThreadLocalContext().SetGlobalOption({});
+  std::ifstream ifs("./hybrid_latency_stats_9.json");
+  ASSERT_TRUE(ifs.is_open());
+  std::stringstream ss;
+  ss << ifs.rdbuf();
+  EXPECT_EQ(nlohmann::json::parse(ss.str())["nodes"]["add"]["prepare"]["count"].get<uint64_t>(), 1);
+  (void)std::remove("./hybrid_latency_stats_9.json");
+
+  hybrid_model.ResetNodeLatencyStats();
+  ASSERT_EQ(hybrid_model.GetNodeLatencyStats(stats), SUCCESS);
+  EXPECT_TRUE(nlohmann::json::parse(stats)["nodes"].empty());
+}
+}  // namespace ge
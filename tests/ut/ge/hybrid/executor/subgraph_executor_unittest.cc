@@ -209,6 +209,10 @@ TEST_F(UtestSubgraphExecutor, simple_schedule_tasks) {
   graph_context.callback_manager = std::unique_ptr<CallbackManager>(new CallbackManager());
 
   SubgraphExecutor executor(hybrid_model.GetRootGraphItem(), &graph_context);
+  // mutex based queues by default
+  EXPECT_FALSE(executor.ready_queue_.IsLockFree());
+  EXPECT_FALSE(executor.schedule_queue_.IsLockFree());
+  EXPECT_FALSE(executor.GetPrepareQueue(-1).IsLockFree());
   ASSERT_EQ(executor.ExecuteAsync(inputs, input_descs, outputs), SUCCESS);
   ASSERT_EQ(executor.Synchronize(), SUCCESS);
 }
@@ -258,7 +262,14 @@ TEST_F(UtestSubgraphExecutor, cond_graph_schedule_tasks) {
   ASSERT_NE(hybrid_model.node_items_.end(), node_it_t);
   ASSERT_NE(hybrid_model.node_items_.end(), node_it_f);
 
+  // the nodes go through lock free queues, the prepare queue holds no more cells than the nodes
+  graph_context.lock_free_queues = {"ready", "schedule", "prepare"};
   SubgraphExecutor executor(hybrid_model.GetRootGraphItem(), &graph_context);
+  EXPECT_TRUE(executor.ready_queue_.IsLockFree());
+  EXPECT_TRUE(executor.schedule_queue_.IsLockFree());
+  EXPECT_TRUE(executor.GetPrepareQueue(-1).IsLockFree());
+  EXPECT_LE(executor.GetPrepareQueue(-1).lock_free_queue_->Capacity(),
+            2 * hybrid_model.GetRootGraphItem()->GetNodeSize(-1));
   ASSERT_EQ(executor.ExecuteAsync(inputs, input_desc, outputs), SUCCESS);
   ASSERT_EQ(executor.Synchronize(), SUCCESS);
 
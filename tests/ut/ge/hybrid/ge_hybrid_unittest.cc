@@ -38,12 +38,14 @@
 #include "hybrid/node_executor/aicore/aicore_node_executor.h"
 #include "graph/load/model_manager/tbe_handle_store.h"
 #include "graph/manager/graph_mem_allocator.h"
+#include "graph/manager/graph_mem_manager.h"
 #include "hybrid/common/npu_memory_allocator.h"
 #include "graph/types.h"
 #include "graph/utils/tensor_utils.h"
 #include "graph/testcase/ge_graph/graph_builder_utils.h"
 #include "single_op/task/build_task_utils.h"
 #include "graph/op_desc_impl.h"
+#include "tests/depends/runtime/src/runtime_stub.h"
 
 using namespace std;
 
@@ -835,4 +837,103 @@ TEST_F(UtestGeHybrid, TestTaskExecuteAsync) {
   AiCoreNodeTask node_task(std::move(tasks));
   ASSERT_EQ(node_task.ExecuteAsync(task_context, nullptr), SUCCESS);
 }
+
+TEST_F(UtestGeHybrid, TestStreamOrderedFree) {
+  ASSERT_EQ(MemManager::Instance().Initialize({RT_MEMORY_HBM}), SUCCESS);
+  auto allocator = NpuMemoryAllocator::GetAllocator(0);
+  ASSERT_NE(allocator, nullptr);
+  rtStream_t stream = reinterpret_cast<rtStream_t>(0x01);
+  rtStream_t other_stream = reinterpret_cast<rtStream_t>(0x02);
+  AllocationAttr attr;
+  attr.SetStream(stream);
+  AllocationAttr other_attr;
+  other_attr.SetStream(other_stream);
+
+  void *buffer = allocator->Allocate(1024, &attr);
+  ASSERT_NE(buffer, nullptr);
+  EXPECT_TRUE(allocator->IsStreamOrdered(buffer));
+  allocator->Deallocate(buffer);
+  EXPECT_FALSE(allocator->IsStreamOrdered(buffer));
+  EXPECT_EQ(allocator->stream_block_num_, 1);
+
+  // tasks of the same stream run in order, no need to wait
+  EXPECT_EQ(allocator->Allocate(1024, &attr), buffer);
+  EXPECT_EQ(allocator->stream_block_num_, 0);
+  allocator->Deallocate(buffer);
+
+  // other streams do not get the block while the tasks using it are running
+  RTS_STUB_RETURN_VALUE(rtEventQuery, rtError_t, ACL_ERROR_RT_EVENT_NOT_COMPLETE);
+  void *other = allocator->Allocate(1024, &other_attr);
+  ASSERT_NE(other, nullptr);
+  EXPECT_NE(other, buffer);
+  EXPECT_EQ(allocator->stream_block_num_, 1);
+  allocator->Deallocate(other);
+  EXPECT_EQ(allocator->stream_block_num_, 2);
+
+  // unordered memory is freed at once, blocks of completed tasks go back to the caching allocator
+  void *unordered = allocator->Allocate(2048, nullptr);
+  ASSERT_NE(unordered, nullptr);
+  EXPECT_FALSE(allocator->IsStreamOrdered(unordered));
+  allocator->Deallocate(unordered);
+  void *large = allocator->Allocate(8192, &other_attr);
+  ASSERT_NE(large, nullptr);
+  EXPECT_EQ(allocator->stream_block_num_, 0);
+
+  // the stream is done, buffers still in use are freed as unordered ones
+  buffer = allocator->Allocate(1024, &attr);
+  ASSERT_NE(buffer, nullptr);
+  allocator->ReleaseStreamBlocks(other_stream);
+  EXPECT_FALSE(allocator->IsStreamOrdered(large));
+  EXPECT_TRUE(allocator->IsStreamOrdered(buffer));
+  allocator->Deallocate(large);
+  allocator->Deallocate(buffer);
+  allocator->ReleaseStreamBlocks(stream);
+  EXPECT_EQ(allocator->stream_block_num_, 0);
+  EXPECT_TRUE(allocator->stream_buffers_.empty());
+  RTS_STUB_TEARDOWN();
+  MemManager::Instance().Finalize();
+}
+
+TEST_F(UtestGeHybrid, TestStreamOrderedFreeUsedByOtherStream) {
+  ASSERT_EQ(MemManager::Instance().Initialize({RT_MEMORY_HBM}), SUCCESS);
+  std::unique_ptr<NpuMemoryAllocator> allocator(new NpuMemoryAllocator(0));
+  rtStream_t stream = reinterpret_cast<rtStream_t>(0x01);
+  rtStream_t other_stream = reinterpret_cast<rtStream_t>(0x02);
+  AllocationAttr attr;
+  attr.SetStream(stream);
+
+  void *buffer = allocator->Allocate(1024, &attr);
+  ASSERT_NE(buffer, nullptr);
+  allocator->RecordStream(buffer, stream);
+  allocator->RecordStream(buffer, other_stream);
+  allocator->RecordStream(buffer, other_stream);
+  EXPECT_EQ(allocator->stream_buffers_[buffer].other_streams.size(), 1U);
+  allocator->Deallocate(buffer);
+  ASSERT_EQ(allocator->stream_blocks_[stream].size(), 1U);
+  EXPECT_EQ(allocator->stream_blocks_[stream].front().events.size(), 2U);
+
+  // the other stream may still read the block, the allocating stream does not take it at once
+  RTS_STUB_RETURN_VALUE(rtEventQuery, rtError_t, ACL_ERROR_RT_EVENT_NOT_COMPLETE);
+  void *other = allocator->Allocate(1024, &attr);
+  ASSERT_NE(other, nullptr);
+  EXPECT_NE(other, buffer);
+  allocator->Deallocate(other);
+  EXPECT_EQ(allocator->stream_block_num_, 2);
+  RTS_STUB_TEARDOWN();
+
+  // the allocating stream is synchronized, the buffer still waits for the other stream when freed
+  void *shared = allocator->Allocate(4096, &attr);
+  ASSERT_NE(shared, nullptr);
+  allocator->RecordStream(shared, other_stream);
+  allocator->ReleaseStreamBlocks(stream);
+  ASSERT_TRUE(allocator->IsStreamOrdered(shared));
+  EXPECT_EQ(allocator->stream_buffers_[shared].stream, other_stream);
+  EXPECT_TRUE(allocator->stream_buffers_[shared].other_streams.empty());
+  allocator->Deallocate(shared);
+  EXPECT_EQ(allocator->stream_blocks_[other_stream].size(), 1U);
+
+  // pending blocks go back to the caching allocator when the allocator is destroyed
+  allocator.reset();
+  MemManager::Instance().Finalize();
+}
 } // namespace ge
@@ -18,6 +18,8 @@
 #include <gtest/gtest.h>
 #include <gmock/gmock.h>
 
+#include <map>
+#include <mutex>
 #include <vector>
 
 #define private public
@@ -38,6 +40,42 @@ using namespace testing;
 namespace ge {
 using namespace hybrid;
 
+namespace {
+class LoadedTask : public NoOpTask {
+ public:
+  explicit LoadedTask(const std::string &node_name) : node_name_(node_name) {}
+  std::string node_name_;
+};
+
+class RecordLoadNodeExecutor : public NodeExecutor {
+ public:
+  Status LoadTask(const HybridModel &model, const NodePtr &node, shared_ptr<NodeTask> &task) const override {
+    if (node->GetName() == failed_node_name_) {
+      return FAILED;
+    }
+    task = make_shared<LoadedTask>(node->GetName());
+    std::lock_guard<std::mutex> lock(mutex_);
+    handles_[node->GetName()]++;
+    return SUCCESS;
+  }
+
+  std::string failed_node_name_;
+  mutable std::mutex mutex_;
+  // times the kernel of each node is registered
+  mutable std::map<std::string, int> handles_;
+};
+
+std::map<std::string, std::string> GetLoadedTasks(HybridModel &hybrid_model) {
+  std::map<std::string, std::string> loaded_tasks;
+  for (auto &it : hybrid_model.node_items_) {
+    auto task = dynamic_cast<LoadedTask *>(it.second->kernel_task.get());
+    loaded_tasks[it.second->node_name] = (task == nullptr) ? "" : task->node_name_;
+    it.second->kernel_task = nullptr;
+  }
+  return loaded_tasks;
+}
+}  // namespace
+
 class UtestHybridModelBuilder : public testing::Test {
  protected:
   void SetUp() {}
@@ -390,4 +428,69 @@ HybridModelBuilder hybrid_model_builder(hybrid_model);
 Status st = hybrid_model_builder.CopyGraph();
 EXPECT_EQ(st, SUCCESS);
 }
+
+TEST_F(UtestHybridModelBuilder, load_tasks_with_multi_threads) {
+  const int node_num = 16;
+  ComputeGraphPtr graph = std::make_shared<ComputeGraph>("test");
+  GeRootModelPtr ge_root_model = make_shared<GeRootModel>(graph);
+  for (int i = 0; i < node_num; ++i) {
+    CreateNode(*graph, "add_" + std::to_string(i), ADD, 2, 1);
+  }
+  CreateNode(*graph, "net_output", NETOUTPUT, 1, 0);
+
+  RecordLoadNodeExecutor executor;
+  HybridModel hybrid_model(ge_root_model);
+  for (const auto &node : graph->GetDirectNode()) {
+    std::unique_ptr<NodeItem> node_item;
+    ASSERT_EQ(NodeItem::Create(node, node_item), SUCCESS);
+    node_item->node_executor = &executor;
+    hybrid_model.node_items_.emplace(node, std::move(node_item));
+  }
+  HybridModelBuilder hybrid_model_builder(hybrid_model);
+
+  GetThreadLocalContext().SetGlobalOption({{OPTION_EXEC_MODEL_LOAD_THREAD_NUM, "1"}});
+  ASSERT_EQ(hybrid_model_builder.LoadTasks(), SUCCESS);
+  const auto serial_tasks = GetLoadedTasks(hybrid_model);
+  const auto serial_handles = executor.handles_;
+  EXPECT_EQ(serial_handles.size(), static_cast<size_t>(node_num));
+  EXPECT_EQ(serial_tasks.at("add_0"), "add_0");
+  EXPECT_EQ(serial_tasks.at("net_output"), "");
+
+  executor.handles_.clear();
+  GetThreadLocalContext().SetGlobalOption({{OPTION_EXEC_MODEL_LOAD_THREAD_NUM, "4"}});
+  ASSERT_EQ(hybrid_model_builder.LoadTasks(), SUCCESS);
+  EXPECT_EQ(GetLoadedTasks(hybrid_model), serial_tasks);
+  EXPECT_EQ(executor.handles_, serial_handles);
+
+  executor.failed_node_name_ = "add_3";
+  EXPECT_EQ(hybrid_model_builder.LoadTasks(), FAILED);
+  GetThreadLocalContext().SetGlobalOption({});
+}
+
+TEST_F(UtestHybridModelBuilder, record_build_costs) {
+  ComputeGraphPtr graph = std::make_shared<ComputeGraph>("test");
+  GeRootModelPtr ge_root_model = make_shared<GeRootModel>(graph);
+  ge_root_model->SetModelName("test_name");
+  ge_root_model->SetSubgraphInstanceNameToModel("sub", make_shared<GeModel>());
+  auto data = CreateNode(*graph, "data", DATA, 1, 1);
+  auto output = CreateNode(*graph, "net_output", NETOUTPUT, 1, 1);
+  GraphUtils::AddEdge(data->GetOutDataAnchor(0), output->GetInDataAnchor(0));
+
+  auto &engine_mapping = NodeExecutorManager::GetInstance().engine_mapping_;
+  engine_mapping.emplace("DNN_VM_RTS_OP_STORE", NodeExecutorManager::ExecutorType::RTS);
+  auto &task_executor = NodeExecutorManager::GetInstance().executors_;
+  task_executor.emplace(NodeExecutorManager::ExecutorType::RTS, std::unique_ptr<NodeExecutor>(new NodeExecutor()));
+
+  HybridModel hybrid_model(ge_root_model);
+  HybridModelBuilder hybrid_model_builder(hybrid_model);
+  ASSERT_EQ(hybrid_model_builder.Build(), SUCCESS);
+  engine_mapping.clear();
+  task_executor.clear();
+
+  std::vector<std::string> phases;
+  for (const auto &cost : hybrid_model_builder.GetBuildCosts()) {
+    phases.emplace_back(cost.first);
+  }
+  EXPECT_EQ(phases, std::vector<std::string>({"CopyGraph", "IndexTaskDefs", "InitWeights", "LoadGraph", "LoadTasks"}));
+}
 } // namespace ge